@@ -1,8 +1,25 @@
 #include "Source/Editor/Editor.h"
+#include "Source/Core/Engine.h"
+#include "Source/Profiling/Benchmark.h"
+#include "Source/Profiling/MathBenchmark.h"
 #include <Windows.h>
 
-int main(int argc, int argv[])
+int main(int argc, char* argv[])
 {
+	Amethyst::Engine::SetCommandLineArguments(argc, argv);
+
+	// Headless benchmark run. See Benchmark.h for its arguments.
+	if (Amethyst::Engine::HasCommandLineArgument("-benchmark"))
+	{
+		Amethyst::Benchmark benchmark(Amethyst::BenchmarkSettings::FromCommandLine());
+		return benchmark.Run() ? 0 : 1;
+	}
+
+	if (Amethyst::Engine::HasCommandLineArgument("-benchmark_math"))
+	{
+		return Amethyst::MathBenchmark::RunFromCommandLine() ? 0 : 1;
+	}
+
 	Editor editor;
 	editor.OnUpdate();
 	return 0;
@@ -20,6 +20,9 @@
 #include "../Runtime/Log/Log.h"
 #include "../Time/Stopwatch.h"
 
+// Profiling
+#include "../Profiling/Profiler.h"
+
 // Events
 #include "../Event/EventSystem.h"
 
@@ -3,8 +3,10 @@
 //Version
 #define ENGINE_VERSION "Amethyst (0.1 WIP)"
 
-//Platform
+//Platform - The Debug_Null and Release_Null configurations define API_GRAPHICS_NULL, building the null backend which records commands instead of sending them to a GPU.
+#if !defined(API_GRAPHICS_NULL)
 #define API_GRAPHICS_VULKAN
+#endif
 //#define API_GRAPHICS_D3D12
 //#define API_GRAPHICS_OPENGL
 
@@ -37,7 +37,7 @@ namespace Amethyst
 		std::string m_Name;
 		uint32_t m_ID = 0;
 
-		uint64_t m_Size_GPU;
-		uint64_t m_Size_CPU;
+		uint64_t m_Size_GPU = 0;
+		uint64_t m_Size_CPU = 0;
 	};
 }
@@ -1,7 +1,9 @@
 #pragma once
+#include <typeinfo>
 #include "ISubsystem.h"
 #include "../Runtime/Log/Log.h"
 #include "AmethystDefinitions.h"
+#include "../Profiling/TimeBlock.h"
 
 namespace Amethyst
 {
@@ -83,6 +85,8 @@ namespace Amethyst
 		// Tick
 		void OnUpdate(TickType tickType, float deltaTime = 0.0f)
 		{
+			AMETHYST_PROFILE_SCOPE(tickType == TickType::Variable ? "Context::OnUpdate (Variable)" : "Context::OnUpdate (Smoothed)");
+
 			for (const _Subsystem& subsystem : m_Subsystems)
 			{
 				if (subsystem.m_TickType != tickType)
@@ -90,6 +94,7 @@ namespace Amethyst
 					continue;
 				}
 
+				AMETHYST_PROFILE_SCOPE(typeid(*subsystem.m_SubsystemPointer).name()); // Type names have static storage duration.
 				subsystem.m_SubsystemPointer->OnUpdate(deltaTime);
 			}
 		}
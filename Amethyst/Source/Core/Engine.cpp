@@ -1,4 +1,7 @@
 #include "Amethyst.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include "Engine.h"
 #include "Context.h"
 #include "Window.h"
@@ -8,6 +11,8 @@
 #include "../Threading/Threading.h"
 #include "../Runtime/ECS/World.h"
 #include "../Input/Input.h"
+#include "../Profiling/Profiler.h"
+#include "../Profiling/MemoryTracker.h"
 
 namespace Amethyst
 {
@@ -16,6 +21,15 @@ namespace Amethyst
 		// Flags
 		m_EngineFlags |= Engine_Physics;
 		m_EngineFlags |= Engine_Game;
+		if (HasCommandLineArgument("-headless") || HasCommandLineArgument("-benchmark"))
+		{
+			m_EngineFlags |= Engine_Headless;
+		}
+		const bool isHeadless = EngineMode_IsToggled(Engine_Headless);
+
+		// Pick the widest math kernels this CPU supports.
+		Math::SIMD::Initialize();
+		AMETHYST_INFO("Math kernels: %s.", Math::SIMD::InstructionSetToString(Math::SIMD::RetrieveKernels().m_InstructionSet));
 
 		// Create our Context.
 		m_Context = std::make_shared<Context>();
@@ -25,15 +39,32 @@ namespace Amethyst
 		/// Settings
 		m_Context->RegisterSubsystem<Timer>(); /// Complete
 		m_Context->RegisterSubsystem<Threading>(); /// Complete
-		m_Context->RegisterSubsystem<Window>(); /// Complete
+		if (!isHeadless)
+		{
+			m_Context->RegisterSubsystem<Window>(); /// Complete
+		}
 		m_Context->RegisterSubsystem<Input>(TickType::Smoothed);  /// Complete
 		m_Context->RegisterSubsystem<ResourceCache>(); /// Complete
 		/// Audio
 		/// Physics
 		/// Scripting
 		m_Context->RegisterSubsystem<World>(TickType::Smoothed); /// Require More Math Stuff/Model/Mesh Classes
-		m_Context->RegisterSubsystem<Renderer>(); /// Require Shader Class / RHI_ImGui Implementation
-		/// Profiler
+		#if defined(API_GRAPHICS_NULL)
+		m_Context->RegisterSubsystem<Renderer>(); // The null backend needs no window, so headless runs still record every frame.
+		#else
+		if (!isHeadless)
+		{
+			m_Context->RegisterSubsystem<Renderer>(); /// Require Shader Class / RHI_ImGui Implementation
+		}
+		#endif
+		m_Context->RegisterSubsystem<MemoryTracker>();
+		m_Context->RegisterSubsystem<Profiler>(); // Registered last so that its post-tick closes off the frame.
+
+		// Headless runs are measured, not watched. Don't spin on the frame limiter.
+		if (isHeadless)
+		{
+			m_Context->RetrieveSubsystem<Timer>()->SetFPSLimitEnabled(false);
+		}
 
 		/// Initialize all our above subsystems.
 		m_Context->OnInitialize();
@@ -48,6 +79,63 @@ namespace Amethyst
 		EventSystem::RetrieveInstance().Reset();
 	}
 
+	void Engine::SetCommandLineArguments(const int argumentCount, char* arguments[])
+	{
+		s_CommandLineArguments.clear();
+
+		for (int i = 0; i < argumentCount; i++)
+		{
+			s_CommandLineArguments.emplace_back(arguments[i]);
+		}
+	}
+
+	bool Engine::HasCommandLineArgument(const std::string& argument)
+	{
+		return std::find(s_CommandLineArguments.begin(), s_CommandLineArguments.end(), argument) != s_CommandLineArguments.end();
+	}
+
+	std::string Engine::RetrieveCommandLineArgumentValue(const std::string& argument)
+	{
+		const auto iterator = std::find(s_CommandLineArguments.begin(), s_CommandLineArguments.end(), argument);
+		if (iterator == s_CommandLineArguments.end() || std::next(iterator) == s_CommandLineArguments.end())
+		{
+			return "";
+		}
+
+		return *std::next(iterator);
+	}
+
+	template<typename T>
+	static T RetrieveCommandLineArgumentAsNumber(const std::string& argument, const T fallback)
+	{
+		const std::string value = Engine::RetrieveCommandLineArgumentValue(argument);
+		if (value.empty())
+		{
+			return fallback;
+		}
+
+		// The whole token has to be the number, so "12abc" or a following argument doesn't slip through. Neither do infinities and NaNs.
+		T number = fallback;
+		const std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(), number);
+		if (result.ec != std::errc() || result.ptr != value.data() + value.size() || !std::isfinite(static_cast<double>(number)))
+		{
+			AMETHYST_WARNING("\"%s\" is not a valid value for %s. The default will be used instead.", value.c_str(), argument.c_str());
+			return fallback;
+		}
+
+		return number;
+	}
+
+	uint32_t Engine::RetrieveCommandLineArgumentAsInteger(const std::string& argument, const uint32_t fallback)
+	{
+		return RetrieveCommandLineArgumentAsNumber(argument, fallback);
+	}
+
+	float Engine::RetrieveCommandLineArgumentAsFloat(const std::string& argument, const float fallback)
+	{
+		return RetrieveCommandLineArgumentAsNumber(argument, fallback);
+	}
+
 	void Engine::OnUpdate() const
 	{
 		Timer* timer = m_Context->RetrieveSubsystem<Timer>();
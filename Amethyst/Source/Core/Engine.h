@@ -1,5 +1,7 @@
 #pragma once
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace Amethyst
 {
@@ -10,6 +12,7 @@ namespace Amethyst
 	{
 		Engine_Physics = 1UL << 0,	//Should Physics be working?
 		Engine_Game    = 1UL << 1,	//Is the engine running in game or editor mode?
+		Engine_Headless = 1UL << 2	//No window. Set from the command line (-headless or -benchmark). Only the null backend keeps its renderer, as it has no use for a swapchain surface.
 	};
 
 	class Engine
@@ -31,7 +34,16 @@ namespace Amethyst
 
 		Context* RetrieveContext() const { return m_Context.get(); }
 
+		// Command Line - Must be set before the engine is created for subsystems to see it during initialization.
+		static void SetCommandLineArguments(const int argumentCount, char* arguments[]);
+		static bool HasCommandLineArgument(const std::string& argument);
+		static std::string RetrieveCommandLineArgumentValue(const std::string& argument); // Returns the token following the argument, or an empty string.
+		static uint32_t RetrieveCommandLineArgumentAsInteger(const std::string& argument, const uint32_t fallback); // Falls back if the value is missing, or with a warning if it isn't a number.
+		static float RetrieveCommandLineArgumentAsFloat(const std::string& argument, const float fallback);
+
 	private:
+		static inline std::vector<std::string> s_CommandLineArguments;
+
 		uint32_t m_EngineFlags = 0;
 		std::shared_ptr<Context> m_Context;
 	};
@@ -0,0 +1,438 @@
+#include "Amethyst.h"
+#include "Benchmark.h"
+#include "MemoryTracker.h"
+#include "../Runtime/ECS/World.h"
+#include "../Runtime/ECS/Entity.h"
+#include "../Runtime/ECS/Components/Transform.h"
+#include "../Runtime/ECS/Components/Renderable.h"
+#include "../Runtime/ECS/Components/Camera.h"
+#include "../Rendering/Model.h"
+#include "../Rendering/Renderer.h"
+#include "../Utilities/Geometry.h"
+#if defined(API_GRAPHICS_NULL)
+#include "../RHI/RHI_Device.h"
+#include "../RHI/RHI_Implementation.h"
+#endif
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <random>
+
+namespace Amethyst
+{
+	BenchmarkSettings BenchmarkSettings::FromCommandLine()
+	{
+		BenchmarkSettings settings;
+		settings.m_EntityCount		= Engine::RetrieveCommandLineArgumentAsInteger("-benchmark_entities", settings.m_EntityCount);
+		settings.m_HierarchyDepth	= Math::Utilities::Max(Engine::RetrieveCommandLineArgumentAsInteger("-benchmark_depth", settings.m_HierarchyDepth), 1u);
+		settings.m_RenderableRatio	= Math::Utilities::Clamp(Engine::RetrieveCommandLineArgumentAsFloat("-benchmark_renderables", settings.m_RenderableRatio), 0.0f, 1.0f);
+		settings.m_AnimatedRatio	= Math::Utilities::Clamp(Engine::RetrieveCommandLineArgumentAsFloat("-benchmark_animated", settings.m_AnimatedRatio), 0.0f, 1.0f);
+		settings.m_Seed				= Engine::RetrieveCommandLineArgumentAsInteger("-benchmark_seed", settings.m_Seed);
+		settings.m_WarmupFrameCount = Engine::RetrieveCommandLineArgumentAsInteger("-benchmark_warmup", settings.m_WarmupFrameCount);
+		settings.m_FrameCount		= Math::Utilities::Max(Engine::RetrieveCommandLineArgumentAsInteger("-benchmark_frames", settings.m_FrameCount), 1u);
+
+		const std::string filePath = Engine::RetrieveCommandLineArgumentValue("-benchmark_file");
+		if (!filePath.empty())
+		{
+			settings.m_OutputFilePath = filePath;
+		}
+
+		return settings;
+	}
+
+	BenchmarkStatistics BenchmarkStatistics::FromSamples(std::vector<double> samples)
+	{
+		BenchmarkStatistics statistics;
+		if (samples.empty())
+		{
+			return statistics;
+		}
+
+		std::sort(samples.begin(), samples.end());
+
+		// Nearest rank.
+		const auto Percentile = [&samples](const double percentile)
+		{
+			const size_t rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(samples.size())));
+			return samples[Math::Utilities::Clamp<size_t>(rank, 1, samples.size()) - 1];
+		};
+
+		double total = 0.0;
+		for (const double sample : samples)
+		{
+			total += sample;
+		}
+
+		statistics.m_Minimum = samples.front();
+		statistics.m_Average = total / static_cast<double>(samples.size());
+		statistics.m_Median = Percentile(0.5);
+		statistics.m_Percentile90 = Percentile(0.9);
+		statistics.m_Percentile99 = Percentile(0.99);
+		statistics.m_Maximum = samples.back();
+
+		return statistics;
+	}
+
+	Benchmark::Benchmark(const BenchmarkSettings& settings) : m_Settings(settings)
+	{
+
+	}
+
+	Benchmark::~Benchmark()
+	{
+		// Entities hold on to the context, so let go of them before the engine shuts down.
+		m_AnimatedEntities.clear();
+		m_RenderableEntities.clear();
+		m_CameraEntity.reset();
+		m_Model.reset(); // Its buffers go back to the device, which must still be there.
+		m_Engine.reset();
+	}
+
+	bool Benchmark::Run()
+	{
+		m_Engine = std::make_unique<Engine>();
+		if (!m_Engine->EngineMode_IsToggled(EngineMode::Engine_Headless))
+		{
+			AMETHYST_ERROR("Benchmarks must run headless. Pass -benchmark on the command line.");
+			return false;
+		}
+
+		Context* context = m_Engine->RetrieveContext();
+		m_Profiler = context->RetrieveSubsystem<Profiler>();
+		m_MemoryTracker = context->RetrieveSubsystem<MemoryTracker>();
+		m_Renderer = context->RetrieveSubsystem<Renderer>();
+		if (!m_Profiler || !m_MemoryTracker)
+		{
+			AMETHYST_ERROR("The profiler and memory tracker are required to run benchmarks.");
+			return false;
+		}
+
+		// We take our own snapshots around the run.
+		m_MemoryTracker->SetSnapshotInterval(0.0f);
+		const MemorySnapshot memoryBefore = m_MemoryTracker->TakeSnapshot();
+
+		// Scene
+		const Stopwatch sceneStopwatch;
+		GenerateScene();
+		const float sceneGenerationTimeInMilliseconds = sceneStopwatch.RetrieveElapsedTimeInMilliseconds();
+		AMETHYST_INFO("Generated %d entities in %.2f ms.", m_Settings.m_EntityCount, sceneGenerationTimeInMilliseconds);
+
+		// Animation is stepped at a fixed rate so that every run does the exact same work.
+		const float timeStep = 1.0f / 60.0f;
+		uint32_t frameIndex = 0;
+
+		// Warmup - Lets caches, allocators and lazily created state settle before we start measuring.
+		m_Profiler->SetEnabled(true);
+		for (uint32_t i = 0; i < m_Settings.m_WarmupFrameCount; i++, frameIndex++)
+		{
+			AnimateScene(frameIndex * timeStep);
+			GatherBounds();
+			m_Engine->OnUpdate();
+		}
+
+		// Validation only runs over the warmup, as it would otherwise be measured with everything else.
+		#if defined(API_GRAPHICS_NULL)
+		if (m_Renderer)
+		{
+			RHI_Context* rhi_Context = m_Renderer->RetrieveRHIDevice()->RetrieveContextRHI();
+			m_ValidationErrorCount = rhi_Context->m_SubmittedStatistics.m_ValidationErrorCount;
+			rhi_Context->m_SubmittedStatistics = Null_CommandStatistics();
+			rhi_Context->m_IsValidationEnabled = false;
+
+			if (m_ValidationErrorCount != 0)
+			{
+				AMETHYST_WARNING("%d validation errors were raised during the warmup.", static_cast<uint32_t>(m_ValidationErrorCount));
+			}
+		}
+		#endif
+
+		// Measure
+		m_Profiler->ResetStatistics();
+		m_FrameTimes.reserve(m_Settings.m_FrameCount);
+		for (uint32_t i = 0; i < m_Settings.m_FrameCount; i++, frameIndex++)
+		{
+			const Stopwatch frameStopwatch;
+			AnimateScene(frameIndex * timeStep);
+			GatherBounds();
+			m_Engine->OnUpdate(); // The profiler aggregates this frame on its post-tick.
+			m_FrameTimes.emplace_back(static_cast<double>(frameStopwatch.RetrieveElapsedTimeInMilliseconds()));
+
+			RecordScopes();
+			RecordSubmissions();
+		}
+
+		const MemorySnapshot memoryAfter = m_MemoryTracker->TakeSnapshot();
+
+		return WriteReport(sceneGenerationTimeInMilliseconds, memoryBefore, memoryAfter);
+	}
+
+	void Benchmark::GenerateScene()
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		World* world = m_Engine->RetrieveContext()->RetrieveSubsystem<World>();
+
+		std::mt19937 generator(m_Settings.m_Seed);
+		std::uniform_real_distribution<float> positionDistribution(-500.0f, 500.0f);
+		std::uniform_real_distribution<float> offsetDistribution(-2.0f, 2.0f);
+		std::uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+		std::uniform_real_distribution<float> ratioDistribution(0.0f, 1.0f);
+
+		// With a renderer, every renderable draws the same cube, which is what lets them be batched into instanced draws.
+		Math::BoundingBox unitBox = Math::BoundingBox(Math::Vector3(-0.5f, -0.5f, -0.5f), Math::Vector3(0.5f, 0.5f, 0.5f));
+		uint32_t indexCount = 0;
+		uint32_t vertexCount = 0;
+		if (m_Renderer)
+		{
+			std::vector<RHI_Vertex_PositionTextureNormalTangent> vertices;
+			std::vector<uint32_t> indices;
+			Utility::Geometry::CreateCube(&vertices, &indices);
+
+			m_Model = std::make_shared<Model>(m_Engine->RetrieveContext());
+			m_Model->AppendGeometry(indices, vertices, nullptr, nullptr);
+			m_Model->UpdateGeometry();
+
+			unitBox = Math::BoundingBox(vertices.data(), static_cast<uint32_t>(vertices.size()));
+			indexCount = static_cast<uint32_t>(indices.size());
+			vertexCount = static_cast<uint32_t>(vertices.size());
+
+			// Looks down the scene from outside of it, so that culling has work to do on both sides of the frustum.
+			m_CameraEntity = world->EntityCreate();
+			m_CameraEntity->SetName("Benchmark_Camera");
+			Camera* camera = m_CameraEntity->AddComponent<Camera>();
+			camera->SetFarPlane(2000.0f);
+			m_CameraEntity->RetrieveTransform()->SetPositionLocal(Math::Vector3(0.0f, 0.0f, -750.0f));
+		}
+
+		const uint32_t hierarchyDepth = Math::Utilities::Max(m_Settings.m_HierarchyDepth, 1u);
+		Transform* parent = nullptr;
+		for (uint32_t i = 0; i < m_Settings.m_EntityCount; i++)
+		{
+			std::shared_ptr<Entity> entity = world->EntityCreate();
+			entity->SetName("Benchmark_" + std::to_string(i));
+
+			Transform* transform = entity->RetrieveTransform();
+			const bool isRoot = (i % hierarchyDepth) == 0;
+			if (isRoot)
+			{
+				const Math::Vector3 position = Math::Vector3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+				transform->SetPositionLocal(position);
+
+				if (ratioDistribution(generator) < m_Settings.m_AnimatedRatio)
+				{
+					m_AnimatedEntities.emplace_back(entity);
+					m_AnimatedEntityPositions.emplace_back(position);
+				}
+			}
+			else
+			{
+				transform->SetParent(parent);
+				transform->SetPositionLocal(Math::Vector3(offsetDistribution(generator), offsetDistribution(generator), offsetDistribution(generator)));
+			}
+
+			const float scale = scaleDistribution(generator);
+			transform->SetScaleLocal(Math::Vector3(scale, scale, scale));
+			parent = transform;
+
+			if (ratioDistribution(generator) < m_Settings.m_RenderableRatio)
+			{
+				Renderable* renderable = entity->AddComponent<Renderable>();
+				renderable->GeometrySet("Benchmark_Geometry", 0, indexCount, 0, vertexCount, unitBox, m_Model.get());
+				m_RenderableEntities.emplace_back(entity);
+			}
+		}
+
+		world->ResolveWorld();
+	}
+
+	void Benchmark::AnimateScene(const float timeInSeconds)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		for (size_t i = 0; i < m_AnimatedEntities.size(); i++)
+		{
+			const float phase = static_cast<float>(i) * 0.1f;
+			const Math::Vector3 offset = Math::Vector3(std::sin(timeInSeconds + phase), std::cos(timeInSeconds + phase), 0.0f);
+			m_AnimatedEntities[i]->RetrieveTransform()->SetPositionLocal(m_AnimatedEntityPositions[i] + offset);
+		}
+	}
+
+	void Benchmark::GatherBounds()
+	{
+		// The renderer gathers them itself, when there is one.
+		if (m_Renderer)
+		{
+			return;
+		}
+
+		AMETHYST_PROFILE_FUNCTION();
+
+		// Stands in for the renderer's visibility gathering, which would otherwise be absent from a headless frame.
+		for (const std::shared_ptr<Entity>& entity : m_RenderableEntities)
+		{
+			entity->GetComponent<Renderable>()->RetrieveAABB();
+		}
+	}
+
+	void Benchmark::RecordScopes()
+	{
+		const std::vector<ProfilerNode>& nodes = m_Profiler->RetrieveNodes();
+		m_ScopeTimes.resize(nodes.size());
+		m_ScopeCalls.resize(nodes.size());
+
+		// Only frames in which a scope was hit count towards it, matching the profiler's own history.
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			if (nodes[i].m_CallCount != 0)
+			{
+				m_ScopeTimes[i].emplace_back(nodes[i].m_TimeInMilliseconds);
+				m_ScopeCalls[i].emplace_back(static_cast<double>(nodes[i].m_CallCount));
+			}
+		}
+	}
+
+	void Benchmark::RecordSubmissions()
+	{
+		#if defined(API_GRAPHICS_NULL)
+		if (!m_Renderer)
+		{
+			return;
+		}
+
+		// Tallied since the previous frame.
+		RHI_Context* rhi_Context = m_Renderer->RetrieveRHIDevice()->RetrieveContextRHI();
+		const Null_CommandStatistics& statistics = rhi_Context->m_SubmittedStatistics;
+		m_DrawCounts.emplace_back(static_cast<double>(statistics.m_DrawCount));
+		m_InstanceCounts.emplace_back(static_cast<double>(statistics.m_InstanceCount));
+		m_StateChangeCounts.emplace_back(static_cast<double>(statistics.RetrieveStateChangeCount()));
+		m_PipelineBindCounts.emplace_back(static_cast<double>(statistics.m_PipelineBindCount));
+		m_DescriptorSetBindCounts.emplace_back(static_cast<double>(statistics.m_DescriptorSetBindCount));
+		m_BarrierCounts.emplace_back(static_cast<double>(statistics.m_BarrierCount));
+		rhi_Context->m_SubmittedStatistics = Null_CommandStatistics();
+		#endif
+	}
+
+	bool Benchmark::WriteReport(const float sceneGenerationTimeInMilliseconds, const MemorySnapshot& memoryBefore, const MemorySnapshot& memoryAfter) const
+	{
+		std::ofstream file(m_Settings.m_OutputFilePath, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			AMETHYST_ERROR("Failed to open \"%s\" for writing.", m_Settings.m_OutputFilePath.c_str());
+			return false;
+		}
+
+		const auto Escape = [](const std::string& text)
+		{
+			std::string escaped;
+			for (const char character : text)
+			{
+				if (character == '"' || character == '\\')
+				{
+					escaped += '\\';
+				}
+
+				escaped += character;
+			}
+
+			return escaped;
+		};
+
+		const auto WriteStatistics = [&file](const BenchmarkStatistics& statistics)
+		{
+			file << "{\"min\":" << statistics.m_Minimum << ",\"avg\":" << statistics.m_Average << ",\"p50\":" << statistics.m_Median
+				 << ",\"p90\":" << statistics.m_Percentile90 << ",\"p99\":" << statistics.m_Percentile99 << ",\"max\":" << statistics.m_Maximum << "}";
+		};
+
+		const auto WriteUsage = [&file](const MemoryUsage& usage)
+		{
+			file << "{\"objects\":" << usage.m_ObjectCount << ",\"cpu_bytes\":" << usage.m_CPU << ",\"gpu_bytes\":" << usage.m_GPU << "}";
+		};
+
+		file << std::fixed << std::setprecision(4);
+		file << "{\n";
+
+		// Settings
+		file << "\"settings\":{\"entities\":" << m_Settings.m_EntityCount << ",\"hierarchy_depth\":" << m_Settings.m_HierarchyDepth
+			 << ",\"renderable_ratio\":" << m_Settings.m_RenderableRatio << ",\"animated_ratio\":" << m_Settings.m_AnimatedRatio << ",\"seed\":" << m_Settings.m_Seed
+			 << ",\"warmup_frames\":" << m_Settings.m_WarmupFrameCount << ",\"frames\":" << m_Settings.m_FrameCount << "},\n";
+
+		file << "\"scene\":{\"generation_ms\":" << sceneGenerationTimeInMilliseconds << ",\"renderables\":" << m_RenderableEntities.size() << ",\"animated\":" << m_AnimatedEntities.size()
+			 << ",\"rendered\":" << (m_Renderer ? "true" : "false") << "},\n";
+
+		// Frames (milliseconds)
+		file << "\"frame_ms\":";
+		WriteStatistics(BenchmarkStatistics::FromSamples(m_FrameTimes));
+		file << ",\n";
+
+		// Scopes (milliseconds per frame), named by their path in the call tree.
+		const std::vector<ProfilerNode>& nodes = m_Profiler->RetrieveNodes();
+		file << "\"scopes\":[";
+		bool isFirstScope = true;
+		for (size_t i = 0; i < m_ScopeTimes.size(); i++)
+		{
+			if (m_ScopeTimes[i].empty())
+			{
+				continue;
+			}
+
+			std::string path = nodes[i].m_Name;
+			for (uint32_t parent = nodes[i].m_Parent; parent < nodes.size(); parent = nodes[parent].m_Parent)
+			{
+				path = nodes[parent].m_Name + "/" + path;
+			}
+
+			file << (isFirstScope ? "\n" : ",\n") << "{\"name\":\"" << Escape(path) << "\",\"depth\":" << nodes[i].m_Depth << ",\"frames\":" << m_ScopeTimes[i].size()
+				 << ",\"calls\":" << BenchmarkStatistics::FromSamples(m_ScopeCalls[i]).m_Average << ",\"ms\":";
+			WriteStatistics(BenchmarkStatistics::FromSamples(m_ScopeTimes[i]));
+			file << "}";
+			isFirstScope = false;
+		}
+		file << "\n],\n";
+		file << "\"dropped_blocks\":" << m_Profiler->RetrieveDroppedBlockCount() << ",\n";
+
+		// Submissions (per frame), only recorded by the null backend.
+		if (!m_DrawCounts.empty())
+		{
+			file << "\"submissions\":{\"draws\":";
+			WriteStatistics(BenchmarkStatistics::FromSamples(m_DrawCounts));
+			file << ",\"instances\":";
+			WriteStatistics(BenchmarkStatistics::FromSamples(m_InstanceCounts));
+			file << ",\"state_changes\":";
+			WriteStatistics(BenchmarkStatistics::FromSamples(m_StateChangeCounts));
+			file << ",\"pipeline_binds\":";
+			WriteStatistics(BenchmarkStatistics::FromSamples(m_PipelineBindCounts));
+			file << ",\"descriptor_set_binds\":";
+			WriteStatistics(BenchmarkStatistics::FromSamples(m_DescriptorSetBindCounts));
+			file << ",\"barriers\":";
+			WriteStatistics(BenchmarkStatistics::FromSamples(m_BarrierCounts));
+			file << ",\"warmup_validation_errors\":" << m_ValidationErrorCount << "},\n";
+		}
+
+		// Memory
+		file << "\"memory\":{\"before\":{";
+		for (size_t i = 0; i < memoryBefore.m_Categories.size(); i++)
+		{
+			file << (i == 0 ? "" : ",") << "\"" << MemoryCategoryToString(static_cast<MemoryCategory>(i)) << "\":";
+			WriteUsage(memoryBefore.m_Categories[i]);
+		}
+		file << "},\"after\":{";
+		for (size_t i = 0; i < memoryAfter.m_Categories.size(); i++)
+		{
+			file << (i == 0 ? "" : ",") << "\"" << MemoryCategoryToString(static_cast<MemoryCategory>(i)) << "\":";
+			WriteUsage(memoryAfter.m_Categories[i]);
+		}
+		file << "},\"deltas\":[";
+		const std::vector<MemoryDelta> deltas = MemoryTracker::Diff(memoryBefore, memoryAfter);
+		for (size_t i = 0; i < deltas.size(); i++)
+		{
+			file << (i == 0 ? "" : ",") << "{\"name\":\"" << Escape(deltas[i].m_Name) << "\",\"cpu_bytes\":" << deltas[i].m_CPU << ",\"gpu_bytes\":" << deltas[i].m_GPU << "}";
+		}
+		file << "]}\n";
+
+		file << "}";
+		file.close();
+
+		AMETHYST_INFO("Benchmark report has been written to \"%s\".", m_Settings.m_OutputFilePath.c_str());
+		return true;
+	}
+}
\ No newline at end of file
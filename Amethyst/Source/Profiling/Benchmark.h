@@ -0,0 +1,103 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Runtime/Math/Vector3.h"
+
+namespace Amethyst
+{
+	class Engine;
+	class Entity;
+	class Model;
+	class Renderer;
+	class Profiler;
+	class MemoryTracker;
+	struct MemorySnapshot;
+
+	/*
+		Command Line: -benchmark [-benchmark_entities N] [-benchmark_depth N] [-benchmark_renderables R] [-benchmark_animated R]
+								 [-benchmark_warmup N] [-benchmark_frames N] [-benchmark_seed N] [-benchmark_file path]
+	*/
+	struct BenchmarkSettings
+	{
+		static BenchmarkSettings FromCommandLine();
+
+		// Scene
+		uint32_t m_EntityCount = 4096;
+		uint32_t m_HierarchyDepth = 4;	   // Length of each parent/child chain. 1 means every entity is a root.
+		float m_RenderableRatio = 0.75f;   // Fraction of entities that carry a Renderable.
+		float m_AnimatedRatio = 0.1f;	   // Fraction of roots moved every frame, which dirties their entire chain.
+		uint32_t m_Seed = 1337;
+
+		// Run
+		uint32_t m_WarmupFrameCount = 30;  // Ticked but not measured.
+		uint32_t m_FrameCount = 600;
+		std::string m_OutputFilePath = "Amethyst_Benchmark.json";
+	};
+
+	struct BenchmarkStatistics
+	{
+		static BenchmarkStatistics FromSamples(std::vector<double> samples); // Sorted by copy.
+
+		double m_Minimum = 0.0;
+		double m_Average = 0.0;
+		double m_Median = 0.0;
+		double m_Percentile90 = 0.0;
+		double m_Percentile99 = 0.0;
+		double m_Maximum = 0.0;
+	};
+
+	/*
+		Boots the engine headless (no window), fills the world with a synthetic scene and ticks it for a fixed number of frames.
+		Frame times and every profiler scope are reduced to percentiles and written out as JSON, alongside the memory snapshots from before and after the run.
+		The scene is generated from a seed so that two runs with the same settings are directly comparable.
+
+		Built with the null backend (the Debug_Null and Release_Null configurations), the renderer stays and every frame is recorded in full. Renderables
+		then share a cube and are looked at by a camera, and the draws and state changes each frame submitted are reported next to its timings.
+		Otherwise there is no renderer, and renderables only carry their bounds.
+	*/
+	class Benchmark
+	{
+	public:
+		Benchmark(const BenchmarkSettings& settings);
+		~Benchmark();
+
+		bool Run();
+
+	private:
+		void GenerateScene();
+		void AnimateScene(const float timeInSeconds);
+		void GatherBounds();
+		void RecordScopes();
+		void RecordSubmissions();
+		bool WriteReport(const float sceneGenerationTimeInMilliseconds, const MemorySnapshot& memoryBefore, const MemorySnapshot& memoryAfter) const;
+
+	private:
+		BenchmarkSettings m_Settings;
+		std::unique_ptr<Engine> m_Engine;
+		Profiler* m_Profiler = nullptr;
+		MemoryTracker* m_MemoryTracker = nullptr;
+		Renderer* m_Renderer = nullptr; // Only with the null backend.
+
+		// Scene
+		std::vector<std::shared_ptr<Entity>> m_AnimatedEntities;
+		std::vector<Math::Vector3> m_AnimatedEntityPositions;
+		std::vector<std::shared_ptr<Entity>> m_RenderableEntities;
+		std::shared_ptr<Entity> m_CameraEntity;
+		std::shared_ptr<Model> m_Model; // Shared by every renderable, so that they can be instanced.
+
+		// Samples
+		std::vector<double> m_FrameTimes;
+		std::vector<std::vector<double>> m_ScopeTimes; // Indexed by profiler node.
+		std::vector<std::vector<double>> m_ScopeCalls;
+
+		// Submissions (null backend), per frame.
+		std::vector<double> m_DrawCounts;
+		std::vector<double> m_InstanceCounts;
+		std::vector<double> m_StateChangeCounts;
+		std::vector<double> m_PipelineBindCounts;
+		std::vector<double> m_DescriptorSetBindCounts;
+		std::vector<double> m_BarrierCounts;
+		uint64_t m_ValidationErrorCount = 0; // Over the warmup, which is the only part run with validation.
+	};
+}
\ No newline at end of file
@@ -0,0 +1,839 @@
+#include "Amethyst.h"
+#include "MathBenchmark.h"
+#include "../Runtime/Math/Frustum.h"
+#include "../Runtime/Math/MathWide.h"
+#include "../Runtime/Math/Ray.h"
+#include "../Runtime/Math/Plane.h"
+#include "../RHI/RHI_Vertex.h"
+#include "../Rendering/OcclusionCuller.h"
+#include <algorithm>
+#include <iomanip>
+#include <random>
+
+namespace Amethyst
+{
+	using Math::Vector3;
+	using Math::Quaternion;
+	using Math::Matrix;
+	using Math::BoundingBox;
+	using Math::Frustum;
+	namespace SIMD = Math::SIMD;
+
+	// Results are folded into this after every measurement so that the optimizer can't discard the work being timed.
+	static volatile float g_MathBenchmarkSink = 0.0f;
+
+	static constexpr float g_HalfPI = Math::Utilities::PI * 0.5f;
+	static constexpr float g_QuarterPI = Math::Utilities::PI * 0.25f;
+
+	template<typename Function>
+	static double MeasureNanosecondsPerOperation(const uint32_t repetitionCount, const uint32_t operationCount, Function&& function)
+	{
+		double bestInNanoseconds = std::numeric_limits<double>::max();
+
+		for (uint32_t i = 0; i < repetitionCount; i++)
+		{
+			const int64_t start = TimeBlock::RetrieveTimestamp();
+			function();
+			const int64_t end = TimeBlock::RetrieveTimestamp();
+
+			bestInNanoseconds = Math::Utilities::Min(bestInNanoseconds, static_cast<double>(end - start));
+		}
+
+		return bestInNanoseconds / static_cast<double>(operationCount);
+	}
+
+	MathBenchmark::MathBenchmark(const uint32_t batchSize /*= 4096*/, const uint32_t repetitionCount /*= 16*/)
+	{
+		// Anything shorter than a register would only ever time the kernels' remainder loops.
+		const SIMD::InstructionSet instructionSet = SIMD::RetrieveKernels().m_InstructionSet;
+		const uint32_t laneCount = SIMD::InstructionSetToLaneCount(instructionSet);
+		if (batchSize < laneCount)
+		{
+			AMETHYST_WARNING("A batch size of %d is narrower than %s (%d lanes). %d will be used instead.", batchSize, SIMD::InstructionSetToString(instructionSet), laneCount, laneCount);
+		}
+
+		if (repetitionCount == 0)
+		{
+			AMETHYST_WARNING("At least one repetition is needed. 1 will be used instead.");
+		}
+
+		m_BatchSize = Math::Utilities::Max(batchSize, laneCount);
+		m_RepetitionCount = Math::Utilities::Max(repetitionCount, 1u);
+	}
+
+	bool MathBenchmark::RunFromCommandLine()
+	{
+		const uint32_t batchSize = Engine::RetrieveCommandLineArgumentAsInteger("-benchmark_batch", 4096);
+		const uint32_t repetitionCount = Engine::RetrieveCommandLineArgumentAsInteger("-benchmark_repetitions", 16);
+		const std::string filePath = Engine::RetrieveCommandLineArgumentValue("-benchmark_file");
+		const std::string instructionSet = Engine::RetrieveCommandLineArgumentValue("-benchmark_instruction_set");
+
+		// Single operations are always inlined at the baseline, so this only affects batches.
+		if (!instructionSet.empty())
+		{
+			bool isFound = false;
+			for (uint8_t i = 0; i < static_cast<uint8_t>(SIMD::InstructionSet::Count); i++)
+			{
+				if (instructionSet == SIMD::InstructionSetToString(static_cast<SIMD::InstructionSet>(i)))
+				{
+					isFound = SIMD::SetInstructionSet(static_cast<SIMD::InstructionSet>(i));
+				}
+			}
+
+			if (!isFound)
+			{
+				AMETHYST_ERROR("Instruction set \"%s\" is unknown or unsupported.", instructionSet.c_str());
+				return false;
+			}
+		}
+
+		MathBenchmark benchmark(batchSize, repetitionCount); // Validated by the constructor, once the instruction set is known.
+		return benchmark.Run(filePath.empty() ? "Amethyst_MathBenchmark.json" : filePath);
+	}
+
+	bool MathBenchmark::Run(const std::string& outputFilePath)
+	{
+		const bool isPassed = RunGoldenChecks();
+		if (!isPassed)
+		{
+			AMETHYST_ERROR("Golden checks failed, timings are not representative.");
+		}
+
+		RunBenchmarks();
+		WriteReport(outputFilePath);
+
+		return isPassed;
+	}
+
+	bool MathBenchmark::RunGoldenChecks()
+	{
+		m_GoldenResults.clear();
+
+		// Matrix * Matrix - Integer inputs, so the result is exact.
+		{
+			const Matrix a(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+			const Matrix b(2, 0, 1, 0, 0, 1, 0, 3, 1, 0, 2, 0, 4, 1, 0, 1);
+			const Matrix expected(21, 6, 7, 10, 49, 14, 19, 26, 77, 22, 31, 42, 105, 30, 43, 58);
+			CheckGolden("Matrix * Matrix", (a * b).Data(), expected.Data(), 16, 0.0f);
+		}
+
+		// Matrix::Invert - Determinant is 418.
+		{
+			const Matrix matrix(4, 7, 2, 3, 0, 5, 1, 2, 3, 1, 6, 4, 2, 2, 1, 5);
+			const Matrix expected(
+				111.0f / 418.0f, -155.0f / 418.0f, -12.0f / 418.0f,   5.0f / 418.0f,
+				 25.0f / 418.0f,   63.0f / 418.0f, -14.0f / 418.0f, -29.0f / 418.0f,
+				-27.0f / 418.0f,   49.0f / 418.0f,  82.0f / 418.0f, -69.0f / 418.0f,
+				-49.0f / 418.0f,   27.0f / 418.0f,  -6.0f / 418.0f, 107.0f / 418.0f
+			);
+			CheckGolden("Matrix::Invert", matrix.Inverted().Data(), expected.Data(), 16, 1e-6f);
+		}
+
+		// Matrix::Decompose - Rotation is 0.7 radians around (1, 2, 3).
+		{
+			const Quaternion rotation = Quaternion::FromAngleAxis(0.7f, Vector3(1.0f, 2.0f, 3.0f).Normalized());
+			const Matrix matrix(Vector3(1.0f, -2.0f, 3.0f), rotation, Vector3(2.0f, 3.0f, 4.0f));
+
+			Vector3 scale;
+			Quaternion rotationDecomposed;
+			Vector3 translation;
+			matrix.Decompose(scale, rotationDecomposed, translation);
+
+			const float values[] = { scale.m_X, scale.m_Y, scale.m_Z, rotationDecomposed.x, rotationDecomposed.y, rotationDecomposed.z, rotationDecomposed.w, translation.m_X, translation.m_Y, translation.m_Z };
+			const float expected[] = { 2.0f, 3.0f, 4.0f, 0.0916432939f, 0.1832865877f, 0.2749298816f, 0.9393727128f, 1.0f, -2.0f, 3.0f };
+			CheckGolden("Matrix::Decompose", values, expected, 10, 1e-5f);
+		}
+
+		// Matrix * Vector3 - Same transform as above, applied to (1, 2, 3).
+		{
+			const Matrix matrix(Vector3(1.0f, -2.0f, 3.0f), Quaternion::FromAngleAxis(0.7f, Vector3(1.0f, 2.0f, 3.0f).Normalized()), Vector3(2.0f, 3.0f, 4.0f));
+			const Vector3 result = matrix * Vector3(1.0f, 2.0f, 3.0f);
+
+			const float values[] = { result.m_X, result.m_Y, result.m_Z };
+			const float expected[] = { 4.4025802206f, 3.2357052710f, 15.0420030791f };
+			CheckGolden("Matrix * Vector3", values, expected, 3, 1e-5f);
+		}
+
+		// Quaternion * Quaternion - Hamilton product.
+		{
+			const Quaternion result = Quaternion(0.1f, 0.2f, 0.3f, 0.9f) * Quaternion(-0.4f, 0.5f, 0.1f, 0.7f);
+
+			const float values[] = { result.x, result.y, result.z, result.w };
+			const float expected[] = { -0.42f, 0.46f, 0.43f, 0.54f };
+			CheckGolden("Quaternion * Quaternion", values, expected, 4, 1e-6f);
+		}
+
+		// Quaternion * Vector3 - A quarter turn around Z takes X to Y.
+		{
+			const Vector3 result = Quaternion::FromAngleAxis(g_HalfPI, Vector3(0.0f, 0.0f, 1.0f)) * Vector3(1.0f, 0.0f, 0.0f);
+
+			const float values[] = { result.m_X, result.m_Y, result.m_Z };
+			const float expected[] = { 0.0f, 1.0f, 0.0f };
+			CheckGolden("Quaternion * Vector3", values, expected, 3, 1e-6f);
+		}
+
+		// Frustum::IsVisible - Camera at (0, 0, -10) looking at the origin with a 90 degree field of view.
+		{
+			const Matrix view = Matrix::CreateLookAtMatrix(Vector3(0.0f, 0.0f, -10.0f), Vector3::Zero, Vector3::Up);
+			const Matrix projection = Matrix::CreatePerspectiveMatrix(g_HalfPI, 1.0f, 0.1f, 100.0f);
+			const Frustum frustum(view, projection, 100.0f);
+			const Vector3 extent = Vector3::One;
+
+			const float values[] =
+			{
+				frustum.IsVisible(Vector3::Zero, extent) ? 1.0f : 0.0f,					   // In front.
+				frustum.IsVisible(Vector3(0.0f, 0.0f, -50.0f), extent) ? 1.0f : 0.0f,  // Behind.
+				frustum.IsVisible(Vector3(1000.0f, 0.0f, 0.0f), extent) ? 1.0f : 0.0f, // Far off to the side.
+				frustum.IsVisible(Vector3(0.0f, 0.0f, 500.0f), extent) ? 1.0f : 0.0f,  // Past the far plane.
+				frustum.IsVisible(Vector3(10.5f, 0.0f, 0.0f), extent) ? 1.0f : 0.0f	   // Straddling the right plane.
+			};
+			const float expected[] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+			CheckGolden("Frustum::IsVisible", values, expected, 5, 0.0f);
+
+			// The same boxes as structure-of-arrays.
+			const float centersX[] = { 0.0f, 0.0f, 1000.0f, 0.0f, 10.5f };
+			const float centersY[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+			const float centersZ[] = { 0.0f, -50.0f, 0.0f, 500.0f, 0.0f };
+			const float extents[] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+			uint32_t visibilityMask = 0;
+			frustum.CullBoxes(centersX, centersY, centersZ, extents, extents, extents, &visibilityMask, 5);
+
+			float cullValues[5];
+			for (uint32_t i = 0; i < 5; i++)
+			{
+				cullValues[i] = (visibilityMask >> i) & 1 ? 1.0f : 0.0f;
+			}
+			CheckGolden("Frustum::CullBoxes", cullValues, expected, 5, 0.0f);
+
+			// Hierarchical - The box straddling the right plane (index 3) leaves only that plane for its children to test.
+			uint8_t planeMask = Frustum::PlaneMaskAll;
+			uint8_t planeHint = 0;
+			const Math::Intersection straddling = frustum.CheckBox(Vector3(10.5f, 0.0f, 0.0f), extent, planeMask, planeHint);
+			const float hierarchicalValues[] = { static_cast<float>(straddling), static_cast<float>(planeMask) };
+			const float hierarchicalExpected[] = { static_cast<float>(Math::Intersects), static_cast<float>(1 << 3) };
+			CheckGolden("Frustum::CheckBox", hierarchicalValues, hierarchicalExpected, 2, 0.0f);
+		}
+
+		// BoundingBox::Transform - Unit box scaled by (2, 3, 4), turned a quarter around Z and moved to (5, 6, 7).
+		{
+			const BoundingBox box(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+			const Matrix matrix(Vector3(5.0f, 6.0f, 7.0f), Quaternion::FromAngleAxis(g_HalfPI, Vector3(0.0f, 0.0f, 1.0f)), Vector3(2.0f, 3.0f, 4.0f));
+			const BoundingBox result = box.Transform(matrix);
+
+			const float values[] = { result.RetrieveMinimum().m_X, result.RetrieveMinimum().m_Y, result.RetrieveMinimum().m_Z, result.RetrieveMaximum().m_X, result.RetrieveMaximum().m_Y, result.RetrieveMaximum().m_Z };
+			const float expected[] = { 2.0f, 4.0f, 3.0f, 8.0f, 8.0f, 11.0f };
+			CheckGolden("BoundingBox::Transform", values, expected, 6, 1e-5f);
+		}
+
+		// BoundingBox::Merge
+		{
+			BoundingBox result(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f));
+			result.Merge(BoundingBox(Vector3(-1.0f, 2.0f, 0.5f), Vector3(0.5f, 3.0f, 4.0f)));
+
+			const float values[] = { result.RetrieveMinimum().m_X, result.RetrieveMinimum().m_Y, result.RetrieveMinimum().m_Z, result.RetrieveMaximum().m_X, result.RetrieveMaximum().m_Y, result.RetrieveMaximum().m_Z };
+			const float expected[] = { -1.0f, 0.0f, 0.0f, 1.0f, 3.0f, 4.0f };
+			CheckGolden("BoundingBox::Merge", values, expected, 6, 0.0f);
+		}
+
+		// Ray::HitDistance - Down the Z axis from (0, 0, -10), which meets the unit box at 9, and the XY plane and a triangle lying in it at 10.
+		// Misses are infinite, so they are checked as flags.
+		{
+			const Math::Ray ray(Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 10.0f));
+			const Math::Ray rayInside(Vector3(0.5f, 0.0f, 0.0f), Vector3(0.5f, 0.0f, 10.0f));
+			const BoundingBox box(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+			const BoundingBox boxAside(Vector3(4.0f, -1.0f, -1.0f), Vector3(6.0f, 1.0f, 1.0f));
+			const Vector3 vertices[] = { Vector3(-1.0f, -1.0f, 0.0f), Vector3(1.0f, -1.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f) };
+
+			Vector3 intersectionPoint, normal, bary;
+			const float planeDistance = ray.HitDistance(Math::Plane(Vector3(0.0f, 0.0f, 1.0f), 0.0f), &intersectionPoint);
+			const float triangleDistance = ray.HitDistance(vertices[0], vertices[1], vertices[2], &normal, &bary);
+			const float missedDistance = ray.HitDistance(vertices[0] + Vector3(3.0f, 0.0f, 0.0f), vertices[1] + Vector3(3.0f, 0.0f, 0.0f), vertices[2] + Vector3(3.0f, 0.0f, 0.0f));
+
+			const float values[] = { ray.HitDistance(box), rayInside.HitDistance(box), ray.HitDistance(boxAside) == Math::Utilities::Infinity ? 1.0f : 0.0f, planeDistance, intersectionPoint.m_Z, triangleDistance, normal.m_Z, bary.m_X, bary.m_Y, bary.m_Z, missedDistance == Math::Utilities::Infinity ? 1.0f : 0.0f };
+			const float expected[] = { 9.0f, 0.0f, 1.0f, 10.0f, 0.0f, 10.0f, 1.0f, 0.25f, 0.25f, 0.5f, 1.0f };
+			CheckGolden("Ray::HitDistance", values, expected, 11, 1e-6f);
+		}
+
+		// OcclusionCuller - A 10 x 10 wall across the origin, seen from (0, 0, -10). Boxes behind it are hidden, everything else isn't.
+		{
+			const Matrix view = Matrix::CreateLookAtMatrix(Vector3(0.0f, 0.0f, -10.0f), Vector3::Zero, Vector3::Up);
+			const Matrix projection = Matrix::CreatePerspectiveMatrix(g_HalfPI, 2.0f, 0.1f, 100.0f);
+			const float wallPositions[] = { -5.0f, -5.0f, 0.0f, 5.0f, -5.0f, 0.0f, 5.0f, 5.0f, 0.0f, -5.0f, 5.0f, 0.0f };
+			const uint32_t wallIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+			OcclusionCuller occlusionCuller;
+			occlusionCuller.Begin(view * projection);
+			occlusionCuller.AddOccluder(wallPositions, sizeof(float) * 3, wallIndices, 6, Matrix::Identity);
+			occlusionCuller.Rasterize();
+
+			const float values[] =
+			{
+				occlusionCuller.IsVisible(BoundingBox(Vector3(-1.0f, -1.0f, 5.0f), Vector3(1.0f, 1.0f, 6.0f))) ? 1.0f : 0.0f,	 // Behind.
+				occlusionCuller.IsVisible(BoundingBox(Vector3(-1.0f, -1.0f, -3.0f), Vector3(1.0f, 1.0f, -2.0f))) ? 1.0f : 0.0f,	 // In front.
+				occlusionCuller.IsVisible(BoundingBox(Vector3(11.0f, -1.0f, 5.0f), Vector3(13.0f, 1.0f, 6.0f))) ? 1.0f : 0.0f,	 // Behind, but past the wall's edge.
+				occlusionCuller.IsVisible(BoundingBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f))) ? 1.0f : 0.0f,	 // Through the wall.
+				occlusionCuller.IsVisible(BoundingBox(Vector3(-1.0f, -1.0f, -11.0f), Vector3(1.0f, 1.0f, -9.0f))) ? 1.0f : 0.0f	 // Around the camera.
+			};
+			const float expected[] = { 0.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+			CheckGolden("OcclusionCuller::IsVisible", values, expected, 5, 0.0f);
+		}
+
+		// Batch kernels - Every supported instruction set against the scalar reference. Translations are kept small so that inverse errors stay comparable.
+		{
+			constexpr uint32_t count = 255; // Odd, so that the wide kernels' remainder handling is covered too.
+
+			std::mt19937 generator(7);
+			std::uniform_real_distribution<float> positionDistribution(-10.0f, 10.0f);
+			std::uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+			std::uniform_real_distribution<float> angleDistribution(-Math::Utilities::PI, Math::Utilities::PI);
+
+			std::vector<Vector3> translations(count), scales(count), points(count);
+			std::vector<Quaternion> rotations(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				translations[i] = Vector3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+				scales[i] = Vector3(scaleDistribution(generator), scaleDistribution(generator), scaleDistribution(generator));
+				points[i] = Vector3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+				rotations[i] = Quaternion::FromYawPitchRoll(angleDistribution(generator), angleDistribution(generator), angleDistribution(generator));
+			}
+
+			const SIMD::Kernels* referenceKernels = SIMD::RetrieveKernels(SIMD::InstructionSet::Scalar);
+			std::vector<Matrix> matrices(count), matricesReversed(count), expectedMatrices(count), resultMatrices(count);
+			std::vector<Vector3> expectedPoints(count), resultPoints(count);
+			referenceKernels->m_MatrixComposeBatch(&translations[0].m_X, &rotations[0].x, &scales[0].m_X, &matrices[0].m00, count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matricesReversed[i] = matrices[count - 1 - i];
+			}
+
+			// Culling - Positions double as box centers and scales as extents (and sphere radii), against a frustum that catches roughly half of them.
+			// Every bit of the masks is compared, including the cleared ones past the end.
+			const Frustum frustum(Matrix::CreateLookAtMatrix(Vector3(0.0f, 0.0f, -12.0f), Vector3(4.0f, 0.0f, 0.0f), Vector3::Up), Matrix::CreatePerspectiveMatrix(g_QuarterPI, 1.0f, 0.1f, 100.0f), 100.0f);
+			const float* frustumPlanes = &frustum.RetrievePlanes()[0].m_Normal.m_X;
+
+			std::vector<float> centersX(count), centersY(count), centersZ(count), extentsX(count), extentsY(count), extentsZ(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				centersX[i] = points[i].m_X;
+				centersY[i] = points[i].m_Y;
+				centersZ[i] = points[i].m_Z;
+				extentsX[i] = scales[i].m_X;
+				extentsY[i] = scales[i].m_Y;
+				extentsZ[i] = scales[i].m_Z;
+			}
+
+			const uint32_t maskBitCount = ((count + 31) / 32) * 32;
+			std::vector<uint32_t> expectedMasks(maskBitCount / 32), resultMasks(maskBitCount / 32);
+			const auto UnpackMasks = [maskBitCount](const std::vector<uint32_t>& masks)
+			{
+				std::vector<float> bits(maskBitCount);
+				for (uint32_t i = 0; i < maskBitCount; i++)
+				{
+					bits[i] = (masks[i / 32] >> (i % 32)) & 1 ? 1.0f : 0.0f;
+				}
+				return bits;
+			};
+
+			// Wide types - Eight lanes at a time against the scalar types, with the last group only partially filled.
+			{
+				std::vector<Matrix> expectedWideMatrices(count), resultWideMatrices(count);
+				std::vector<Quaternion> rotationsReversed(count), expectedQuaternions(count), resultQuaternions(count);
+				std::vector<Vector3> expectedVectors(count * 3), resultVectors(count * 3);
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					expectedWideMatrices[i] = Matrix(translations[i], rotations[i], scales[i]) * matricesReversed[i];
+					rotationsReversed[i] = rotations[count - 1 - i];
+					expectedQuaternions[i] = rotations[i] * rotationsReversed[i];
+					expectedVectors[i] = matrices[i] * points[i];
+					expectedVectors[count + i] = rotations[i] * points[i];
+					expectedVectors[count * 2 + i] = points[i].Normalized();
+				}
+
+				for (uint32_t i = 0; i < count; i += Math::Float8::Width)
+				{
+					const uint32_t laneCount = Math::Utilities::Min(Math::Float8::Width, count - i);
+					const Math::Vector3x8 point = Math::Vector3x8::Load(&points[i], laneCount);
+					const Math::Quaternionx8 rotation = Math::Quaternionx8::Load(&rotations[i], laneCount);
+					const Math::Matrix4x8 composed(Math::Vector3x8::Load(&translations[i], laneCount), rotation, Math::Vector3x8::Load(&scales[i], laneCount));
+
+					(composed * Math::Matrix4x8::Load(&matricesReversed[i], laneCount)).Store(&resultWideMatrices[i], laneCount);
+					(rotation * Math::Quaternionx8::Load(&rotationsReversed[i], laneCount)).Store(&resultQuaternions[i], laneCount);
+					Math::Matrix4x8::Load(&matrices[i], laneCount).TransformPoint(point).Store(&resultVectors[i], laneCount);
+					(rotation * point).Store(&resultVectors[count + i], laneCount);
+					point.Normalized().Store(&resultVectors[count * 2 + i], laneCount);
+				}
+
+				CheckGolden("Matrix4x8 * Matrix4x8", resultWideMatrices[0].Data(), expectedWideMatrices[0].Data(), count * 16, 0.0f);
+				CheckGolden("Quaternionx8 * Quaternionx8", &resultQuaternions[0].x, &expectedQuaternions[0].x, count * 4, 0.0f);
+				CheckGolden("Matrix4x8::TransformPoint", &resultVectors[0].m_X, &expectedVectors[0].m_X, count * 3, 0.0f);
+				CheckGolden("Quaternionx8 * Vector3x8", &resultVectors[count].m_X, &expectedVectors[count].m_X, count * 3, 0.0f);
+				CheckGolden("Vector3x8::Normalized", &resultVectors[count * 2].m_X, &expectedVectors[count * 2].m_X, count * 3, 0.0f);
+			}
+
+			// Rays - Against boxes and triangles scattered around the origin, one ray per box, triangle stream and packet. Misses are stored
+			// as -1 so that they compare.
+			{
+				const auto Finite = [](const float distance) { return distance == Math::Utilities::Infinity ? -1.0f : distance; };
+				const uint32_t triangleCount = count / 3;
+
+				std::vector<BoundingBox> boxes(count);
+				std::vector<Math::Ray> rays(count);
+				std::vector<RHI_Vertex_PositionTextureNormalTangent> vertices(count);
+				std::vector<uint32_t> indices(triangleCount * 3);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					boxes[i] = BoundingBox(points[i] * 0.25f - scales[i], points[i] * 0.25f + scales[i]);
+					vertices[i] = RHI_Vertex_PositionTextureNormalTangent(points[i] * 0.5f, Math::Vector2::Zero);
+				}
+
+				for (uint32_t i = 0; i < triangleCount * 3; i++)
+				{
+					indices[i] = (i * 7) % count;
+				}
+
+				const auto Position = [&](const uint32_t index) { const float* position = vertices[indices[index]].m_Position; return Vector3(position[0], position[1], position[2]); };
+
+				// A third of the rays aim at the first box, a third at the first triangle and the rest anywhere.
+				const Vector3 triangleCenter = (Position(0) + Position(1) + Position(2)) / 3.0f;
+				for (uint32_t i = 0; i < count; i++)
+				{
+					const Vector3 target = i % 3 == 0 ? points[0] * 0.25f : (i % 3 == 1 ? triangleCenter : points[count - 1 - i]);
+					rays[i] = Math::Ray(translations[i], translations[i] + (target - translations[i]) * 2.0f);
+				}
+
+				// One ray through every box, and every ray through one box and one triangle.
+				std::vector<float> expectedDistances(count * 3), resultDistances(count * 3);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					expectedDistances[i] = Finite(rays[0].HitDistance(boxes[i]));
+					expectedDistances[count + i] = Finite(rays[i].HitDistance(boxes[0]));
+					expectedDistances[count * 2 + i] = Finite(rays[i].HitDistance(Position(0), Position(1), Position(2)));
+				}
+
+				rays[0].HitDistances(boxes.data(), count, resultDistances.data());
+				for (uint32_t i = 0; i < count; i += Math::Float8::Width)
+				{
+					const uint32_t laneCount = Math::Utilities::Min(Math::Float8::Width, count - i);
+					const Math::RayPacket packet(&rays[i], laneCount);
+					Math::StoreLanes(packet.HitDistance(boxes[0]), &resultDistances[count + i], 1, laneCount);
+					Math::StoreLanes(packet.HitDistance(Position(0), Position(1), Position(2)), &resultDistances[count * 2 + i], 1, laneCount);
+				}
+
+				for (float& distance : resultDistances)
+				{
+					distance = Finite(distance);
+				}
+
+				// The closest triangle along each ray, through the mesh stream.
+				std::vector<float> expectedClosest(count * 2), resultClosest(count * 2);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					float closestDistance = Math::Utilities::Infinity;
+					uint32_t closestTriangle = 0;
+					for (uint32_t triangle = 0; triangle < triangleCount; triangle++)
+					{
+						const float distance = rays[i].HitDistance(Position(triangle * 3), Position(triangle * 3 + 1), Position(triangle * 3 + 2));
+						if (distance < closestDistance)
+						{
+							closestDistance = distance;
+							closestTriangle = triangle;
+						}
+					}
+
+					uint32_t triangleIndex = 0;
+					expectedClosest[i * 2] = Finite(closestDistance);
+					expectedClosest[i * 2 + 1] = static_cast<float>(closestTriangle);
+					resultClosest[i * 2] = Finite(rays[i].HitDistance(vertices.data(), indices.data(), triangleCount * 3, &triangleIndex));
+					resultClosest[i * 2 + 1] = static_cast<float>(triangleIndex);
+				}
+
+				CheckGolden("Ray::HitDistances", &resultDistances[0], &expectedDistances[0], count, 0.0f);
+				CheckGolden("RayPacket::HitDistance (Box)", &resultDistances[count], &expectedDistances[count], count, 0.0f);
+				CheckGolden("RayPacket::HitDistance (Triangle)", &resultDistances[count * 2], &expectedDistances[count * 2], count, 0.0f);
+				CheckGolden("Ray::HitDistance (Mesh)", resultClosest.data(), expectedClosest.data(), count * 2, 0.0f);
+			}
+
+			for (uint8_t i = static_cast<uint8_t>(SIMD::InstructionSet::Scalar) + 1; i < static_cast<uint8_t>(SIMD::InstructionSet::Count); i++)
+			{
+				const SIMD::Kernels* kernels = SIMD::RetrieveKernels(static_cast<SIMD::InstructionSet>(i));
+				if (!kernels)
+				{
+					continue;
+				}
+
+				const std::string prefix = std::string(SIMD::InstructionSetToString(kernels->m_InstructionSet)) + ": ";
+
+				referenceKernels->m_MatrixMultiplyBatch(&matrices[0].m00, &matricesReversed[0].m00, &expectedMatrices[0].m00, count);
+				kernels->m_MatrixMultiplyBatch(&matrices[0].m00, &matricesReversed[0].m00, &resultMatrices[0].m00, count);
+				CheckGolden(prefix + "Matrix::Multiply (Batch)", resultMatrices[0].Data(), expectedMatrices[0].Data(), count * 16, 0.0f);
+
+				referenceKernels->m_MatrixInvertBatch(&matrices[0].m00, &expectedMatrices[0].m00, count);
+				kernels->m_MatrixInvertBatch(&matrices[0].m00, &resultMatrices[0].m00, count);
+				CheckGolden(prefix + "Matrix::Invert (Batch)", resultMatrices[0].Data(), expectedMatrices[0].Data(), count * 16, 1e-5f);
+
+				kernels->m_MatrixComposeBatch(&translations[0].m_X, &rotations[0].x, &scales[0].m_X, &resultMatrices[0].m00, count);
+				CheckGolden(prefix + "Matrix::Compose (Batch)", resultMatrices[0].Data(), matrices[0].Data(), count * 16, 0.0f);
+
+				referenceKernels->m_MatrixTransformPointBatch(matrices[0].Data(), &points[0].m_X, &expectedPoints[0].m_X, count);
+				kernels->m_MatrixTransformPointBatch(matrices[0].Data(), &points[0].m_X, &resultPoints[0].m_X, count);
+				CheckGolden(prefix + "Matrix::TransformPoints (Batch)", &resultPoints[0].m_X, &expectedPoints[0].m_X, count * 3, 0.0f);
+
+				referenceKernels->m_FrustumCullBoxesBatch(frustumPlanes, centersX.data(), centersY.data(), centersZ.data(), extentsX.data(), extentsY.data(), extentsZ.data(), expectedMasks.data(), count);
+				kernels->m_FrustumCullBoxesBatch(frustumPlanes, centersX.data(), centersY.data(), centersZ.data(), extentsX.data(), extentsY.data(), extentsZ.data(), resultMasks.data(), count);
+				CheckGolden(prefix + "Frustum::CullBoxes (Batch)", UnpackMasks(resultMasks).data(), UnpackMasks(expectedMasks).data(), maskBitCount, 0.0f);
+
+				// Boxes - Minimum then maximum, six floats each, which is how the kernels read and write them.
+				std::vector<float> boxes(count * 6), expectedBoxes(count * 6), resultBoxes(count * 6);
+				for (uint32_t j = 0; j < count; j++)
+				{
+					const Vector3 minimum = points[j] - scales[j];
+					const Vector3 maximum = points[j] + scales[j];
+					const float box[] = { minimum.m_X, minimum.m_Y, minimum.m_Z, maximum.m_X, maximum.m_Y, maximum.m_Z };
+					std::copy(std::begin(box), std::end(box), boxes.begin() + j * 6);
+				}
+
+				referenceKernels->m_BoundingBoxTransformBatch(matrices[0].Data(), boxes.data(), expectedBoxes.data(), count);
+				kernels->m_BoundingBoxTransformBatch(matrices[0].Data(), boxes.data(), resultBoxes.data(), count);
+				CheckGolden(prefix + "BoundingBox::Transform (Batch)", resultBoxes.data(), expectedBoxes.data(), count * 6, 0.0f);
+
+				referenceKernels->m_BoundingBoxMergeBatch(boxes.data(), count, expectedBoxes.data());
+				kernels->m_BoundingBoxMergeBatch(boxes.data(), count, resultBoxes.data());
+				CheckGolden(prefix + "BoundingBox::Merge (Batch)", resultBoxes.data(), expectedBoxes.data(), 6, 0.0f);
+
+				referenceKernels->m_BoundingBoxFromPointsBatch(&points[0].m_X, sizeof(Vector3), count, expectedBoxes.data());
+				kernels->m_BoundingBoxFromPointsBatch(&points[0].m_X, sizeof(Vector3), count, resultBoxes.data());
+				CheckGolden(prefix + "BoundingBox (Points, Batch)", resultBoxes.data(), expectedBoxes.data(), 6, 0.0f);
+
+				referenceKernels->m_FrustumCullSpheresBatch(frustumPlanes, centersX.data(), centersY.data(), centersZ.data(), extentsX.data(), expectedMasks.data(), count);
+				kernels->m_FrustumCullSpheresBatch(frustumPlanes, centersX.data(), centersY.data(), centersZ.data(), extentsX.data(), resultMasks.data(), count);
+				CheckGolden(prefix + "Frustum::CullSpheres (Batch)", UnpackMasks(resultMasks).data(), UnpackMasks(expectedMasks).data(), maskBitCount, 0.0f);
+			}
+		}
+
+		bool isPassed = true;
+		for (const MathGoldenResult& result : m_GoldenResults)
+		{
+			if (!result.m_IsPassed)
+			{
+				AMETHYST_ERROR("Golden check \"%s\" failed with an error of %f (tolerance is %f).", result.m_Name.c_str(), result.m_ErrorMaximum, result.m_Tolerance);
+				isPassed = false;
+			}
+		}
+
+		return isPassed;
+	}
+
+	void MathBenchmark::RunBenchmarks()
+	{
+		m_BenchmarkResults.clear();
+
+		const uint32_t count = m_BatchSize;
+
+		// Inputs - Seeded so that every run times the exact same data.
+		std::mt19937 generator(1337);
+		std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+		std::uniform_real_distribution<float> angleDistribution(-Math::Utilities::PI, Math::Utilities::PI);
+
+		std::vector<Vector3> vectors(count);
+		std::vector<Quaternion> quaternionsA(count);
+		std::vector<Quaternion> quaternionsB(count);
+		std::vector<Matrix> matricesA(count);
+		std::vector<Matrix> matricesB(count);
+		std::vector<BoundingBox> boxesA(count);
+		std::vector<BoundingBox> boxesB(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			vectors[i] = Vector3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+			quaternionsA[i] = Quaternion::FromYawPitchRoll(angleDistribution(generator), angleDistribution(generator), angleDistribution(generator));
+			quaternionsB[i] = Quaternion::FromYawPitchRoll(angleDistribution(generator), angleDistribution(generator), angleDistribution(generator));
+			matricesA[i] = Matrix(vectors[i], quaternionsA[i], Vector3(scaleDistribution(generator), scaleDistribution(generator), scaleDistribution(generator)));
+			matricesB[i] = Matrix(-vectors[i], quaternionsB[i], Vector3(scaleDistribution(generator), scaleDistribution(generator), scaleDistribution(generator)));
+
+			const Vector3 extent = Vector3(scaleDistribution(generator), scaleDistribution(generator), scaleDistribution(generator));
+			boxesA[i] = BoundingBox(vectors[i] - extent, vectors[i] + extent);
+			boxesB[i] = BoundingBox(-vectors[i] - extent, -vectors[i] + extent);
+		}
+
+		const Frustum frustum(Matrix::CreateLookAtMatrix(Vector3(0.0f, 0.0f, -150.0f), Vector3::Zero, Vector3::Up), Matrix::CreatePerspectiveMatrix(g_QuarterPI, 16.0f / 9.0f, 0.1f, 1000.0f), 1000.0f);
+
+		// Latency chains feed each result back in through a quarter turn, which keeps values from drifting or growing over long chains.
+		const Quaternion quarterTurn = Quaternion::FromAngleAxis(g_HalfPI, Vector3::Up);
+		const Matrix quarterTurnMatrix = Matrix::CreateRotation(quarterTurn);
+
+		std::vector<Vector3> vectorsOut(count);
+		std::vector<Vector3> translationsOut(count);
+		std::vector<Quaternion> quaternionsOut(count);
+		std::vector<Matrix> matricesOut(count);
+		std::vector<BoundingBox> boxesOut(count);
+		std::vector<uint8_t> visibilityOut(count);
+
+		const auto Record = [this](const char* name, const double latency, const double throughput)
+		{
+			m_BenchmarkResults.push_back({ name, latency, throughput });
+			AMETHYST_INFO("%s: %.2f ns latency, %.2f ns throughput.", name, latency, throughput);
+		};
+
+		// Matrix * Matrix
+		{
+			Matrix value = matricesA[0];
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { value = value * quarterTurnMatrix; } });
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { matricesOut[i] = matricesA[i] * matricesB[i]; } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.m00 + matricesOut[count - 1].m00;
+			Record("Matrix * Matrix", latency, throughput);
+		}
+
+		// Matrix::Invert
+		{
+			Matrix value = matricesA[0];
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { value = Matrix::Invert(value); } });
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { matricesOut[i] = Matrix::Invert(matricesA[i]); } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.m00 + matricesOut[count - 1].m00;
+			Record("Matrix::Invert", latency, throughput);
+		}
+
+		// Matrix::Decompose - The latency chain recomposes the matrix, so it includes one TRS construction per operation.
+		{
+			Matrix value = matricesA[0];
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]()
+			{
+				Vector3 scale, translation;
+				Quaternion rotation;
+				for (uint32_t i = 0; i < count; i++)
+				{
+					value.Decompose(scale, rotation, translation);
+					value = Matrix(translation, rotation, scale);
+				}
+			});
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]()
+			{
+				for (uint32_t i = 0; i < count; i++)
+				{
+					matricesA[i].Decompose(vectorsOut[i], quaternionsOut[i], translationsOut[i]);
+				}
+			});
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.m00 + vectorsOut[count - 1].m_X + quaternionsOut[count - 1].w + translationsOut[count - 1].m_X;
+			Record("Matrix::Decompose", latency, throughput);
+		}
+
+		// Matrix * Vector3
+		{
+			Vector3 value = vectors[0];
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { value = quarterTurnMatrix * value; } });
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { vectorsOut[i] = matricesA[i] * vectors[i]; } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.m_X + vectorsOut[count - 1].m_X;
+			Record("Matrix * Vector3", latency, throughput);
+		}
+
+		// Quaternion * Quaternion
+		{
+			Quaternion value = quaternionsA[0];
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { value = value * quarterTurn; } });
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { quaternionsOut[i] = quaternionsA[i] * quaternionsB[i]; } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.w + quaternionsOut[count - 1].w;
+			Record("Quaternion * Quaternion", latency, throughput);
+		}
+
+		// Quaternion * Vector3
+		{
+			Vector3 value = vectors[0];
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { value = quarterTurn * value; } });
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { vectorsOut[i] = quaternionsA[i] * vectors[i]; } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.m_X + vectorsOut[count - 1].m_X;
+			Record("Quaternion * Vector3", latency, throughput);
+		}
+
+		// Frustum::IsVisible - The latency chain mirrors the center whenever a box is culled, so each test depends on the previous outcome.
+		{
+			Vector3 center = vectors[0];
+			const Vector3 extent = boxesA[0].RetrieveExtents();
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]()
+			{
+				for (uint32_t i = 0; i < count; i++)
+				{
+					center.m_X = frustum.IsVisible(center, extent) ? center.m_X : -center.m_X;
+				}
+			});
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]()
+			{
+				for (uint32_t i = 0; i < count; i++)
+				{
+					visibilityOut[i] = frustum.IsVisible(boxesA[i].RetrieveCenter(), boxesA[i].RetrieveExtents()) ? 1 : 0;
+				}
+			});
+			g_MathBenchmarkSink = g_MathBenchmarkSink + center.m_X + static_cast<float>(visibilityOut[count - 1]);
+			Record("Frustum::IsVisible", latency, throughput);
+		}
+
+		// BoundingBox::Transform
+		{
+			BoundingBox value = boxesA[0];
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { value = value.Transform(quarterTurnMatrix); } });
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { boxesOut[i] = boxesA[i].Transform(matricesA[i]); } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.RetrieveMinimum().m_X + boxesOut[count - 1].RetrieveMinimum().m_X;
+			Record("BoundingBox::Transform", latency, throughput);
+		}
+
+		// BoundingBox::Merge - Merging a whole batch into one box is a dependency chain by nature.
+		{
+			BoundingBox value;
+			const double latency = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { value.Merge(boxesA[i]); } });
+			const double throughput = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { boxesOut[i] = boxesA[i]; boxesOut[i].Merge(boxesB[i]); } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + value.RetrieveMaximum().m_X + boxesOut[count - 1].RetrieveMaximum().m_X;
+			Record("BoundingBox::Merge", latency, throughput);
+		}
+
+		// Batches - Throughput only, through whichever kernels are active.
+		{
+			std::vector<Vector3> scales(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				scales[i] = boxesA[i].RetrieveExtents();
+			}
+
+			const double multiply = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { Matrix::Multiply(matricesA.data(), matricesB.data(), matricesOut.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + matricesOut[count - 1].m00;
+			Record("Matrix::Multiply (Batch)", 0.0, multiply);
+
+			const double invert = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { Matrix::Invert(matricesA.data(), matricesOut.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + matricesOut[count - 1].m00;
+			Record("Matrix::Invert (Batch)", 0.0, invert);
+
+			const double compose = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { Matrix::Compose(vectors.data(), quaternionsA.data(), scales.data(), matricesOut.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + matricesOut[count - 1].m00;
+			Record("Matrix::Compose (Batch)", 0.0, compose);
+
+			const double transform = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { matricesA[0].TransformPoints(vectors.data(), vectorsOut.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + vectorsOut[count - 1].m_X;
+			Record("Matrix::TransformPoints (Batch)", 0.0, transform);
+
+			std::vector<float> centersX(count), centersY(count), centersZ(count), extentsX(count), extentsY(count), extentsZ(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				centersX[i] = vectors[i].m_X;
+				centersY[i] = vectors[i].m_Y;
+				centersZ[i] = vectors[i].m_Z;
+				extentsX[i] = scales[i].m_X;
+				extentsY[i] = scales[i].m_Y;
+				extentsZ[i] = scales[i].m_Z;
+			}
+
+			const double transformBoxes = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { BoundingBox::Transform(boxesA.data(), matricesA.data(), boxesOut.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + boxesOut[count - 1].RetrieveMinimum().m_X;
+			Record("BoundingBox::Transform (Batch)", 0.0, transformBoxes);
+
+			BoundingBox merged;
+			const double mergeBoxes = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { merged = BoundingBox::Merge(boxesA.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + merged.RetrieveMaximum().m_X;
+			Record("BoundingBox::Merge (Batch)", 0.0, mergeBoxes);
+
+			// Wide types - Packed up front, as data kept in structure-of-arrays form would be, and timed per element.
+			const uint32_t groupCount = (count + Math::Float8::Width - 1) / Math::Float8::Width;
+			std::vector<Math::Matrix4x8> wideMatricesA(groupCount), wideMatricesB(groupCount), wideMatricesOut(groupCount);
+			std::vector<Math::Quaternionx8> wideQuaternions(groupCount);
+			std::vector<Math::Vector3x8> wideVectors(groupCount), wideVectorsOut(groupCount);
+			for (uint32_t i = 0; i < groupCount; i++)
+			{
+				const uint32_t first = i * Math::Float8::Width;
+				const uint32_t laneCount = Math::Utilities::Min(Math::Float8::Width, count - first);
+				wideMatricesA[i] = Math::Matrix4x8::Load(&matricesA[first], laneCount);
+				wideMatricesB[i] = Math::Matrix4x8::Load(&matricesB[first], laneCount);
+				wideQuaternions[i] = Math::Quaternionx8::Load(&quaternionsA[first], laneCount);
+				wideVectors[i] = Math::Vector3x8::Load(&vectors[first], laneCount);
+			}
+
+			const double wideMultiply = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < groupCount; i++) { wideMatricesOut[i] = wideMatricesA[i] * wideMatricesB[i]; } });
+			Record("Matrix4x8 * Matrix4x8", 0.0, wideMultiply);
+
+			const double wideRotate = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < groupCount; i++) { wideVectorsOut[i] = wideQuaternions[i] * wideVectors[i]; } });
+			Record("Quaternionx8 * Vector3x8", 0.0, wideRotate);
+
+			float wideSink[Math::Float8::Width];
+			(wideMatricesOut[groupCount - 1].m_Elements[0] + wideVectorsOut[groupCount - 1].m_X).Store(wideSink);
+			g_MathBenchmarkSink = g_MathBenchmarkSink + wideSink[0];
+
+			std::vector<uint32_t> visibilityMasks((count + 31) / 32);
+			const double cullBoxes = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { frustum.CullBoxes(centersX.data(), centersY.data(), centersZ.data(), extentsX.data(), extentsY.data(), extentsZ.data(), visibilityMasks.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + static_cast<float>(visibilityMasks[0]);
+			Record("Frustum::CullBoxes (Batch)", 0.0, cullBoxes);
+
+			const double cullSpheres = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { frustum.CullSpheres(centersX.data(), centersY.data(), centersZ.data(), extentsX.data(), visibilityMasks.data(), count); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + static_cast<float>(visibilityMasks[0]);
+			Record("Frustum::CullSpheres (Batch)", 0.0, cullSpheres);
+
+			const Math::Ray ray(vectors[0], vectors[1]);
+			std::vector<float> distances(count);
+			const double rayBoxes = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { ray.HitDistances(boxesA.data(), count, distances.data()); });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + distances[count - 1];
+			Record("Ray::HitDistances (Batch)", 0.0, rayBoxes);
+
+			// A 100 x 100 wall across the origin hides much of the box field from the frustum's camera.
+			const float wallPositions[] = { -50.0f, -50.0f, 0.0f, 50.0f, -50.0f, 0.0f, 50.0f, 50.0f, 0.0f, -50.0f, 50.0f, 0.0f };
+			const uint32_t wallIndices[] = { 0, 1, 2, 0, 2, 3 };
+			OcclusionCuller occlusionCuller;
+			const Matrix viewProjection = Matrix::CreateLookAtMatrix(Vector3(0.0f, 0.0f, -150.0f), Vector3::Zero, Vector3::Up) * Matrix::CreatePerspectiveMatrix(g_QuarterPI, 16.0f / 9.0f, 0.1f, 1000.0f);
+			const double occlusionRasterize = MeasureNanosecondsPerOperation(m_RepetitionCount, 1, [&]()
+			{
+				occlusionCuller.Begin(viewProjection);
+				occlusionCuller.AddOccluder(wallPositions, sizeof(float) * 3, wallIndices, 6, Matrix::Identity);
+				occlusionCuller.Rasterize();
+			});
+			Record("OcclusionCuller::Rasterize", 0.0, occlusionRasterize);
+
+			uint32_t occlusionVisibleCount = 0;
+			const double occlusionTest = MeasureNanosecondsPerOperation(m_RepetitionCount, count, [&]() { for (uint32_t i = 0; i < count; i++) { occlusionVisibleCount += occlusionCuller.IsVisible(boxesA[i]) ? 1 : 0; } });
+			g_MathBenchmarkSink = g_MathBenchmarkSink + static_cast<float>(occlusionVisibleCount);
+			Record("OcclusionCuller::IsVisible (Batch)", 0.0, occlusionTest);
+		}
+	}
+
+	void MathBenchmark::CheckGolden(const std::string& name, const float* values, const float* expectedValues, const uint32_t count, const float tolerance)
+	{
+		MathGoldenResult result;
+		result.m_Name = name;
+		result.m_Tolerance = tolerance;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			result.m_ErrorMaximum = Math::Utilities::Max(result.m_ErrorMaximum, Math::Utilities::Absolute(values[i] - expectedValues[i]));
+		}
+
+		result.m_IsPassed = result.m_ErrorMaximum <= tolerance;
+		m_GoldenResults.emplace_back(result);
+	}
+
+	bool MathBenchmark::WriteReport(const std::string& outputFilePath) const
+	{
+		std::ofstream file(outputFilePath, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			AMETHYST_ERROR("Failed to open \"%s\" for writing.", outputFilePath.c_str());
+			return false;
+		}
+
+		file << std::setprecision(6);
+		file << "{\n\"batch\":" << m_BatchSize << ",\"repetitions\":" << m_RepetitionCount << ",\"instruction_set\":\"" << SIMD::InstructionSetToString(SIMD::RetrieveKernels().m_InstructionSet) << "\",\n";
+
+		file << "\"golden\":[";
+		for (size_t i = 0; i < m_GoldenResults.size(); i++)
+		{
+			const MathGoldenResult& result = m_GoldenResults[i];
+			file << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << result.m_Name << "\",\"passed\":" << (result.m_IsPassed ? "true" : "false")
+				 << ",\"error\":" << result.m_ErrorMaximum << ",\"tolerance\":" << result.m_Tolerance << "}";
+		}
+		file << "\n],\n";
+
+		file << "\"benchmarks\":[";
+		for (size_t i = 0; i < m_BenchmarkResults.size(); i++)
+		{
+			const MathBenchmarkResult& result = m_BenchmarkResults[i];
+			file << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << result.m_Name << "\",\"latency_ns\":" << result.m_LatencyInNanoseconds << ",\"throughput_ns\":" << result.m_ThroughputInNanoseconds << "}";
+		}
+		file << "\n]\n}";
+		file.close();
+
+		AMETHYST_INFO("Math benchmark report has been written to \"%s\".", outputFilePath.c_str());
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Amethyst
+{
+	// A known input/output pair for one of the math primitives.
+	struct MathGoldenResult
+	{
+		std::string m_Name;
+		float m_ErrorMaximum = 0.0f; // Largest absolute difference from the expected value.
+		float m_Tolerance = 0.0f;
+		bool m_IsPassed = false;
+	};
+
+	struct MathBenchmarkResult
+	{
+		std::string m_Name;
+		double m_LatencyInNanoseconds = 0.0;	// Per operation, with each operation depending on the result of the previous one.
+		double m_ThroughputInNanoseconds = 0.0; // Per operation, over a batch of independent inputs.
+	};
+
+	/*
+		Command Line: -benchmark_math [-benchmark_batch N] [-benchmark_repetitions N] [-benchmark_file path] [-benchmark_instruction_set Scalar|SSE2|AVX2|NEON]
+
+		Golden checks run first and compare against values worked out independently of this library, so that any replacement implementation
+		(vectorized or otherwise) can be validated before its timings are trusted. Batch kernels for every instruction set the CPU supports are
+		also checked against the scalar reference. Timings are the best of several repetitions.
+	*/
+	class MathBenchmark
+	{
+	public:
+		MathBenchmark(const uint32_t batchSize = 4096, const uint32_t repetitionCount = 16); // The batch is at least as wide as the active kernels, and there is at least one repetition.
+		~MathBenchmark() = default;
+
+		static bool RunFromCommandLine();
+		bool Run(const std::string& outputFilePath); // Returns false if any golden check fails.
+
+		bool RunGoldenChecks();
+		void RunBenchmarks();
+
+		const std::vector<MathGoldenResult>& RetrieveGoldenResults() const { return m_GoldenResults; }
+		const std::vector<MathBenchmarkResult>& RetrieveBenchmarkResults() const { return m_BenchmarkResults; }
+
+	private:
+		void CheckGolden(const std::string& name, const float* values, const float* expectedValues, const uint32_t count, const float tolerance);
+		bool WriteReport(const std::string& outputFilePath) const;
+
+	private:
+		uint32_t m_BatchSize = 0;
+		uint32_t m_RepetitionCount = 0;
+		std::vector<MathGoldenResult> m_GoldenResults;
+		std::vector<MathBenchmarkResult> m_BenchmarkResults;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include "Amethyst.h"
+#include "MemoryTracker.h"
+#include "../Resource/ResourceCache.h"
+#include "../Rendering/Renderer.h"
+#include "../RHI/RHI_Device.h"
+
+namespace Amethyst
+{
+	struct MemoryTrackerEntry
+	{
+		MemoryCategory m_Category = MemoryCategory::Texture;
+		std::string m_Owner;
+	};
+
+	// Registry - Objects can be created and destroyed from any thread (loading threads, etc.).
+	static std::mutex g_MemoryTrackerMutex;
+	static std::unordered_map<const AmethystObject*, MemoryTrackerEntry> g_MemoryTrackerEntries;
+
+	static const char* g_ResourceTypeNames[] = { "Unknown", "Texture", "Texture2D", "TextureCube", "Audio", "Material", "Mesh", "Model", "Cubemap", "Animation", "Font", "Shader" };
+	static_assert(sizeof(g_ResourceTypeNames) / sizeof(g_ResourceTypeNames[0]) == static_cast<size_t>(ResourceType::Shader) + 1, "Resource type names are out of sync with ResourceType.");
+
+	static std::string RetrieveOwnerName(const AmethystObject* object, const MemoryTrackerEntry& entry)
+	{
+		if (!entry.m_Owner.empty())
+		{
+			return entry.m_Owner;
+		}
+
+		return object->RetrieveObjectName().empty() ? "Unnamed" : object->RetrieveObjectName();
+	}
+
+	static void AppendDelta(std::vector<MemoryDelta>& deltas, const std::string& name, const MemoryUsage& before, const MemoryUsage& after)
+	{
+		const int64_t deltaCPU = static_cast<int64_t>(after.m_CPU) - static_cast<int64_t>(before.m_CPU);
+		const int64_t deltaGPU = static_cast<int64_t>(after.m_GPU) - static_cast<int64_t>(before.m_GPU);
+
+		if (deltaCPU != 0 || deltaGPU != 0)
+		{
+			deltas.push_back({ name, deltaCPU, deltaGPU });
+		}
+	}
+
+	MemoryTracker::MemoryTracker(Context* context) : ISubsystem(context)
+	{
+
+	}
+
+	bool MemoryTracker::OnInitialize()
+	{
+		m_ResourceCache = m_EngineContext->RetrieveSubsystem<ResourceCache>();
+		m_Renderer = m_EngineContext->RetrieveSubsystem<Renderer>();
+
+		// Baseline to diff against.
+		m_Snapshots.emplace_back(TakeSnapshot());
+
+		return true;
+	}
+
+	void MemoryTracker::OnUpdate(float deltaTime)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		m_FrameNumber++;
+		m_TimeSinceSnapshot += deltaTime;
+
+		if (m_SnapshotIntervalInSeconds <= 0.0f || m_TimeSinceSnapshot < m_SnapshotIntervalInSeconds)
+		{
+			return;
+		}
+
+		m_TimeSinceSnapshot = 0.0f;
+		m_Snapshots.emplace_back(TakeSnapshot());
+
+		// Report anything that grew noticeably since the previous snapshot. Steady growth across these is what leaks look like in soak tests.
+		if (m_Snapshots.size() >= 2)
+		{
+			for (const MemoryDelta& delta : Diff(m_Snapshots[m_Snapshots.size() - 2], m_Snapshots.back()))
+			{
+				if (delta.m_CPU > static_cast<int64_t>(m_GrowthWarningThreshold) || delta.m_GPU > static_cast<int64_t>(m_GrowthWarningThreshold))
+				{
+					AMETHYST_WARNING("Memory for \"%s\" grew by %lld KB (CPU) and %lld KB (GPU) since the last snapshot.", delta.m_Name.c_str(), delta.m_CPU / 1024, delta.m_GPU / 1024);
+				}
+			}
+		}
+
+		while (m_Snapshots.size() > m_SnapshotHistoryCount)
+		{
+			m_Snapshots.pop_front();
+		}
+	}
+
+	void MemoryTracker::Track(const AmethystObject* object, const MemoryCategory category, const std::string& owner /*= ""*/)
+	{
+		if (!object)
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(g_MemoryTrackerMutex);
+
+		MemoryTrackerEntry& entry = g_MemoryTrackerEntries[object];
+		entry.m_Category = category;
+		if (!owner.empty())
+		{
+			entry.m_Owner = owner;
+		}
+	}
+
+	void MemoryTracker::Untrack(const AmethystObject* object)
+	{
+		std::lock_guard<std::mutex> lock(g_MemoryTrackerMutex);
+		g_MemoryTrackerEntries.erase(object);
+	}
+
+	void MemoryTracker::SetOwner(const AmethystObject* object, const std::string& owner)
+	{
+		std::lock_guard<std::mutex> lock(g_MemoryTrackerMutex);
+
+		auto iterator = g_MemoryTrackerEntries.find(object);
+		if (iterator != g_MemoryTrackerEntries.end())
+		{
+			iterator->second.m_Owner = owner;
+		}
+	}
+
+	MemorySnapshot MemoryTracker::TakeSnapshot() const
+	{
+		MemorySnapshot snapshot;
+		snapshot.m_FrameNumber = m_FrameNumber;
+
+		// RHI Objects
+		{
+			std::lock_guard<std::mutex> lock(g_MemoryTrackerMutex);
+
+			for (const auto& [object, entry] : g_MemoryTrackerEntries)
+			{
+				MemoryUsage& categoryUsage = snapshot.m_Categories[static_cast<size_t>(entry.m_Category)];
+				categoryUsage.m_CPU += object->RetrieveCPUSize();
+				categoryUsage.m_GPU += object->RetrieveGPUSize();
+				categoryUsage.m_ObjectCount++;
+
+				MemoryUsage& ownerUsage = snapshot.m_Owners[RetrieveOwnerName(object, entry)];
+				ownerUsage.m_CPU += object->RetrieveCPUSize();
+				ownerUsage.m_GPU += object->RetrieveGPUSize();
+				ownerUsage.m_ObjectCount++;
+			}
+		}
+
+		// Resources
+		if (m_ResourceCache)
+		{
+			for (size_t i = 1; i < snapshot.m_ResourceTypes.size(); i++) // Skip ResourceType::Unknown as the cache treats it as "all".
+			{
+				const ResourceType resourceType = static_cast<ResourceType>(i);
+				snapshot.m_ResourceTypes[i].m_CPU = m_ResourceCache->RetrieveMemoryUsageCPU(resourceType);
+				snapshot.m_ResourceTypes[i].m_GPU = m_ResourceCache->RetrieveMemoryUsageGPU(resourceType);
+				snapshot.m_ResourceTypes[i].m_ObjectCount = m_ResourceCache->RetrieveResourceCount(resourceType);
+			}
+		}
+
+		// Device
+		if (m_Renderer && m_Renderer->RetrieveRHIDevice())
+		{
+			RHI_MemoryStatistics statistics;
+			m_Renderer->RetrieveRHIDevice()->RetrieveMemoryStatistics(statistics);
+
+			snapshot.m_DeviceBytesAllocated = statistics.m_BytesAllocated;
+			snapshot.m_DeviceBytesUsed = statistics.m_BytesUsed;
+			snapshot.m_DeviceBytesBudget = statistics.m_BytesBudget;
+			snapshot.m_DeviceAllocationCount = statistics.m_AllocationCount;
+		}
+
+		return snapshot;
+	}
+
+	MemoryUsage MemoryTracker::RetrieveUsage(const MemoryCategory category)
+	{
+		std::lock_guard<std::mutex> lock(g_MemoryTrackerMutex);
+
+		MemoryUsage usage;
+		for (const auto& [object, entry] : g_MemoryTrackerEntries)
+		{
+			if (entry.m_Category == category)
+			{
+				usage.m_CPU += object->RetrieveCPUSize();
+				usage.m_GPU += object->RetrieveGPUSize();
+				usage.m_ObjectCount++;
+			}
+		}
+
+		return usage;
+	}
+
+	MemoryUsage MemoryTracker::RetrieveUsage(const std::string& owner)
+	{
+		std::lock_guard<std::mutex> lock(g_MemoryTrackerMutex);
+
+		MemoryUsage usage;
+		for (const auto& [object, entry] : g_MemoryTrackerEntries)
+		{
+			if (RetrieveOwnerName(object, entry) == owner)
+			{
+				usage.m_CPU += object->RetrieveCPUSize();
+				usage.m_GPU += object->RetrieveGPUSize();
+				usage.m_ObjectCount++;
+			}
+		}
+
+		return usage;
+	}
+
+	std::vector<MemoryDelta> MemoryTracker::Diff(const MemorySnapshot& before, const MemorySnapshot& after)
+	{
+		std::vector<MemoryDelta> deltas;
+
+		for (size_t i = 0; i < before.m_Categories.size(); i++)
+		{
+			AppendDelta(deltas, MemoryCategoryToString(static_cast<MemoryCategory>(i)), before.m_Categories[i], after.m_Categories[i]);
+		}
+
+		for (size_t i = 1; i < before.m_ResourceTypes.size(); i++)
+		{
+			AppendDelta(deltas, std::string("Resource/") + g_ResourceTypeNames[i], before.m_ResourceTypes[i], after.m_ResourceTypes[i]);
+		}
+
+		// Owners that appeared or grew/shrank...
+		for (const auto& [owner, usageAfter] : after.m_Owners)
+		{
+			auto iterator = before.m_Owners.find(owner);
+			AppendDelta(deltas, "Owner/" + owner, iterator != before.m_Owners.end() ? iterator->second : MemoryUsage(), usageAfter);
+		}
+
+		// ...and owners that went away.
+		for (const auto& [owner, usageBefore] : before.m_Owners)
+		{
+			if (after.m_Owners.find(owner) == after.m_Owners.end())
+			{
+				AppendDelta(deltas, "Owner/" + owner, usageBefore, MemoryUsage());
+			}
+		}
+
+		MemoryUsage deviceBefore;
+		deviceBefore.m_GPU = before.m_DeviceBytesAllocated;
+		MemoryUsage deviceAfter;
+		deviceAfter.m_GPU = after.m_DeviceBytesAllocated;
+		AppendDelta(deltas, "Device", deviceBefore, deviceAfter);
+
+		return deltas;
+	}
+
+	void MemoryTracker::LogSnapshot(const MemorySnapshot& snapshot)
+	{
+		AMETHYST_INFO("Memory snapshot at frame %llu.", snapshot.m_FrameNumber);
+
+		for (size_t i = 0; i < snapshot.m_Categories.size(); i++)
+		{
+			const MemoryUsage& usage = snapshot.m_Categories[i];
+			AMETHYST_INFO("%s: %u objects, %llu KB CPU, %llu KB GPU.", MemoryCategoryToString(static_cast<MemoryCategory>(i)), usage.m_ObjectCount, usage.m_CPU / 1024, usage.m_GPU / 1024);
+		}
+
+		for (size_t i = 1; i < snapshot.m_ResourceTypes.size(); i++)
+		{
+			const MemoryUsage& usage = snapshot.m_ResourceTypes[i];
+			if (usage.m_ObjectCount != 0)
+			{
+				AMETHYST_INFO("Resource/%s: %u objects, %llu KB CPU, %llu KB GPU.", g_ResourceTypeNames[i], usage.m_ObjectCount, usage.m_CPU / 1024, usage.m_GPU / 1024);
+			}
+		}
+
+		AMETHYST_INFO("Device: %u allocations, %llu KB used out of %llu KB allocated, %llu KB budget.", snapshot.m_DeviceAllocationCount, snapshot.m_DeviceBytesUsed / 1024, snapshot.m_DeviceBytesAllocated / 1024, snapshot.m_DeviceBytesBudget / 1024);
+	}
+}
\ No newline at end of file
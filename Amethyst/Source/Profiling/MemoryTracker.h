@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../Core/ISubsystem.h"
+#include "../Resource/IResource.h"
+
+namespace Amethyst
+{
+	class Context;
+	class ResourceCache;
+	class Renderer;
+
+	// RHI objects don't go through the resource cache, so they are accounted for by what they are used as.
+	enum class MemoryCategory : uint8_t
+	{
+		Texture,
+		RenderTarget,
+		VertexBuffer,
+		IndexBuffer,
+		ConstantBuffer,
+		StructuredBuffer,
+		Count
+	};
+
+	inline const char* MemoryCategoryToString(const MemoryCategory category)
+	{
+		switch (category)
+		{
+			case MemoryCategory::Texture:		 return "Texture";
+			case MemoryCategory::RenderTarget:	 return "RenderTarget";
+			case MemoryCategory::VertexBuffer:	 return "VertexBuffer";
+			case MemoryCategory::IndexBuffer:	 return "IndexBuffer";
+			case MemoryCategory::ConstantBuffer: return "ConstantBuffer";
+			case MemoryCategory::StructuredBuffer: return "StructuredBuffer";
+			default:							 return "Unknown";
+		}
+	}
+
+	struct MemoryUsage
+	{
+		uint64_t m_CPU = 0;
+		uint64_t m_GPU = 0;
+		uint32_t m_ObjectCount = 0;
+	};
+
+	struct MemorySnapshot
+	{
+		uint64_t m_FrameNumber = 0;
+		std::array<MemoryUsage, static_cast<size_t>(MemoryCategory::Count)> m_Categories;
+		std::array<MemoryUsage, static_cast<size_t>(ResourceType::Shader) + 1> m_ResourceTypes; // From the resource cache.
+		std::unordered_map<std::string, MemoryUsage> m_Owners;
+
+		// Device (VMA)
+		uint64_t m_DeviceBytesAllocated = 0; // Sum of all VkDeviceMemory blocks.
+		uint64_t m_DeviceBytesUsed = 0;		 // Sum of all allocations within those blocks.
+		uint64_t m_DeviceBytesBudget = 0;
+		uint32_t m_DeviceAllocationCount = 0;
+	};
+
+	// A single non-zero change between two snapshots.
+	struct MemoryDelta
+	{
+		std::string m_Name;
+		int64_t m_CPU = 0;
+		int64_t m_GPU = 0;
+	};
+
+	class MemoryTracker : public ISubsystem
+	{
+	public:
+		MemoryTracker(Context* context);
+		~MemoryTracker() = default;
+
+		// === ISubsystem ===
+		bool OnInitialize() override;
+		void OnUpdate(float deltaTime) override;
+
+		// Registry - Called by objects as they (re)allocate and release memory. Sizes are read from the object whenever a snapshot is taken.
+		static void Track(const AmethystObject* object, const MemoryCategory category, const std::string& owner = "");
+		static void Untrack(const AmethystObject* object);
+		static void SetOwner(const AmethystObject* object, const std::string& owner);
+
+		// Queries
+		MemorySnapshot TakeSnapshot() const;
+		static MemoryUsage RetrieveUsage(const MemoryCategory category);
+		static MemoryUsage RetrieveUsage(const std::string& owner);
+		static std::vector<MemoryDelta> Diff(const MemorySnapshot& before, const MemorySnapshot& after);
+		static void LogSnapshot(const MemorySnapshot& snapshot);
+
+		// Periodic Snapshots
+		const std::deque<MemorySnapshot>& RetrieveSnapshots() const { return m_Snapshots; }
+		void SetSnapshotInterval(const float intervalInSeconds) { m_SnapshotIntervalInSeconds = intervalInSeconds; }
+		void SetGrowthWarningThreshold(const uint64_t bytes) { m_GrowthWarningThreshold = bytes; }
+
+	private:
+		ResourceCache* m_ResourceCache = nullptr;
+		Renderer* m_Renderer = nullptr;
+
+		std::deque<MemorySnapshot> m_Snapshots;
+		uint32_t m_SnapshotHistoryCount = 32;
+		float m_SnapshotIntervalInSeconds = 10.0f;
+		float m_TimeSinceSnapshot = 0.0f;
+		uint64_t m_GrowthWarningThreshold = 16 * 1024 * 1024; // Growth between two snapshots past this gets logged as a warning.
+		uint64_t m_FrameNumber = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,382 @@
+#include "Amethyst.h"
+#include "Profiler.h"
+#include "../Input/Input.h"
+#include <iomanip>
+
+namespace Amethyst
+{
+	// Thread Registry - Buffers are never freed so that a thread exiting mid-frame can't leave the profiler reading freed memory.
+	static std::mutex g_TimeBlockBuffersMutex;
+	static std::vector<std::unique_ptr<TimeBlockBuffer>> g_TimeBlockBuffers;
+	static thread_local TimeBlockBuffer* g_TimeBlockBufferCurrentThread = nullptr;
+
+	TimeBlockBuffer* TimeBlockBuffer::RetrieveForCurrentThread()
+	{
+		if (!g_TimeBlockBufferCurrentThread)
+		{
+			std::lock_guard<std::mutex> lock(g_TimeBlockBuffersMutex);
+			g_TimeBlockBuffers.emplace_back(std::make_unique<TimeBlockBuffer>("Thread_" + std::to_string(g_TimeBlockBuffers.size())));
+			g_TimeBlockBufferCurrentThread = g_TimeBlockBuffers.back().get();
+		}
+
+		return g_TimeBlockBufferCurrentThread;
+	}
+
+	void TimeBlockBuffer::SetCurrentThreadName(const std::string& threadName)
+	{
+		TimeBlockBuffer* buffer = RetrieveForCurrentThread();
+
+		std::lock_guard<std::mutex> lock(g_TimeBlockBuffersMutex);
+		buffer->m_ThreadName = threadName;
+	}
+
+	void TimeBlockBuffer::RetrieveAll(std::vector<TimeBlockBuffer*>& buffers, std::vector<std::string>* threadNames /*= nullptr*/)
+	{
+		std::lock_guard<std::mutex> lock(g_TimeBlockBuffersMutex);
+
+		buffers.clear();
+		if (threadNames)
+		{
+			threadNames->clear();
+		}
+
+		for (const std::unique_ptr<TimeBlockBuffer>& buffer : g_TimeBlockBuffers)
+		{
+			buffers.emplace_back(buffer.get());
+			if (threadNames)
+			{
+				threadNames->emplace_back(buffer->m_ThreadName);
+			}
+		}
+	}
+
+	Profiler::Profiler(Context* context) : ISubsystem(context)
+	{
+
+	}
+
+	bool Profiler::OnInitialize()
+	{
+		m_Input = m_EngineContext->RetrieveSubsystem<Input>();
+
+		// Command Line: -trace [frame count] [file path]
+		if (Engine::HasCommandLineArgument("-trace"))
+		{
+			m_TraceFrameCount = Math::Utilities::Max(Engine::RetrieveCommandLineArgumentAsInteger("-trace_frames", m_TraceFrameCount), 1u);
+			CaptureTrace(m_TraceFrameCount, Engine::RetrieveCommandLineArgumentValue("-trace_file"));
+		}
+
+		return true;
+	}
+
+	void Profiler::OnPostUpdate()
+	{
+		if (IsEnabled())
+		{
+			Aggregate();
+
+			if (IsCapturingTrace())
+			{
+				m_TraceFrameBoundaries.emplace_back(TimeBlock::RetrieveTimestamp());
+
+				if (--m_TraceFramesRemaining == 0)
+				{
+					WriteTrace();
+
+					m_TraceEvents.clear();
+					m_TraceEvents.shrink_to_fit();
+					m_TraceThreadNames.clear();
+					m_TraceFrameBoundaries.clear();
+				}
+			}
+		}
+
+		// Hotkey - Checked after aggregation so that the capture starts on a frame boundary.
+		if (m_Input && m_Input->GetKeyDown(KeyCode::F10) && !IsCapturingTrace())
+		{
+			CaptureTrace(m_TraceFrameCount);
+		}
+	}
+
+	void Profiler::SetEnabled(const bool isEnabled)
+	{
+		if (isEnabled == IsEnabled())
+		{
+			return;
+		}
+
+		// Drain whatever was recorded so far so that it doesn't leak into the first frame after re-enabling.
+		if (!isEnabled)
+		{
+			Aggregate();
+		}
+
+		ScopedTimeBlock::s_IsEnabled.store(isEnabled, std::memory_order_relaxed);
+		AMETHYST_INFO("Profiler has been %s.", isEnabled ? "enabled" : "disabled");
+	}
+
+	uint32_t Profiler::RetrieveDroppedBlockCount() const
+	{
+		std::vector<TimeBlockBuffer*> buffers;
+		TimeBlockBuffer::RetrieveAll(buffers);
+
+		uint32_t droppedCount = 0;
+		for (const TimeBlockBuffer* buffer : buffers)
+		{
+			droppedCount += buffer->RetrieveDroppedCount();
+		}
+
+		return droppedCount;
+	}
+
+	void Profiler::ResetStatistics()
+	{
+		m_Nodes.clear();
+		m_RootNodes.clear();
+		m_FrameCount = 0;
+	}
+
+	void Profiler::LogCallTree() const
+	{
+		AMETHYST_INFO("Profiler call tree over %llu frames (last/min/avg/max in milliseconds).", m_FrameCount);
+
+		for (const uint32_t rootNode : m_RootNodes)
+		{
+			LogNode(rootNode);
+		}
+	}
+
+	void Profiler::CaptureTrace(const uint32_t frameCount, const std::string& filePath /*= ""*/)
+	{
+		if (frameCount == 0)
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		if (IsCapturingTrace())
+		{
+			AMETHYST_WARNING("A trace capture is already in progress.");
+			return;
+		}
+
+		SetEnabled(true);
+
+		m_TraceFramesRemaining = frameCount;
+		m_TraceFilePath = filePath.empty() ? "Amethyst_Trace_" + std::to_string(m_FrameCount) + ".json" : filePath;
+		m_TraceEvents.clear();
+		m_TraceThreadNames.clear();
+		m_TraceFrameBoundaries.clear();
+		m_TraceFrameBoundaries.emplace_back(TimeBlock::RetrieveTimestamp());
+
+		AMETHYST_INFO("Capturing a trace of %d frames to \"%s\".", frameCount, m_TraceFilePath.c_str());
+	}
+
+	void Profiler::Aggregate()
+	{
+		// Reset per-frame values.
+		for (ProfilerNode& node : m_Nodes)
+		{
+			node.m_CallCount = 0;
+			node.m_TimeInMilliseconds = 0.0;
+		}
+
+		// Drain every thread's buffer into the call tree.
+		std::vector<TimeBlockBuffer*> buffers;
+		std::vector<std::string> threadNames;
+		TimeBlockBuffer::RetrieveAll(buffers, &threadNames);
+
+		if (IsCapturingTrace())
+		{
+			m_TraceThreadNames = threadNames;
+		}
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(buffers.size()); i++)
+		{
+			AggregateBuffer(buffers[i], i, threadNames[i]);
+		}
+
+		// Fold this frame into the history of every scope that was hit.
+		for (ProfilerNode& node : m_Nodes)
+		{
+			if (node.m_CallCount == 0)
+			{
+				continue;
+			}
+
+			node.m_TimeMinimumInMilliseconds = Math::Utilities::Min(node.m_TimeMinimumInMilliseconds, node.m_TimeInMilliseconds);
+			node.m_TimeMaximumInMilliseconds = Math::Utilities::Max(node.m_TimeMaximumInMilliseconds, node.m_TimeInMilliseconds);
+			node.m_TimeTotalInMilliseconds += node.m_TimeInMilliseconds;
+			node.m_FrameCount++;
+		}
+
+		m_FrameCount++;
+	}
+
+	void Profiler::AggregateBuffer(TimeBlockBuffer* buffer, const uint32_t threadIndex, const std::string& threadName)
+	{
+		const uint32_t tail = buffer->RetrieveTail();
+		const uint32_t head = buffer->RetrieveHead();
+
+		// Only consume up to the last completed root scope. Anything after it belongs to scopes that are still open and is picked up next frame.
+		uint32_t end = tail;
+		for (uint32_t i = tail; i != head; i++)
+		{
+			if (buffer->RetrieveBlock(i).m_Depth == 0)
+			{
+				end = i + 1;
+			}
+		}
+
+		if (end == tail)
+		{
+			return;
+		}
+
+		const uint32_t rootNode = RetrieveOrCreateRootNode(threadName);
+		const bool isCapturingTrace = IsCapturingTrace();
+
+		// Blocks are stored in the order their scopes ended, so walking backwards visits every parent before its children.
+		m_ScopeStack.clear();
+		for (uint32_t i = end; i != tail; i--)
+		{
+			const TimeBlock& timeBlock = buffer->RetrieveBlock(i - 1);
+			const uint32_t depth = timeBlock.m_Depth;
+			const uint32_t parentNode = (depth == 0 || depth > m_ScopeStack.size()) ? rootNode : m_ScopeStack[depth - 1];
+			const uint32_t node = RetrieveOrCreateNode(parentNode, timeBlock.m_Name);
+
+			m_ScopeStack.resize(depth + 1);
+			m_ScopeStack[depth] = node;
+
+			const double duration = timeBlock.RetrieveDurationInMilliseconds();
+			m_Nodes[node].m_CallCount++;
+			m_Nodes[node].m_TimeInMilliseconds += duration;
+
+			if (depth == 0)
+			{
+				m_Nodes[rootNode].m_CallCount++;
+				m_Nodes[rootNode].m_TimeInMilliseconds += duration;
+			}
+
+			if (isCapturingTrace && timeBlock.m_End >= m_TraceFrameBoundaries.front())
+			{
+				m_TraceEvents.push_back({ timeBlock.m_Name, timeBlock.m_Start, timeBlock.m_End, threadIndex });
+			}
+		}
+
+		buffer->Release(end);
+	}
+
+	uint32_t Profiler::RetrieveOrCreateNode(const uint32_t parentIndex, const char* name)
+	{
+		for (const uint32_t childIndex : m_Nodes[parentIndex].m_Children)
+		{
+			if (m_Nodes[childIndex].m_Name == name)
+			{
+				return childIndex;
+			}
+		}
+
+		const uint32_t nodeIndex = static_cast<uint32_t>(m_Nodes.size());
+		ProfilerNode& node = m_Nodes.emplace_back();
+		node.m_Name = name ? name : "Unnamed";
+		node.m_Parent = parentIndex;
+		node.m_Depth = m_Nodes[parentIndex].m_Depth + 1;
+		m_Nodes[parentIndex].m_Children.emplace_back(nodeIndex);
+
+		return nodeIndex;
+	}
+
+	uint32_t Profiler::RetrieveOrCreateRootNode(const std::string& threadName)
+	{
+		for (const uint32_t rootIndex : m_RootNodes)
+		{
+			if (m_Nodes[rootIndex].m_Name == threadName)
+			{
+				return rootIndex;
+			}
+		}
+
+		const uint32_t nodeIndex = static_cast<uint32_t>(m_Nodes.size());
+		m_Nodes.emplace_back().m_Name = threadName;
+		m_RootNodes.emplace_back(nodeIndex);
+
+		return nodeIndex;
+	}
+
+	void Profiler::LogNode(const uint32_t nodeIndex) const
+	{
+		const ProfilerNode& node = m_Nodes[nodeIndex];
+		const std::string indentation(node.m_Depth * 2, ' ');
+
+		AMETHYST_INFO("%s%s: %.3f/%.3f/%.3f/%.3f (%u calls)", indentation.c_str(), node.m_Name.c_str(), node.m_TimeInMilliseconds,
+			node.m_FrameCount == 0 ? 0.0 : node.m_TimeMinimumInMilliseconds, node.RetrieveTimeAverageInMilliseconds(), node.m_TimeMaximumInMilliseconds, node.m_CallCount);
+
+		for (const uint32_t childIndex : node.m_Children)
+		{
+			LogNode(childIndex);
+		}
+	}
+
+	bool Profiler::WriteTrace() const
+	{
+		std::ofstream file(m_TraceFilePath, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			AMETHYST_ERROR("Failed to open \"%s\" for writing.", m_TraceFilePath.c_str());
+			return false;
+		}
+
+		// Trace Event Format expects microseconds. We make them relative to the start of the capture to keep the numbers readable.
+		const int64_t origin = m_TraceFrameBoundaries.empty() ? 0 : m_TraceFrameBoundaries.front();
+		const auto ToMicroseconds = [origin](const int64_t timestamp) { return static_cast<double>(timestamp - origin) / 1000.0; };
+
+		const auto Escape = [](const char* text)
+		{
+			std::string escaped;
+			for (const char* character = text ? text : "Unnamed"; *character != '\0'; character++)
+			{
+				if (*character == '"' || *character == '\\')
+				{
+					escaped += '\\';
+				}
+
+				escaped += *character;
+			}
+
+			return escaped;
+		};
+
+		file << std::fixed << std::setprecision(3);
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		// Thread names (metadata events).
+		bool isFirstEvent = true;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_TraceThreadNames.size()); i++)
+		{
+			file << (isFirstEvent ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":\"" << Escape(m_TraceThreadNames[i].c_str()) << "\"}}";
+			isFirstEvent = false;
+		}
+
+		// Frame boundaries (global instant events), so hitches can be lined up against the frame they happened in.
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_TraceFrameBoundaries.size()); i++)
+		{
+			file << (isFirstEvent ? "" : ",\n") << "{\"name\":\"Frame " << i << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":" << ToMicroseconds(m_TraceFrameBoundaries[i]) << "}";
+			isFirstEvent = false;
+		}
+
+		// Scopes (complete events).
+		for (const ProfilerTraceEvent& traceEvent : m_TraceEvents)
+		{
+			file << (isFirstEvent ? "" : ",\n") << "{\"name\":\"" << Escape(traceEvent.m_Name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << traceEvent.m_ThreadIndex
+				 << ",\"ts\":" << ToMicroseconds(traceEvent.m_Start) << ",\"dur\":" << static_cast<double>(traceEvent.m_End - traceEvent.m_Start) / 1000.0 << "}";
+			isFirstEvent = false;
+		}
+
+		file << "\n]}";
+		file.close();
+
+		AMETHYST_INFO("Trace with %d events has been written to \"%s\".", static_cast<uint32_t>(m_TraceEvents.size()), m_TraceFilePath.c_str());
+		return true;
+	}
+}
\ No newline at end of file
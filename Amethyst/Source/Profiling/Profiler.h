@@ -0,0 +1,92 @@
+#pragma once
+#include <limits>
+#include "../Core/ISubsystem.h"
+#include "TimeBlock.h"
+
+namespace Amethyst
+{
+	class Context;
+	class Input;
+
+	// A node in the aggregated call tree. Roots are threads, everything else is a named scope.
+	struct ProfilerNode
+	{
+		double RetrieveTimeAverageInMilliseconds() const { return m_FrameCount == 0 ? 0.0 : m_TimeTotalInMilliseconds / static_cast<double>(m_FrameCount); }
+
+		std::string m_Name;
+		uint32_t m_Parent = std::numeric_limits<uint32_t>::max();
+		uint32_t m_Depth = 0;
+		std::vector<uint32_t> m_Children;
+
+		// Last Frame
+		uint32_t m_CallCount = 0;
+		double m_TimeInMilliseconds = 0.0;
+
+		// History (only frames in which the scope was hit count towards it).
+		double m_TimeMinimumInMilliseconds = std::numeric_limits<double>::max();
+		double m_TimeMaximumInMilliseconds = 0.0;
+		double m_TimeTotalInMilliseconds = 0.0;
+		uint64_t m_FrameCount = 0;
+	};
+
+	// A raw time block kept around for trace export.
+	struct ProfilerTraceEvent
+	{
+		const char* m_Name = nullptr;
+		int64_t m_Start = 0;
+		int64_t m_End = 0;
+		uint32_t m_ThreadIndex = 0;
+	};
+
+	class Profiler : public ISubsystem
+	{
+	public:
+		Profiler(Context* context);
+		~Profiler() = default;
+
+		// === ISubsystem ===
+		bool OnInitialize() override;
+		void OnPostUpdate() override; // Frame boundary.
+
+		// Toggling
+		void SetEnabled(const bool isEnabled);
+		bool IsEnabled() const { return ScopedTimeBlock::s_IsEnabled.load(std::memory_order_relaxed); }
+
+		// Call Tree
+		const std::vector<ProfilerNode>& RetrieveNodes() const { return m_Nodes; }
+		const std::vector<uint32_t>& RetrieveRootNodes() const { return m_RootNodes; }
+		uint64_t RetrieveFrameCount() const { return m_FrameCount; }
+		uint32_t RetrieveDroppedBlockCount() const;
+		void ResetStatistics();
+		void LogCallTree() const;
+
+		// Trace Export - Dumps a window of frames as Chrome Trace Event JSON (viewable in chrome://tracing or ui.perfetto.dev).
+		void CaptureTrace(const uint32_t frameCount, const std::string& filePath = "");
+		bool IsCapturingTrace() const { return m_TraceFramesRemaining != 0; }
+		void SetTraceFrameCount(const uint32_t frameCount) { m_TraceFrameCount = frameCount; }
+		uint32_t RetrieveTraceFrameCount() const { return m_TraceFrameCount; }
+
+	private:
+		void Aggregate();
+		void AggregateBuffer(TimeBlockBuffer* buffer, const uint32_t threadIndex, const std::string& threadName);
+		bool WriteTrace() const;
+		uint32_t RetrieveOrCreateNode(const uint32_t parentIndex, const char* name);
+		uint32_t RetrieveOrCreateRootNode(const std::string& threadName);
+		void LogNode(const uint32_t nodeIndex) const;
+
+	private:
+		std::vector<ProfilerNode> m_Nodes;
+		std::vector<uint32_t> m_RootNodes;
+		std::vector<uint32_t> m_ScopeStack; // Scratch space for rebuilding parent links, indexed by depth.
+		uint64_t m_FrameCount = 0;
+
+		// Trace
+		uint32_t m_TraceFrameCount = 300; // Frames captured by the hotkey/command line.
+		uint32_t m_TraceFramesRemaining = 0;
+		std::string m_TraceFilePath;
+		std::vector<ProfilerTraceEvent> m_TraceEvents;
+		std::vector<std::string> m_TraceThreadNames;
+		std::vector<int64_t> m_TraceFrameBoundaries;
+		Input* m_Input = nullptr;
+	};
+}
\ No newline at end of file
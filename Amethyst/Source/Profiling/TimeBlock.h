@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Amethyst
+{
+	// A single completed CPU scope, recorded by the thread that timed it.
+	struct TimeBlock
+	{
+		static int64_t RetrieveTimestamp() // In nanoseconds.
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+		}
+
+		double RetrieveDurationInMilliseconds() const { return static_cast<double>(m_End - m_Start) / 1000000.0; }
+
+		const char* m_Name = nullptr; // Must outlive the profiler (string literals, __FUNCTION__, typeid names).
+		int64_t m_Start = 0;
+		int64_t m_End = 0;
+		uint32_t m_Depth = 0;
+	};
+
+	/*
+		Single producer/single consumer ring of completed time blocks. Each thread owns exactly one buffer and is the only one writing to it, while the profiler
+		is the only one reading from it (at frame boundaries). As such, pushing a block never takes a lock. Blocks are pushed when their scope ends, which means
+		that children always appear before their parents.
+	*/
+	class TimeBlockBuffer
+	{
+	public:
+		static constexpr uint32_t s_Capacity = 16384; // Must be a power of two.
+
+		TimeBlockBuffer(const std::string& threadName) : m_ThreadName(threadName) { m_Blocks.resize(s_Capacity); }
+
+		// Producer
+		void Push(const TimeBlock& timeBlock)
+		{
+			const uint32_t head = m_Head.load(std::memory_order_relaxed);
+
+			// If the profiler hasn't caught up, drop the block rather than stalling the thread being profiled.
+			if (head - m_Tail.load(std::memory_order_acquire) >= s_Capacity)
+			{
+				m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			m_Blocks[head & (s_Capacity - 1)] = timeBlock;
+			m_Head.store(head + 1, std::memory_order_release);
+		}
+
+		// Consumer
+		uint32_t RetrieveHead() const { return m_Head.load(std::memory_order_acquire); }
+		uint32_t RetrieveTail() const { return m_Tail.load(std::memory_order_relaxed); }
+		const TimeBlock& RetrieveBlock(const uint32_t index) const { return m_Blocks[index & (s_Capacity - 1)]; }
+		void Release(const uint32_t tail) { m_Tail.store(tail, std::memory_order_release); }
+		uint32_t RetrieveDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+
+		// Thread Registry
+		static TimeBlockBuffer* RetrieveForCurrentThread(); // Lazily registers the calling thread.
+		static void SetCurrentThreadName(const std::string& threadName);
+		static void RetrieveAll(std::vector<TimeBlockBuffer*>& buffers, std::vector<std::string>* threadNames = nullptr);
+
+	public:
+		uint32_t m_Depth = 0; // Current scope depth. Only ever touched by the owning thread.
+
+	private:
+		std::string m_ThreadName; // Guarded by the registry mutex.
+		std::vector<TimeBlock> m_Blocks;
+		std::atomic<uint32_t> m_Head = 0;
+		std::atomic<uint32_t> m_Tail = 0;
+		std::atomic<uint32_t> m_DroppedCount = 0;
+	};
+
+	// RAII scope marker. When profiling is disabled, the only cost is the branch on s_IsEnabled in the constructor (and on m_Buffer in the destructor).
+	class ScopedTimeBlock
+	{
+	public:
+		ScopedTimeBlock(const char* name)
+		{
+			if (!s_IsEnabled.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			m_Buffer = TimeBlockBuffer::RetrieveForCurrentThread();
+			m_Name = name;
+			m_Depth = m_Buffer->m_Depth++;
+			m_Start = TimeBlock::RetrieveTimestamp();
+		}
+
+		~ScopedTimeBlock()
+		{
+			if (!m_Buffer)
+			{
+				return;
+			}
+
+			TimeBlock timeBlock;
+			timeBlock.m_Name = m_Name;
+			timeBlock.m_Start = m_Start;
+			timeBlock.m_End = TimeBlock::RetrieveTimestamp();
+			timeBlock.m_Depth = m_Depth;
+
+			m_Buffer->m_Depth--;
+			m_Buffer->Push(timeBlock);
+		}
+
+		ScopedTimeBlock(const ScopedTimeBlock&) = delete;
+		ScopedTimeBlock& operator=(const ScopedTimeBlock&) = delete;
+
+	public:
+		static inline std::atomic<bool> s_IsEnabled = true;
+
+	private:
+		TimeBlockBuffer* m_Buffer = nullptr;
+		const char* m_Name = nullptr;
+		int64_t m_Start = 0;
+		uint32_t m_Depth = 0;
+	};
+
+	#define AMETHYST_PROFILE_CONCATENATE_INTERNAL(x, y) x##y
+	#define AMETHYST_PROFILE_CONCATENATE(x, y) AMETHYST_PROFILE_CONCATENATE_INTERNAL(x, y)
+	#define AMETHYST_PROFILE_SCOPE(name) Amethyst::ScopedTimeBlock AMETHYST_PROFILE_CONCATENATE(_scopedTimeBlock, __LINE__)(name)
+	#define AMETHYST_PROFILE_FUNCTION()  AMETHYST_PROFILE_SCOPE(__FUNCTION__)
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_AliasedMemory.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture.h"
+#include "../../Profiling/MemoryTracker.h"
+
+namespace Amethyst
+{
+	RHI_AliasedMemory::RHI_AliasedMemory(RHI_Device* rhi_Device, const std::vector<RHI_Texture*>& textures, const char* name /*= nullptr*/)
+	{
+		m_RHI_Device = rhi_Device;
+		m_Name = name ? name : "";
+
+		// Nothing is allocated for images, so the block is only as large as the largest texture would be.
+		for (RHI_Texture* texture : textures)
+		{
+			AMETHYST_ASSERT(texture->RetrieveFlags() & RHI_Texture_Flags::RHI_Texture_Aliased);
+
+			const uint64_t textureSize = static_cast<uint64_t>(texture->RetrieveWidth()) * texture->RetrieveHeight() * texture->RetrieveArraySize() * RHI_Format_ToBytesPerPixel(texture->RetrieveFormat());
+			m_Size_GPU = Math::Utilities::Max(m_Size_GPU, textureSize);
+		}
+
+		m_Resource = NullUtility::Resource::Create(Null_Resource_Type::Memory);
+		MemoryTracker::Track(this, MemoryCategory::RenderTarget);
+
+		for (RHI_Texture* texture : textures)
+		{
+			if (!texture->PlaceInMemory(this))
+			{
+				AMETHYST_ERROR("Failed to place \"%s\" in \"%s\".", texture->RetrieveObjectName().c_str(), m_Name.c_str());
+			}
+		}
+	}
+
+	RHI_AliasedMemory::~RHI_AliasedMemory()
+	{
+		if (!m_Resource)
+		{
+			return;
+		}
+
+		MemoryTracker::Untrack(this);
+		NullUtility::Resource::Destroy(m_Resource);
+	}
+}
+
+#endif
\ No newline at end of file
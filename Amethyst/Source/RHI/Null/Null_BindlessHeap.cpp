@@ -0,0 +1,77 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_BindlessHeap.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_CommandList.h"
+
+namespace Amethyst
+{
+	// Always supported, so that slots are handed out and written exactly as they would be on a GPU with descriptor indexing.
+	bool RHI_BindlessHeap::CreateResource()
+	{
+		m_IsSupported = true;
+
+		m_DescriptorSetLayout = NullUtility::Resource::Create(Null_Resource_Type::DescriptorSetLayout);
+		m_DescriptorPool = NullUtility::Resource::Create(Null_Resource_Type::DescriptorPool);
+		m_PipelineLayout = NullUtility::Resource::Create(Null_Resource_Type::PipelineLayout);
+
+		// Same as Vulkan, the set is allocated from the pool and is freed along with it.
+		m_DescriptorSet = NullUtility::Resource::Create(Null_Resource_Type::DescriptorSet);
+		NullUtility::Resource::Retrieve(m_DescriptorPool)->m_Children.emplace_back(m_DescriptorSet);
+
+		return true;
+	}
+
+	void RHI_BindlessHeap::DestroyResource()
+	{
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		NullUtility::Resource::Destroy(m_PipelineLayout);
+		NullUtility::Resource::Destroy(m_DescriptorPool);
+		NullUtility::Resource::Destroy(m_DescriptorSetLayout);
+		m_DescriptorSet = nullptr;
+	}
+
+	// Nothing to write, but the resources going into slots are checked like those going into pass sets.
+	inline void ValidateResource(const RHI_Device* rhi_Device, const RHI_Bindless_Type type, const uint32_t index, const void* resource)
+	{
+		if (rhi_Device->RetrieveContextRHI()->m_IsValidationEnabled && !NullUtility::Resource::IsAlive(resource))
+		{
+			AMETHYST_ERROR("Bindless slot %d of array %d refers to a destroyed resource.", index, static_cast<uint32_t>(type));
+		}
+	}
+
+	void RHI_BindlessHeap::UpdateTexture(const uint32_t index, RHI_Texture* texture)
+	{
+		ValidateResource(m_RHI_Device, RHI_Bindless_Type::Texture, index, texture->RetrieveResourceView(0));
+	}
+
+	void RHI_BindlessHeap::UpdateSampler(const uint32_t index, RHI_Sampler* sampler)
+	{
+		ValidateResource(m_RHI_Device, RHI_Bindless_Type::Sampler, index, sampler->RetrieveResource());
+	}
+
+	void RHI_BindlessHeap::UpdateStructuredBuffer(const uint32_t index, RHI_StructuredBuffer* structuredBuffer)
+	{
+		ValidateResource(m_RHI_Device, RHI_Bindless_Type::StructuredBuffer, index, structuredBuffer->RetrieveResource());
+	}
+
+	void RHI_BindlessHeap::Bind(RHI_CommandList* commandList, const bool isCompute) const
+	{
+		static_cast<Null_CommandStream*>(commandList->RetrieveCommandBuffer())->Record(
+			Null_Command_Type::BindDescriptorSet,
+			m_DescriptorSet,
+			isCompute ? 1 : 0,				  // Bind Point
+			g_RHI_DescriptorSetIndexBindless, // First Set
+			1,								  // Descriptor Set Count
+			0								  // Dynamic Offset Count
+		);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,892 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_VertexBuffer.h"
+#include "../RHI_IndexBuffer.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+#include "../RHI_PipelineCache.h"
+#include "../RHI_BindlessHeap.h"
+#include "../RHI_UploadHeap.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Fence.h"
+#include "../Rendering/Renderer.h"
+
+namespace Amethyst
+{
+	RHI_CommandList::RHI_CommandList(uint32_t index, RHI_SwapChain* swapchain, Context* context)
+	{
+		m_SwapChain = swapchain;
+		m_Renderer = context->RetrieveSubsystem<Renderer>();
+		// Profiler
+		m_RHI_Device = m_Renderer->RetrieveRHIDevice().get();
+		m_PipelineCache = m_Renderer->RetrievePipelineCache();
+		m_DescriptorSetLayoutCache = m_Renderer->RetrieveDescriptorLayoutCache();
+
+		RHI_Context* rhi_Context = m_RHI_Device->RetrieveContextRHI();
+
+		// Command Buffer - The stream the commands are recorded into.
+		m_CommandBuffer = new Null_CommandStream();
+
+		// Sync - Fence
+		m_ProcessedFence = std::make_shared<RHI_Fence>(m_RHI_Device, "Processed Command Buffer");
+
+		// Sync - Semaphore
+		m_ProcessedSemaphore = std::make_shared<RHI_Semaphore>(m_RHI_Device, false, "Processed Command Buffer");
+
+		// Query Pool - Only if profiler exists.
+	}
+
+	RHI_CommandList::RHI_CommandList(RHI_CommandList* primary, const uint32_t index)
+	{
+		m_Primary = primary;
+		m_SwapChain = primary->m_SwapChain;
+		m_Renderer = primary->m_Renderer;
+		m_RHI_Device = primary->m_RHI_Device;
+		m_PipelineCache = primary->m_PipelineCache;
+		m_DescriptorSetLayoutCache = primary->m_DescriptorSetLayoutCache;
+
+		// Command Pool
+		m_CommandPool = NullUtility::Resource::Create(Null_Resource_Type::CommandPool);
+
+		// Command Buffer - Executed by the primary, so it is never submitted and needs no fence or semaphore.
+		m_CommandBuffer = new Null_CommandStream();
+	}
+
+	RHI_CommandList::~RHI_CommandList()
+	{
+		RHI_Context* rhi_Context = m_RHI_Device->RetrieveContextRHI();
+
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Secondaries
+		m_SecondaryCommandLists.clear();
+
+		// Command Buffer
+		delete static_cast<Null_CommandStream*>(m_CommandBuffer);
+		m_CommandBuffer = nullptr;
+
+		// Command Pool
+		if (m_CommandPool)
+		{
+			NullUtility::Resource::Destroy(m_CommandPool);
+		}
+
+		// Query Pool
+		if (m_QueryPool) // - Swapchain
+		{
+			///=====
+		}
+	}
+
+	bool RHI_CommandList::BeginCommandBuffer()
+	{
+		// If the command buffer is in use, wait for it to be complete.
+		if (m_CommandListState == RHI_CommandListState::Submitted)
+		{
+			if (!WaitCommandBuffer())
+			{
+				AMETHYST_ERROR("Failed to wait for command buffer to complete.");
+				return false;
+			}
+		}
+
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Idle);
+
+		// Retrieve Queries
+		///=====
+
+		// Clears whatever was recorded last time. Secondaries record entirely within the render pass their primary has begun.
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Begin(m_RHI_Device->RetrieveContextRHI()->m_IsValidationEnabled, m_Primary != nullptr);
+
+		// Same as Vulkan, the bindless set is bound once per command buffer.
+		if (RHI_BindlessHeap* bindlessHeap = m_Renderer->RetrieveBindlessHeap())
+		{
+			bindlessHeap->Bind(this, false);
+
+			// Secondaries only ever draw.
+			if (!m_Primary)
+			{
+				bindlessHeap->Bind(this, true);
+			}
+		}
+
+		/// 
+
+		m_CommandListState = RHI_CommandListState::Recording;
+		m_IsCommandBufferFlushed = false;
+		m_SecondaryCommandListOffset = 0;
+		m_SecondaryCommandListCount = 0;
+
+		return true;
+	}
+
+	bool RHI_CommandList::EndCommandBuffer()
+	{
+		// Validate command buffer state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->End();
+
+		m_CommandListState = RHI_CommandListState::Ended;
+
+		return true;
+	}
+
+	bool RHI_CommandList::SubmitCommandBuffer()
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Ended);
+
+		// Ensure that the processed semaphore can be used.
+		AMETHYST_ASSERT(m_ProcessedSemaphore->RetrieveState() == RHI_Semaphore_State::Idle);
+
+		// Retrieve wait and signal semaphore.
+		RHI_Semaphore* waitSemaphore = nullptr;
+		RHI_Semaphore* signalSemaphore = nullptr;
+
+		if (m_Pipeline)
+		{
+			if (RHI_PipelineState* state = m_Pipeline->RetrievePipelineState())
+			{
+				if (state->m_RenderTargetSwapchain)
+				{
+					// If the swapchain is not presenting (e.g. minimized window), don't submit any work.
+					if (!state->m_RenderTargetSwapchain->IsPresentationEnabled())
+					{
+						m_CommandListState = RHI_CommandListState::Submitted;
+						return true;
+					}
+
+					// Queue submission should wait on this semaphore (image must have been acquired).
+					if (state->m_RenderTargetSwapchain->RetrieveImageAcquiredSemaphore()->RetrieveState() == RHI_Semaphore_State::Signaled)
+					{
+						waitSemaphore = state->m_RenderTargetSwapchain->RetrieveImageAcquiredSemaphore();
+					}
+
+					signalSemaphore = m_ProcessedSemaphore.get(); // Signal this semaphore once the command buffer has completed execution.
+				}
+			}
+		}
+
+		// Same as Vulkan, uploads recorded so far are submitted first.
+		if (RHI_UploadHeap* uploadHeap = m_Renderer->RetrieveUploadHeap())
+		{
+			uploadHeap->Flush();
+		}
+
+		m_ProcessedFence->Reset(); // Fence to signal once the command buffer completes execution.
+
+		if (!m_RHI_Device->Queue_Submit(
+			RHI_Queue_Type::RHI_Queue_Graphics, // Queue
+			0,									// Wait Flags - There are no pipeline stages to wait at.
+			m_CommandBuffer,					// Command Buffer
+			waitSemaphore,						// Wait Semaphore
+			signalSemaphore,					// Signal Semaphore
+			m_ProcessedFence.get()				// Signal Fence
+		))
+		{
+			AMETHYST_ERROR("Failed to submit the command buffer.");
+			return false;
+		}
+
+		m_CommandListState = RHI_CommandListState::Submitted;
+		return true;
+	}
+
+	bool RHI_CommandList::ResetCommandBuffer()
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		std::lock_guard<std::mutex> guard(m_MutexReset);
+
+		// The stream is cleared by the next BeginCommandBuffer(), which keeps the commands around for inspection until then.
+
+		m_CommandListState = RHI_CommandListState::Idle;
+
+		return true;
+	}
+
+	bool RHI_CommandList::BeginRenderPass(RHI_PipelineState& pipelineState)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		// Retrieve pipeline.
+		{
+			m_IsPipelineActive = false;
+
+			// Update the descriptor cache with the pipeline state.
+			m_DescriptorSetLayoutCache->SetPipelineState(pipelineState);
+
+			// Retrieve (or create) a pipeline which matches the pipeline state.
+			bool isCompiling = false;
+			m_Pipeline = m_PipelineCache->RetrievePipeline(this, pipelineState, m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout(), isCompiling);
+
+			if (!m_Pipeline)
+			{
+				// Passes whose pipeline is still compiling in the background are skipped until it's done.
+				if (!isCompiling)
+				{
+					AMETHYST_ERROR("Failed to acquire appropriate pipeline.");
+				}
+
+				return false;
+			}
+
+			// Keep a local pointer for convenience.
+			m_PipelineState = &pipelineState;
+		}
+
+		// Start marker and profiler (if used).
+		///
+
+		// Shader resources.
+		{
+			// If the pipeline changed, resources have to be reset again.
+			m_VertexBufferID = 0;
+			m_IndexBufferID = 0;
+
+			// Same as Vulkan, global resources have to be set again.
+			m_Renderer->SetGlobalSamplersAndConstantBuffers(this);
+		}
+
+		return true;
+	}
+
+	bool RHI_CommandList::EndRenderPass()
+	{
+		// Render Pass
+		if (m_IsRenderPassActive)
+		{
+			static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::EndRenderPass);
+			m_IsRenderPassActive = false;
+		}
+
+		// Profiling
+		///
+
+		return true;
+	}
+
+	bool RHI_CommandList::BeginSecondaryCommandLists(const uint32_t count)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary && m_SecondaryCommandListCount == 0);
+
+		// Only graphics passes which haven't drawn anything yet can be split up.
+		if (count == 0 || !m_Pipeline || m_PipelineState->IsComputePipeline() || m_IsRenderPassActive || m_IsCommandBufferFlushed)
+		{
+			return false;
+		}
+
+		// Same as Vulkan, the descriptor set is resolved up front and bound by every secondary.
+		RHI_DescriptorSet* descriptorSet = nullptr;
+		m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout()->NeedsToBind();
+		if (!m_DescriptorSetLayoutCache->RetrieveDescriptorSet(descriptorSet) || !descriptorSet)
+		{
+			return false;
+		}
+
+		// Same as Vulkan, the secondaries are readied before the render pass begins, so that the pass can still be recorded inline if any of them fails.
+		const uint32_t offset = m_SecondaryCommandListOffset + m_SecondaryCommandListCount;
+		for (uint32_t i = offset; i < offset + count; i++)
+		{
+			if (i == m_SecondaryCommandLists.size())
+			{
+				m_SecondaryCommandLists.emplace_back(std::make_shared<RHI_CommandList>(this, i));
+			}
+
+			RHI_CommandList* secondary = m_SecondaryCommandLists[i].get();
+			secondary->m_Pipeline = m_Pipeline;
+			secondary->m_PipelineState = m_PipelineState;
+			secondary->m_IsPipelineActive = false;
+			secondary->m_VertexBufferID = 0;
+			secondary->m_IndexBufferID = 0;
+
+			if (!secondary->BeginCommandBuffer() || !secondary->Deferred_BindPipeline())
+			{
+				AbortSecondaryCommandLists(offset, i + 1);
+				return false;
+			}
+
+			secondary->BindDescriptorSet(descriptorSet);
+			secondary->m_IsRenderPassActive = true;
+		}
+
+		if (!Deferred_BeginRenderPass(true))
+		{
+			AMETHYST_ERROR("Failed to begin render pass.");
+			AbortSecondaryCommandLists(offset, offset + count);
+			return false;
+		}
+
+		m_SecondaryCommandListOffset = offset;
+		m_SecondaryCommandListCount = count;
+
+		return true;
+	}
+
+	void RHI_CommandList::AbortSecondaryCommandLists(const uint32_t begin, const uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			RHI_CommandList* secondary = m_SecondaryCommandLists[i].get();
+			secondary->m_IsRenderPassActive = false;
+
+			if (secondary->m_CommandListState == RHI_CommandListState::Recording)
+			{
+				secondary->EndCommandBuffer();
+			}
+
+			secondary->m_CommandListState = RHI_CommandListState::Idle;
+		}
+	}
+
+	RHI_CommandList* RHI_CommandList::RetrieveSecondaryCommandList(const uint32_t index) const
+	{
+		AMETHYST_ASSERT(index < m_SecondaryCommandListCount);
+		return m_SecondaryCommandLists[m_SecondaryCommandListOffset + index].get();
+	}
+
+	bool RHI_CommandList::ExecuteSecondaryCommandLists()
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(m_IsRenderPassActive);
+
+		std::vector<const Null_CommandStream*> commandStreams;
+		commandStreams.reserve(m_SecondaryCommandListCount);
+
+		for (uint32_t i = 0; i < m_SecondaryCommandListCount; i++)
+		{
+			RHI_CommandList* secondary = RetrieveSecondaryCommandList(i);
+			secondary->m_IsRenderPassActive = false;
+
+			if (!secondary->EndCommandBuffer())
+			{
+				return false;
+			}
+
+			// It's safe to record again once the primary has begun again.
+			secondary->m_CommandListState = RHI_CommandListState::Idle;
+			commandStreams.push_back(static_cast<const Null_CommandStream*>(secondary->m_CommandBuffer));
+		}
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Execute(commandStreams);
+
+		return true;
+	}
+
+	bool RHI_CommandList::OnDraw()
+	{
+		if (m_IsCommandBufferFlushed)
+		{
+			return false;
+		}
+
+		// Secondaries were handed the render pass, pipeline and descriptor set by their primary.
+		if (m_Primary)
+		{
+			return true;
+		}
+
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		// Begin render pass.
+		if (!m_IsRenderPassActive && !m_PipelineState->IsComputePipeline())
+		{
+			if (!Deferred_BeginRenderPass())
+			{
+				AMETHYST_ERROR("Failed to begin render pass.");
+				return false;
+			}
+		}
+
+		// Set pipeline.
+		if (!m_IsPipelineActive)
+		{
+			if (!Deferred_BindPipeline())
+			{
+				AMETHYST_ERROR("Failed to begin render pass.");
+				return false;
+			}
+		}
+
+		// Bind descriptor set.
+		return Deferred_BindDescriptorSet();
+	}
+
+	bool RHI_CommandList::Draw(const uint32_t vertexCount)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		if (!OnDraw()) // Begins Deferred Render Pass, Binds Deferred Pipeline and Binds Deferred Descriptor Set.
+		{
+			return false;
+		}
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(
+			Null_Command_Type::Draw,
+			nullptr,
+			vertexCount, // Vertex Count
+			1,			 // Instance Count
+			0,			 // First Vertex
+			0			 // First Instance
+		);
+
+		/// Profiling.
+
+		return true;
+	}
+
+	bool RHI_CommandList::DrawIndexed(const uint32_t indexCount, const uint32_t indexOffset, const uint32_t vertexOffset, const uint32_t instanceCount, const uint32_t instanceOffset)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		// Ensure correct state before attempting to draw.
+
+		if (!OnDraw()) // Begins Deferred Render Pass, Binds Deferred Pipeline and Binds Deferred Descriptor Set.
+		{
+			return false;
+		}
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(
+			Null_Command_Type::DrawIndexed,
+			nullptr,
+			indexCount,	   // Index Count
+			instanceCount, // Instance Count
+			indexOffset,   // First Index
+			vertexOffset,  // Vertex Offset
+			instanceOffset // First Instance
+		);
+
+		/// Profiling.
+
+		return true;
+	}
+
+	void RHI_CommandList::ClearPipelineStateRenderTargets(RHI_PipelineState& pipelineState)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		if (m_IsRenderPassActive)
+		{
+			uint32_t attachmentCount = 0;
+
+			for (uint8_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
+			{
+				if (m_PipelineState->m_RenderTargetColorTextures[i] && pipelineState.m_ClearValuesColor[i] != g_RHI_ColorLoadValue)
+				{
+					attachmentCount++;
+				}
+			}
+
+			if (pipelineState.m_ClearValueDepth != g_RHI_DepthLoadValue || pipelineState.m_ClearValueStencil != g_RHI_StencilLoadValue)
+			{
+				attachmentCount++;
+			}
+
+			static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::ClearAttachments, nullptr, attachmentCount, pipelineState.RetrieveRenderTargetWidth(), pipelineState.RetrieveRenderTargetHeight());
+		}
+
+		else if (BeginRenderPass(pipelineState))
+		{
+			OnDraw(); // Start render pass.
+			EndRenderPass(); // End render pass.
+		}
+	}
+
+	void RHI_CommandList::ClearRenderTarget(
+		RHI_Texture* texture,
+		const uint32_t colorIndex			/*= 0*/,
+		const uint32_t depthStencilIndex	/*= 0*/,
+		const bool storage					/*= false*/,
+		const Math::Vector4& clearColor		/*= g_RHI_ColorLoadValue*/,
+		const float clearDepth				/*= g_RHI_DepthLoadValue*/,
+		const uint32_t clearStencil			/*= g_RHI_StencilLoadValue*/
+	)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		if (m_IsRenderPassActive)
+		{
+			AMETHYST_ERROR("This must be only be called outside of a render pass instance.");
+			return;
+		}
+
+		if (!texture || !texture->RetrieveResourceView())
+		{
+			AMETHYST_ERROR("Texture is null.");
+			return;
+		}
+
+		// One of the required layouts for clear functions.
+		texture->SetLayout(RHI_Image_Layout::Transfer_Destination_Optimal, this);
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::ClearImage, texture->RetrieveResource(), colorIndex, depthStencilIndex);
+	}
+
+	bool RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z, bool async /*= false*/)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		// Ensure correct state before attempting to draw.
+		if (!OnDraw())
+		{
+			return false;
+		}
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::Dispatch, nullptr, x, y, z);
+		///Profiler.
+
+		return true;
+	}
+
+	void RHI_CommandList::InsertBarriers(const std::vector<RHI_ImageBarrier>& barriers)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		for (const RHI_ImageBarrier& barrier : barriers)
+		{
+			RHI_Texture* texture = barrier.m_Texture;
+			const RHI_Image_Layout oldLayout = barrier.m_DiscardContents ? RHI_Image_Layout::Undefined : texture->RetrieveLayout();
+			if (!barrier.m_DiscardContents && oldLayout == barrier.m_Layout)
+			{
+				continue;
+			}
+
+			static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::ImageBarrier, texture->RetrieveResource(), static_cast<uint32_t>(oldLayout), static_cast<uint32_t>(barrier.m_Layout));
+			texture->SetLayout(barrier.m_Layout);
+		}
+	}
+
+	//=========================
+
+	void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(
+			Null_Command_Type::SetViewport,
+			nullptr,
+			0,										 // First Viewport
+			1,										 // Viewport Count
+			static_cast<uint32_t>(viewport.m_Width), // Width
+			static_cast<uint32_t>(viewport.m_Height) // Height
+		);
+	}
+
+	void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissorRectangle) const
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(
+			Null_Command_Type::SetScissor,
+			nullptr,
+			0,												 // First Scissor
+			1,												 // Scissor Count
+			static_cast<uint32_t>(scissorRectangle.Width()), // Width
+			static_cast<uint32_t>(scissorRectangle.Height()) // Height
+		);
+	}
+
+	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer, const uint64_t offset /*= 0*/)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		if (m_VertexBufferID == buffer->RetrieveObjectID() && m_VertexBufferOffset == offset)
+		{
+			return;
+		}
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::BindVertexBuffer, buffer->RetrieveResource(), 0, 1, static_cast<uint32_t>(offset));
+
+		/// Profiler
+		m_VertexBufferID = buffer->RetrieveObjectID();
+		m_VertexBufferOffset = offset;
+	}
+
+	void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer, const uint64_t offset /*= 0*/)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		if (m_IndexBufferID == buffer->RetrieveObjectID() && m_IndexBufferOffset == offset)
+		{
+			return;
+		}
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::BindIndexBuffer, buffer->RetrieveResource(), static_cast<uint32_t>(offset), buffer->Is16Bit() ? 16 : 32);
+
+		/// Profiler
+		m_IndexBufferID = buffer->RetrieveObjectID();
+		m_IndexBufferOffset = offset;
+	}
+
+	bool RHI_CommandList::SetConstantBuffer(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constantBuffer) const
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
+
+		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
+		{
+			AMETHYST_WARNING("Descriptor layout not set, try setting constant buffer \"%s\" within a render pass.", constantBuffer->RetrieveObjectName().c_str());
+			return false;
+		}
+
+		// Set ( will only happen if it's not already set.
+		return m_DescriptorSetLayoutCache->SetConstantBuffer(slot, constantBuffer);
+	}
+
+	bool RHI_CommandList::SetStructuredBuffer(const uint32_t slot, const uint8_t scope, RHI_StructuredBuffer* structuredBuffer) const
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
+
+		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
+		{
+			AMETHYST_WARNING("Descriptor layout not set, try setting structured buffer \"%s\" within a render pass.", structuredBuffer->RetrieveObjectName().c_str());
+			return false;
+		}
+
+		// Set (will only happen if it's not already set).
+		return m_DescriptorSetLayoutCache->SetStructuredBuffer(slot, structuredBuffer);
+	}
+
+	void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
+
+		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
+		{
+			AMETHYST_WARNING("Descriptor layout not set, try setting sampler \"%s\" within a render pass.", sampler->RetrieveObjectName().c_str());
+			return;
+		}
+
+		// Set (will only happen if it's not already set).
+		m_DescriptorSetLayoutCache->SetSampler(slot, sampler);
+	}
+
+	void RHI_CommandList::SetTexture(const uint32_t slot, RHI_Texture* texture, const bool storage /*= false*/)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
+
+		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
+		{
+			AMETHYST_WARNING("Descriptor layout not set, trying setting texture \"%s\" within a render pass.", texture->RetrieveObjectName().c_str());
+			return;
+		}
+
+		// Null textures are not allowed, and gets replaced with a black texture here.
+		if (!texture || !texture->RetrieveResourceView())
+		{
+			texture = m_Renderer->RetrieveDefaultTextureTransparent();
+		}
+
+		// Same as Vulkan, textures stand in with white until they are resident.
+		if (!texture->IsResident())
+		{
+			texture = m_Renderer->RetrieveDefaultTextureWhite();
+		}
+
+		// If the image has an invalid layout (can happen for a few frames during staging), replace with black texture.
+		if (texture->RetrieveLayout() == RHI_Image_Layout::Undefined || texture->RetrieveLayout() == RHI_Image_Layout::Preinitialized)
+		{
+			AMETHYST_WARNING("Can't set texture without a layout.");
+			texture = m_Renderer->RetrieveDefaultTextureTransparent();
+		}
+
+		// Transition to appropriate layout if needed.
+		{
+			RHI_Image_Layout targetLayout = RHI_Image_Layout::Undefined;
+
+			if (storage)
+			{
+				if (!texture->IsStorage())
+				{
+					AMETHYST_ERROR("Texture %s doesn't support storage.", texture->RetrieveObjectName().c_str());
+				}
+				else
+				{
+					// According to Section 13.1 of the Vulkan specification, storage textures have to be in a general layout. See: https://www.khronos.org/registry/vulkan/specs/1.1-extensions/html/vkspec.html#descriptorsets-storageimage
+					if (texture->RetrieveLayout() != RHI_Image_Layout::General)
+					{
+						targetLayout = RHI_Image_Layout::General;
+					}
+				}
+			}
+			else
+			{
+				// Color
+				if (texture->IsColorFormat() && texture->RetrieveLayout() != RHI_Image_Layout::Shader_Read_Only_Optimal)
+				{
+					targetLayout = RHI_Image_Layout::Shader_Read_Only_Optimal;
+				}
+
+				// Depth
+				if (texture->IsDepthFormat() && texture->RetrieveLayout() != RHI_Image_Layout::Depth_Stencil_Read_Only_Optimal)
+				{
+					targetLayout = RHI_Image_Layout::Depth_Stencil_Read_Only_Optimal;
+				}
+			}
+
+			bool transitionRequired = targetLayout != RHI_Image_Layout::Undefined;
+
+			// Transition
+			if (transitionRequired && !m_IsRenderPassActive)
+			{
+				texture->SetLayout(targetLayout, this);
+			}
+			else if (transitionRequired && m_IsRenderPassActive)
+			{
+				AMETHYST_WARNING("Can't transition texture to target layout while a render pass is active.");
+				texture = m_Renderer->RetrieveDefaultTextureTransparent();
+			}
+		}
+
+		// Set (will only happen if it's not already set).
+		m_DescriptorSetLayoutCache->SetTexture(slot, texture, storage);
+	}
+
+	// Retrieve GPU memory used.
+
+	// Timestamp start.
+
+	// Timestamp end.
+
+	// Timestamp duration.
+
+	// GPU Query Create
+
+	// GPU Querty Release
+
+	// Timeblock start.
+
+	// Timeblock end.
+
+	void RHI_CommandList::ResetDescriptorCache()
+	{
+		if (m_DescriptorSetLayoutCache)
+		{
+			m_DescriptorSetLayoutCache->ResetDescriptorCache();
+		}
+	}
+
+	bool RHI_CommandList::Deferred_BeginRenderPass(const bool isRecordedBySecondaries /*= false*/)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		// Retrieve pipeline state.
+		RHI_PipelineState* pipelineState = m_Pipeline->RetrievePipelineState();
+
+		// Validate pipeline state.
+		AMETHYST_ASSERT(pipelineState != nullptr);
+		AMETHYST_ASSERT(pipelineState->RetrieveRenderPass() != nullptr);
+		AMETHYST_ASSERT(pipelineState->RetrieveFramebuffer() != nullptr);
+
+		// The framebuffer is what the pass draws into, so it's the resource validation checks.
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(
+			Null_Command_Type::BeginRenderPass,
+			pipelineState->RetrieveFramebuffer(),
+			pipelineState->RetrieveRenderTargetWidth(),
+			pipelineState->RetrieveRenderTargetHeight(),
+			isRecordedBySecondaries ? 1 : 0
+		);
+
+		m_IsRenderPassActive = true;
+
+		return true;
+	}
+
+	bool RHI_CommandList::Deferred_BindDescriptorSet()
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+
+		// Descriptor Set != null, Result = true -> A descriptor set must be bound.
+		// Descriptor Set == null, Result = true -> A descriptor set is already bound.
+		// Descriptor Set == null, Result = false -> A new descriptor was needed but we are out of memory (allocates next frame).
+
+		RHI_DescriptorSet* descriptorSet = nullptr;
+		bool result = m_DescriptorSetLayoutCache->RetrieveDescriptorSet(descriptorSet);
+
+		if (result && descriptorSet != nullptr)
+		{
+			BindDescriptorSet(descriptorSet);
+		}
+
+		return result;
+	}
+
+	void RHI_CommandList::BindDescriptorSet(RHI_DescriptorSet* descriptorSet)
+	{
+		// Dynamic Offsets
+		RHI_DescriptorSetLayout* descriptorSetLayout = m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout();
+		uint32_t dynamicOffsetCount = descriptorSetLayout->RetrieveDynamicOffsetCount();
+
+		// Validate descriptor sets.
+		std::array<void*, 1> descriptorSets = { descriptorSet->RetrieveResource() };
+		for (uint32_t i = 0; i < static_cast<uint32_t>(descriptorSets.size()); i++)
+		{
+			AMETHYST_ASSERT(descriptorSets[i] != nullptr);
+		}
+
+		static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(
+			Null_Command_Type::BindDescriptorSet,
+			descriptorSets[0],
+			m_PipelineState->IsComputePipeline() ? 1 : 0, // Bind Point
+			g_RHI_DescriptorSetIndexPass,				  // First Set
+			static_cast<uint32_t>(descriptorSets.size()), // Descriptor Set Count
+			dynamicOffsetCount							  // Dynamic Offset Count
+		);
+
+		/// Profiler.
+	}
+	
+	bool RHI_CommandList::Deferred_BindPipeline()
+	{
+		if (void* pipeline = m_Pipeline->RetrievePipeline())
+		{
+			static_cast<Null_CommandStream*>(m_CommandBuffer)->Record(Null_Command_Type::BindPipeline, pipeline, m_PipelineState->IsComputePipeline() ? 1 : 0);
+			/// Profiler
+			m_IsPipelineActive = true;
+		}
+		else
+		{
+			AMETHYST_ERROR("Invalid pipeline.");
+			return false;
+		}
+
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include "Amethyst.h"
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+
+namespace Amethyst
+{
+	Null_CommandStatistics& Null_CommandStatistics::operator+=(const Null_CommandStatistics& other)
+	{
+		m_CommandCount += other.m_CommandCount;
+		m_RenderPassCount += other.m_RenderPassCount;
+		m_DrawCount += other.m_DrawCount;
+		m_DispatchCount += other.m_DispatchCount;
+		m_InstanceCount += other.m_InstanceCount;
+		m_VertexCount += other.m_VertexCount;
+		m_PipelineBindCount += other.m_PipelineBindCount;
+		m_DescriptorSetBindCount += other.m_DescriptorSetBindCount;
+		m_VertexBufferBindCount += other.m_VertexBufferBindCount;
+		m_IndexBufferBindCount += other.m_IndexBufferBindCount;
+		m_DynamicStateCount += other.m_DynamicStateCount;
+		m_ClearCount += other.m_ClearCount;
+		m_BarrierCount += other.m_BarrierCount;
+		m_CopyCount += other.m_CopyCount;
+		m_ValidationErrorCount += other.m_ValidationErrorCount;
+
+		return *this;
+	}
+
+	void Null_CommandStream::Begin(const bool isValidationEnabled, const bool isRenderPassContinued /*= false*/)
+	{
+		m_Commands.clear();
+		m_CommandCounts.fill(0);
+		m_Statistics = Null_CommandStatistics();
+
+		m_IsValidationEnabled = isValidationEnabled;
+		m_IsRecording = true;
+		m_IsRenderPassActive = isRenderPassContinued;
+		m_IsRenderPassContinued = isRenderPassContinued;
+		m_IsRenderPassRecordedBySecondaries = false;
+		m_IsPipelineBound = false;
+		m_IsVertexBufferBound = false;
+		m_IsIndexBufferBound = false;
+	}
+
+	void Null_CommandStream::End()
+	{
+		if (m_IsValidationEnabled && m_IsRenderPassActive && !m_IsRenderPassContinued)
+		{
+			ReportValidationError(Null_Command(), "Recording ended inside a render pass.");
+		}
+
+		m_IsRecording = false;
+	}
+
+	void Null_CommandStream::Record(const Null_Command_Type type, const void* resource /*= nullptr*/, const uint32_t argument0 /*= 0*/, const uint32_t argument1 /*= 0*/, const uint32_t argument2 /*= 0*/, const uint32_t argument3 /*= 0*/, const uint32_t argument4 /*= 0*/)
+	{
+		Null_Command& command = m_Commands.emplace_back();
+		command.m_Type = type;
+		command.m_Resource = resource;
+		command.m_Arguments = { argument0, argument1, argument2, argument3, argument4 };
+
+		if (m_IsValidationEnabled)
+		{
+			Validate(command);
+		}
+
+		m_CommandCounts[static_cast<uint32_t>(type)]++;
+		m_Statistics.m_CommandCount++;
+
+		switch (type)
+		{
+			case Null_Command_Type::BeginRenderPass: // Framebuffer, Width, Height, Recorded By Secondaries
+				m_Statistics.m_RenderPassCount++;
+				m_IsRenderPassActive = true;
+				m_IsRenderPassRecordedBySecondaries = argument2 != 0;
+				break;
+
+			case Null_Command_Type::EndRenderPass:
+				m_IsRenderPassActive = false;
+				break;
+
+			case Null_Command_Type::BindPipeline:
+				m_Statistics.m_PipelineBindCount++;
+				m_IsPipelineBound = true;
+				break;
+
+			case Null_Command_Type::BindDescriptorSet:
+				m_Statistics.m_DescriptorSetBindCount++;
+				break;
+
+			case Null_Command_Type::BindVertexBuffer:
+				m_Statistics.m_VertexBufferBindCount++;
+				m_IsVertexBufferBound = true;
+				break;
+
+			case Null_Command_Type::BindIndexBuffer:
+				m_Statistics.m_IndexBufferBindCount++;
+				m_IsIndexBufferBound = true;
+				break;
+
+			case Null_Command_Type::SetViewport:
+			case Null_Command_Type::SetScissor:
+				m_Statistics.m_DynamicStateCount++;
+				break;
+
+			case Null_Command_Type::ClearAttachments:
+			case Null_Command_Type::ClearImage:
+				m_Statistics.m_ClearCount++;
+				break;
+
+			case Null_Command_Type::ImageBarrier:
+				m_Statistics.m_BarrierCount++;
+				break;
+
+			case Null_Command_Type::CopyBuffer:		   // Destination Buffer, Source Offset, Size
+			case Null_Command_Type::CopyBufferToImage: // Destination Image, Region Count
+				m_Statistics.m_CopyCount++;
+				break;
+
+			case Null_Command_Type::Draw:		 // Vertex Count, Instance Count, First Vertex, First Instance
+			case Null_Command_Type::DrawIndexed: // Index Count, Instance Count, First Index, Vertex Offset, First Instance
+				m_Statistics.m_DrawCount++;
+				m_Statistics.m_VertexCount += argument0;
+				m_Statistics.m_InstanceCount += argument1;
+				break;
+
+			case Null_Command_Type::Dispatch:
+				m_Statistics.m_DispatchCount++;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	void Null_CommandStream::Execute(const std::vector<const Null_CommandStream*>& secondaries)
+	{
+		Record(Null_Command_Type::ExecuteCommands, nullptr, static_cast<uint32_t>(secondaries.size()));
+
+		for (const Null_CommandStream* secondary : secondaries)
+		{
+			if (m_IsValidationEnabled && secondary->IsRecording())
+			{
+				ReportValidationError(m_Commands.back(), "Executed a secondary command buffer which is still recording.");
+			}
+
+			m_Statistics += secondary->RetrieveStatistics();
+		}
+	}
+
+	void Null_CommandStream::Validate(const Null_Command& command)
+	{
+		if (!m_IsRecording)
+		{
+			ReportValidationError(command, "Recorded outside of BeginCommandBuffer/EndCommandBuffer.");
+		}
+
+		// Handles have to be alive when they are recorded. Dynamic state and draws don't take any.
+		const bool takesResource = command.m_Type != Null_Command_Type::EndRenderPass && command.m_Type != Null_Command_Type::SetViewport && command.m_Type != Null_Command_Type::SetScissor &&
+								   command.m_Type != Null_Command_Type::ClearAttachments && command.m_Type != Null_Command_Type::Draw && command.m_Type != Null_Command_Type::DrawIndexed &&
+								   command.m_Type != Null_Command_Type::Dispatch && command.m_Type != Null_Command_Type::ExecuteCommands;
+		if (takesResource && !NullUtility::Resource::IsAlive(command.m_Resource))
+		{
+			ReportValidationError(command, command.m_Resource ? "Uses a destroyed resource." : "Uses a null resource.");
+		}
+
+		switch (command.m_Type)
+		{
+			case Null_Command_Type::BeginRenderPass:
+				if (m_IsRenderPassActive)
+				{
+					ReportValidationError(command, "Render passes can't be nested.");
+				}
+				break;
+
+			case Null_Command_Type::EndRenderPass:
+				if (!m_IsRenderPassActive)
+				{
+					ReportValidationError(command, "No render pass is active.");
+				}
+				break;
+
+			case Null_Command_Type::ClearAttachments:
+				if (!m_IsRenderPassActive)
+				{
+					ReportValidationError(command, "Attachments can only be cleared inside a render pass.");
+				}
+
+				if (m_IsRenderPassRecordedBySecondaries)
+				{
+					ReportValidationError(command, "Render passes recorded by secondaries can only execute them.");
+				}
+				break;
+
+			case Null_Command_Type::ExecuteCommands:
+				if (!m_IsRenderPassActive || !m_IsRenderPassRecordedBySecondaries)
+				{
+					ReportValidationError(command, "Secondaries can only be executed inside a render pass begun for them.");
+				}
+				break;
+
+			case Null_Command_Type::ClearImage:
+			case Null_Command_Type::ImageBarrier:
+			case Null_Command_Type::CopyBuffer:
+			case Null_Command_Type::CopyBufferToImage:
+				if (m_IsRenderPassActive)
+				{
+					ReportValidationError(command, "Not allowed inside a render pass.");
+				}
+				break;
+
+			case Null_Command_Type::Dispatch:
+				if (m_IsRenderPassActive)
+				{
+					ReportValidationError(command, "Dispatches are not allowed inside a render pass.");
+				}
+
+				if (!m_IsPipelineBound)
+				{
+					ReportValidationError(command, "Dispatches need a bound pipeline.");
+				}
+				break;
+
+			case Null_Command_Type::Draw:
+			case Null_Command_Type::DrawIndexed:
+				if (!m_IsRenderPassActive)
+				{
+					ReportValidationError(command, "Draws need an active render pass.");
+				}
+
+				if (m_IsRenderPassRecordedBySecondaries)
+				{
+					ReportValidationError(command, "Render passes recorded by secondaries can only execute them.");
+				}
+
+				if (!m_IsPipelineBound)
+				{
+					ReportValidationError(command, "Draws need a bound pipeline.");
+				}
+
+				if (command.m_Type == Null_Command_Type::DrawIndexed && (!m_IsVertexBufferBound || !m_IsIndexBufferBound))
+				{
+					ReportValidationError(command, "Indexed draws need bound vertex and index buffers.");
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	void Null_CommandStream::ReportValidationError(const Null_Command& command, const char* message)
+	{
+		m_Statistics.m_ValidationErrorCount++;
+		AMETHYST_ERROR("Validation failed for command %d (%s): %s", static_cast<uint32_t>(m_Commands.size()) - 1, NullCommandTypeToString(command.m_Type), message);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace Amethyst
+{
+	// One for every Vulkan command the null backend stands in for.
+	enum class Null_Command_Type : uint8_t
+	{
+		BeginRenderPass,
+		EndRenderPass,
+		BindPipeline,
+		BindDescriptorSet,
+		BindVertexBuffer,
+		BindIndexBuffer,
+		SetViewport,
+		SetScissor,
+		ClearAttachments,
+		ClearImage,
+		ImageBarrier,
+		CopyBuffer,
+		CopyBufferToImage,
+		Draw,
+		DrawIndexed,
+		Dispatch,
+		ExecuteCommands,
+		Count
+	};
+
+	inline const char* NullCommandTypeToString(const Null_Command_Type type)
+	{
+		switch (type)
+		{
+			case Null_Command_Type::BeginRenderPass:   return "BeginRenderPass";
+			case Null_Command_Type::EndRenderPass:	   return "EndRenderPass";
+			case Null_Command_Type::BindPipeline:	   return "BindPipeline";
+			case Null_Command_Type::BindDescriptorSet: return "BindDescriptorSet";
+			case Null_Command_Type::BindVertexBuffer:  return "BindVertexBuffer";
+			case Null_Command_Type::BindIndexBuffer:   return "BindIndexBuffer";
+			case Null_Command_Type::SetViewport:	   return "SetViewport";
+			case Null_Command_Type::SetScissor:		   return "SetScissor";
+			case Null_Command_Type::ClearAttachments:  return "ClearAttachments";
+			case Null_Command_Type::ClearImage:		   return "ClearImage";
+			case Null_Command_Type::ImageBarrier:	   return "ImageBarrier";
+			case Null_Command_Type::CopyBuffer:		   return "CopyBuffer";
+			case Null_Command_Type::CopyBufferToImage: return "CopyBufferToImage";
+			case Null_Command_Type::Draw:			   return "Draw";
+			case Null_Command_Type::DrawIndexed:	   return "DrawIndexed";
+			case Null_Command_Type::Dispatch:		   return "Dispatch";
+			case Null_Command_Type::ExecuteCommands:   return "ExecuteCommands";
+			default:								   return "Unknown";
+		}
+	}
+
+	struct Null_Command
+	{
+		Null_Command_Type m_Type = Null_Command_Type::Count;
+		const void* m_Resource = nullptr;			// The render pass, pipeline, descriptor set, buffer or image the command uses.
+		std::array<uint32_t, 5> m_Arguments = {};	// Counts, offsets and sizes, in the order the matching Vulkan command takes them.
+	};
+
+	struct Null_CommandStatistics
+	{
+		uint32_t m_CommandCount = 0;
+		uint32_t m_RenderPassCount = 0;
+		uint32_t m_DrawCount = 0;			   // Indexed or not.
+		uint32_t m_DispatchCount = 0;
+		uint64_t m_InstanceCount = 0;
+		uint64_t m_VertexCount = 0;			   // Indices, for indexed draws.
+		uint32_t m_PipelineBindCount = 0;
+		uint32_t m_DescriptorSetBindCount = 0;
+		uint32_t m_VertexBufferBindCount = 0;
+		uint32_t m_IndexBufferBindCount = 0;
+		uint32_t m_DynamicStateCount = 0;	   // Viewports and scissors.
+		uint32_t m_ClearCount = 0;
+		uint32_t m_BarrierCount = 0;
+		uint32_t m_CopyCount = 0;			   // Uploads, into buffers or images.
+		uint32_t m_ValidationErrorCount = 0;
+
+		// Everything that changes what the next draw sees, which is what the renderer's sorting and caching try to keep down.
+		uint32_t RetrieveStateChangeCount() const { return m_PipelineBindCount + m_DescriptorSetBindCount + m_VertexBufferBindCount + m_IndexBufferBindCount + m_DynamicStateCount; }
+
+		Null_CommandStatistics& operator+=(const Null_CommandStatistics& other);
+	};
+
+	/*
+		What a command buffer is to the null backend. Commands are appended as the command list records them, with the same arguments the Vulkan backend
+		would pass on, and the stream is cleared whenever recording begins again. Since the command list filters redundant state exactly as it does under
+		Vulkan, the counts here are the ones a GPU would have seen.
+
+		With validation enabled, every command is also checked against the rules Vulkan would enforce (draws inside render passes with a pipeline bound,
+		no transfers or barriers inside render passes, no resources used after they were destroyed and so on). Failures are logged and counted.
+
+		Streams of secondary command lists begin inside the render pass of their primary. Executing them adds their counts to the primary's.
+	*/
+	class Null_CommandStream
+	{
+	public:
+		Null_CommandStream() = default;
+		~Null_CommandStream() = default;
+
+		void Begin(const bool isValidationEnabled, const bool isRenderPassContinued = false);
+		void End();
+		void Record(const Null_Command_Type type, const void* resource = nullptr, const uint32_t argument0 = 0, const uint32_t argument1 = 0, const uint32_t argument2 = 0, const uint32_t argument3 = 0, const uint32_t argument4 = 0);
+		void Execute(const std::vector<const Null_CommandStream*>& secondaries);
+
+		const std::vector<Null_Command>& RetrieveCommands() const { return m_Commands; }
+		const Null_CommandStatistics& RetrieveStatistics() const { return m_Statistics; }
+		uint32_t RetrieveCommandCount(const Null_Command_Type type) const { return m_CommandCounts[static_cast<uint32_t>(type)]; }
+		bool IsRecording() const { return m_IsRecording; }
+
+	private:
+		void Validate(const Null_Command& command);
+		void ReportValidationError(const Null_Command& command, const char* message);
+
+	private:
+		std::vector<Null_Command> m_Commands; // Keeps its capacity between recordings.
+		std::array<uint32_t, static_cast<uint32_t>(Null_Command_Type::Count)> m_CommandCounts = {};
+		Null_CommandStatistics m_Statistics;
+
+		// Validation
+		bool m_IsValidationEnabled = false;
+		bool m_IsRecording = false;
+		bool m_IsRenderPassActive = false;
+		bool m_IsRenderPassContinued = false;		 // Secondaries, which record within their primary's render pass.
+		bool m_IsRenderPassRecordedBySecondaries = false; // Its draws have to come from secondaries.
+		bool m_IsPipelineBound = false;
+		bool m_IsVertexBufferBound = false;
+		bool m_IsIndexBufferBound = false;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_Device.h"
+#include "../RHI_CommandList.h"
+#include "../../Profiling/MemoryTracker.h"
+
+namespace Amethyst
+{
+	void RHI_ConstantBuffer::_Destroy()
+	{
+		// Nothing to wait for if the buffer was never created.
+		if (!m_Buffer)
+		{
+			return;
+		}
+
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Unmap
+		m_MappedMemory = nullptr;
+
+		// Destroy
+		NullUtility::Resource::Destroy(m_Buffer);
+		m_BufferAllocation = nullptr;
+		MemoryTracker::Untrack(this);
+	}
+
+	RHI_ConstantBuffer::RHI_ConstantBuffer(const std::shared_ptr<RHI_Device>& rhi_Device, const std::string& name, bool isDynamic /*= false*/)
+	{
+		m_RHI_Device = rhi_Device;
+		m_Name = name;
+		m_IsDynamic = isDynamic;
+	}
+
+	bool RHI_ConstantBuffer::_Create()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		// Destroy previous buffer.
+		_Destroy();
+
+		// Align to the largest minUniformBufferOffsetAlignment desktop drivers report, so that offsets and sizes match what a GPU would see.
+		const size_t minimumUBOAlignment = 256;
+		m_Stride = static_cast<uint32_t>((m_Stride + minimumUBOAlignment - 1) & ~(minimumUBOAlignment - 1));
+		m_Size_GPU = m_OffsetCount * m_Stride;
+
+		// Create Buffer
+		m_Buffer = NullUtility::Resource::Create(Null_Resource_Type::Buffer, m_Size_GPU);
+		m_BufferAllocation = m_Buffer; // The buffer is its own allocation.
+
+		// Memory Accounting
+		MemoryTracker::Track(this, MemoryCategory::ConstantBuffer);
+
+		return true;
+	}
+
+	void* RHI_ConstantBuffer::Map()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation.");
+			return nullptr;
+		}
+
+		if (!m_MappedMemory) // Let's map it.
+		{
+			m_MappedMemory = NullUtility::Resource::RetrieveMemory(m_BufferAllocation);
+		}
+
+		return m_MappedMemory;
+	}
+
+	bool RHI_ConstantBuffer::Unmap(const uint64_t offset /*= 0*/, const uint64_t size /*= 0*/)
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation");
+			return false;
+		}
+
+		// Host memory needs no flushing, so this only unmaps as Vulkan would.
+		if (!m_PersistentMapping)
+		{
+			m_MappedMemory = nullptr;
+		}
+
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+
+namespace Amethyst
+{
+	RHI_DescriptorSet::~RHI_DescriptorSet()
+	{
+
+	}
+
+	bool RHI_DescriptorSet::Create()
+	{
+		// Validate Descriptor Set
+		AMETHYST_ASSERT(m_Resource == nullptr);
+
+		// Validate Descriptor Set Layout
+		AMETHYST_ASSERT(m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout()->RetrieveResource() != nullptr);
+
+		// Same as Vulkan, allocated from whichever of the cache's pools has room.
+		return m_DescriptorSetLayoutCache->AllocateDescriptorSet(m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout()->RetrieveResource(), m_Resource, m_PoolIndex);
+	}
+
+	void RHI_DescriptorSet::Update(const std::vector<RHI_Descriptor>& descriptors) // Updates all our descriptors.
+	{
+		// Validate Descriptor Set
+		AMETHYST_ASSERT(m_Resource != nullptr);
+
+		if (!m_RHI_Device->RetrieveContextRHI()->m_IsValidationEnabled)
+		{
+			return;
+		}
+
+		for (const RHI_Descriptor& descriptor : descriptors)
+		{
+			// Ignore null resources (this is legal, as a render pass can choose to not use one or more resources).
+			if (!descriptor.m_Resource)
+			{
+				continue;
+			}
+
+			if (!NullUtility::Resource::IsAlive(descriptor.m_Resource))
+			{
+				AMETHYST_ERROR("Descriptor in slot %d refers to a destroyed resource.", descriptor.m_Slot);
+			}
+		}
+	}
+}
+
+#endif
\ No newline at end of file
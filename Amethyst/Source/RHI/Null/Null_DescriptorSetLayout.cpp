@@ -0,0 +1,29 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+
+namespace Amethyst
+{
+	RHI_DescriptorSetLayout::~RHI_DescriptorSetLayout()
+	{
+		if (m_Resource)
+		{
+			// Wait in case its still in use by the GPU.
+			m_RHI_Device->Queue_WaitAll();
+
+			NullUtility::Resource::Destroy(m_Resource);
+		}
+	}
+
+	void RHI_DescriptorSetLayout::CreateResource(const std::vector<RHI_Descriptor>& descriptors)
+	{
+		AMETHYST_ASSERT(m_Resource == nullptr); // Ensure our resource is empty.
+
+		m_Resource = NullUtility::Resource::Create(Null_Resource_Type::DescriptorSetLayout);
+	}
+}
+
+#endif
\ No newline at end of file
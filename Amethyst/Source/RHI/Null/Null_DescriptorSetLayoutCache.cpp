@@ -0,0 +1,102 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI/RHI_Implementation.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+#include "../RHI_Shader.h"
+#include "../RHI_PipelineCache.h"
+#include "../../Rendering/Renderer.h"
+#include <algorithm>
+
+namespace Amethyst
+{
+	RHI_DescriptorSetLayoutCache::~RHI_DescriptorSetLayoutCache()
+	{
+		if (m_DescriptorPools.empty())
+		{
+			return;
+		}
+
+		// Wait in case they're still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		for (DescriptorPool& descriptorPool : m_DescriptorPools)
+		{
+			DestroyDescriptorPool(descriptorPool.m_Resource);
+		}
+
+		m_DescriptorPools.clear();
+	}
+
+	void RHI_DescriptorSetLayoutCache::ResetDescriptorCache()
+	{
+		// Pipelines compiling in the background may still be creating their layouts from these.
+		if (Renderer* renderer = m_RHI_Device->RetrieveContextEngine()->RetrieveSubsystem<Renderer>())
+		{
+			if (RHI_PipelineCache* pipelineCache = renderer->RetrievePipelineCache())
+			{
+				pipelineCache->WaitForCompilation();
+			}
+		}
+
+		// Destroy Layouts
+		m_AreDescriptorSetLayoutsBeingCleared = true;
+		m_DescriptorSetLayouts.clear();
+		m_AreDescriptorSetLayoutsBeingCleared = false;
+		m_DescriptorSetLayoutCurrent = nullptr;
+		m_Generation++;
+
+		// Wait in case their sets are still in use by the GPU. Only resource destruction gets here, which waits for the GPU anyway, whereas growing adds a pool instead.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Reset Pools - They are kept around, as whatever filled them is likely to fill them again.
+		for (DescriptorPool& descriptorPool : m_DescriptorPools)
+		{
+			ResetDescriptorPool(descriptorPool.m_Resource);
+			descriptorPool.m_SetCount = 0;
+			descriptorPool.m_IsFull = false;
+		}
+		m_DescriptorPoolIndex = 0;
+
+		AMETHYST_INFO("Descriptor pools have been reset.");
+	}
+
+	void* RHI_DescriptorSetLayoutCache::CreateDescriptorPool()
+	{
+		// The pool only has to own the sets allocated from it, so its capacity is enforced by the set count alone.
+		return NullUtility::Resource::Create(Null_Resource_Type::DescriptorPool);
+	}
+
+	void RHI_DescriptorSetLayoutCache::DestroyDescriptorPool(void*& descriptorPool)
+	{
+		NullUtility::Resource::Destroy(descriptorPool); // Along with every set allocated from it.
+	}
+
+	void RHI_DescriptorSetLayoutCache::ResetDescriptorPool(void* descriptorPool)
+	{
+		std::vector<void*>& descriptorSets = NullUtility::Resource::Retrieve(descriptorPool)->m_Children;
+		for (void*& descriptorSet : descriptorSets)
+		{
+			NullUtility::Resource::Destroy(descriptorSet);
+		}
+		descriptorSets.clear();
+	}
+
+	bool RHI_DescriptorSetLayoutCache::AllocateFromDescriptorPool(void* descriptorPool, void* descriptorSetLayout, void*& descriptorSet)
+	{
+		// Same as Vulkan, the set is owned by the pool and is freed along with it.
+		descriptorSet = NullUtility::Resource::Create(Null_Resource_Type::DescriptorSet);
+		NullUtility::Resource::Retrieve(descriptorPool)->m_Children.emplace_back(descriptorSet);
+
+		return true;
+	}
+
+	void RHI_DescriptorSetLayoutCache::FreeToDescriptorPool(void* descriptorPool, void*& descriptorSet)
+	{
+		std::vector<void*>& descriptorSets = NullUtility::Resource::Retrieve(descriptorPool)->m_Children;
+		descriptorSets.erase(std::remove(descriptorSets.begin(), descriptorSets.end(), descriptorSet), descriptorSets.end());
+
+		NullUtility::Resource::Destroy(descriptorSet);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Device.h"
+#include "../RHI/RHI_Implementation.h"
+#include "../RHI/RHI_Semaphore.h"
+#include "../RHI/RHI_Fence.h"
+
+namespace Amethyst
+{
+	RHI_Device::RHI_Device(Context* context)
+	{
+		m_Context = context;
+		m_RHI_Context = std::make_shared<RHI_Context>();
+
+		// Pass pointer to the widely used Utility namespace.
+		NullUtility::Globals::g_RHI_Device = this;
+		NullUtility::Globals::g_RHI_Context = m_RHI_Context.get();
+
+		// A single device which can do everything, with one queue of each type.
+		RegisterPhysicalDevice(PhysicalDevice(0, 0, 0, RHI_PhysicalDevice_Type::RHI_PhysicalDevice_CPU, "Null Device", 0, nullptr));
+		SetPrimaryPhysicalDevice(0);
+
+		m_RHI_Context->m_Queue_Graphics = NullUtility::Resource::Create(Null_Resource_Type::CommandPool);
+		m_RHI_Context->m_Queue_Transfer = m_RHI_Context->m_Queue_Graphics;
+		m_RHI_Context->m_Queue_Compute = m_RHI_Context->m_Queue_Graphics;
+
+		m_EnabledGraphicsShaderStages = RHI_Shader_Vertex | RHI_Shader_Pixel;
+		m_IsInitialized = true;
+	}
+
+	RHI_Device::~RHI_Device()
+	{
+		if (!m_RHI_Context || !m_RHI_Context->m_Queue_Graphics)
+		{
+			return;
+		}
+
+		NullUtility::Resource::Destroy(m_RHI_Context->m_Queue_Graphics);
+
+		// Anything still alive at this point was never destroyed by its owner.
+		for (uint32_t i = 0; i < static_cast<uint32_t>(Null_Resource_Type::Count); i++)
+		{
+			if (m_RHI_Context->m_ResourceCounts[i] != 0)
+			{
+				AMETHYST_WARNING("%d resources of type %d were leaked.", m_RHI_Context->m_ResourceCounts[i], i);
+			}
+		}
+	}
+
+	void RHI_Device::RetrieveMemoryStatistics(RHI_MemoryStatistics& statistics) const
+	{
+		statistics = RHI_MemoryStatistics();
+
+		if (!m_RHI_Context)
+		{
+			return;
+		}
+
+		// Buffers are the only resources holding memory, each in its own block.
+		std::lock_guard<std::mutex> lock(m_RHI_Context->m_ResourceMutex);
+		statistics.m_BytesAllocated = m_RHI_Context->m_ResourceBytes;
+		statistics.m_BytesUsed = m_RHI_Context->m_ResourceBytes;
+		statistics.m_AllocationCount = m_RHI_Context->m_ResourceCounts[static_cast<uint32_t>(Null_Resource_Type::Buffer)];
+		statistics.m_BlockCount = statistics.m_AllocationCount;
+	}
+
+	bool RHI_Device::Queue_Present(void* swapchainView, uint32_t* imageIndex, RHI_Semaphore* waitSemaphore /*= nullptr*/) const
+	{
+		// Validate Semaphore State
+		if (waitSemaphore) AMETHYST_ASSERT(waitSemaphore->RetrieveState() == RHI_Semaphore_State::Signaled);
+
+		std::lock_guard<std::mutex> lock(m_QueueMutex);
+		m_RHI_Context->m_PresentCount++;
+
+		// Update Semaphore State
+		if (waitSemaphore)
+		{
+			waitSemaphore->SetState(RHI_Semaphore_State::Idle);
+		}
+
+		return true;
+	}
+
+	bool RHI_Device::Queue_Submit(const RHI_Queue_Type queueType, const uint32_t waitFlags, void* commandBuffer, RHI_Semaphore* waitSemaphore /*= nullptr*/, RHI_Semaphore* signalSemaphore /*= nullptr*/, RHI_Fence* signalFence /*= nullptr*/, const uint64_t waitValue /*= 0*/, const uint64_t signalValue /*= 0*/) const
+	{
+		// Validate Input
+		AMETHYST_ASSERT(commandBuffer != nullptr);
+
+		// Timeline semaphores have values instead of states, so only binary semaphores are tracked.
+		const bool isWaitBinary = waitSemaphore && !waitSemaphore->IsTimelineSemaphore();
+		const bool isSignalBinary = signalSemaphore && !signalSemaphore->IsTimelineSemaphore();
+
+		// Validate Semaphore States
+		if (isWaitBinary)	AMETHYST_ASSERT(waitSemaphore->RetrieveState() == RHI_Semaphore_State::Signaled);
+		if (isSignalBinary) AMETHYST_ASSERT(signalSemaphore->RetrieveState() == RHI_Semaphore_State::Idle);
+
+		// Everything before this submission has completed already, so a value it waits for which wasn't reached yet never will be. On a GPU, the queue would hang.
+		if (waitSemaphore && !isWaitBinary && waitSemaphore->RetrieveValue() < waitValue)
+		{
+			AMETHYST_ERROR("Submission waits for value %llu, which was never signaled.", waitValue);
+			return false;
+		}
+
+		const Null_CommandStream* commandStream = static_cast<const Null_CommandStream*>(commandBuffer);
+		if (m_RHI_Context->m_IsValidationEnabled && commandStream->IsRecording())
+		{
+			AMETHYST_ERROR("Submitted a command buffer which is still recording.");
+		}
+
+		// The work is done as soon as it's submitted.
+		std::lock_guard<std::mutex> lock(m_QueueMutex);
+		m_RHI_Context->m_SubmittedStatistics += commandStream->RetrieveStatistics();
+		m_RHI_Context->m_SubmissionCount++;
+
+		if (signalFence)
+		{
+			NullUtility::Resource::Retrieve(signalFence->RetrieveResource())->m_Value = 1;
+		}
+
+		// Update Semaphore States
+		if (isWaitBinary)   waitSemaphore->SetState(RHI_Semaphore_State::Idle);
+		if (isSignalBinary) signalSemaphore->SetState(RHI_Semaphore_State::Signaled);
+		if (signalSemaphore && !isSignalBinary)
+		{
+			signalSemaphore->Signal(signalValue);
+		}
+
+		return true;
+	}
+
+	bool RHI_Device::Queue_Wait(const RHI_Queue_Type queueType) const
+	{
+		// Nothing is ever in flight.
+		std::lock_guard<std::mutex> lock(m_QueueMutex);
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Fence.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+
+namespace Amethyst
+{
+	RHI_Fence::RHI_Fence(RHI_Device* rhi_Device, const char* name /*= nullptr*/)
+	{
+		m_RHI_Device = rhi_Device;
+
+		// Create Fence - Unsignaled, same as Vulkan.
+		m_Resource = NullUtility::Resource::Create(Null_Resource_Type::Fence);
+
+		// Name
+		if (name)
+		{
+			m_Name = name;
+		}
+	}
+
+	RHI_Fence::~RHI_Fence()
+	{
+		if (!m_Resource)
+		{
+			return;
+		}
+
+		// Wait in case it's still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		NullUtility::Resource::Destroy(m_Resource);
+	}
+
+	bool RHI_Fence::IsSignaled()
+	{
+		// Signaled by RHI_Device::Queue_Submit().
+		return NullUtility::Resource::Retrieve(m_Resource)->m_Value != 0;
+	}
+
+	bool RHI_Fence::Wait(uint64_t timeout /*= (std::numeric_limits<uint64_t>::max)()*/)
+	{
+		// Submitted work completes as it's submitted, so there is never anything to wait for.
+		return true;
+	}
+
+	bool RHI_Fence::Reset()
+	{
+		// Resets the fence to unsignalled state.
+		NullUtility::Resource::Retrieve(m_Resource)->m_Value = 0;
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
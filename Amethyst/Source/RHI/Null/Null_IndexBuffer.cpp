@@ -0,0 +1,117 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_IndexBuffer.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_UploadHeap.h"
+#include "../../Profiling/MemoryTracker.h"
+
+namespace Amethyst
+{
+	void RHI_IndexBuffer::_Destroy()
+	{
+		// Same as Vulkan, creation doesn't wait on the GPU when there is no buffer yet.
+		if (!m_Buffer)
+		{
+			return;
+		}
+
+		// Wait in case it's still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Unmap
+		m_MappedMemory = nullptr;
+
+		// Destroy
+		NullUtility::Resource::Destroy(m_Buffer);
+		m_BufferAllocation = nullptr;
+		MemoryTracker::Untrack(this);
+	}
+
+	bool RHI_IndexBuffer::_Create(const void* indices)
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		// Destroy previous buffer.
+		_Destroy();
+
+		m_Buffer = NullUtility::Resource::Create(Null_Resource_Type::Buffer, m_Size_GPU);
+		m_BufferAllocation = m_Buffer; // The buffer is its own allocation.
+
+		// Buffers created with data would be staged into device local memory, which only staging can update afterwards. Keep that, so that code which works here works on a GPU.
+		bool useStagingBuffer = indices != nullptr;
+		if (useStagingBuffer)
+		{
+			RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+			if (!uploadHeap || !uploadHeap->UploadBuffer(m_Buffer, indices, m_Size_GPU, m_UploadValue))
+			{
+				AMETHYST_ERROR("Failed to stage indices.");
+				return false;
+			}
+		}
+		m_IsMappable = !useStagingBuffer;
+
+		// Memory Accounting
+		MemoryTracker::Track(this, MemoryCategory::IndexBuffer);
+
+		return true;
+	}
+
+	void* RHI_IndexBuffer::Map()
+	{
+		if (!m_IsMappable)
+		{
+			AMETHYST_ERROR("Not mappable. Buffer can only be updated via staging.");
+			return nullptr;
+		}
+
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation.");
+			return nullptr;
+		}
+
+		if (!m_MappedMemory)
+		{
+			m_MappedMemory = NullUtility::Resource::RetrieveMemory(m_BufferAllocation);
+		}
+
+		return m_MappedMemory;
+	}
+
+	bool RHI_IndexBuffer::Unmap()
+	{
+		if (!m_IsMappable)
+		{
+			AMETHYST_ERROR("Not mappable. Buffer can only be updated via staging.");
+			return false;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation.");
+			return false;
+		}
+
+		// Host memory needs no flushing, so this only unmaps as Vulkan would.
+		if (!m_PersistentMapping)
+		{
+			m_MappedMemory = nullptr;
+		}
+
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_InputLayout.h"
+
+namespace Amethyst
+{
+	RHI_InputLayout::~RHI_InputLayout()
+	{
+
+	}
+
+	bool RHI_InputLayout::_CreateResource(void* vertexShaderBlob)
+	{
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
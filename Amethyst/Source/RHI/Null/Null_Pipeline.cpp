@@ -0,0 +1,54 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_BindlessHeap.h"
+
+namespace Amethyst
+{
+	RHI_Pipeline::RHI_Pipeline(const RHI_Device* rhi_Device, RHI_PipelineState& rhi_PipelineState, RHI_DescriptorSetLayout* rhi_DescriptorSetLayout, void* rhi_PipelineCache /*= nullptr*/)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		m_RHI_Device = rhi_Device;
+		m_PipelineState = rhi_PipelineState;
+
+		// Pipeline Layout
+		{
+			// Same as Vulkan, the bindless arrays come first.
+			RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device);
+			std::array<void*, 2> layouts = { bindlessHeap ? bindlessHeap->RetrieveDescriptorSetLayout() : nullptr, rhi_DescriptorSetLayout->RetrieveResource() };
+
+			// Validate Descriptor Set Layouts
+			for (void* layout : layouts)
+			{
+				AMETHYST_ASSERT(layout != nullptr);
+			}
+
+			m_PipelineLayout = NullUtility::Resource::Create(Null_Resource_Type::PipelineLayout);
+		}
+
+		// Graphics pipelines need the render pass they will be used in, same as Vulkan.
+		if (!m_PipelineState.IsComputePipeline())
+		{
+			AMETHYST_ASSERT(m_PipelineState.RetrieveRenderPass() != nullptr);
+		}
+
+		// There is nothing to compile, but the cache has to be alive, same as Vulkan.
+		AMETHYST_ASSERT(!rhi_PipelineCache || NullUtility::Resource::IsAlive(rhi_PipelineCache));
+
+		m_Pipeline = NullUtility::Resource::Create(Null_Resource_Type::Pipeline);
+	}
+
+	RHI_Pipeline::~RHI_Pipeline()
+	{
+		// Wait in case it's still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		NullUtility::Resource::Destroy(m_Pipeline);
+		NullUtility::Resource::Destroy(m_PipelineLayout);
+	}
+};
+
+#endif
\ No newline at end of file
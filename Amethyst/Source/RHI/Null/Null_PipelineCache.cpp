@@ -0,0 +1,29 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_PipelineCache.h"
+
+namespace Amethyst
+{
+	// There is no driver cache to save or load, but the prewarm list and background creation work the same as with Vulkan.
+	RHI_PipelineCache::RHI_PipelineCache(const RHI_Device* rhi_Device)
+	{
+		m_RHI_Device = rhi_Device;
+		m_Resource = NullUtility::Resource::Create(Null_Resource_Type::PipelineCache);
+
+		LoadPrewarmList();
+	}
+
+	RHI_PipelineCache::~RHI_PipelineCache()
+	{
+		// Nothing may still be creating pipelines from the cache.
+		WaitForCompilation();
+		SavePrewarmList();
+
+		NullUtility::Resource::Destroy(m_Resource);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_PipelineState.h"
+
+namespace Amethyst
+{
+	bool RHI_PipelineState::CreateFramebuffer(const RHI_Device* rhi_Device)
+	{
+		if (IsComputePipeline())
+		{
+			return true; // Compute pipelines do not require framebuffers as they are usually doing operations only.
+		}
+
+		m_RHI_Device = rhi_Device;
+
+		// Destroy Existing Frame Resources
+		DestroyFramebuffer();
+
+		// Create a Render Pass
+		m_RenderPass = NullUtility::Resource::Create(Null_Resource_Type::RenderPass);
+
+		// Create Framebuffer
+		if (m_RenderTargetSwapchain)
+		{
+			// Create one framebuffer per image.
+			for (uint32_t i = 0; i < m_RenderTargetSwapchain->RetrieveBufferCount(); i++)
+			{
+				m_FrameBuffers[i] = NullUtility::Resource::Create(Null_Resource_Type::Framebuffer);
+			}
+
+			return true;
+		}
+
+		// If this is not a swapchain, we populate the first item in the framebuffer array.
+		m_FrameBuffers[0] = NullUtility::Resource::Create(Null_Resource_Type::Framebuffer);
+
+		return true;
+	}
+
+	void* RHI_PipelineState::RetrieveFramebuffer() const
+	{
+		// If this is a swapchain, return the appropriate buffer.
+		if (m_RenderTargetSwapchain)
+		{
+			if (m_RenderTargetSwapchain->RetrieveImageIndex() >= g_RHI_MaxRenderTargetCount)
+			{
+				AMETHYST_ERROR("Invalid swapchain image index: %d.", m_RenderTargetSwapchain->RetrieveImageIndex());
+				return nullptr;
+			}
+
+			return m_FrameBuffers[m_RenderTargetSwapchain->RetrieveImageIndex()];
+		}
+
+		// If this is a render texture, we simply return the first framebuffer.
+		return m_FrameBuffers[0];
+	}
+
+	void RHI_PipelineState::DestroyFramebuffer()
+	{
+		if (!m_RHI_Device)
+		{
+			return;
+		}
+
+		// Wait in case the buffer is still in use by the graphics queue.
+		m_RHI_Device->Queue_Wait(RHI_Queue_Type::RHI_Queue_Graphics);
+
+		for (uint32_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
+		{
+			NullUtility::Resource::Destroy(m_FrameBuffers[i]);
+		}
+
+		// Destroy Render Pass
+		NullUtility::Resource::Destroy(m_RenderPass);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_Device.h"
+#include "../RHI_BindlessHeap.h"
+
+namespace Amethyst
+{
+	void RHI_Sampler::CreateResource()
+	{
+		m_Resource = NullUtility::Resource::Create(Null_Resource_Type::Sampler);
+	}
+
+	RHI_Sampler::~RHI_Sampler()
+	{
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Free its bindless slot.
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			bindlessHeap->Release(RHI_Bindless_Type::Sampler, m_BindlessIndex);
+		}
+
+		NullUtility::Resource::Destroy(m_Resource);
+	}
+}
+
+#endif
\ No newline at end of file
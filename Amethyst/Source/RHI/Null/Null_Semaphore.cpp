@@ -0,0 +1,73 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI/RHI_Semaphore.h"
+#include "../RHI/RHI_Implementation.h"
+
+namespace Amethyst
+{
+	RHI_Semaphore::RHI_Semaphore(RHI_Device* rhi_Device, bool isTimeline /*= false*/, const char* name /*= nullptr*/)
+	{
+		m_IsTimelineSemaphore = isTimeline;
+		m_RHI_Device = rhi_Device;
+
+		// Create - Timeline semaphores keep their value in the resource, starting at 0 like Vulkan's initialValue.
+		m_Resource = NullUtility::Resource::Create(Null_Resource_Type::Semaphore);
+
+		// Name
+		if (name)
+		{
+			m_Name = name;
+		}
+	}
+
+	RHI_Semaphore::~RHI_Semaphore()
+	{
+		if (!m_Resource)
+		{
+			return;
+		}
+
+		// Wait in case it's still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		NullUtility::Resource::Destroy(m_Resource);
+	}
+
+	bool RHI_Semaphore::Wait(const uint64_t value, const uint64_t timeout /*= (std::numeric_limits<uint64_t>::max)()*/)
+	{
+		AMETHYST_ASSERT(m_IsTimelineSemaphore);
+
+		// Timeline semaphores are signaled by the host or as soon as a submission is made, so a value that hasn't been reached yet never will be. On a GPU this would hang until the timeout.
+		if (RetrieveValue() < value)
+		{
+			AMETHYST_ERROR("Waiting for value %llu, which was never signaled (currently %llu).", value, RetrieveValue());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RHI_Semaphore::Signal(const uint64_t value)
+	{
+		AMETHYST_ASSERT(m_IsTimelineSemaphore);
+
+		// Timeline values have to strictly increase.
+		if (value <= RetrieveValue())
+		{
+			AMETHYST_ERROR("Signaled value %llu, which is not greater than the current value %llu.", value, RetrieveValue());
+			return false;
+		}
+
+		NullUtility::Resource::Retrieve(m_Resource)->m_Value = value;
+		return true;
+	}
+
+	uint64_t RHI_Semaphore::RetrieveValue()
+	{
+		AMETHYST_ASSERT(m_IsTimelineSemaphore);
+
+		return NullUtility::Resource::Retrieve(m_Resource)->m_Value;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Shader.h"
+#include "../RHI_InputLayout.h"
+
+namespace Amethyst
+{
+	RHI_Shader::~RHI_Shader()
+	{
+		if (HasResource())
+		{
+			// Wait in case its in use by the GPU.
+			m_RHI_Device->Queue_WaitAll();
+
+			NullUtility::Resource::Destroy(m_Resource);
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_Device.h"
+#include "../RHI_BindlessHeap.h"
+#include "../../Profiling/MemoryTracker.h"
+
+namespace Amethyst
+{
+	void RHI_StructuredBuffer::_Destroy()
+	{
+		if (!m_Buffer)
+		{
+			return;
+		}
+
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Unmap
+		m_MappedMemory = nullptr;
+
+		// Destroy
+		NullUtility::Resource::Destroy(m_Buffer);
+		m_BufferAllocation = nullptr;
+		MemoryTracker::Untrack(this);
+	}
+
+	RHI_StructuredBuffer::RHI_StructuredBuffer(const std::shared_ptr<RHI_Device>& rhi_Device, const std::string& name)
+	{
+		m_RHI_Device = rhi_Device;
+		m_Name = name;
+	}
+
+	RHI_StructuredBuffer::~RHI_StructuredBuffer()
+	{
+		_Destroy();
+
+		// Free its bindless slot.
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			bindlessHeap->Release(RHI_Bindless_Type::StructuredBuffer, m_BindlessIndex);
+		}
+	}
+
+	bool RHI_StructuredBuffer::_Create()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		// Destroy previous buffer.
+		_Destroy();
+
+		// Create Buffer
+		m_Buffer = NullUtility::Resource::Create(Null_Resource_Type::Buffer, m_Size_GPU);
+		m_BufferAllocation = m_Buffer; // The buffer is its own allocation.
+
+		// Memory Accounting
+		MemoryTracker::Track(this, MemoryCategory::StructuredBuffer);
+
+		// Bindless - Written into the slot the buffer already has, if it's being recreated.
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			m_BindlessIndex = bindlessHeap->SetStructuredBuffer(this, m_BindlessIndex);
+		}
+
+		return true;
+	}
+
+	void* RHI_StructuredBuffer::Map()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation.");
+			return nullptr;
+		}
+
+		if (!m_MappedMemory)
+		{
+			m_MappedMemory = NullUtility::Resource::RetrieveMemory(m_BufferAllocation);
+		}
+
+		return m_MappedMemory;
+	}
+
+	bool RHI_StructuredBuffer::Unmap(const uint64_t offset /*= 0*/, const uint64_t size /*= 0*/)
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation");
+			return false;
+		}
+
+		// The memory stays mapped and host memory needs no flushing.
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
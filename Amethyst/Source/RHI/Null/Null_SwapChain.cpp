@@ -0,0 +1,237 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_Device.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_Semaphore.h"
+
+namespace Amethyst
+{
+	// Headless - there is no window to present to, so the surface and images are handles like any other. The window handle is kept but never used.
+	static bool CreateSwapchain
+	(
+		RHI_Device* rhi_Device,
+		uint32_t* width,
+		uint32_t* height,
+		uint32_t bufferCount,
+		void*& surfaceOut,
+		void*& swapchainViewOut,
+		std::array<void*, g_RHI_MaxRenderTargetCount>& resourceTextures,
+		std::array<void*, g_RHI_MaxRenderTargetCount>& resourceViews,
+		std::array<std::shared_ptr<RHI_Semaphore>, g_RHI_MaxRenderTargetCount>& imageAcquiredSemaphores // 1 semaphore per swapchain image buffer.
+	)
+	{
+		// Compute Extents
+		*width = Math::Utilities::Clamp(*width, 1u, RHI_Context::m_Texture2D_DimensionsMax);
+		*height = Math::Utilities::Clamp(*height, 1u, RHI_Context::m_Texture2D_DimensionsMax);
+
+		surfaceOut = NullUtility::Resource::Create(Null_Resource_Type::Surface);
+		swapchainViewOut = NullUtility::Resource::Create(Null_Resource_Type::Swapchain);
+
+		// Create Images and Image Views
+		for (uint32_t i = 0; i < bufferCount; i++)
+		{
+			resourceTextures[i] = NullUtility::Resource::Create(Null_Resource_Type::Image);
+			resourceViews[i] = NullUtility::Resource::Create(Null_Resource_Type::ImageView);
+		}
+
+		// Semaphores
+		for (uint32_t i = 0; i < bufferCount; i++)
+		{
+			imageAcquiredSemaphores[i] = std::make_shared<RHI_Semaphore>(rhi_Device, false, (std::string("Swapchain Image Acquired Semaphore ") + std::to_string(i)).c_str());
+		}
+
+		return true;
+	}
+
+	static void DestroySwapchain(
+	uint8_t bufferCount,
+	void*& surface,
+	void*& swapchainView,
+	std::array<void*, g_RHI_MaxRenderTargetCount>& swapchainImages,
+	std::array<void*, g_RHI_MaxRenderTargetCount>& swapchainImageViews,
+	std::array<std::shared_ptr<RHI_Semaphore>, g_RHI_MaxRenderTargetCount>& imageAcquiredSemaphores
+	)
+	{
+		// Semaphores
+		imageAcquiredSemaphores.fill(nullptr);
+
+		// Images and Image Views - Unlike Vulkan, the images are ours to destroy as well.
+		for (uint32_t i = 0; i < bufferCount; i++)
+		{
+			NullUtility::Resource::Destroy(swapchainImageViews[i]);
+			NullUtility::Resource::Destroy(swapchainImages[i]);
+		}
+
+		// Swapchain
+		NullUtility::Resource::Destroy(swapchainView);
+
+		// Surface
+		NullUtility::Resource::Destroy(surface);
+	}
+
+	RHI_SwapChain::RHI_SwapChain(
+		void* windowHandle,
+		const std::shared_ptr<RHI_Device>& rhi_Device,
+		uint32_t width,
+		uint32_t height,
+		RHI_Format format		 /*= RHI_Format::RHI_Format_R8G8B8A8_Unorm*/,
+		uint32_t bufferCount	 /*= 2*/,
+		uint32_t flags		     /*= RHI_Present_Mode::RHI_Present_Immediate*/,
+		const char* name		 /*= nullptr*/
+	)
+	{
+		m_Name = name;
+
+		// Validate Device
+		if (!rhi_Device || !rhi_Device->IsInitialized())
+		{
+			AMETHYST_ERROR("Invalid device.");
+			return;
+		}
+
+		// Validate Resolution
+		if (!RHI_Device::IsValidResolution(width, height))
+		{
+			AMETHYST_WARNING("%dx%d is an invalid resolution.", width, height);
+			return;
+		}
+
+		// Copy Parameters
+		m_Format = format;
+		m_RHI_Device = rhi_Device.get();
+		m_BufferCount = bufferCount;
+		m_Width = width;
+		m_Height = height;
+		m_WindowHandle = windowHandle;
+		m_Flags = flags;
+
+		m_Initialized = CreateSwapchain(m_RHI_Device, &m_Width, &m_Height, m_BufferCount, m_Surface, m_SwapchainView, m_Resource, m_ResourceViews, m_ImageAcquiredSemaphores);
+
+		// Create Command Pool
+		m_CommandPool = NullUtility::Resource::Create(Null_Resource_Type::CommandPool);
+
+		// Create Command Lists.
+		for (uint32_t i = 0; i < m_BufferCount; i++)
+		{
+			m_CommandLists.emplace_back(std::make_shared<RHI_CommandList>(i, this, rhi_Device->RetrieveContextEngine()));
+		}
+
+		AcquireNextImage();
+	}
+
+	RHI_SwapChain::~RHI_SwapChain()
+	{
+		// Wait in case any command buffer is still in use.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Command Buffers.
+		m_CommandLists.clear();
+
+		// Command Pool.
+		NullUtility::Resource::Destroy(m_CommandPool);
+
+		// Resources
+		DestroySwapchain(m_BufferCount, m_Surface, m_SwapchainView, m_Resource, m_ResourceViews, m_ImageAcquiredSemaphores);
+	}
+
+	bool RHI_SwapChain::Resize(const uint32_t width, const uint32_t height, const bool forceResize /*= false*/)
+	{
+		// Validate resolution.
+		m_IsPresentationEnabled = RHI_Device::IsValidResolution(width, height);
+		if (!m_IsPresentationEnabled)
+		{
+			// Return true as when minimizing, a resolution of 0,0 can be passed in, and this is fine.
+			return true;
+		}
+
+		// Only resize if needed.
+		if (!forceResize)
+		{
+			if (m_Width == width && m_Height == height)
+			{
+				return true;
+			}
+		}
+
+		// Wait in case any command buffer is still in use.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Save new dimensions.
+		m_Width = width;
+		m_Height = height;
+
+		// Destroy previous swapchain.
+		DestroySwapchain(m_BufferCount, m_Surface, m_SwapchainView, m_Resource, m_ResourceViews, m_ImageAcquiredSemaphores);
+
+		// Create the swapchain with the new dimensions.
+		m_Initialized = CreateSwapchain(m_RHI_Device, &m_Width, &m_Height, m_BufferCount, m_Surface, m_SwapchainView, m_Resource, m_ResourceViews, m_ImageAcquiredSemaphores);
+
+		// The pipeline state used by the pipeline will now be invalid since its referring to a destroyed swapchain view. By generating a new ID, the pipeline cache will automatically generate a new pipeline for this swapchain.
+		if (m_Initialized)
+		{
+			m_ID = GenerateObjectID();
+		}
+
+		return m_Initialized;
+	}
+
+	// Acquire image from our swapchain.
+	bool RHI_SwapChain::AcquireNextImage()
+	{
+		if (!m_IsPresentationEnabled)
+		{
+			return true;
+		}
+
+		// Retrieve next command index.
+		uint32_t nextCommandIndex = (m_CommandListIndex + 1) % m_BufferCount;
+
+		// Retrieve signal semaphore.
+		RHI_Semaphore* signalSemaphore = m_ImageAcquiredSemaphores[nextCommandIndex].get();
+
+		// Validate semaphore state.
+		AMETHYST_ASSERT(signalSemaphore->RetrieveState() == RHI_Semaphore_State::Idle); // Our semaphore should be in idle state.
+
+		// Nothing is ever reading from the images, so they are handed out in order and are available right away.
+		m_ImageIndex = nextCommandIndex;
+
+		// Save command index.
+		m_CommandListIndex = nextCommandIndex; // Current command index.
+
+		// Update semaphore state.
+		signalSemaphore->SetState(RHI_Semaphore_State::Signaled); // Update new semaphore state.
+
+		return true;
+	}
+
+	// Present only when signalled.
+	bool RHI_SwapChain::Present(RHI_Semaphore* waitSemaphore)
+	{
+		// Validate swapchain state.
+		AMETHYST_ASSERT(m_IsPresentationEnabled);
+
+		// Validate semaphore state.
+		AMETHYST_ASSERT(waitSemaphore->RetrieveState() == RHI_Semaphore_State::Signaled);
+
+		// Acquire next image
+		if (!AcquireNextImage())
+		{
+			AMETHYST_ERROR("Failed to acquire next image.");
+			return false;
+		}
+
+		// Present
+		if (!m_RHI_Device->Queue_Present(m_SwapchainView, &m_ImageIndex, waitSemaphore))
+		{
+			AMETHYST_ERROR("Failed to present.");
+			return false;
+		}
+
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
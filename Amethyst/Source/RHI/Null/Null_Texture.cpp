@@ -0,0 +1,242 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture2D.h"
+#include "../RHI_TextureCube.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+#include "../RHI_UploadHeap.h"
+#include "../Rendering/Renderer.h"
+#include "../../Profiling/MemoryTracker.h"
+
+namespace Amethyst
+{
+	inline void DestroyImageAndViews(void*& resource, void* (&resourceView)[2], std::array<void*, g_RHI_MaxRenderTargetCount>& resourceViewDepthStencil, std::array<void*, g_RHI_MaxRenderTargetCount>& resourceViewRenderTarget)
+	{
+		NullUtility::Resource::Destroy(resourceView[0]); // Color/Depth
+		NullUtility::Resource::Destroy(resourceView[1]); // Stencil
+
+		for (uint32_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
+		{
+			NullUtility::Resource::Destroy(resourceViewDepthStencil[i]);
+			NullUtility::Resource::Destroy(resourceViewRenderTarget[i]);
+		}
+
+		NullUtility::Resource::Destroy(resource);
+	}
+
+	RHI_Texture2D::~RHI_Texture2D()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR("Invalid RHI Device.");
+		}
+
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Same as Vulkan, descriptor sets may still refer to this texture.
+		if (Renderer* renderer = m_RHI_Device->RetrieveContextEngine()->RetrieveSubsystem<Renderer>())
+		{
+			if (RHI_DescriptorSetLayoutCache* descriptorSetLayoutCache = renderer->RetrieveDescriptorLayoutCache())
+			{
+				descriptorSetLayoutCache->ResetDescriptorCache();
+			}
+		}
+
+		// Same as Vulkan, the bindless slot is freed once the GPU is done with the texture.
+		ReleaseBindlessIndex();
+
+		// Deallocate everything.
+		m_Data.clear();
+		DestroyResourceGPU();
+	}
+
+	void RHI_Texture::DestroyResourceGPU()
+	{
+		DestroyImageAndViews(m_Resource, m_ResourceView, m_ResourceView_DepthStencil, m_ResourceView_RenderTarget);
+	}
+
+	void RHI_Texture::UpdateMemoryAccounting()
+	{
+		// CPU - Whatever mip data we are still holding on to.
+		m_Size_CPU = 0;
+		for (const std::vector<std::byte>& mip : m_Data)
+		{
+			m_Size_CPU += static_cast<uint64_t>(mip.size());
+		}
+
+		// GPU - Nothing is allocated, so report what the image would take. Aliased textures are accounted for by their memory.
+		m_Size_GPU = (m_Resource && !m_AliasedMemory) ? RetrieveMipChainSize(0) : 0;
+
+		MemoryTracker::Track(this, (IsRenderTarget() || IsDepthStencil()) ? MemoryCategory::RenderTarget : MemoryCategory::Texture);
+	}
+
+	void RHI_Texture::SetLayout(const RHI_Image_Layout newLayout, RHI_CommandList* commandList /*= nullptr*/)
+	{
+		// The texture is most likely still initializing.
+		if (m_Layout == RHI_Image_Layout::Undefined)
+		{
+			return;
+		}
+
+		if (m_Layout == newLayout)
+		{
+			return;
+		}
+
+		// If a command list was provided, this means we should insert a pipeline barrier for the layout transition.
+		if (commandList)
+		{
+			static_cast<Null_CommandStream*>(commandList->RetrieveCommandBuffer())->Record(Null_Command_Type::ImageBarrier, m_Resource, static_cast<uint32_t>(m_Layout), static_cast<uint32_t>(newLayout));
+		}
+
+		m_Layout = newLayout;
+	}
+
+	inline RHI_Image_Layout RetrieveAppropriateLayout(RHI_Texture* texture)
+	{
+		RHI_Image_Layout targetLayout = RHI_Image_Layout::Preinitialized;
+
+		if (texture->IsSampled() && texture->IsColorFormat())
+		{
+			targetLayout = RHI_Image_Layout::Shader_Read_Only_Optimal;
+		}
+
+		if (texture->IsRenderTarget())
+		{
+			targetLayout = RHI_Image_Layout::Color_Attachment_Optimal;
+		}
+
+		if (texture->IsDepthStencil())
+		{
+			targetLayout = RHI_Image_Layout::Depth_Stencil_Attachment_Optimal;
+		}
+
+		if (texture->IsStorage())
+		{
+			targetLayout = RHI_Image_Layout::General;
+		}
+
+		return targetLayout;
+	}
+
+	// Images and views are created under the same conditions as Vulkan's, so that everything checking for them sees the same thing.
+	inline void CreateImageAndViews(RHI_Texture* texture, void*& resource, void* (&resourceView)[2], std::array<void*, g_RHI_MaxRenderTargetCount>& resourceViewDepthStencil, std::array<void*, g_RHI_MaxRenderTargetCount>& resourceViewRenderTarget)
+	{
+		resource = NullUtility::Resource::Create(Null_Resource_Type::Image);
+
+		// Shader Resource Views
+		if (texture->IsSampled())
+		{
+			if (texture->IsColorFormat() || texture->IsDepthFormat())
+			{
+				resourceView[0] = NullUtility::Resource::Create(Null_Resource_Type::ImageView);
+			}
+
+			if (texture->IsStencilFormat())
+			{
+				resourceView[1] = NullUtility::Resource::Create(Null_Resource_Type::ImageView);
+			}
+		}
+
+		// Render-Target Views
+		for (uint32_t i = 0; i < texture->RetrieveArraySize(); i++)
+		{
+			if (texture->IsRenderTarget())
+			{
+				resourceViewRenderTarget[i] = NullUtility::Resource::Create(Null_Resource_Type::ImageView);
+			}
+
+			if (texture->IsDepthStencil())
+			{
+				resourceViewDepthStencil[i] = NullUtility::Resource::Create(Null_Resource_Type::ImageView);
+			}
+		}
+	}
+
+	// Create our Image.
+	bool RHI_Texture2D::CreateResourceGPU()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		CreateImageAndViews(this, m_Resource, m_ResourceView, m_ResourceView_DepthStencil, m_ResourceView_RenderTarget);
+
+		// Memory Accounting
+		UpdateMemoryAccounting();
+
+		// Same as Vulkan, staging and the transition to the target layout are recorded into the upload heap.
+		RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+		if (!uploadHeap)
+		{
+			AMETHYST_ERROR("No upload heap to stage data through.");
+			return false;
+		}
+
+		const RHI_Image_Layout targetLayout = RetrieveAppropriateLayout(this);
+		if (!uploadHeap->UploadTexture(this, targetLayout, m_UploadValue))
+		{
+			return false;
+		}
+
+		m_Layout = targetLayout;
+
+		// Bindless
+		UpdateBindlessIndex();
+
+		return true;
+	}
+
+	// Texture Cube Stuff
+	RHI_TextureCube::~RHI_TextureCube()
+	{
+		if (!m_RHI_Device->IsInitialized())
+		{
+			return;
+		}
+
+		m_RHI_Device->Queue_WaitAll();
+		m_Data.clear();
+
+		DestroyResourceGPU();
+	}
+
+	bool RHI_TextureCube::CreateResourceGPU()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		CreateImageAndViews(this, m_Resource, m_ResourceView, m_ResourceView_DepthStencil, m_ResourceView_RenderTarget);
+
+		// Memory Accounting
+		UpdateMemoryAccounting();
+
+		// Same as Vulkan, staging and the transition to the target layout are recorded into the upload heap.
+		RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+		if (!uploadHeap)
+		{
+			AMETHYST_ERROR("No upload heap to stage data through.");
+			return false;
+		}
+
+		const RHI_Image_Layout targetLayout = RetrieveAppropriateLayout(this);
+		if (!uploadHeap->UploadTexture(this, targetLayout, m_UploadValue))
+		{
+			return false;
+		}
+
+		m_Layout = targetLayout;
+
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
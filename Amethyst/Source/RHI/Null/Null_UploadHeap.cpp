@@ -0,0 +1,112 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_NULL
+#include "../RHI_Implementation.h"
+#include "../RHI_UploadHeap.h"
+#include "../RHI_Device.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Texture.h"
+
+namespace Amethyst
+{
+	bool RHI_UploadHeap::CreateResources()
+	{
+		// Ring - Host memory, so it's mapped by definition.
+		m_Buffer = NullUtility::Resource::Create(Null_Resource_Type::Buffer, g_RHI_UploadHeap_Size);
+		m_MappedData = NullUtility::Resource::RetrieveMemory(m_Buffer);
+
+		// Command Buffers - Same as Vulkan, three per batch from a pool per queue family.
+		m_CommandPoolCopy = NullUtility::Resource::Create(Null_Resource_Type::CommandPool);
+		m_CommandPoolGraphics = NullUtility::Resource::Create(Null_Resource_Type::CommandPool);
+		for (Batch& batch : m_Batches)
+		{
+			batch.m_CommandBufferCopy = new Null_CommandStream();
+			batch.m_CommandBufferTransition = new Null_CommandStream();
+			batch.m_CommandBufferAcquire = new Null_CommandStream();
+		}
+
+		return true;
+	}
+
+	void RHI_UploadHeap::DestroyResources()
+	{
+		for (Batch& batch : m_Batches)
+		{
+			for (void** commandBuffer : { &batch.m_CommandBufferCopy, &batch.m_CommandBufferTransition, &batch.m_CommandBufferAcquire })
+			{
+				delete static_cast<Null_CommandStream*>(*commandBuffer);
+				*commandBuffer = nullptr;
+			}
+		}
+
+		NullUtility::Resource::Destroy(m_CommandPoolCopy);
+		NullUtility::Resource::Destroy(m_CommandPoolGraphics);
+		NullUtility::Resource::Destroy(m_Buffer);
+		m_MappedData = nullptr;
+	}
+
+	bool RHI_UploadHeap::BeginBatch(Batch& batch)
+	{
+		const bool isValidationEnabled = m_RHI_Device->RetrieveContextRHI()->m_IsValidationEnabled;
+
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferCopy)->Begin(isValidationEnabled);
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferTransition)->Begin(isValidationEnabled);
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferAcquire)->Begin(isValidationEnabled);
+
+		return true;
+	}
+
+	bool RHI_UploadHeap::SubmitBatch(Batch& batch)
+	{
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferCopy)->End();
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferTransition)->End();
+
+		// The copies complete as soon as they are submitted, so the next Flush() acquires them.
+		return m_RHI_Device->Queue_Submit(RHI_Queue_Type::RHI_Queue_Transfer, 0, batch.m_CommandBufferCopy, nullptr, m_CopyTimeline.get(), nullptr, 0, batch.m_Value) &&
+			   m_RHI_Device->Queue_Submit(RHI_Queue_Type::RHI_Queue_Graphics, 0, batch.m_CommandBufferTransition);
+	}
+
+	bool RHI_UploadHeap::AcquireBatch(Batch& batch)
+	{
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferAcquire)->End();
+		return m_RHI_Device->Queue_Submit(RHI_Queue_Type::RHI_Queue_Graphics, 0, batch.m_CommandBufferAcquire, m_CopyTimeline.get(), m_AcquireTimeline.get(), nullptr, batch.m_Value, batch.m_Value);
+	}
+
+	void RHI_UploadHeap::RecordBufferCopy(Batch& batch, void* sourceBuffer, const uint64_t sourceOffset, void* destinationBuffer, const uint64_t size)
+	{
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferCopy)->Record(Null_Command_Type::CopyBuffer, destinationBuffer, static_cast<uint32_t>(sourceOffset), static_cast<uint32_t>(size));
+
+		// Buffers hold their bytes, so the copy is made right away. Nothing reads the destination before the batch is acquired anyway.
+		std::memcpy(NullUtility::Resource::RetrieveMemory(destinationBuffer), NullUtility::Resource::RetrieveMemory(sourceBuffer) + sourceOffset, size);
+	}
+
+	void RHI_UploadHeap::RecordTextureCopy(Batch& batch, void* sourceBuffer, const std::vector<uint64_t>& sourceOffsets, RHI_Texture* texture, const RHI_Image_Layout targetLayout)
+	{
+		// Images hold no bytes, so only the commands Vulkan would record are, on the same command buffers. There is one queue family, so nothing changes owner.
+		if (sourceOffsets.empty())
+		{
+			static_cast<Null_CommandStream*>(batch.m_CommandBufferTransition)->Record(Null_Command_Type::ImageBarrier, texture->RetrieveResource(), static_cast<uint32_t>(texture->RetrieveLayout()), static_cast<uint32_t>(targetLayout));
+			return;
+		}
+
+		Null_CommandStream* commandStream = static_cast<Null_CommandStream*>(batch.m_CommandBufferCopy);
+		commandStream->Record(Null_Command_Type::ImageBarrier, texture->RetrieveResource(), static_cast<uint32_t>(texture->RetrieveLayout()), static_cast<uint32_t>(RHI_Image_Layout::Transfer_Destination_Optimal));
+		commandStream->Record(Null_Command_Type::CopyBufferToImage, texture->RetrieveResource(), static_cast<uint32_t>(sourceOffsets.size()));
+
+		static_cast<Null_CommandStream*>(batch.m_CommandBufferAcquire)->Record(Null_Command_Type::ImageBarrier, texture->RetrieveResource(), static_cast<uint32_t>(RHI_Image_Layout::Transfer_Destination_Optimal), static_cast<uint32_t>(targetLayout));
+	}
+
+	void* RHI_UploadHeap::CreateOverflowBuffer(const void* data, const uint64_t size)
+	{
+		void* buffer = NullUtility::Resource::Create(Null_Resource_Type::Buffer, size);
+		std::memcpy(NullUtility::Resource::RetrieveMemory(buffer), data, size);
+
+		return buffer;
+	}
+
+	void RHI_UploadHeap::DestroyOverflowBuffer(void*& buffer)
+	{
+		NullUtility::Resource::Destroy(buffer);
+	}
+}
+
+#endif
\ No newline at end of file
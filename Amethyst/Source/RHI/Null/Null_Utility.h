@@ -0,0 +1,73 @@
+#pragma once
+#include "../RHI/RHI_Implementation.h"
+#include "../RHI/RHI_Device.h"
+#include "../RHI/RHI_Texture.h"
+#include "../RHI/RHI_SwapChain.h"
+#include "../Runtime/Log/Log.h"
+
+namespace Amethyst::NullUtility
+{
+	struct Globals
+	{
+		static inline RHI_Device* g_RHI_Device;
+		static inline RHI_Context* g_RHI_Context;
+	};
+
+	/*
+		Every API object of the null backend is one of these behind the same void* a Vulkan handle would occupy, so the engine's null checks keep working
+		unchanged. Buffers carry host memory in place of device memory, which makes mapping behave as it does on a GPU. The context keeps track of what is
+		alive, so that validation can catch resources used after they were destroyed and the device can report leaks on shutdown.
+	*/
+	namespace Resource
+	{
+		inline void* Create(const Null_Resource_Type type, const uint64_t size = 0)
+		{
+			Null_Resource* resource = new Null_Resource();
+			resource->m_Type = type;
+			resource->m_Memory.resize(size);
+
+			RHI_Context* rhi_Context = Globals::g_RHI_Context;
+			std::lock_guard<std::mutex> lock(rhi_Context->m_ResourceMutex);
+			rhi_Context->m_Resources.emplace(resource);
+			rhi_Context->m_ResourceCounts[static_cast<uint32_t>(type)]++;
+			rhi_Context->m_ResourceBytes += size;
+
+			return resource;
+		}
+
+		inline void Destroy(void*& resource)
+		{
+			if (!resource)
+			{
+				return;
+			}
+
+			Null_Resource* nullResource = static_cast<Null_Resource*>(resource);
+			for (void*& child : nullResource->m_Children)
+			{
+				Destroy(child);
+			}
+
+			{
+				RHI_Context* rhi_Context = Globals::g_RHI_Context;
+				std::lock_guard<std::mutex> lock(rhi_Context->m_ResourceMutex);
+				rhi_Context->m_Resources.erase(nullResource);
+				rhi_Context->m_ResourceCounts[static_cast<uint32_t>(nullResource->m_Type)]--;
+				rhi_Context->m_ResourceBytes -= nullResource->m_Memory.size();
+			}
+
+			delete nullResource;
+			resource = nullptr;
+		}
+
+		inline bool IsAlive(const void* resource)
+		{
+			RHI_Context* rhi_Context = Globals::g_RHI_Context;
+			std::lock_guard<std::mutex> lock(rhi_Context->m_ResourceMutex);
+			return rhi_Context->m_Resources.find(resource) != rhi_Context->m_Resources.end();
+		}
+
+		inline Null_Resource* Retrieve(void* resource) { return static_cast<Null_Resource*>(resource); }
+		inline std::byte* RetrieveMemory(void* resource) { return resource ? Retrieve(resource)->m_Memory.data() : nullptr; }
+	}
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+#include "../Core/AmethystObject.h"
+#include "RHI_Utilities.h"
+
+namespace Amethyst
+{
+	/*
+		A block of device memory shared by textures which are never in use at the same time, like render targets that only live for part of a frame.
+		Every texture is placed at the start of the block, which is as large as the largest of them. The textures have to be created with RHI_Texture_Aliased,
+		are placed by the constructor and have to be destroyed before the block is. Whoever uses them is responsible for discarding their contents on first use.
+	*/
+	class RHI_AliasedMemory : public AmethystObject
+	{
+	public:
+		RHI_AliasedMemory(RHI_Device* rhi_Device, const std::vector<RHI_Texture*>& textures, const char* name = nullptr);
+		~RHI_AliasedMemory();
+
+		bool IsInitialized() const { return m_Resource != nullptr; }
+		void* RetrieveResource() const { return m_Resource; }
+
+	private:
+		void* m_Resource = nullptr;
+		RHI_Device* m_RHI_Device = nullptr;
+	};
+}
\ No newline at end of file
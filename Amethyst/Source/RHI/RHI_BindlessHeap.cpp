@@ -0,0 +1,138 @@
+#include "Amethyst.h"
+#include "RHI_BindlessHeap.h"
+#include "RHI_Device.h"
+#include "../Rendering/Renderer.h"
+
+namespace Amethyst
+{
+	RHI_BindlessHeap::RHI_BindlessHeap(const RHI_Device* rhi_Device)
+	{
+		m_RHI_Device = rhi_Device;
+
+		m_Slots[static_cast<uint32_t>(RHI_Bindless_Type::Texture)].m_Capacity = g_RHI_Bindless_Max_Textures;
+		m_Slots[static_cast<uint32_t>(RHI_Bindless_Type::Sampler)].m_Capacity = g_RHI_Bindless_Max_Samplers;
+		m_Slots[static_cast<uint32_t>(RHI_Bindless_Type::StructuredBuffer)].m_Capacity = g_RHI_Bindless_Max_StructuredBuffers;
+
+		if (!CreateResource())
+		{
+			AMETHYST_ERROR("Failed to create bindless descriptor heap.");
+		}
+	}
+
+	RHI_BindlessHeap::~RHI_BindlessHeap()
+	{
+		DestroyResource();
+	}
+
+	RHI_BindlessHeap* RHI_BindlessHeap::Retrieve(const RHI_Device* rhi_Device)
+	{
+		// Null while the renderer is starting up or being destroyed, in which case there are no slots to write or free.
+		if (Renderer* renderer = rhi_Device->RetrieveContextEngine()->RetrieveSubsystem<Renderer>())
+		{
+			return renderer->RetrieveBindlessHeap();
+		}
+
+		return nullptr;
+	}
+
+	uint32_t RHI_BindlessHeap::SetTexture(RHI_Texture* texture, uint32_t index /*= g_RHI_Bindless_InvalidIndex*/)
+	{
+		if (!m_IsSupported || !texture)
+		{
+			return g_RHI_Bindless_InvalidIndex;
+		}
+
+		// Writes to the set are guarded as well, since they can come from any thread.
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		index = Allocate(RHI_Bindless_Type::Texture, index);
+		if (index != g_RHI_Bindless_InvalidIndex)
+		{
+			UpdateTexture(index, texture);
+		}
+
+		return index;
+	}
+
+	uint32_t RHI_BindlessHeap::SetSampler(RHI_Sampler* sampler, uint32_t index /*= g_RHI_Bindless_InvalidIndex*/)
+	{
+		if (!m_IsSupported || !sampler)
+		{
+			return g_RHI_Bindless_InvalidIndex;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		index = Allocate(RHI_Bindless_Type::Sampler, index);
+		if (index != g_RHI_Bindless_InvalidIndex)
+		{
+			UpdateSampler(index, sampler);
+		}
+
+		return index;
+	}
+
+	uint32_t RHI_BindlessHeap::SetStructuredBuffer(RHI_StructuredBuffer* structuredBuffer, uint32_t index /*= g_RHI_Bindless_InvalidIndex*/)
+	{
+		if (!m_IsSupported || !structuredBuffer)
+		{
+			return g_RHI_Bindless_InvalidIndex;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		index = Allocate(RHI_Bindless_Type::StructuredBuffer, index);
+		if (index != g_RHI_Bindless_InvalidIndex)
+		{
+			UpdateStructuredBuffer(index, structuredBuffer);
+		}
+
+		return index;
+	}
+
+	void RHI_BindlessHeap::Release(const RHI_Bindless_Type type, const uint32_t index)
+	{
+		if (index == g_RHI_Bindless_InvalidIndex)
+		{
+			return;
+		}
+
+		// The slot keeps pointing at the destroyed resource until it is handed out again, which is fine as partially bound arrays only need the slots shaders actually read to be valid.
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Slots[static_cast<uint32_t>(type)].m_FreeIndices.emplace_back(index);
+	}
+
+	uint32_t RHI_BindlessHeap::RetrieveCount(const RHI_Bindless_Type type) const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		const Slots& slots = m_Slots[static_cast<uint32_t>(type)];
+		return slots.m_Count - static_cast<uint32_t>(slots.m_FreeIndices.size());
+	}
+
+	uint32_t RHI_BindlessHeap::Allocate(const RHI_Bindless_Type type, uint32_t index)
+	{
+		// Recreated resources keep the slot they already have.
+		if (index != g_RHI_Bindless_InvalidIndex)
+		{
+			return index;
+		}
+
+		Slots& slots = m_Slots[static_cast<uint32_t>(type)];
+
+		if (!slots.m_FreeIndices.empty())
+		{
+			index = slots.m_FreeIndices.back();
+			slots.m_FreeIndices.pop_back();
+			return index;
+		}
+
+		if (slots.m_Count == slots.m_Capacity)
+		{
+			AMETHYST_WARNING("Bindless array %d is full (%d slots), the resource will only be accessible through pass descriptor sets.", static_cast<uint32_t>(type), slots.m_Capacity);
+			return g_RHI_Bindless_InvalidIndex;
+		}
+
+		return slots.m_Count++;
+	}
+}
\ No newline at end of file
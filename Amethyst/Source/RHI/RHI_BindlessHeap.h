@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <mutex>
+#include <vector>
+#include "RHI_Utilities.h"
+#include "../Core/AmethystObject.h"
+
+namespace Amethyst
+{
+	enum class RHI_Bindless_Type : uint8_t
+	{
+		Texture,		 // Texture2D, binding 0.
+		Sampler,		 // SamplerState, binding 1.
+		StructuredBuffer, // StructuredBuffer, binding 2.
+		Count
+	};
+
+	/*
+		Every sampled texture, sampler and structured buffer gets a slot in one of three large arrays, which live in a single descriptor set that is written
+		when a resource is created and bound once per command buffer (set g_RHI_DescriptorSetIndexBindless). Shaders then pick their resources with indices
+		they read from constants or instance data, so drawing with a different material changes data rather than descriptors.
+
+		The set is created with update-after-bind, so slots can be written and freed while command buffers which use the set are still in flight, as long
+		as those command buffers don't touch the slots in question. Resources are waited on before they are destroyed, which guarantees that.
+
+		Without descriptor indexing, the set layout is left empty so that pass sets keep their index, and every slot comes back as g_RHI_Bindless_InvalidIndex.
+	*/
+	class RHI_BindlessHeap : public AmethystObject
+	{
+	public:
+		RHI_BindlessHeap(const RHI_Device* rhi_Device);
+		~RHI_BindlessHeap();
+
+		// Slots - Writes the resource into the given slot, or a free one if there is none yet, and returns the slot. Called again whenever the resource is recreated.
+		uint32_t SetTexture(RHI_Texture* texture, uint32_t index = g_RHI_Bindless_InvalidIndex);
+		uint32_t SetSampler(RHI_Sampler* sampler, uint32_t index = g_RHI_Bindless_InvalidIndex);
+		uint32_t SetStructuredBuffer(RHI_StructuredBuffer* structuredBuffer, uint32_t index = g_RHI_Bindless_InvalidIndex);
+		void Release(const RHI_Bindless_Type type, const uint32_t index);
+
+		// Binding
+		void Bind(RHI_CommandList* commandList, const bool isCompute) const;
+
+		// The renderer's heap, if there is one yet (or still).
+		static RHI_BindlessHeap* Retrieve(const RHI_Device* rhi_Device);
+
+		bool IsSupported() const { return m_IsSupported; }
+		uint32_t RetrieveCount(const RHI_Bindless_Type type) const;
+		void* RetrieveResource() const { return m_DescriptorSet; }
+		void* RetrieveDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+
+	private:
+		uint32_t Allocate(const RHI_Bindless_Type type, uint32_t index);
+		bool CreateResource();
+		void DestroyResource();
+		void UpdateTexture(const uint32_t index, RHI_Texture* texture);
+		void UpdateSampler(const uint32_t index, RHI_Sampler* sampler);
+		void UpdateStructuredBuffer(const uint32_t index, RHI_StructuredBuffer* structuredBuffer);
+
+	private:
+		// Slots - Resources are created on worker threads, so the free lists are guarded.
+		struct Slots
+		{
+			uint32_t m_Capacity = 0;
+			uint32_t m_Count = 0;				// Slots handed out so far, including freed ones.
+			std::vector<uint32_t> m_FreeIndices;
+		};
+
+		std::array<Slots, static_cast<uint32_t>(RHI_Bindless_Type::Count)> m_Slots;
+		mutable std::mutex m_Mutex;
+		bool m_IsSupported = false;
+
+		// API
+		void* m_DescriptorSetLayout = nullptr;
+		void* m_DescriptorPool = nullptr;
+		void* m_DescriptorSet = nullptr;
+		void* m_PipelineLayout = nullptr; // Holds only the bindless set, which is all binding it needs.
+
+		// Dependencies
+		const RHI_Device* m_RHI_Device;
+	};
+}
\ No newline at end of file
@@ -15,7 +15,6 @@ namespace Amethyst
 			return false;
 		}
 
-		m_DescriptorSetLayoutCache->GrowIfNeeded();
 		m_CommandListState = RHI_CommandListState::Idle;
 
 		return true;
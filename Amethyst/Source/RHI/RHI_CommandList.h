@@ -2,6 +2,7 @@
 #include <array>
 #include <atomic>
 #include <mutex>
+#include <vector>
 #include "RHI_Utilities.h"
 #include "../Core/AmethystObject.h"
 #include "../Rendering/RendererEnums.h"
@@ -26,10 +27,19 @@ namespace Amethyst
 		Submitted
 	};
 
+	// A layout transition. Barriers handed over together are recorded as a single pipeline barrier.
+	struct RHI_ImageBarrier
+	{
+		RHI_Texture* m_Texture = nullptr;
+		RHI_Image_Layout m_Layout = RHI_Image_Layout::Undefined;
+		bool m_DiscardContents = false; // Transition from an undefined layout, as when the memory was last used by an aliased texture.
+	};
+
 	class RHI_CommandList : public AmethystObject
 	{
 	public:
 		RHI_CommandList(uint32_t index, RHI_SwapChain* swapchain, Context* context);
+		RHI_CommandList(RHI_CommandList* primary, const uint32_t index); // Secondary, see BeginSecondaryCommandLists().
 		~RHI_CommandList();
 
 		//Command List
@@ -44,13 +54,29 @@ namespace Amethyst
 		bool BeginRenderPass(RHI_PipelineState& pipelineState);
 		bool EndRenderPass();
 
+		/*
+			Secondary Command Lists - Split the draws of a render pass across threads.
+
+			Call after BeginRenderPass() and after binding the pass's resources, but before drawing. The render pass then begins on this list and every
+			secondary inherits it, along with the pipeline and descriptor set. Each secondary can then be recorded on its own thread (draws and vertex/index
+			buffers only, as the descriptor cache is shared), and ExecuteSecondaryCommandLists() plays them back in index order. A secondary is only recorded
+			once per frame, so every call hands out fresh ones. Returns false if the pass should be recorded inline instead.
+		*/
+		bool BeginSecondaryCommandLists(const uint32_t count);
+		RHI_CommandList* RetrieveSecondaryCommandList(const uint32_t index) const;
+		bool ExecuteSecondaryCommandLists();
+		bool IsSecondary() const { return m_Primary != nullptr; }
+
 		//Clear
 		void ClearPipelineStateRenderTargets(RHI_PipelineState& pipelineState);
 		void ClearRenderTarget(RHI_Texture* texture, const uint32_t colorIndex = 0, const uint32_t depthStencilIndex = 0, const bool storage = false, const Math::Vector4& clearColor = g_RHI_ColorLoadValue, const float clearDepth = g_RHI_DepthLoadValue, const uint32_t clearStencil = g_RHI_StencilLoadValue);
 
 		//Draw
 		bool Draw(uint32_t vertexCount);
-		bool DrawIndexed(uint32_t indexCount, uint32_t indexOffset = 0, uint32_t vertexOffset = 0);
+		bool DrawIndexed(uint32_t indexCount, uint32_t indexOffset = 0, uint32_t vertexOffset = 0, uint32_t instanceCount = 1, uint32_t instanceOffset = 0);
+
+		//Barriers
+		void InsertBarriers(const std::vector<RHI_ImageBarrier>& barriers);
 
 		//Dispatch
 		bool Dispatch(uint32_t x, uint32_t y, uint32_t z, bool async = false);
@@ -71,6 +97,10 @@ namespace Amethyst
 		bool SetConstantBuffer(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constantBuffer) const;
 		inline bool SetConstantBuffer(const uint32_t slot, const uint8_t scope, const std::shared_ptr<RHI_ConstantBuffer>& constantBuffer) const { return SetConstantBuffer(slot, scope, constantBuffer.get()); }
 
+		//Structured Buffer
+		bool SetStructuredBuffer(const uint32_t slot, const uint8_t scope, RHI_StructuredBuffer* structuredBuffer) const;
+		inline bool SetStructuredBuffer(const uint32_t slot, const uint8_t scope, const std::shared_ptr<RHI_StructuredBuffer>& structuredBuffer) const { return SetStructuredBuffer(slot, scope, structuredBuffer.get()); }
+
 		//Sampler
 		void SetSampler(const uint32_t slot, RHI_Sampler* sampler) const;
 		inline void SetSampler(const uint32_t slot, const std::shared_ptr<RHI_Sampler>& sampler) const { SetSampler(slot, sampler.get()); }
@@ -91,9 +121,11 @@ namespace Amethyst
 		const RHI_CommandListState RetrieveCommandListState() const { return m_CommandListState; }
 
 	private:
-		bool Deferred_BeginRenderPass();
+		bool Deferred_BeginRenderPass(const bool isRecordedBySecondaries = false);
 		bool Deferred_BindPipeline();
 		bool Deferred_BindDescriptorSet();
+		void BindDescriptorSet(RHI_DescriptorSet* descriptorSet);
+		void AbortSecondaryCommandLists(const uint32_t begin, const uint32_t end); // Leaves secondaries which were begun but won't be executed ready to record again.
 		bool OnDraw();
 
 	private:
@@ -124,6 +156,13 @@ namespace Amethyst
 		uint32_t m_IndexBufferID = 0;
 		uint32_t m_IndexBufferOffset = 0;
 
+		// Secondaries - Handed out in order, and only reused once the primary has begun again.
+		RHI_CommandList* m_Primary = nullptr;
+		void* m_CommandPool = nullptr; // Secondaries have a pool each, as a pool can only be recorded from by one thread at a time.
+		std::vector<std::shared_ptr<RHI_CommandList>> m_SecondaryCommandLists;
+		uint32_t m_SecondaryCommandListOffset = 0; // First one of the current render pass.
+		uint32_t m_SecondaryCommandListCount = 0;  // How many the current render pass uses.
+
 		std::atomic<RHI_CommandListState> m_CommandListState = RHI_CommandListState::Idle;
 		void* m_CommandBuffer; // Currently bound command buffer.
 	};
@@ -1,16 +1,26 @@
 #include "Amethyst.h"
 #include "RHI_DescriptorSet.h"
+#include "RHI_DescriptorSetLayoutCache.h"
 
 namespace Amethyst
 {
-	RHI_DescriptorSet::RHI_DescriptorSet(const RHI_Device* rhi_Device, const RHI_DescriptorSetLayoutCache* descriptorSetLayoutCache, const std::vector<RHI_Descriptor>& descriptors)
+	RHI_DescriptorSet::RHI_DescriptorSet(const RHI_Device* rhi_Device, RHI_DescriptorSetLayoutCache* descriptorSetLayoutCache, const std::vector<RHI_Descriptor>& descriptors)
 	{
 		m_RHI_Device = rhi_Device;
 		m_DescriptorSetLayoutCache = descriptorSetLayoutCache;
+		m_FrameUsed = descriptorSetLayoutCache->RetrieveFrameIndex();
 
 		if (Create())
 		{
 			Update(descriptors);
 		}
 	}
+
+	void RHI_DescriptorSet::Release()
+	{
+		if (m_Resource)
+		{
+			m_DescriptorSetLayoutCache->FreeDescriptorSet(m_Resource, m_PoolIndex);
+		}
+	}
 }
\ No newline at end of file
@@ -8,10 +8,15 @@ namespace Amethyst
 	{
 	public:
 		RHI_DescriptorSet() = default;
-		RHI_DescriptorSet(const RHI_Device* rhi_Device, const RHI_DescriptorSetLayoutCache* descriptorSetLayoutCache, const std::vector<RHI_Descriptor>& descriptors);
+		RHI_DescriptorSet(const RHI_Device* rhi_Device, RHI_DescriptorSetLayoutCache* descriptorSetLayoutCache, const std::vector<RHI_Descriptor>& descriptors);
 		~RHI_DescriptorSet();
 
 		void* RetrieveResource() { return m_Resource; }
+		void Release(); // Gives the set back to its pool. Sets are copied around by value, so this isn't left to the destructor.
+
+		// The last frame it was bound in, which is what trimming goes by.
+		uint64_t RetrieveFrameUsed() const { return m_FrameUsed; }
+		void SetFrameUsed(const uint64_t frameIndex) { m_FrameUsed = frameIndex; }
 
 	private:
 		bool Create();
@@ -19,7 +24,9 @@ namespace Amethyst
 
 	private:
 		void* m_Resource = nullptr;
-		const RHI_DescriptorSetLayoutCache* m_DescriptorSetLayoutCache = nullptr;
+		uint32_t m_PoolIndex = 0;
+		uint64_t m_FrameUsed = 0;
+		RHI_DescriptorSetLayoutCache* m_DescriptorSetLayoutCache = nullptr;
 		const RHI_Device* m_RHI_Device = nullptr;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Amethyst.h"
 #include "RHI_DescriptorSetLayout.h"
 #include "RHI_ConstantBuffer.h"
+#include "RHI_StructuredBuffer.h"
 #include "RHI_Sampler.h"
 #include "RHI_Texture.h"
 #include "RHI_DescriptorSetLayoutCache.h"
@@ -107,8 +108,37 @@ namespace Amethyst
 		}
 	}
 
+	bool RHI_DescriptorSetLayout::SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structuredBuffer)
+	{
+		// Structured buffers are shader resource views, so they share the texture register space.
+		for (RHI_Descriptor& descriptor : m_Descriptors)
+		{
+			if (descriptor.m_DescriptorType == RHI_Descriptor_Type::StructuredBuffer && descriptor.m_Slot == slot + g_RHI_ShaderShiftTexture)
+			{
+				// Determine if the descriptor set needs to be binded.
+				m_NeedsToBind = descriptor.m_Resource != structuredBuffer->RetrieveResource() ? true : m_NeedsToBind; // Affects vkUpdateDescriptorSets.
+				m_NeedsToBind = descriptor.m_Range != structuredBuffer->RetrieveGPUSize() ? true : m_NeedsToBind;		 // Affects vkUpdateDescriptorSets.
+
+				// Update
+				descriptor.m_Resource = structuredBuffer->RetrieveResource();
+				descriptor.m_Offset = 0;
+				descriptor.m_Range = structuredBuffer->RetrieveGPUSize();
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	bool RHI_DescriptorSetLayout::RetrieveDescriptorSet(RHI_DescriptorSetLayoutCache* descriptorSetLayoutCache, RHI_DescriptorSet*& descriptorSet)
 	{
+		// Nothing was set since the last bind, which is the common case with resources coming from the bindless arrays, so skip hashing the descriptors altogether.
+		if (!m_NeedsToBind)
+		{
+			return true;
+		}
+
 		// Integrate resource into the hash.
 		uint32_t hash = m_Hash;
 		for (const RHI_Descriptor& descriptor : m_Descriptors)
@@ -117,33 +147,55 @@ namespace Amethyst
 		}
 
 		// If we don't have a descriptor set to match that state, create one.
-		const auto it = m_DescriptorSets.find(hash);
+		auto it = m_DescriptorSets.find(hash);
 		if (it == m_DescriptorSets.end())
 		{
-			// Only allocate if the descriptor set cache has enough capacity.
-			if (descriptorSetLayoutCache->HasEnoughCapacity())
-			{
-				// Create descriptor set.
-				m_DescriptorSets[hash] = RHI_DescriptorSet(m_RHI_Device, descriptorSetLayoutCache, m_Descriptors);
+			RHI_DescriptorSet newDescriptorSet = RHI_DescriptorSet(m_RHI_Device, descriptorSetLayoutCache, m_Descriptors);
 
-				// Reroutes the descriptor set pointer to the new one in our data.
-				descriptorSet = &m_DescriptorSets[hash];
-			}
-			else
+			// Pools are added as needed, so this only fails when the device is out of memory.
+			if (!newDescriptorSet.RetrieveResource())
 			{
 				return false;
 			}
+
+			it = m_DescriptorSets.emplace(hash, newDescriptorSet).first;
 		}
-		else // Retrieve the existing one.
+
+		// Retrieve it, and note that it's in use so that trimming leaves it be.
+		descriptorSet = &it->second;
+		descriptorSet->SetFrameUsed(descriptorSetLayoutCache->RetrieveFrameIndex());
+		m_NeedsToBind = false;
+
+		return true;
+	}
+
+	uint32_t RHI_DescriptorSetLayout::TrimDescriptorSets(const uint64_t frameUsedCutoff)
+	{
+		uint32_t trimmedCount = 0;
+
+		for (auto it = m_DescriptorSets.begin(); it != m_DescriptorSets.end();)
 		{
-			if (m_NeedsToBind)
+			if (it->second.RetrieveFrameUsed() < frameUsedCutoff)
 			{
-				descriptorSet = &it->second;
-				m_NeedsToBind = false;
+				it->second.Release();
+				it = m_DescriptorSets.erase(it);
+				trimmedCount++;
+			}
+			else
+			{
+				it++;
 			}
 		}
 
-		return true;
+		return trimmedCount;
+	}
+
+	void RHI_DescriptorSetLayout::RetrieveFramesUsed(std::vector<uint64_t>& framesUsed) const
+	{
+		for (const std::pair<const uint32_t, RHI_DescriptorSet>& descriptorSet : m_DescriptorSets)
+		{
+			framesUsed.emplace_back(descriptorSet.second.RetrieveFrameUsed());
+		}
 	}
 
 	const std::array<uint32_t, g_RHI_MaxConstantBufferCount> RHI_DescriptorSetLayout::RetrieveDynamicOffsets() const // Retrieves all dynamic offsets.
@@ -18,11 +18,16 @@ namespace Amethyst
 		bool SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constantBuffer);
 		void SetSampler(const uint32_t slot, RHI_Sampler* sampler);
 		void SetTexture(const uint32_t slot, RHI_Texture* texture, const bool isStorage);
+		bool SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structuredBuffer);
 
 		bool RetrieveDescriptorSet(RHI_DescriptorSetLayoutCache* descriptorSetLayoutCache, RHI_DescriptorSet*& descriptorSet);
 		const std::array<uint32_t, g_RHI_MaxConstantBufferCount> RetrieveDynamicOffsets() const;
 		uint32_t RetrieveDynamicOffsetCount() const;
 		uint32_t RetrieveDescriptorSetCount() const { return static_cast<uint32_t>(m_DescriptorSets.size()); }
+
+		//Trimming - Frees the sets last bound before the given frame.
+		uint32_t TrimDescriptorSets(const uint64_t frameUsedCutoff);
+		void RetrieveFramesUsed(std::vector<uint64_t>& framesUsed) const;
 		void NeedsToBind() { m_NeedsToBind = true; }
 		void* RetrieveResource() const { return m_Resource; }
 
@@ -3,6 +3,7 @@
 #include "RHI_Shader.h"
 #include "RHI_Pipeline.h"
 #include "RHI_DescriptorSetLayout.h"
+#include <algorithm>
 
 namespace Amethyst
 {
@@ -10,12 +11,23 @@ namespace Amethyst
 	{
 		m_RHI_Device = rhi_Device;
 
-		//Set the descriptor set capacity to an initial value.
-		SetDescriptorSetCapacity(16); // Creates the descriptor pool.
+		//Start the chain off with a pool, so that the first frame doesn't have to create one.
+		if (void* descriptorPool = CreateDescriptorPool())
+		{
+			m_DescriptorPools.push_back({ descriptorPool });
+		}
 	}
 
 	void RHI_DescriptorSetLayoutCache::SetPipelineState(RHI_PipelineState& pipelineState)
 	{
+		//Built states hold on to the layout they got last time, for as long as it hasn't been reset since.
+		if (pipelineState.IsBuilt() && pipelineState.m_ResolvedDescriptorSetLayout && pipelineState.m_ResolvedDescriptorSetLayoutGeneration == m_Generation)
+		{
+			m_DescriptorSetLayoutCurrent = pipelineState.m_ResolvedDescriptorSetLayout;
+			m_DescriptorSetLayoutCurrent->NeedsToBind();
+			return;
+		}
+
 		//Retrieve pipeline descriptors.
 		RetrieveDescriptors(pipelineState, m_Descriptors);
 
@@ -42,6 +54,12 @@ namespace Amethyst
 		//Retrieve the descriptor set layout we will be using.
 		m_DescriptorSetLayoutCurrent = it->second.get();
 		m_DescriptorSetLayoutCurrent->NeedsToBind();
+
+		if (pipelineState.IsBuilt())
+		{
+			pipelineState.m_ResolvedDescriptorSetLayout = m_DescriptorSetLayoutCurrent;
+			pipelineState.m_ResolvedDescriptorSetLayoutGeneration = m_Generation;
+		}
 	}
 
 	bool RHI_DescriptorSetLayoutCache::SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constantBuffer)
@@ -62,21 +80,128 @@ namespace Amethyst
 		m_DescriptorSetLayoutCurrent->SetTexture(slot, texture, storage);
 	}
 
+	bool RHI_DescriptorSetLayoutCache::SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structuredBuffer)
+	{
+		AMETHYST_ASSERT(m_DescriptorSetLayoutCurrent != nullptr);
+		return m_DescriptorSetLayoutCurrent->SetStructuredBuffer(slot, structuredBuffer);
+	}
+
 	bool RHI_DescriptorSetLayoutCache::RetrieveDescriptorSet(RHI_DescriptorSet*& descriptorSet)
 	{
 		AMETHYST_ASSERT(m_DescriptorSetLayoutCurrent != nullptr);
 		return m_DescriptorSetLayoutCurrent->RetrieveDescriptorSet(this, descriptorSet);
 	}
 
-	void RHI_DescriptorSetLayoutCache::GrowIfNeeded()
+	void RHI_DescriptorSetLayoutCache::BeginFrame(const uint64_t frameIndex)
+	{
+		m_FrameIndex = frameIndex;
+		TrimDescriptorSets();
+	}
+
+	void RHI_DescriptorSetLayoutCache::TrimDescriptorSets()
 	{
-		//If there is room for at least one more descriptor set (hence +1), we don't need to re-allocate yet.
-		const uint32_t requiredCapacity = RetrieveDescriptorSetCount() + 1;
+		//Nothing has been around for long enough yet.
+		if (m_FrameIndex < g_RHI_DescriptorSetMinAge)
+		{
+			return;
+		}
+
+		//Sets which went unused for long enough go regardless.
+		uint64_t frameUsedCutoff = m_FrameIndex > g_RHI_DescriptorSetMaxAge ? m_FrameIndex - g_RHI_DescriptorSetMaxAge : 0;
+
+		//Over budget, the least recently bound go as well, for as long as the GPU can't be using them.
+		const uint32_t descriptorSetCount = RetrieveDescriptorSetCount();
+		if (descriptorSetCount > g_RHI_DescriptorSetBudget)
+		{
+			std::vector<uint64_t> framesUsed;
+			framesUsed.reserve(descriptorSetCount);
+			for (const std::pair<const std::size_t, std::shared_ptr<RHI_DescriptorSetLayout>>& descriptorSetLayout : m_DescriptorSetLayouts)
+			{
+				descriptorSetLayout.second->RetrieveFramesUsed(framesUsed);
+			}
+
+			//The frame the oldest of the sets over budget were last bound in. Everything bound before or in it goes.
+			const uint32_t overBudgetCount = descriptorSetCount - g_RHI_DescriptorSetBudget;
+			std::nth_element(framesUsed.begin(), framesUsed.begin() + (overBudgetCount - 1), framesUsed.end());
+			const uint64_t frameUsedBudget = Math::Utilities::Min(framesUsed[overBudgetCount - 1] + 1, m_FrameIndex - g_RHI_DescriptorSetMinAge);
+
+			frameUsedCutoff = Math::Utilities::Max(frameUsedCutoff, frameUsedBudget);
+		}
+
+		if (frameUsedCutoff == 0)
+		{
+			return;
+		}
+
+		for (const std::pair<const std::size_t, std::shared_ptr<RHI_DescriptorSetLayout>>& descriptorSetLayout : m_DescriptorSetLayouts)
+		{
+			descriptorSetLayout.second->TrimDescriptorSets(frameUsedCutoff);
+		}
+	}
+
+	bool RHI_DescriptorSetLayoutCache::AllocateDescriptorSet(void* descriptorSetLayout, void*& descriptorSet, uint32_t& poolIndex)
+	{
+		//Start from the pool which last had room, as the ones before it are likely still full.
+		const uint32_t descriptorPoolCount = static_cast<uint32_t>(m_DescriptorPools.size());
+		for (uint32_t i = 0; i < descriptorPoolCount; i++)
+		{
+			const uint32_t index = (m_DescriptorPoolIndex + i) % descriptorPoolCount;
+			DescriptorPool& descriptorPool = m_DescriptorPools[index];
+
+			if (descriptorPool.m_IsFull || descriptorPool.m_SetCount == g_RHI_DescriptorPoolCapacity)
+			{
+				continue;
+			}
+
+			if (AllocateFromDescriptorPool(descriptorPool.m_Resource, descriptorSetLayout, descriptorSet))
+			{
+				descriptorPool.m_SetCount++;
+				m_DescriptorPoolIndex = index;
+				poolIndex = index;
+				return true;
+			}
+
+			//Out of descriptors before sets, which depends on the layouts allocated from it.
+			descriptorPool.m_IsFull = true;
+		}
+
+		//Every pool is full, so chain another one. The existing ones and their sets are left as they are, so nothing has to wait for the GPU.
+		void* newDescriptorPool = CreateDescriptorPool();
+		if (!newDescriptorPool)
+		{
+			AMETHYST_ERROR("Failed to create descriptor pool.");
+			return false;
+		}
+
+		m_DescriptorPools.push_back({ newDescriptorPool });
+		m_DescriptorPoolIndex = descriptorPoolCount;
+		AMETHYST_INFO("Descriptor pools have been increased to %d.", descriptorPoolCount + 1);
+
+		if (!AllocateFromDescriptorPool(newDescriptorPool, descriptorSetLayout, descriptorSet))
+		{
+			AMETHYST_ERROR("Failed to allocate descriptor set.");
+			return false;
+		}
+
+		m_DescriptorPools.back().m_SetCount++;
+		poolIndex = descriptorPoolCount;
+
+		return true;
+	}
+
+	void RHI_DescriptorSetLayoutCache::FreeDescriptorSet(void*& descriptorSet, const uint32_t poolIndex)
+	{
+		AMETHYST_ASSERT(poolIndex < m_DescriptorPools.size());
+
+		DescriptorPool& descriptorPool = m_DescriptorPools[poolIndex];
+		FreeToDescriptorPool(descriptorPool.m_Resource, descriptorSet);
+		descriptorPool.m_SetCount--;
+		descriptorPool.m_IsFull = false;
 
-		//If we are over budget, re-allocate the descriptor pool with double its current size.
-		if (requiredCapacity > m_DescriptorSetCapacity)
+		//Once empty, the pool is reset rather than left fragmented, and is then as good as new for whichever frame allocates from it next.
+		if (descriptorPool.m_SetCount == 0)
 		{
-			SetDescriptorSetCapacity(m_DescriptorSetCapacity * 2);
+			ResetDescriptorPool(descriptorPool.m_Resource);
 		}
 	}
 
@@ -7,6 +7,18 @@
 
 namespace Amethyst
 {
+	// Pools are chained, each holding up to this many sets.
+	static const uint32_t g_RHI_DescriptorPoolCapacity = 256;
+
+	/*
+		Sets which haven't been bound for g_RHI_DescriptorSetMaxAge frames are freed. Past g_RHI_DescriptorSetBudget sets, the least recently bound ones are
+		freed early, but never ones bound within the last g_RHI_DescriptorSetMinAge frames. That's more frames than the GPU can be behind by, so freeing
+		never has to wait for it.
+	*/
+	static const uint32_t g_RHI_DescriptorSetMaxAge = 120;
+	static const uint32_t g_RHI_DescriptorSetMinAge = 8;
+	static const uint32_t g_RHI_DescriptorSetBudget = 2048;
+
 	class RHI_DescriptorSetLayoutCache : public AmethystObject
 	{
 	public:
@@ -19,22 +31,33 @@ namespace Amethyst
 		bool SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constantBuffer);
 		void SetSampler(const uint32_t slot, RHI_Sampler* sampler);
 		void SetTexture(const uint32_t slot, RHI_Texture* texture, const bool storage);
+		bool SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structuredBuffer);
 
 		RHI_DescriptorSetLayout* RetrieveCurrentDescriptorSetLayout() const { return m_DescriptorSetLayoutCurrent; }
 		bool RetrieveDescriptorSet(RHI_DescriptorSet*& descriptorSet);
-		void ResetDescriptorCache(uint32_t descriptorSetCapacity = 0);
-		void* RetrieveDescriptorPool() const { return m_DescriptorPool; }
+		void ResetDescriptorCache();
 
-		//Capacity
-		bool HasEnoughCapacity() const { return m_DescriptorSetCapacity > RetrieveDescriptorSetCount(); }
-		void GrowIfNeeded();
+		//Frames - Called once the frame's command list has begun, which is when sets that have gone unused for long enough are freed.
+		void BeginFrame(const uint64_t frameIndex);
+		uint64_t RetrieveFrameIndex() const { return m_FrameIndex; }
 
-	private:
+		//Pools - A set is allocated from the first pool with room, and a pool is added to the chain when none has any.
+		bool AllocateDescriptorSet(void* descriptorSetLayout, void*& descriptorSet, uint32_t& poolIndex);
+		void FreeDescriptorSet(void*& descriptorSet, const uint32_t poolIndex);
+		uint32_t RetrieveDescriptorPoolCount() const { return static_cast<uint32_t>(m_DescriptorPools.size()); }
 		uint32_t RetrieveDescriptorSetCount() const;
-		void SetDescriptorSetCapacity(uint32_t descriptorSetCapacity);
-		bool CreateDescriptorPool(uint32_t descriptorSetCapacity);
+
+	private:
+		void TrimDescriptorSets();
 		void RetrieveDescriptors(RHI_PipelineState& pipelineState, std::vector<RHI_Descriptor>& descriptors);
 
+		//API
+		void* CreateDescriptorPool();
+		void DestroyDescriptorPool(void*& descriptorPool);
+		void ResetDescriptorPool(void* descriptorPool);
+		bool AllocateFromDescriptorPool(void* descriptorPool, void* descriptorSetLayout, void*& descriptorSet);
+		void FreeToDescriptorPool(void* descriptorPool, void*& descriptorSet);
+
 	private:
 		/*	
 			A descriptor is a special opaque variable that shaders use to access buffer and image resources in an indirect fashion. It can be thought of a pointer to a resource.
@@ -53,12 +76,21 @@ namespace Amethyst
 		RHI_DescriptorSetLayout* m_DescriptorSetLayoutCurrent = nullptr;
 		std::vector<RHI_Descriptor> m_Descriptors;
 		
-		//Descriptor Pool
-		void* m_DescriptorPool = nullptr;
-		uint32_t m_DescriptorSetCapacity = 0;
+		//Descriptor Pools - Only ever added to, so a set's pool index stays valid for as long as the set lives.
+		struct DescriptorPool
+		{
+			void* m_Resource = nullptr;
+			uint32_t m_SetCount = 0;
+			bool m_IsFull = false; // Ran out of descriptors before sets. Cleared once a set is freed from it.
+		};
+
+		std::vector<DescriptorPool> m_DescriptorPools;
+		uint32_t m_DescriptorPoolIndex = 0; // The last one that had room.
+		uint64_t m_FrameIndex = 0;
 
 		//Misc
 		std::atomic<bool> m_AreDescriptorSetLayoutsBeingCleared = false;
+		uint32_t m_Generation = 0; // Bumped whenever the layouts are destroyed, so that built pipeline states know to look theirs up again.
 		const RHI_Device* m_RHI_Device;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Amethyst.h"
 #include "RHI_Device.h"
 #include "RHI_Implementation.h"
+#include "RHI_UploadHeap.h"
 
 namespace Amethyst
 {
@@ -45,6 +46,12 @@ namespace Amethyst
 
 	bool RHI_Device::Queue_WaitAll() const
 	{
+		// Uploads which were recorded or copied but not yet acquired are part of "all", and the resources they write to are usually about to be destroyed.
+		if (RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(this))
+		{
+			uploadHeap->Flush(true);
+		}
+
 		return Queue_Wait(RHI_Queue_Graphics) && Queue_Wait(RHI_Queue_Transfer) && Queue_Wait(RHI_Queue_Compute);
 	}
 
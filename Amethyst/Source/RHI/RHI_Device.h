@@ -7,6 +7,15 @@
 
 namespace Amethyst
 {
+	struct RHI_MemoryStatistics
+	{
+		uint64_t m_BytesAllocated = 0; // Device memory blocks allocated by the API.
+		uint64_t m_BytesUsed = 0;	   // Portion of those blocks occupied by resources.
+		uint64_t m_BytesBudget = 0;	   // How much the process can allocate before the OS starts to evict (if reported by the driver).
+		uint32_t m_AllocationCount = 0;
+		uint32_t m_BlockCount = 0;
+	};
+
 	class RHI_Device : public AmethystObject
 	{
 	public:
@@ -21,13 +30,16 @@ namespace Amethyst
 
 		//Queue
 		bool Queue_Present(void* swapchainView, uint32_t* imageIndex, RHI_Semaphore* waitSemaphore = nullptr) const;
-		bool Queue_Submit(const RHI_Queue_Type queueType, const uint32_t waitFlags, void* commandBuffer, RHI_Semaphore* waitSemaphore = nullptr, RHI_Semaphore* signalSemaphore = nullptr, RHI_Fence* signalFence = nullptr) const;
+		bool Queue_Submit(const RHI_Queue_Type queueType, const uint32_t waitFlags, void* commandBuffer, RHI_Semaphore* waitSemaphore = nullptr, RHI_Semaphore* signalSemaphore = nullptr, RHI_Fence* signalFence = nullptr, const uint64_t waitValue = 0, const uint64_t signalValue = 0) const; // The values are only used by timeline semaphores.
 		bool Queue_Wait(const RHI_Queue_Type queueType) const;
 
 		bool Queue_WaitAll() const;
 		void* Queue_Retrieve(const RHI_Queue_Type queueType) const;
 		uint32_t Queue_Index(const RHI_Queue_Type queueType) const;
 
+		//Memory
+		void RetrieveMemoryStatistics(RHI_MemoryStatistics& statistics) const;
+
 		//Misc
 		static bool IsValidResolution(const uint32_t width, const uint32_t height);
 		bool IsInitialized() const { return m_IsInitialized; }
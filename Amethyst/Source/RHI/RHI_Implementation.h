@@ -1,5 +1,7 @@
 #pragma once
+#if !defined(API_GRAPHICS_NULL)
 #define API_GRAPHICS_VULKAN
+#endif
 #define DEBUG
 
 //Definition - OpenGL
@@ -16,6 +18,50 @@
 
 
 
+//Definition - Null
+#if defined(API_GRAPHICS_NULL)
+#include <array>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <unordered_set>
+#include "Null/Null_CommandStream.h"
+
+enum class Null_Resource_Type : uint8_t
+{
+	Buffer,
+	Image,
+	ImageView,
+	Sampler,
+	Shader,
+	Pipeline,
+	PipelineLayout,
+	PipelineCache,
+	RenderPass,
+	Framebuffer,
+	DescriptorPool,
+	DescriptorSetLayout,
+	DescriptorSet,
+	CommandPool,
+	Fence,
+	Semaphore,
+	Surface,
+	Swapchain,
+	Memory, // Shared by aliased textures, holds no bytes of its own.
+	Count
+};
+
+// What every null handle points to.
+struct Null_Resource
+{
+	Null_Resource_Type m_Type = Null_Resource_Type::Count;
+	std::vector<std::byte> m_Memory;   // Buffers only, in place of device memory.
+	std::atomic<uint64_t> m_Value = 0; // Fence state or timeline semaphore value.
+	std::vector<void*> m_Children;	   // Freed along with this resource, like descriptor sets with their pool.
+};
+
+#endif
+
 //Definition - Vulkan
 
 #if defined(API_GRAPHICS_VULKAN)
@@ -179,6 +225,24 @@ namespace Amethyst
 		#if defined (API_GRAPHICS_D3D12)
 		#endif
 		
+		#if defined (API_GRAPHICS_NULL)
+
+		RHI_API_Type m_APIType											= RHI_API_Type::RHI_API_Null;
+		bool m_IsValidationEnabled										= true; // Checks recorded commands. Worth turning off when measuring CPU cost.
+
+		// Nothing is executed, so submissions are tallied instead.
+		Null_CommandStatistics m_SubmittedStatistics;
+		uint64_t m_SubmissionCount										= 0;
+		uint64_t m_PresentCount											= 0;
+
+		// Live API objects.
+		std::mutex m_ResourceMutex;
+		std::unordered_set<const void*> m_Resources;
+		std::array<uint32_t, static_cast<uint32_t>(Null_Resource_Type::Count)> m_ResourceCounts = {};
+		uint64_t m_ResourceBytes										= 0;
+
+		#endif
+
 		#if defined (API_GRAPHICS_VULKAN)
 
 		RHI_API_Type m_APIType											= RHI_API_Type::RHI_API_Vulkan;
@@ -189,6 +253,7 @@ namespace Amethyst
 		VkPhysicalDeviceProperties m_PhysicalDeviceProperties			= {};
 		VkPhysicalDeviceVulkan12Features m_PhysicalDeviceFeatures1_2    = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
 		VkPhysicalDeviceFeatures2 m_PhysicalDeviceFeatures				= { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &m_PhysicalDeviceFeatures1_2 };
+		bool m_IsDescriptorIndexingSupported							= false; // Everything RHI_BindlessHeap needs.
 		VkFormat m_SurfaceFormat										= VK_FORMAT_UNDEFINED;
 		VkColorSpaceKHR	m_SurfaceColorSpace								= VK_COLOR_SPACE_MAX_ENUM_KHR;
 		VmaAllocator m_Allocator										= nullptr;
@@ -275,4 +340,6 @@ namespace Amethyst
 
 #elif defined (API_GRAPHICS_VULKAN)
 	#include "Vulkan/Vulkan_Utility.h"
+#elif defined (API_GRAPHICS_NULL)
+	#include "Null/Null_Utility.h"
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "../Core/AmethystObject.h"
+#include "RHI_UploadHeap.h"
 #include "RHI_Device.h"
 
 namespace Amethyst
@@ -51,6 +52,13 @@ namespace Amethyst
 		void* Map();
 		bool Unmap();
 
+		// Whether the data the buffer was created with has reached the graphics queue. Until then, it isn't drawn.
+		bool IsResident() const
+		{
+			RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+			return !uploadHeap || uploadHeap->IsResident(m_UploadValue);
+		}
+
 		void* RetrieveResource() const { return m_Buffer; }
 		uint32_t RetrieveIndexCount() const { return m_IndexCount; }
 		bool Is16Bit() const { return sizeof(uint16_t) == m_Stride; }
@@ -71,6 +79,7 @@ namespace Amethyst
 		void* m_Buffer = nullptr; // Data buffer.
 		void* m_BufferAllocation = nullptr; // Buffer memory allocation via VMA.
 		bool m_IsMappable = true;
+		uint64_t m_UploadValue = 0;
 
 		//API
 		std::shared_ptr<RHI_Device> m_RHI_Device;
@@ -8,7 +8,7 @@ namespace Amethyst
 	{
 	public:
 		RHI_Pipeline() = default;
-		RHI_Pipeline(const RHI_Device* rhi_Device, RHI_PipelineState& rhi_PipelineState, RHI_DescriptorSetLayout* rhi_DescriptorSetLayout);
+		RHI_Pipeline(const RHI_Device* rhi_Device, RHI_PipelineState& rhi_PipelineState, RHI_DescriptorSetLayout* rhi_DescriptorSetLayout, void* rhi_PipelineCache = nullptr);
 		~RHI_Pipeline();
 
 		void* RetrievePipeline() const { return m_Pipeline; }
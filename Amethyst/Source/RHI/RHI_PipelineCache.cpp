@@ -1,36 +1,157 @@
 #include "Amethyst.h"
 #include "RHI_PipelineCache.h"
+#include "RHI_Device.h"
 #include "RHI_Texture.h"
 #include "RHI_Pipeline.h"
 #include "RHI_SwapChain.h"
 #include "RHI_DescriptorSetLayoutCache.h"
+#include "../Core/FileSystem.h"
+#include "../Threading/Threading.h"
 
 namespace Amethyst
 {
-	RHI_Pipeline* RHI_PipelineCache::RetrievePipeline(RHI_CommandList* commandList, RHI_PipelineState& pipelineState, RHI_DescriptorSetLayout* descriptorSetLayout)
+	RHI_Pipeline* RHI_PipelineCache::RetrievePipeline(RHI_CommandList* commandList, RHI_PipelineState& pipelineState, RHI_DescriptorSetLayout* descriptorSetLayout, bool& isCompiling)
 	{
-		//Validate it.
-		if (!pipelineState.IsPipelineStateValid())
+		isCompiling = false;
+
+		//Built states were validated and hashed up front, and hold on to their pipeline once it's ready.
+		if (pipelineState.IsBuilt())
 		{
-			AMETHYST_ERROR("Invalid pipeline state.");
-			return nullptr;
+			pipelineState.TransitionRenderTargetLayouts(commandList);
+
+			if (pipelineState.m_ResolvedPipeline)
+			{
+				return pipelineState.m_ResolvedPipeline;
+			}
 		}
+		else
+		{
+			//Validate it.
+			if (!pipelineState.IsPipelineStateValid())
+			{
+				AMETHYST_ERROR("Invalid pipeline state.");
+				return nullptr;
+			}
+
+			//Render target layout transitions.
+			pipelineState.TransitionRenderTargetLayouts(commandList); ///
 
-		//Render target layout transitions.
-		pipelineState.TransitionRenderTargetLayouts(commandList); ///
+			//Compute a hash for it.
+			pipelineState.ComputeHash();
+		}
 
-		//Compute a hash for it.
-		uint32_t hash = pipelineState.ComputeHash();
+		const uint64_t hash = pipelineState.RetrieveHash();
+
+		//Keys can collide, so the state itself decides which pipeline under the key, if any, is ours.
+		std::vector<std::shared_ptr<Entry>>& entries = m_PipelineCache[hash];
+		std::shared_ptr<Entry> entry = nullptr;
+		for (const std::shared_ptr<Entry>& candidate : entries)
+		{
+			if (candidate->m_PipelineState.IsEquivalent(pipelineState))
+			{
+				entry = candidate;
+				break;
+			}
+		}
 
 		//If no pipeline exists for this state, create one.
-		auto it = m_PipelineCache.find(hash);
-		if (it == m_PipelineCache.end())
+		if (!entry)
 		{
-			//Cache a new pipeline.
-			it = m_PipelineCache.emplace(std::make_pair(hash, std::move(std::make_shared<RHI_Pipeline>(m_RHI_Device, pipelineState, descriptorSetLayout)))).first;
-			AMETHYST_INFO("A new pipeline has been created.");
+			if (!entries.empty())
+			{
+				AMETHYST_WARNING("Pipeline key %llu is shared by %d different states.", static_cast<unsigned long long>(hash), static_cast<uint32_t>(entries.size()) + 1);
+			}
+
+			entry = std::make_shared<Entry>();
+			entry->m_PipelineState = pipelineState;
+			entry->m_ContentHash = pipelineState.ComputeContentHash();
+			entries.emplace_back(entry);
+			m_PipelineCount++;
+
+			//Dummy pipelines have no shaders to compile, and the previous run's are cheap to create thanks to the driver cache.
+			if (!pipelineState.IsDummyPipeline() && m_PrewarmHashes.find(entry->m_ContentHash) == m_PrewarmHashes.end())
+			{
+				m_CompilingCount++;
+				m_RHI_Device->RetrieveContextEngine()->RetrieveSubsystem<Threading>()->AddTask([this, entry, descriptorSetLayout]()
+				{
+					CreatePipeline(*entry, descriptorSetLayout);
+
+					//Notified under the lock, as a waiting destructor may otherwise destroy the condition before it's notified.
+					std::lock_guard<std::mutex> lock(m_CompilingMutex);
+					m_CompilingCount--;
+					m_CompilingCondition.notify_all();
+				});
+			}
+			else
+			{
+				CreatePipeline(*entry, descriptorSetLayout);
+			}
+		}
+
+		if (!entry->m_IsReady.load())
+		{
+			isCompiling = true;
+			return nullptr;
 		}
 
-		return it->second.get();
+		if (pipelineState.IsBuilt())
+		{
+			pipelineState.m_ResolvedPipeline = entry->m_Pipeline.get();
+		}
+
+		return entry->m_Pipeline.get();
+	}
+
+	void RHI_PipelineCache::WaitForCompilation() const
+	{
+		std::unique_lock<std::mutex> lock(m_CompilingMutex);
+		m_CompilingCondition.wait(lock, [this]() { return m_CompilingCount.load() == 0; });
+	}
+
+	void RHI_PipelineCache::CreatePipeline(Entry& entry, RHI_DescriptorSetLayout* descriptorSetLayout) const
+	{
+		entry.m_Pipeline = std::make_shared<RHI_Pipeline>(m_RHI_Device, entry.m_PipelineState, descriptorSetLayout, m_Resource);
+		entry.m_IsReady = true;
+
+		AMETHYST_INFO("A new pipeline has been created.");
+	}
+
+	void RHI_PipelineCache::LoadPrewarmList()
+	{
+		std::ifstream file(g_RHI_PipelineCachePrewarmFilePath);
+		std::string line;
+
+		//Each line is a content hash, followed by the name of the pass it was created for. The name is only there for whoever reads the file.
+		while (std::getline(file, line))
+		{
+			uint64_t contentHash = 0;
+			if (std::istringstream(line) >> std::hex >> contentHash)
+			{
+				m_PrewarmHashes.insert(contentHash);
+			}
+		}
+
+		if (!m_PrewarmHashes.empty())
+		{
+			AMETHYST_INFO("%d pipelines were created by the previous run.", static_cast<uint32_t>(m_PrewarmHashes.size()));
+		}
+	}
+
+	void RHI_PipelineCache::SavePrewarmList() const
+	{
+		FileSystem::CreateDirectory_(g_RHI_PipelineCacheDirectory);
+		std::ofstream file(g_RHI_PipelineCachePrewarmFilePath, std::ios::trunc);
+
+		for (const std::pair<const uint64_t, std::vector<std::shared_ptr<Entry>>>& entries : m_PipelineCache)
+		{
+			for (const std::shared_ptr<Entry>& entry : entries.second)
+			{
+				//Only the ones the driver actually created.
+				if (entry->m_IsReady.load() && entry->m_Pipeline->RetrievePipeline())
+				{
+					file << std::hex << entry->m_ContentHash << " " << (entry->m_PipelineState.m_PassName ? entry->m_PipelineState.m_PassName : "Unnamed") << "\n";
+				}
+			}
+		}
 	}
 }
\ No newline at end of file
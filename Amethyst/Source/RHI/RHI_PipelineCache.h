@@ -1,20 +1,70 @@
 #pragma once
 #include <memory>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <unordered_map>
+#include <unordered_set>
 #include "RHI_Utilities.h"
+#include "RHI_PipelineState.h"
 #include "../Core/AmethystObject.h"
 
 namespace Amethyst
 {
+	// Written on shutdown and read back on startup.
+	static constexpr const char* g_RHI_PipelineCacheDirectory = "Resources\\Cache";
+	static constexpr const char* g_RHI_PipelineCacheBlobFilePath = "Resources\\Cache\\Pipelines.bin";
+	static constexpr const char* g_RHI_PipelineCachePrewarmFilePath = "Resources\\Cache\\Pipelines.txt";
+
+	/*
+		Pipelines are keyed by a 64-bit hash of their state. As keys can still collide, every state stored under a key is compared against on lookup, and
+		a state which merely shares a key gets a pipeline of its own rather than somebody else's.
+
+		Pipelines with shaders are created on worker threads, as creation is where the driver compiles them. Until one is done, RetrievePipeline reports it
+		as compiling and the pass asking for it is skipped for that frame. The driver's own cache is saved to disk on shutdown and loaded on startup, along
+		with the content hash (shaders, defines and state descriptions, see RHI_PipelineState::ComputeContentHash) of every pipeline that was created. Object IDs
+		differ from one run to the next, so the keys themselves can't be. States seen by the previous run are created right away instead, as the driver cache
+		makes them cheap and the passes that were drawn last time then don't pop in over the first few frames.
+	*/
 	class RHI_PipelineCache : public AmethystObject
 	{
 	public:
-		RHI_PipelineCache(const RHI_Device* rhi_Device) { m_RHI_Device = rhi_Device; }
-		RHI_Pipeline* RetrievePipeline(RHI_CommandList* commandList, RHI_PipelineState& pipelineState, RHI_DescriptorSetLayout* descriptorSetLayout);
+		RHI_PipelineCache(const RHI_Device* rhi_Device);
+		~RHI_PipelineCache();
+
+		// Returns nullptr if the state is invalid or its pipeline is still compiling, which isCompiling tells apart.
+		RHI_Pipeline* RetrievePipeline(RHI_CommandList* commandList, RHI_PipelineState& pipelineState, RHI_DescriptorSetLayout* descriptorSetLayout, bool& isCompiling);
+
+		// Blocks until no pipeline is compiling, for when something they are created from (descriptor set layouts, render targets) is about to go away.
+		void WaitForCompilation() const;
+
+		uint32_t RetrievePipelineCount() const { return m_PipelineCount; }
+		uint32_t RetrieveCompilingCount() const { return m_CompilingCount.load(); }
+		void* RetrieveResource() const { return m_Resource; }
 
 	private:
-		//Hash of pipeline state.
-		std::unordered_map<uint32_t, std::shared_ptr<RHI_Pipeline>> m_PipelineCache;
+		struct Entry
+		{
+			RHI_PipelineState m_PipelineState; // A copy of what the key was computed from.
+			uint64_t m_ContentHash = 0;
+			std::shared_ptr<RHI_Pipeline> m_Pipeline;
+			std::atomic<bool> m_IsReady = false;
+		};
+
+		void CreatePipeline(Entry& entry, RHI_DescriptorSetLayout* descriptorSetLayout) const;
+		void LoadPrewarmList();
+		void SavePrewarmList() const;
+
+		std::unordered_map<uint64_t, std::vector<std::shared_ptr<Entry>>> m_PipelineCache;
+		std::unordered_set<uint64_t> m_PrewarmHashes; // Content hashes of what the previous run created.
+		uint32_t m_PipelineCount = 0;
+		std::atomic<uint32_t> m_CompilingCount = 0;
+		mutable std::mutex m_CompilingMutex;
+		mutable std::condition_variable m_CompilingCondition; // Notified whenever a compilation finishes.
+
+		//API
+		void* m_Resource = nullptr;
 
 		//Dependencies
 		const RHI_Device* m_RHI_Device;
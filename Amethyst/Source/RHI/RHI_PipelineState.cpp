@@ -8,6 +8,7 @@
 #include "RHI_RasterizerState.h"
 #include "RHI_DepthStencilState.h"
 #include "../Utilities/Hash.h"
+#include <algorithm>
 
 namespace Amethyst
 {
@@ -70,45 +71,82 @@ namespace Amethyst
 		m_ClearValueStencil = g_RHI_StencilLoadValue;
 	}
 
-	void RHI_PipelineState::TransitionRenderTargetLayouts(RHI_CommandList* rhi_CommandList)
+	bool RHI_PipelineState::Build()
+	{
+		//Whatever was resolved before belongs to the previous contents.
+		m_IsBuilt = false;
+		m_ResolvedPipeline = nullptr;
+		m_ResolvedDescriptorSetLayout = nullptr;
+
+		//Shaders which are still compiling make this fail, so it can be tried again later.
+		if (!IsPipelineStateValid())
+		{
+			return false;
+		}
+
+		ComputeRenderTargetLayouts();
+		ComputeHash();
+		m_IsBuilt = true;
+
+		return true;
+	}
+
+	void RHI_PipelineState::ComputeRenderTargetLayouts()
 	{
 		//Color
 		{
 			//Texture
 			for (uint8_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
 			{
-				if (RHI_Texture* texture = m_RenderTargetColorTextures[i])
+				if (m_RenderTargetColorTextures[i])
 				{
-					RHI_Image_Layout layout = RHI_Image_Layout::Color_Attachment_Optimal;
-
-					texture->SetLayout(layout, rhi_CommandList);
-					m_RenderTargetColorLayoutInitial = layout;
-					m_RenderTargetColorLayoutFinal = layout;
+					m_RenderTargetColorLayoutInitial = RHI_Image_Layout::Color_Attachment_Optimal;
+					m_RenderTargetColorLayoutFinal = RHI_Image_Layout::Color_Attachment_Optimal;
 				}
 			}
 
 			//Swapchain
-			if (RHI_SwapChain* swapchain = m_RenderTargetSwapchain)
+			if (m_RenderTargetSwapchain)
 			{
-				RHI_Image_Layout layout = RHI_Image_Layout::Present_Source;
-
-				m_RenderTargetColorLayoutInitial = layout;
-				m_RenderTargetColorLayoutFinal = layout;
+				m_RenderTargetColorLayoutInitial = RHI_Image_Layout::Present_Source;
+				m_RenderTargetColorLayoutFinal = RHI_Image_Layout::Present_Source;
 			}
 		}
 
 		//Depth
-		if (RHI_Texture* texture = m_RenderTargetDepthTexture)
+		if (m_RenderTargetDepthTexture)
 		{
 			RHI_Image_Layout layout = m_RenderTargetDepthTextureReadOnly ? RHI_Image_Layout::Depth_Stencil_Read_Only_Optimal : RHI_Image_Layout::Depth_Stencil_Attachment_Optimal;
-			
-			texture->SetLayout(layout, rhi_CommandList);
 
 			m_RenderTargetDepthLayoutInitial = layout;
 			m_RenderTargetDepthLayoutFinal = layout;
 		}
 	}
 
+	void RHI_PipelineState::TransitionRenderTargetLayouts(RHI_CommandList* rhi_CommandList)
+	{
+		//Built states worked theirs out already.
+		if (!m_IsBuilt)
+		{
+			ComputeRenderTargetLayouts();
+		}
+
+		//Color
+		for (uint8_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
+		{
+			if (RHI_Texture* texture = m_RenderTargetColorTextures[i])
+			{
+				texture->SetLayout(RHI_Image_Layout::Color_Attachment_Optimal, rhi_CommandList);
+			}
+		}
+
+		//Depth
+		if (RHI_Texture* texture = m_RenderTargetDepthTexture)
+		{
+			texture->SetLayout(m_RenderTargetDepthLayoutInitial, rhi_CommandList);
+		}
+	}
+
 	uint32_t RHI_PipelineState::RetrieveRenderTargetWidth() const
 	{
 		if (m_RenderTargetSwapchain)
@@ -149,7 +187,19 @@ namespace Amethyst
 		return 0;
 	}
 
-	uint32_t RHI_PipelineState::ComputeHash()
+	// 0 ignores, 1 loads and 2 clears whatever is in the render target.
+	template<typename T>
+	static uint8_t RetrieveLoadOperation(const T& clearValue, const T& ignoreValue, const T& loadValue)
+	{
+		return clearValue == ignoreValue ? 0 : clearValue == loadValue ? 1 : 2;
+	}
+
+	static uint32_t RetrieveID(const AmethystObject* object)
+	{
+		return object ? object->RetrieveObjectID() : 0;
+	}
+
+	uint64_t RHI_PipelineState::ComputeHash()
 	{
 		m_Hash = 0;
 
@@ -208,17 +258,14 @@ namespace Amethyst
 		//Render Targets
 		bool hasRenderTargetColor = false;
 		{
-			uint8_t loadOperation = 0;
-
-			//Color
+				//Color
 			for (uint32_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
 			{
 				if (RHI_Texture* texture = m_RenderTargetColorTextures[i])
 				{
 					Utility::HashCombine(m_Hash, texture->RetrieveObjectID());
 
-					loadOperation = m_ClearValuesColor[i] == g_RHI_ColorIgnoreValue ? 0 : m_ClearValuesColor[i] == g_RHI_ColorLoadValue ? 1 : 2;
-					Utility::HashCombine(m_Hash, loadOperation);
+					Utility::HashCombine(m_Hash, RetrieveLoadOperation(m_ClearValuesColor[i], g_RHI_ColorIgnoreValue, g_RHI_ColorLoadValue));
 
 					hasRenderTargetColor = true;
 				}
@@ -228,12 +275,8 @@ namespace Amethyst
 			if (m_RenderTargetDepthTexture)
 			{
 				Utility::HashCombine(m_Hash, m_RenderTargetDepthTexture->RetrieveObjectID());
-				
-				loadOperation = m_ClearValueDepth == g_RHI_DepthIgnoreValue ? 0 : m_ClearValueDepth == g_RHI_DepthLoadValue ? 1 : 2;
-				Utility::HashCombine(m_Hash, loadOperation);
-
-				loadOperation = m_ClearValueStencil == g_RHI_StencilIgnoreValue ? 0 : m_ClearValueStencil == g_RHI_StencilLoadValue ? 1 : 2;
-				Utility::HashCombine(m_Hash, loadOperation);
+				Utility::HashCombine(m_Hash, RetrieveLoadOperation(m_ClearValueDepth, g_RHI_DepthIgnoreValue, g_RHI_DepthLoadValue));
+				Utility::HashCombine(m_Hash, RetrieveLoadOperation(m_ClearValueStencil, g_RHI_StencilIgnoreValue, g_RHI_StencilLoadValue));
 			}
 		}
 
@@ -254,4 +297,207 @@ namespace Amethyst
 
 		return m_Hash;
 	}
+
+	uint64_t RHI_PipelineState::ComputeContentHash() const
+	{
+		uint64_t hash = 0;
+
+		Utility::HashCombine(hash, m_IsScissorDynamic);
+		Utility::HashCombine(hash, m_Viewport.m_X);
+		Utility::HashCombine(hash, m_Viewport.m_Y);
+		Utility::HashCombine(hash, m_Viewport.m_Width);
+		Utility::HashCombine(hash, m_Viewport.m_Height);
+		Utility::HashCombine(hash, m_PrimitiveTopology);
+		Utility::HashCombine(hash, m_VertexBufferStride);
+		Utility::HashCombine(hash, m_RenderTargetColorTextureArrayIndex);
+		Utility::HashCombine(hash, m_RenderTargetDepthStencilTextureArrayIndex);
+
+		if (!m_IsScissorDynamic)
+		{
+			Utility::HashCombine(hash, m_Scissor.m_Left);
+			Utility::HashCombine(hash, m_Scissor.m_Top);
+			Utility::HashCombine(hash, m_Scissor.m_Right);
+			Utility::HashCombine(hash, m_Scissor.m_Bottom);
+		}
+
+		//States
+		if (m_RasterizerState)
+		{
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveCullMode());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveFillMode());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveDepthClippingEnabled());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveScissorEnabled());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveAntialiasedLineEnabled());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveDepthBias());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveDepthBiasClamp());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveDepthBiasSlopeScaled());
+			Utility::HashCombine(hash, m_RasterizerState->RetrieveLineWidth());
+		}
+
+		if (m_BlendState)
+		{
+			Utility::HashCombine(hash, m_BlendState->RetrieveBlendingEnabled());
+			Utility::HashCombine(hash, m_BlendState->RetrieveSourceBlendFunction());
+			Utility::HashCombine(hash, m_BlendState->RetrieveDestinationBlendFunction());
+			Utility::HashCombine(hash, m_BlendState->RetrieveBlendOperation());
+			Utility::HashCombine(hash, m_BlendState->RetrieveSourceBlendFunctionAlpha());
+			Utility::HashCombine(hash, m_BlendState->RetrieveDestinationBlendFunctionAlpha());
+			Utility::HashCombine(hash, m_BlendState->RetrieveBlendOperationAlpha());
+		}
+
+		if (m_DepthStencilState)
+		{
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveDepthTestingEnabled());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveDepthWritingEnabled());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveDepthComparisonFunction());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilTestingEnabled());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilWritingEnabled());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilComparisonFunction());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilFailOperation());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilDepthFailOperation());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilPassOperation());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilReadMask());
+			Utility::HashCombine(hash, m_DepthStencilState->RetrieveStencilWriteMask());
+		}
+
+		//Shaders - By file and defines. The defines live in an unordered map, so they are sorted first.
+		for (const RHI_Shader* shader : { m_ComputeShader, m_VertexShader, m_PixelShader })
+		{
+			if (!shader)
+			{
+				Utility::HashCombine(hash, 0);
+				continue;
+			}
+
+			Utility::HashCombine(hash, shader->RetrieveFilePath());
+
+			std::vector<std::pair<std::string, std::string>> defines(shader->RetrieveDefines().begin(), shader->RetrieveDefines().end());
+			std::sort(defines.begin(), defines.end());
+			for (const std::pair<std::string, std::string>& define : defines)
+			{
+				Utility::HashCombine(hash, define.first);
+				Utility::HashCombine(hash, define.second);
+			}
+		}
+
+		//Render Targets - By format, along with how they are loaded and laid out.
+		if (m_RenderTargetSwapchain)
+		{
+			Utility::HashCombine(hash, m_RenderTargetSwapchain->RetrieveFormat());
+			Utility::HashCombine(hash, m_RenderTargetColorLayoutInitial);
+			Utility::HashCombine(hash, m_RenderTargetColorLayoutFinal);
+		}
+
+		for (uint32_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
+		{
+			if (const RHI_Texture* texture = m_RenderTargetColorTextures[i])
+			{
+				Utility::HashCombine(hash, i);
+				Utility::HashCombine(hash, texture->RetrieveFormat());
+				Utility::HashCombine(hash, RetrieveLoadOperation(m_ClearValuesColor[i], g_RHI_ColorIgnoreValue, g_RHI_ColorLoadValue));
+				Utility::HashCombine(hash, m_RenderTargetColorLayoutInitial);
+				Utility::HashCombine(hash, m_RenderTargetColorLayoutFinal);
+			}
+		}
+
+		if (m_RenderTargetDepthTexture)
+		{
+			Utility::HashCombine(hash, m_RenderTargetDepthTexture->RetrieveFormat());
+			Utility::HashCombine(hash, RetrieveLoadOperation(m_ClearValueDepth, g_RHI_DepthIgnoreValue, g_RHI_DepthLoadValue));
+			Utility::HashCombine(hash, RetrieveLoadOperation(m_ClearValueStencil, g_RHI_StencilIgnoreValue, g_RHI_StencilLoadValue));
+			Utility::HashCombine(hash, m_RenderTargetDepthLayoutInitial);
+			Utility::HashCombine(hash, m_RenderTargetDepthLayoutFinal);
+		}
+
+		return hash;
+	}
+
+	bool RHI_PipelineState::IsEquivalent(const RHI_PipelineState& pipelineState) const
+	{
+		// Everything ComputeHash() looks at, compared rather than hashed.
+		if (m_IsScissorDynamic != pipelineState.m_IsScissorDynamic || m_Viewport != pipelineState.m_Viewport || m_PrimitiveTopology != pipelineState.m_PrimitiveTopology || m_VertexBufferStride != pipelineState.m_VertexBufferStride)
+		{
+			return false;
+		}
+
+		if (m_RenderTargetColorTextureArrayIndex != pipelineState.m_RenderTargetColorTextureArrayIndex || m_RenderTargetDepthStencilTextureArrayIndex != pipelineState.m_RenderTargetDepthStencilTextureArrayIndex)
+		{
+			return false;
+		}
+
+		if (!m_IsScissorDynamic && !(m_Scissor == pipelineState.m_Scissor))
+		{
+			return false;
+		}
+
+		// States and Shaders
+		const std::array<std::pair<const AmethystObject*, const AmethystObject*>, 7> objects =
+		{
+			std::make_pair(m_RenderTargetSwapchain, pipelineState.m_RenderTargetSwapchain),
+			std::make_pair(m_RasterizerState,       pipelineState.m_RasterizerState),
+			std::make_pair(m_BlendState,            pipelineState.m_BlendState),
+			std::make_pair(m_DepthStencilState,     pipelineState.m_DepthStencilState),
+			std::make_pair(m_ComputeShader,         pipelineState.m_ComputeShader),
+			std::make_pair(m_VertexShader,          pipelineState.m_VertexShader),
+			std::make_pair(m_PixelShader,           pipelineState.m_PixelShader)
+		};
+
+		for (const std::pair<const AmethystObject*, const AmethystObject*>& object : objects)
+		{
+			if (RetrieveID(object.first) != RetrieveID(object.second))
+			{
+				return false;
+			}
+		}
+
+		// Render Targets
+		bool hasRenderTargetColor = false;
+		for (uint32_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
+		{
+			if (RetrieveID(m_RenderTargetColorTextures[i]) != RetrieveID(pipelineState.m_RenderTargetColorTextures[i]))
+			{
+				return false;
+			}
+
+			if (m_RenderTargetColorTextures[i])
+			{
+				if (RetrieveLoadOperation(m_ClearValuesColor[i], g_RHI_ColorIgnoreValue, g_RHI_ColorLoadValue) != RetrieveLoadOperation(pipelineState.m_ClearValuesColor[i], g_RHI_ColorIgnoreValue, g_RHI_ColorLoadValue))
+				{
+					return false;
+				}
+
+				hasRenderTargetColor = true;
+			}
+		}
+
+		if (RetrieveID(m_RenderTargetDepthTexture) != RetrieveID(pipelineState.m_RenderTargetDepthTexture))
+		{
+			return false;
+		}
+
+		if (m_RenderTargetDepthTexture)
+		{
+			if (RetrieveLoadOperation(m_ClearValueDepth, g_RHI_DepthIgnoreValue, g_RHI_DepthLoadValue) != RetrieveLoadOperation(pipelineState.m_ClearValueDepth, g_RHI_DepthIgnoreValue, g_RHI_DepthLoadValue) ||
+				RetrieveLoadOperation(m_ClearValueStencil, g_RHI_StencilIgnoreValue, g_RHI_StencilLoadValue) != RetrieveLoadOperation(pipelineState.m_ClearValueStencil, g_RHI_StencilIgnoreValue, g_RHI_StencilLoadValue))
+			{
+				return false;
+			}
+
+			if (m_RenderTargetDepthLayoutInitial != pipelineState.m_RenderTargetDepthLayoutInitial || m_RenderTargetDepthLayoutFinal != pipelineState.m_RenderTargetDepthLayoutFinal)
+			{
+				return false;
+			}
+		}
+
+		// Initial and Final Layouts
+		if (hasRenderTargetColor)
+		{
+			if (m_RenderTargetColorLayoutInitial != pipelineState.m_RenderTargetColorLayoutInitial || m_RenderTargetColorLayoutFinal != pipelineState.m_RenderTargetColorLayoutFinal)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
@@ -15,6 +15,14 @@ namespace Amethyst
 
 		bool IsPipelineStateValid();
 
+		/*
+			Validates the state and works out everything derived from it (render target layouts, hash) once. From then on the state counts as immutable, and
+			BeginRenderPass only compares it against the pipeline and descriptor set layout it resolved the first time. Changing anything which is hashed takes
+			another Build(). Clear values may still change freely, as long as what they do (clear, load or ignore) stays the same.
+		*/
+		bool Build();
+		bool IsBuilt() const { return m_IsBuilt; }
+
 		//Framebuffer
 		bool CreateFramebuffer(const RHI_Device* rhi_Device);
 		void* RetrieveFramebuffer() const;
@@ -23,8 +31,10 @@ namespace Amethyst
 		uint32_t RetrieveRenderTargetHeight() const;
 
 		//Hash
-		uint32_t ComputeHash();
-		uint32_t RetrieveHash() const { return m_Hash; }
+		uint64_t ComputeHash();
+		uint64_t RetrieveHash() const { return m_Hash; }
+		bool IsEquivalent(const RHI_PipelineState& pipelineState) const; // Compares everything the hash is made of, so that colliding hashes can be told apart.
+		uint64_t ComputeContentHash() const; // Made of what objects describe rather than which objects they are, so that it's the same from one run to the next.
 		void ResetClearValues();
 
 		bool IsGraphicsPipeline() const { return (m_VertexShader != nullptr || m_PixelShader != nullptr) && !m_ComputeShader; }
@@ -90,7 +100,11 @@ namespace Amethyst
 		bool m_IsProfilingEnabled = false;
 
 	private:
+		friend class RHI_PipelineCache;
+		friend class RHI_DescriptorSetLayoutCache;
+
 		void DestroyFramebuffer();
+		void ComputeRenderTargetLayouts();
 
 	private:
 		RHI_Image_Layout m_RenderTargetColorLayoutInitial = RHI_Image_Layout::Undefined;
@@ -98,10 +112,16 @@ namespace Amethyst
 		RHI_Image_Layout m_RenderTargetDepthLayoutInitial = RHI_Image_Layout::Undefined;
 		RHI_Image_Layout m_RenderTargetDepthLayoutFinal = RHI_Image_Layout::Undefined;
 
-		uint32_t m_Hash = 0;
+		uint64_t m_Hash = 0;
+		bool m_IsBuilt = false;
 		void* m_RenderPass = nullptr;
 		std::array<void*, g_RHI_MaxConstantBufferCount> m_FrameBuffers;
 
+		//Resolved by the first BeginRenderPass after Build(). Pipelines live for as long as their cache, while descriptor set layouts only last until the next reset.
+		RHI_Pipeline* m_ResolvedPipeline = nullptr;
+		RHI_DescriptorSetLayout* m_ResolvedDescriptorSetLayout = nullptr;
+		uint32_t m_ResolvedDescriptorSetLayoutGeneration = 0;
+
 		//Dependencies
 		const RHI_Device* m_RHI_Device = nullptr;
 		
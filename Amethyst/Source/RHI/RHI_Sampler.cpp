@@ -1,6 +1,7 @@
 #include "Amethyst.h"
 #include "RHI_Sampler.h"
 #include "RHI_Device.h"
+#include "RHI_BindlessHeap.h"
 #include "RHI_Implementation.h"
 
 namespace Amethyst
@@ -15,7 +16,7 @@ namespace Amethyst
 		const bool isAnisotropyEnabled, 
 		const bool isComparisonEnabled)
 	{
-		if (!m_RHI_Device || !m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice)
+		if (!rhi_Device)
 		{
 			AMETHYST_ERROR_INVALID_PARAMETER();
 			return;
@@ -32,5 +33,11 @@ namespace Amethyst
 		m_IsComparisonEnabled = isComparisonEnabled;
 
 		CreateResource();
+
+		// Bindless
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			m_BindlessIndex = bindlessHeap->SetSampler(this);
+		}
 	}
 }
\ No newline at end of file
@@ -37,6 +37,7 @@ namespace Amethyst
 		bool RetrieveAnistropyEnabled()							const { return m_IsAnisotropyEnabled; }
 		bool RetrieveComparisonEnabled()						const { return m_ComparisonFunction; }
 		void* RetrieveResource()								const { return m_Resource; }
+		uint32_t RetrieveBindlessIndex()						const { return m_BindlessIndex; } // Slot in the bindless sampler array.
 
 	private:
 		void CreateResource();
@@ -54,6 +55,7 @@ namespace Amethyst
 
 		//API
 		void* m_Resource = nullptr;
+		uint32_t m_BindlessIndex = g_RHI_Bindless_InvalidIndex;
 
 		//Dependencies
 		std::shared_ptr<RHI_Device> m_RHI_Device;
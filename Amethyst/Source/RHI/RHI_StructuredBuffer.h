@@ -0,0 +1,52 @@
+#pragma once
+#include <memory>
+#include "RHI_Utilities.h"
+#include "../Core/AmethystObject.h"
+
+namespace Amethyst
+{
+	// Read-only arrays of structures for shaders (StructuredBuffer in HLSL, storage buffers in Vulkan). Unlike constant buffers, their size isn't capped
+	// at 64KB and shaders can index them freely, which makes them the home of per-instance data.
+	class RHI_StructuredBuffer : public AmethystObject
+	{
+	public:
+		RHI_StructuredBuffer(const std::shared_ptr<RHI_Device>& rhi_Device, const std::string& name);
+		~RHI_StructuredBuffer();
+
+		template<typename T>
+		bool Create(const uint32_t elementCount)
+		{
+			m_Stride = static_cast<uint32_t>(sizeof(T));
+			m_ElementCount = elementCount;
+			m_Size_GPU = static_cast<uint64_t>(m_Stride) * m_ElementCount;
+
+			return _Create();
+		}
+
+		// Stays mapped for the lifetime of the buffer.
+		void* Map();
+		bool Unmap(const uint64_t offset = 0, const uint64_t size = 0);
+
+		void* RetrieveResource() const { return m_Buffer; }
+		uint32_t RetrieveStride() const { return m_Stride; }
+		uint32_t RetrieveElementCount() const { return m_ElementCount; }
+		uint32_t RetrieveBindlessIndex() const { return m_BindlessIndex; } // Slot in the bindless structured buffer array, kept when the buffer is recreated.
+
+	private:
+		bool _Create();
+		void _Destroy();
+
+	private:
+		uint32_t m_Stride = 0;
+		uint32_t m_ElementCount = 0;
+
+		//API
+		void* m_Buffer = nullptr;
+		void* m_BufferAllocation = nullptr;
+		void* m_MappedMemory = nullptr;
+		uint32_t m_BindlessIndex = g_RHI_Bindless_InvalidIndex;
+
+		//Dependencies
+		std::shared_ptr<RHI_Device> m_RHI_Device;
+	};
+}
\ No newline at end of file
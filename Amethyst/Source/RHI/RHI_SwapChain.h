@@ -32,6 +32,7 @@ namespace Amethyst
 		uint32_t RetrieveHeight() const { return m_Height; }
 		uint32_t RetrieveBufferCount() const { return m_BufferCount; }
 		uint32_t RetrieveFlags() const { return m_Flags; }
+		RHI_Format RetrieveFormat() const { return m_Format; }
 		uint32_t RetrieveCommandListIndex() const { return m_CommandListIndex; };
 		uint32_t RetrieveImageIndex() const { return m_ImageIndex; }
 		bool IsInitialized() const { return m_Initialized; }
@@ -3,8 +3,11 @@
 #include "Amethyst.h"
 #include "RHI_Texture.h"
 #include "RHI_Device.h"
+#include "RHI_BindlessHeap.h"
+#include "RHI_UploadHeap.h"
 #include "../Rendering/Renderer.h"
 #include "../Resource/ResourceCache.h"
+#include "../Profiling/MemoryTracker.h"
 //Image Import
 
 namespace Amethyst
@@ -18,6 +21,7 @@ namespace Amethyst
 	{
 		m_Data.clear();
 		m_Data.shrink_to_fit();
+		MemoryTracker::Untrack(this);
 	}
 
 	bool RHI_Texture::SaveToFile(const std::string& filePath)
@@ -32,6 +36,50 @@ namespace Amethyst
 		return true;
 	}
 
+	bool RHI_Texture::IsResident() const
+	{
+		RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+		return !uploadHeap || uploadHeap->IsResident(m_UploadValue);
+	}
+
+	uint64_t RHI_Texture::RetrieveMipChainSize(const uint8_t mipIndex) const
+	{
+		uint64_t size = 0;
+
+		for (uint32_t i = mipIndex; i < m_MipCount; i++)
+		{
+			const uint64_t mipWidth = (m_Width >> i) > 1 ? (m_Width >> i) : 1;
+			const uint64_t mipHeight = (m_Height >> i) > 1 ? (m_Height >> i) : 1;
+			size += mipWidth * mipHeight * RHI_Format_ToBytesPerPixel(m_Format);
+		}
+
+		return size * m_ArraySize;
+	}
+
+	void RHI_Texture::UpdateBindlessIndex()
+	{
+		// Only single 2D images fit the Texture2D array, which leaves out cubes and texture arrays.
+		if (!IsSampled() || m_ArraySize != 1 || !m_ResourceView[0])
+		{
+			return;
+		}
+
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			m_BindlessIndex = bindlessHeap->SetTexture(this, m_BindlessIndex);
+		}
+	}
+
+	void RHI_Texture::ReleaseBindlessIndex()
+	{
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			bindlessHeap->Release(RHI_Bindless_Type::Texture, m_BindlessIndex);
+		}
+
+		m_BindlessIndex = g_RHI_Bindless_InvalidIndex;
+	}
+
 	std::vector<std::byte>& RHI_Texture::RetrieveMip(const uint8_t mipIndex)
 	{
 		static std::vector<std::byte> empty;
@@ -45,11 +93,6 @@ namespace Amethyst
 		return m_Data[mipIndex];
 	}
 
-	std::vector<std::byte> RHI_Texture::RetrieveOrLoadMip(const uint8_t mipIndex)
-	{
-		return std::vector<std::byte>();
-	}
-
 	bool RHI_Texture::LoadFromFile_NativeFormat(const std::string& filePath)
 	{
 		return false;
@@ -20,7 +20,8 @@ namespace Amethyst
 		RHI_Texture_DepthStencilReadOnly    = 1 << 4,
 		RHI_Texture_Grayscale				= 1 << 5,
 		RHI_Texture_Transparent				= 1 << 6,
-		RHI_Texture_GenerateMipsWhenLoading = 1 << 7
+		RHI_Texture_GenerateMipsWhenLoading = 1 << 7,
+		RHI_Texture_Aliased					= 1 << 8  //Created once placed in an RHI_AliasedMemory, rather than with memory of its own.
 	};
 
 	//Shader resource views wrap textures in a format that the shaders can access them.
@@ -73,7 +74,6 @@ namespace Amethyst
 		std::vector<std::byte>& AddMip() { return m_Data.emplace_back(std::vector<std::byte>()); }
 		std::vector<std::vector<std::byte>>& RetrieveMips() { return m_Data; }
 		std::vector<std::byte>& RetrieveMip(const uint8_t mipIndex);
-		std::vector<std::byte> RetrieveOrLoadMip(const uint8_t mipIndex);
 
 		//Binding Type
 		bool IsSampled() const { return m_Flags & RHI_Texture_Flags::RHI_Texture_Sampled; }
@@ -91,6 +91,12 @@ namespace Amethyst
 		void SetLayout(const RHI_Image_Layout layout, RHI_CommandList* commandList = nullptr);
 		RHI_Image_Layout RetrieveLayout() const { return m_Layout; }
 
+		//Size
+		uint64_t RetrieveMipChainSize(const uint8_t mipIndex) const; //GPU bytes of the mips from mipIndex down, every array slice, without alignment or padding.
+
+		//Residency - Whether the texture's data has reached the graphics queue. Its upload runs on the transfer queue (see RHI_UploadHeap), and until then, default textures are bound instead.
+		bool IsResident() const;
+
 		//Misc
 		uint32_t RetrieveArraySize() const { return m_ArraySize; }
 		const RHI_Viewport& RetrieveViewport() const { return m_Viewport; }
@@ -105,6 +111,13 @@ namespace Amethyst
 		void* RetrieveResourceView_DepthStencilReadOnly(const uint32_t viewIndex = 0)   const { return viewIndex < m_ResourceView_DepthStencilReadOnly.size() ? m_ResourceView_DepthStencilReadOnly[viewIndex] : nullptr; }
 		void* RetrieveResourceView_RenderTarget(const uint32_t viewIndex = 0)			const { return viewIndex < m_ResourceView_RenderTarget.size() ? m_ResourceView_RenderTarget[viewIndex] : nullptr; }
 
+		//Aliasing
+		RHI_AliasedMemory* RetrieveAliasedMemory() const { return m_AliasedMemory; }
+		bool PlaceInMemory(RHI_AliasedMemory* aliasedMemory) { m_AliasedMemory = aliasedMemory; return CreateResourceGPU(); }
+
+		//Bindless - The texture's slot in the bindless texture array, or g_RHI_Bindless_InvalidIndex if it has none.
+		uint32_t RetrieveBindlessIndex() const { return m_BindlessIndex; }
+
 	protected:
 		bool LoadFromFile_NativeFormat(const std::string& filePath);
 		bool LoadFromFile_ForeignFormat(const std::string& filePath, bool generateMipmaps);
@@ -124,6 +137,7 @@ namespace Amethyst
 		uint8_t m_MipCount = 1;
 		RHI_Format m_Format = RHI_Format::RHI_Format_Undefined;
 		RHI_Image_Layout m_Layout = RHI_Image_Layout::Undefined;
+		uint64_t m_UploadValue = 0;
 		uint16_t m_Flags = 0;
 		RHI_Viewport m_Viewport;
 		std::vector<std::vector<std::byte>> m_Data; ///
@@ -133,12 +147,22 @@ namespace Amethyst
 		void* m_ResourceView[2] = { nullptr, nullptr }; //Color/Depth, Stencil
 		void* m_ResourceView_UnorderedAccess = nullptr; ///
 		void* m_Resource = nullptr;
+		RHI_AliasedMemory* m_AliasedMemory = nullptr;
 
 		// 1 only. Data/Size.
 		std::array<void*, g_RHI_MaxRenderTargetCount> m_ResourceView_RenderTarget = { nullptr }; // Initializes with 1 element.
 		std::array<void*, g_RHI_MaxRenderTargetCount> m_ResourceView_DepthStencil = { nullptr }; // Initializes with 1 element.
 		std::array<void*, g_RHI_MaxRenderTargetCount> m_ResourceView_DepthStencilReadOnly = { nullptr }; // Initializes with 1 element.
 
+		// Memory
+		void UpdateMemoryAccounting(); // Called once the GPU resource exists.
+		void DestroyResourceGPU();	   // The image and its views.
+
+		// Bindless
+		void UpdateBindlessIndex(); // Called once the views exist, and again whenever they are recreated.
+		void ReleaseBindlessIndex();
+		uint32_t m_BindlessIndex = g_RHI_Bindless_InvalidIndex;
+
 	private:
 		uint32_t RetrieveByteCount();
 	};
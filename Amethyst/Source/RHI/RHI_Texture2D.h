@@ -64,7 +64,11 @@ namespace Amethyst
 			m_Flags |= IsDepthFormat() ? RHI_Texture_Flags::RHI_Texture_DepthStencil : (RHI_Texture_Flags::RHI_Texture_RenderTarget | RHI_Texture_Flags::RHI_Texture_Storage); //Need to optimize this as not every RT is used in a compute shader.
 			m_MipCount = 1;
 
-			RHI_Texture2D::CreateResourceGPU();
+			//Aliased textures are created by the memory they are placed in.
+			if (!(m_Flags & RHI_Texture_Flags::RHI_Texture_Aliased))
+			{
+				RHI_Texture2D::CreateResourceGPU();
+			}
 		}
 
 		~RHI_Texture2D();
@@ -0,0 +1,375 @@
+#include "Amethyst.h"
+#include "RHI_UploadHeap.h"
+#include "RHI_Device.h"
+#include "RHI_Semaphore.h"
+#include "RHI_Texture.h"
+#include "../Rendering/Renderer.h"
+#include <numeric>
+
+namespace Amethyst
+{
+	// Alignments needn't be powers of two, as texels can be 12 bytes.
+	inline uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+	{
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+
+	RHI_UploadHeap::RHI_UploadHeap(RHI_Device* rhi_Device)
+	{
+		m_RHI_Device = rhi_Device;
+
+		m_CopyTimeline = std::make_shared<RHI_Semaphore>(m_RHI_Device, true, "Upload Copies");
+		m_AcquireTimeline = std::make_shared<RHI_Semaphore>(m_RHI_Device, true, "Upload Acquires");
+
+		if (!CreateResources())
+		{
+			AMETHYST_ERROR("Failed to create upload heap.");
+		}
+	}
+
+	RHI_UploadHeap::~RHI_UploadHeap()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			// Whatever was recorded still has to run, and everything in flight has to finish before the ring goes away.
+			SubmitOpenBatch();
+			while (RetireOldestBatch(true)) {}
+		}
+
+		DestroyResources();
+	}
+
+	RHI_UploadHeap* RHI_UploadHeap::Retrieve(const RHI_Device* rhi_Device)
+	{
+		// Null while the renderer is starting up or being destroyed, in which case there is nothing recorded to submit.
+		if (Renderer* renderer = rhi_Device->RetrieveContextEngine()->RetrieveSubsystem<Renderer>())
+		{
+			return renderer->RetrieveUploadHeap();
+		}
+
+		return nullptr;
+	}
+
+	bool RHI_UploadHeap::UploadBuffer(void* destinationBuffer, const void* data, const uint64_t size, uint64_t& uploadValue)
+	{
+		if (!destinationBuffer || !data || size == 0)
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		void* sourceBuffer = m_Buffer;
+		uint64_t sourceOffset = 0;
+
+		if (size > g_RHI_UploadHeap_Size)
+		{
+			sourceBuffer = CreateOverflowBuffer(data, size);
+			if (!sourceBuffer)
+			{
+				AMETHYST_ERROR("Failed to create staging buffer.");
+				return false;
+			}
+		}
+		else
+		{
+			if (!Allocate(size, g_RHI_UploadHeap_Alignment, sourceOffset))
+			{
+				return false;
+			}
+
+			std::memcpy(m_MappedData + sourceOffset, data, size);
+		}
+
+		Batch* batch = RetrieveOpenBatch();
+		if (!batch)
+		{
+			if (sourceBuffer != m_Buffer)
+			{
+				DestroyOverflowBuffer(sourceBuffer);
+			}
+
+			return false;
+		}
+
+		if (sourceBuffer != m_Buffer)
+		{
+			batch->m_OverflowBuffers.emplace_back(sourceBuffer);
+		}
+
+		RecordBufferCopy(*batch, sourceBuffer, sourceOffset, destinationBuffer, size);
+		m_UploadedBytes += size;
+		uploadValue = batch->m_Value;
+
+		return true;
+	}
+
+	bool RHI_UploadHeap::UploadTexture(RHI_Texture* texture, const RHI_Image_Layout targetLayout, uint64_t& uploadValue)
+	{
+		if (!texture || !texture->RetrieveResource())
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		// Lay out every mip of every slice, slice by slice, with each one aligned for the copy.
+		const std::vector<std::vector<std::byte>>& mips = texture->RetrieveMips();
+		const uint32_t mipCount = texture->HasData() ? texture->RetrieveArraySize() * texture->RetrieveMipCount() : 0;
+		if (mips.size() < mipCount)
+		{
+			AMETHYST_ERROR("The texture has %d mips, %d are needed.", static_cast<uint32_t>(mips.size()), mipCount);
+			return false;
+		}
+
+		// Buffer to image copies must start at a multiple of the texel size, and of 4 when they run on a transfer queue.
+		const uint64_t texelSize = RHI_Format_ToBytesPerPixel(texture->RetrieveFormat());
+		if (mipCount != 0 && texelSize == 0)
+		{
+			AMETHYST_ERROR("%s can't be uploaded.", RHI_Format_ToString(texture->RetrieveFormat()));
+			return false;
+		}
+		const uint64_t alignment = std::lcm<uint64_t>(Math::Utilities::Max<uint64_t>(texelSize, 1), 4);
+
+		m_TextureOffsets.clear();
+		uint64_t size = 0;
+		for (uint32_t i = 0; i < mipCount; i++)
+		{
+			m_TextureOffsets.emplace_back(size);
+			size += AlignUp(static_cast<uint64_t>(mips[i].size()), alignment);
+		}
+
+		void* sourceBuffer = m_Buffer;
+		uint64_t sourceOffset = 0;
+
+		if (size > g_RHI_UploadHeap_Size)
+		{
+			// Gathered first, so that the staging buffer can be created with its data.
+			std::vector<std::byte> data(size);
+			for (uint32_t i = 0; i < mipCount; i++)
+			{
+				std::memcpy(data.data() + m_TextureOffsets[i], mips[i].data(), mips[i].size());
+			}
+
+			sourceBuffer = CreateOverflowBuffer(data.data(), size);
+			if (!sourceBuffer)
+			{
+				AMETHYST_ERROR("Failed to create staging buffer.");
+				return false;
+			}
+		}
+		else if (size != 0)
+		{
+			if (!Allocate(size, alignment, sourceOffset))
+			{
+				return false;
+			}
+
+			for (uint32_t i = 0; i < mipCount; i++)
+			{
+				m_TextureOffsets[i] += sourceOffset;
+				std::memcpy(m_MappedData + m_TextureOffsets[i], mips[i].data(), mips[i].size());
+			}
+		}
+
+		Batch* batch = RetrieveOpenBatch();
+		if (!batch)
+		{
+			if (sourceBuffer != m_Buffer)
+			{
+				DestroyOverflowBuffer(sourceBuffer);
+			}
+
+			return false;
+		}
+
+		if (sourceBuffer != m_Buffer)
+		{
+			batch->m_OverflowBuffers.emplace_back(sourceBuffer);
+		}
+
+		RecordTextureCopy(*batch, sourceBuffer, m_TextureOffsets, texture, targetLayout);
+		m_UploadedBytes += size;
+
+		// Without data, there is only the transition, which goes to the graphics queue along with the copies.
+		uploadValue = mipCount != 0 ? batch->m_Value : 0;
+
+		return true;
+	}
+
+	void RHI_UploadHeap::Flush(const bool wait /*= false*/)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		SubmitOpenBatch();
+		AcquireSubmittedBatches(wait);
+
+		// Hand back the ring space of whatever has finished in the meantime, without waiting for anything.
+		while (RetireOldestBatch(false)) {}
+	}
+
+	RHI_UploadHeap::Batch* RHI_UploadHeap::RetrieveOpenBatch()
+	{
+		Batch& batch = m_Batches[m_BatchIndex];
+
+		if (!batch.m_IsRecording)
+		{
+			// Batches are reused in order, so if this one is still in flight, it's the oldest.
+			if (batch.m_IsSubmitted)
+			{
+				RetireOldestBatch(true);
+			}
+
+			if (!BeginBatch(batch))
+			{
+				AMETHYST_ERROR("Failed to begin upload batch.");
+				return nullptr;
+			}
+
+			batch.m_Value = ++m_BatchValue;
+			batch.m_IsRecording = true;
+		}
+
+		return &batch;
+	}
+
+	bool RHI_UploadHeap::SubmitOpenBatch()
+	{
+		Batch& batch = m_Batches[m_BatchIndex];
+
+		if (!batch.m_IsRecording)
+		{
+			return true;
+		}
+
+		batch.m_IsRecording = false;
+		if (!SubmitBatch(batch))
+		{
+			AMETHYST_ERROR("Failed to submit upload batch.");
+			return false;
+		}
+
+		batch.m_RingEnd = m_Head;
+		batch.m_IsSubmitted = true;
+		m_BatchIndex = (m_BatchIndex + 1) % g_RHI_UploadHeap_BatchCount;
+		m_SubmittedBatchCount++;
+
+		return true;
+	}
+
+	void RHI_UploadHeap::AcquireSubmittedBatches(const bool wait)
+	{
+		// Starting from the open batch, submitted batches go from oldest to newest. They are acquired in that order, so that residency is a single value.
+		for (uint32_t i = 0; i < g_RHI_UploadHeap_BatchCount; i++)
+		{
+			Batch& batch = m_Batches[(m_BatchIndex + i) % g_RHI_UploadHeap_BatchCount];
+			if (!batch.m_IsSubmitted || batch.m_IsAcquired)
+			{
+				continue;
+			}
+
+			// The acquire waits for the copies on the GPU as well, but submitting it any earlier would hold up everything submitted after it.
+			if (wait ? !m_CopyTimeline->Wait(batch.m_Value) : m_CopyTimeline->RetrieveValue() < batch.m_Value)
+			{
+				return;
+			}
+
+			if (!AcquireBatch(batch))
+			{
+				AMETHYST_ERROR("Failed to acquire upload batch.");
+				return;
+			}
+
+			batch.m_IsAcquired = true;
+			m_AcquiredValue = batch.m_Value;
+		}
+	}
+
+	bool RHI_UploadHeap::RetireOldestBatch(const bool wait)
+	{
+		// Starting from the open batch, the first one that was submitted is the oldest.
+		for (uint32_t i = 0; i < g_RHI_UploadHeap_BatchCount; i++)
+		{
+			Batch& batch = m_Batches[(m_BatchIndex + i) % g_RHI_UploadHeap_BatchCount];
+			if (!batch.m_IsSubmitted)
+			{
+				continue;
+			}
+
+			if (!batch.m_IsAcquired)
+			{
+				AcquireSubmittedBatches(wait);
+				if (!batch.m_IsAcquired)
+				{
+					return false;
+				}
+			}
+
+			// The acquire is submitted last and waits for the copies, so once it's done, so is everything else in the batch.
+			if (wait ? !m_AcquireTimeline->Wait(batch.m_Value) : m_AcquireTimeline->RetrieveValue() < batch.m_Value)
+			{
+				return false;
+			}
+
+			for (void*& overflowBuffer : batch.m_OverflowBuffers)
+			{
+				DestroyOverflowBuffer(overflowBuffer);
+			}
+			batch.m_OverflowBuffers.clear();
+
+			m_Tail = batch.m_RingEnd;
+			batch.m_IsSubmitted = false;
+			batch.m_IsAcquired = false;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool RHI_UploadHeap::Allocate(const uint64_t size, const uint64_t alignment, uint64_t& offset)
+	{
+		while (true)
+		{
+			// Aligned from the start of the ring, as its size isn't a multiple of every alignment.
+			const uint64_t ringStart = (m_Head / g_RHI_UploadHeap_Size) * g_RHI_UploadHeap_Size;
+			uint64_t head = ringStart + AlignUp(m_Head - ringStart, alignment);
+
+			// Allocations don't wrap around, the rest of the ring is skipped instead.
+			if ((head - ringStart) + size > g_RHI_UploadHeap_Size)
+			{
+				head = ringStart + g_RHI_UploadHeap_Size;
+			}
+
+			if (head + size - m_Tail <= g_RHI_UploadHeap_Size)
+			{
+				m_Head = head + size;
+				offset = head % g_RHI_UploadHeap_Size;
+				return true;
+			}
+
+			// Out of room, so wait for the oldest batch to give its part of the ring back.
+			if (RetireOldestBatch(true))
+			{
+				continue;
+			}
+
+			// Only the open batch is holding on to the ring, so it has to go first.
+			if (m_Batches[m_BatchIndex].m_IsRecording)
+			{
+				if (!SubmitOpenBatch())
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			// Nothing is in flight, so start over from the beginning of the ring.
+			m_Head = m_Tail = ((m_Head + g_RHI_UploadHeap_Size - 1) / g_RHI_UploadHeap_Size) * g_RHI_UploadHeap_Size;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "RHI_Utilities.h"
+#include "../Core/AmethystObject.h"
+
+namespace Amethyst
+{
+	static const uint64_t g_RHI_UploadHeap_Size = 64 * 1024 * 1024;
+	static const uint32_t g_RHI_UploadHeap_BatchCount = 4;  // Batches which can be in flight at once, before recording has to wait for the oldest.
+	static const uint64_t g_RHI_UploadHeap_Alignment = 16; // Of buffer uploads. Texture uploads are aligned to their texel size instead (see UploadTexture()).
+
+	/*
+		A persistently mapped ring buffer that every buffer and texture upload is staged through. Uploads copy their data into the ring and record their copy
+		into the open batch, which is only submitted when Flush() is called (before a command list is submitted or the GPU is waited on), so loading thousands
+		of resources results in a handful of submissions instead of one submission and wait for each.
+
+		The copies run on the transfer queue and signal the copy timeline with the batch's value, so nothing on the graphics queue waits for them. Once a later
+		Flush() sees that value reached, the batch's acquire command buffer is submitted to the graphics queue. It takes ownership of whatever was copied (when
+		the transfer queue is a family of its own), moves textures to their final layout and signals the acquire timeline. From then on, the resources are
+		resident: every command list submitted afterwards is ordered after the acquire. Until then, the renderer falls back to default textures and skips meshes.
+
+		Textures without data only need a layout transition, which goes to the graphics queue along with the copies, so they are resident right away.
+
+		A batch's part of the ring is handed out again once its acquire has finished, so recording only ever waits when the ring or every batch is still in use.
+		Uploads larger than the ring get a staging buffer of their own, which is destroyed along with their batch.
+	*/
+	class RHI_UploadHeap : public AmethystObject
+	{
+	public:
+		RHI_UploadHeap(RHI_Device* rhi_Device);
+		~RHI_UploadHeap();
+
+		// Uploads - Recorded into the open batch. The data is copied, so it can be released as soon as these return. The upload value tells when it's resident.
+		bool UploadBuffer(void* destinationBuffer, const void* data, const uint64_t size, uint64_t& uploadValue);
+		bool UploadTexture(RHI_Texture* texture, const RHI_Image_Layout targetLayout, uint64_t& uploadValue); // Copies the texture's data (if any) and transitions it to the target layout.
+
+		// Submits the open batch, if anything was recorded into it, and acquires the batches whose copies have completed. Only waits for the copies if asked to, which makes everything resident.
+		void Flush(const bool wait = false);
+
+		// Whether the upload with the given value has been acquired by the graphics queue. Safe to call from any thread.
+		bool IsResident(const uint64_t uploadValue) const { return uploadValue <= m_AcquiredValue; }
+
+		// The renderer's heap, if there is one yet (or still).
+		static RHI_UploadHeap* Retrieve(const RHI_Device* rhi_Device);
+
+		uint64_t RetrieveSubmittedBatchCount() const { return m_SubmittedBatchCount; }
+		uint64_t RetrieveUploadedBytes() const { return m_UploadedBytes; }
+
+	private:
+		struct Batch
+		{
+			void* m_CommandBufferCopy = nullptr;		 // Transfer queue - Copies, and releases to the graphics queue.
+			void* m_CommandBufferTransition = nullptr; // Graphics queue - Layout transitions of textures without data, submitted along with the copies.
+			void* m_CommandBufferAcquire = nullptr;	 // Graphics queue - Acquires and final layouts of whatever was copied, submitted once the copies have completed.
+			uint64_t m_Value = 0;					 // Signaled on both timelines.
+			uint64_t m_RingEnd = 0;					 // The ring's head when it was submitted, which is where the tail moves to once it's done.
+			std::vector<void*> m_OverflowBuffers;	 // Uploads too big for the ring.
+			bool m_IsRecording = false;
+			bool m_IsSubmitted = false;
+			bool m_IsAcquired = false;
+		};
+
+		Batch* RetrieveOpenBatch();
+		bool SubmitOpenBatch();
+		void AcquireSubmittedBatches(const bool wait);
+		bool RetireOldestBatch(const bool wait);
+		bool Allocate(const uint64_t size, const uint64_t alignment, uint64_t& offset);
+
+		// API
+		bool CreateResources();
+		void DestroyResources();
+		bool BeginBatch(Batch& batch);
+		bool SubmitBatch(Batch& batch);
+		bool AcquireBatch(Batch& batch);
+		void RecordBufferCopy(Batch& batch, void* sourceBuffer, const uint64_t sourceOffset, void* destinationBuffer, const uint64_t size);
+		void RecordTextureCopy(Batch& batch, void* sourceBuffer, const std::vector<uint64_t>& sourceOffsets, RHI_Texture* texture, const RHI_Image_Layout targetLayout); // Offsets of every mip of every slice, slice by slice.
+		void* CreateOverflowBuffer(const void* data, const uint64_t size);
+		void DestroyOverflowBuffer(void*& buffer);
+
+	private:
+		// Ring - Offsets keep counting up past the ring's size, so that the head and tail can't be confused when they meet.
+		uint64_t m_Head = 0;
+		uint64_t m_Tail = 0;
+		std::byte* m_MappedData = nullptr;
+
+		// Batches - Recorded into one at a time, in order.
+		std::array<Batch, g_RHI_UploadHeap_BatchCount> m_Batches;
+		uint32_t m_BatchIndex = 0;
+		uint64_t m_BatchValue = 0; // Value of the last batch that was begun.
+		std::atomic<uint64_t> m_AcquiredValue = 0;
+		std::vector<uint64_t> m_TextureOffsets;
+
+		// Timelines
+		std::shared_ptr<RHI_Semaphore> m_CopyTimeline;
+		std::shared_ptr<RHI_Semaphore> m_AcquireTimeline;
+
+		// Statistics
+		uint64_t m_SubmittedBatchCount = 0;
+		uint64_t m_UploadedBytes = 0;
+
+		// Resources are created on worker threads.
+		std::mutex m_Mutex;
+
+		// API
+		void* m_Buffer = nullptr;
+		void* m_CommandPoolCopy = nullptr;
+		void* m_CommandPoolGraphics = nullptr;
+
+		// Dependencies
+		RHI_Device* m_RHI_Device;
+	};
+}
\ No newline at end of file
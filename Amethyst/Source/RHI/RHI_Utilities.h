@@ -15,6 +15,8 @@ namespace Amethyst
 	class RHI_DescriptorSet;
 	class RHI_DescriptorSetLayout;
 	class RHI_DescriptorSetLayoutCache;
+	class RHI_BindlessHeap;
+	class RHI_UploadHeap;
 	class RHI_SwapChain;
 	class RHI_RasterizerState;
 	class RHI_BlendState;
@@ -23,11 +25,13 @@ namespace Amethyst
 	class RHI_VertexBuffer;
 	class RHI_IndexBuffer;
 	class RHI_ConstantBuffer;
+	class RHI_StructuredBuffer;
 	class RHI_Sampler;
 	class RHI_Viewport;
 	class RHI_Texture;
 	class RHI_Texture2D;
 	class RHI_TextureCube;
+	class RHI_AliasedMemory;
 	class RHI_Shader;
 	class RHI_Semaphore;
 	class RHI_Fence;
@@ -50,7 +54,8 @@ namespace Amethyst
 	{
 		RHI_API_D3D12,
 		RHI_API_Vulkan,
-		RHI_API_OpenGL
+		RHI_API_OpenGL,
+		RHI_API_Null
 	};
 
 	enum RHI_Queue_Type
@@ -216,6 +221,7 @@ namespace Amethyst
 		Sampler,
 		Texture,
 		ConstantBuffer,	//Constant Buffers preserve the values of stored shader constants until it becomes necessary to change them.
+		StructuredBuffer, //Read-only arrays of structures, indexed freely by shaders.
 		Undefined
 	};
 
@@ -263,6 +269,10 @@ namespace Amethyst
 	static const uint32_t g_RHI_ShaderShiftTexture		  = 200;
 	static const uint32_t g_RHI_ShaderShiftSampler		  = 300;
 
+	//Descriptor set indices (register spaces in HLSL). The bindless arrays come first, so that switching between pass layouts never disturbs them.
+	static const uint32_t g_RHI_DescriptorSetIndexBindless = 0;
+	static const uint32_t g_RHI_DescriptorSetIndexPass	   = 1;
+
 	//Limits
 	static const Math::Vector4 g_RHI_ColorLoadValue   = Math::Vector4(std::numeric_limits<float>::infinity(), 0.0f, 0.0f, 0.0f);
 	static const Math::Vector4 g_RHI_ColorIgnoreValue = Math::Vector4(-std::numeric_limits<float>::infinity(), 0.0f, 0.0f, 0.0f);
@@ -283,6 +293,13 @@ namespace Amethyst
 	static const uint8_t g_RHI_Descriptor_Max_Textures					= 10;
 	static const uint8_t g_RHI_Descriptor_Max_ConstantBuffers			= 10;
 	static const uint8_t g_RHI_Descriptor_Max_ConstantBuffersDynamic    = 10;
+	static const uint8_t g_RHI_Descriptor_Max_StructuredBuffers			= 10;
+
+	// Bindless Limits - Slots in the global arrays, see RHI_BindlessHeap.
+	static const uint32_t g_RHI_Bindless_Max_Textures					= 8192;
+	static const uint32_t g_RHI_Bindless_Max_Samplers					= 64;
+	static const uint32_t g_RHI_Bindless_Max_StructuredBuffers			= 1024;
+	static const uint32_t g_RHI_Bindless_InvalidIndex					= (std::numeric_limits<uint32_t>::max)();
 
 	inline const char* RHI_Format_ToString(const RHI_Format format)
 	{
@@ -308,6 +325,31 @@ namespace Amethyst
 		return "Unknown Format";
 	}
 
+	inline uint32_t RHI_Format_ToBytesPerPixel(const RHI_Format format)
+	{
+		switch (format)
+		{
+			case RHI_Format_R8_Unorm:               return 1;
+			case RHI_Format_R16_Uint:               return 2;
+			case RHI_Format_R16_Float:              return 2;
+			case RHI_Format_R32_Uint:               return 4;
+			case RHI_Format_R32_Float:              return 4;
+			case RHI_Format_R8G8_Unorm:             return 2;
+			case RHI_Format_R16G16_Float:           return 4;
+			case RHI_Format_R32G32_Float:           return 8;
+			case RHI_Format_R11G11B10_Float:        return 4;
+			case RHI_Format_R32G32B32_Float:        return 12;
+			case RHI_Format_R8G8B8A8_Unorm:         return 4;
+			case RHI_Format_R10G10B10A2_Unorm:      return 4;
+			case RHI_Format_R16G16B16A16_Snorm:     return 8;
+			case RHI_Format_R16G16B16A16_Float:     return 8;
+			case RHI_Format_R32G32B32A32_Float:     return 16;
+			case RHI_Format_D32_Float:              return 4;
+			case RHI_Format_D32_Float_S8X24_Uint:   return 8;
+			default:                                return 0;
+		}
+	}
+
 	//Temporary
 	inline std::string RetrieveRHIVendor()
 	{
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "../Core/AmethystObject.h"
+#include "RHI_UploadHeap.h"
 
 namespace Amethyst
 {
@@ -51,6 +52,13 @@ namespace Amethyst
 		void* Map();
 		bool Unmap();
 
+		// Whether the data the buffer was created with has reached the graphics queue. Until then, it isn't drawn.
+		bool IsResident() const
+		{
+			RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+			return !uploadHeap || uploadHeap->IsResident(m_UploadValue);
+		}
+
 		void* RetrieveResource() const { return m_Buffer; }
 		uint32_t RetrieveStride() const { return m_Stride; }
 		uint32_t RetrieveVertexCount() const { return m_VertexCount; }
@@ -69,6 +77,7 @@ namespace Amethyst
 		void* m_Buffer = nullptr; // Data buffer.
 		void* m_BufferAllocation = nullptr; // Buffer memory allocation via VMA.
 		bool m_IsMappable = true;
+		uint64_t m_UploadValue = 0;
 
 		//API
 		std::shared_ptr<RHI_Device> m_RHI_Device;
@@ -0,0 +1,82 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
+#include "../RHI_AliasedMemory.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture.h"
+#include "../../Profiling/MemoryTracker.h"
+
+namespace Amethyst
+{
+	RHI_AliasedMemory::RHI_AliasedMemory(RHI_Device* rhi_Device, const std::vector<RHI_Texture*>& textures, const char* name /*= nullptr*/)
+	{
+		m_RHI_Device = rhi_Device;
+		m_Name = name ? name : "";
+
+		// Merge the requirements of every texture, so that any of them fits.
+		VkMemoryRequirements memoryRequirements = {};
+		memoryRequirements.memoryTypeBits = (std::numeric_limits<uint32_t>::max)();
+
+		for (RHI_Texture* texture : textures)
+		{
+			AMETHYST_ASSERT(texture->RetrieveFlags() & RHI_Texture_Flags::RHI_Texture_Aliased);
+
+			VkMemoryRequirements textureRequirements = {};
+			if (!VulkanUtility::Image::RetrieveMemoryRequirements(texture, textureRequirements))
+			{
+				return;
+			}
+
+			memoryRequirements.size = Math::Utilities::Max(memoryRequirements.size, textureRequirements.size);
+			memoryRequirements.alignment = Math::Utilities::Max(memoryRequirements.alignment, textureRequirements.alignment);
+			memoryRequirements.memoryTypeBits &= textureRequirements.memoryTypeBits;
+		}
+
+		if (memoryRequirements.memoryTypeBits == 0)
+		{
+			AMETHYST_ERROR("The textures of \"%s\" have no memory type in common.", m_Name.c_str());
+			return;
+		}
+
+		VmaAllocationCreateInfo allocationInfo = {};
+		allocationInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+		VmaAllocation allocation = nullptr;
+		if (!VulkanUtility::Error::CheckResult(vmaAllocateMemory(m_RHI_Device->RetrieveContextRHI()->m_Allocator, &memoryRequirements, &allocationInfo, &allocation, nullptr)))
+		{
+			return;
+		}
+
+		m_Resource = static_cast<void*>(allocation);
+
+		// Memory Accounting - The textures report nothing, the block reports everything.
+		m_Size_GPU = static_cast<uint64_t>(memoryRequirements.size);
+		MemoryTracker::Track(this, MemoryCategory::RenderTarget);
+
+		for (RHI_Texture* texture : textures)
+		{
+			if (!texture->PlaceInMemory(this))
+			{
+				AMETHYST_ERROR("Failed to place \"%s\" in \"%s\".", texture->RetrieveObjectName().c_str(), m_Name.c_str());
+			}
+		}
+	}
+
+	RHI_AliasedMemory::~RHI_AliasedMemory()
+	{
+		if (!m_Resource)
+		{
+			return;
+		}
+
+		MemoryTracker::Untrack(this);
+
+		// Wait in case it's still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		vmaFreeMemory(m_RHI_Device->RetrieveContextRHI()->m_Allocator, static_cast<VmaAllocation>(m_Resource));
+		m_Resource = nullptr;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
+#include "../RHI_Implementation.h"
+#include "../RHI_BindlessHeap.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_CommandList.h"
+
+namespace Amethyst
+{
+	bool RHI_BindlessHeap::CreateResource()
+	{
+		RHI_Context* rhi_Context = m_RHI_Device->RetrieveContextRHI();
+		m_IsSupported = rhi_Context->m_IsDescriptorIndexingSupported;
+
+		if (!m_IsSupported)
+		{
+			AMETHYST_WARNING("Descriptor indexing is not supported, resources will only be accessible through pass descriptor sets.");
+		}
+
+		// Bindings - One array per resource type, at the binding matching its RHI_Bindless_Type.
+		static const VkDescriptorType descriptorTypes[] = { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
+		std::array<VkDescriptorSetLayoutBinding, static_cast<uint32_t>(RHI_Bindless_Type::Count)> layoutBindings;
+		std::array<VkDescriptorBindingFlags, static_cast<uint32_t>(RHI_Bindless_Type::Count)> bindingFlags;
+		std::array<VkDescriptorPoolSize, static_cast<uint32_t>(RHI_Bindless_Type::Count)> poolSizes;
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(RHI_Bindless_Type::Count); i++)
+		{
+			layoutBindings[i].binding = i;
+			layoutBindings[i].descriptorType = descriptorTypes[i];
+			layoutBindings[i].descriptorCount = m_Slots[i].m_Capacity;
+			layoutBindings[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+			layoutBindings[i].pImmutableSamplers = nullptr;
+
+			// Partially bound - Only the slots a shader actually reads have to hold something valid.
+			// Update after bind/unused while pending - Slots can be written while command buffers using the set are recorded or executing.
+			bindingFlags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+			poolSizes[i].type = descriptorTypes[i];
+			poolSizes[i].descriptorCount = m_Slots[i].m_Capacity;
+		}
+
+		// Descriptor Set Layout - Left empty without descriptor indexing, so that pipeline layouts still have a set 0 and pass sets keep their index.
+		{
+			VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
+			bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+			bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+			bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+			VkDescriptorSetLayoutCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			createInfo.pNext = m_IsSupported ? &bindingFlagsInfo : nullptr;
+			createInfo.flags = m_IsSupported ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT : 0;
+			createInfo.bindingCount = m_IsSupported ? static_cast<uint32_t>(layoutBindings.size()) : 0;
+			createInfo.pBindings = layoutBindings.data();
+
+			if (!VulkanUtility::Error::CheckResult(vkCreateDescriptorSetLayout(rhi_Context->m_LogicalDevice, &createInfo, nullptr, reinterpret_cast<VkDescriptorSetLayout*>(&m_DescriptorSetLayout))))
+			{
+				m_IsSupported = false;
+				return false;
+			}
+
+			VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkDescriptorSetLayout>(m_DescriptorSetLayout), "Bindless");
+		}
+
+		if (!m_IsSupported)
+		{
+			return true;
+		}
+
+		// Descriptor Pool - Holds the one set, for the lifetime of the heap.
+		{
+			VkDescriptorPoolCreateInfo poolCreateInfo = {};
+			poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+			poolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			poolCreateInfo.pPoolSizes = poolSizes.data();
+			poolCreateInfo.maxSets = 1;
+
+			if (!VulkanUtility::Error::CheckResult(vkCreateDescriptorPool(rhi_Context->m_LogicalDevice, &poolCreateInfo, nullptr, reinterpret_cast<VkDescriptorPool*>(&m_DescriptorPool))))
+			{
+				m_IsSupported = false;
+				return false;
+			}
+		}
+
+		// Descriptor Set
+		{
+			VkDescriptorSetAllocateInfo allocateInfo = {};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocateInfo.descriptorPool = static_cast<VkDescriptorPool>(m_DescriptorPool);
+			allocateInfo.descriptorSetCount = 1;
+			allocateInfo.pSetLayouts = reinterpret_cast<VkDescriptorSetLayout*>(&m_DescriptorSetLayout);
+
+			if (!VulkanUtility::Error::CheckResult(vkAllocateDescriptorSets(rhi_Context->m_LogicalDevice, &allocateInfo, reinterpret_cast<VkDescriptorSet*>(&m_DescriptorSet))))
+			{
+				m_IsSupported = false;
+				return false;
+			}
+
+			VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkDescriptorSet>(m_DescriptorSet), "Bindless");
+		}
+
+		// Pipeline Layout - Sets are bound against a layout, and any layout which starts with the same set layout is compatible with it for set 0.
+		{
+			VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
+			pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			pipelineLayoutCreateInfo.setLayoutCount = 1;
+			pipelineLayoutCreateInfo.pSetLayouts = reinterpret_cast<VkDescriptorSetLayout*>(&m_DescriptorSetLayout);
+
+			if (!VulkanUtility::Error::CheckResult(vkCreatePipelineLayout(rhi_Context->m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, reinterpret_cast<VkPipelineLayout*>(&m_PipelineLayout))))
+			{
+				m_IsSupported = false;
+				return false;
+			}
+
+			VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkPipelineLayout>(m_PipelineLayout), "Bindless");
+		}
+
+		return true;
+	}
+
+	void RHI_BindlessHeap::DestroyResource()
+	{
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		VkDevice logicalDevice = m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice;
+
+		// The set is freed along with its pool.
+		vkDestroyPipelineLayout(logicalDevice, static_cast<VkPipelineLayout>(m_PipelineLayout), nullptr);
+		vkDestroyDescriptorPool(logicalDevice, static_cast<VkDescriptorPool>(m_DescriptorPool), nullptr);
+		vkDestroyDescriptorSetLayout(logicalDevice, static_cast<VkDescriptorSetLayout>(m_DescriptorSetLayout), nullptr);
+
+		m_PipelineLayout = nullptr;
+		m_DescriptorSet = nullptr;
+		m_DescriptorPool = nullptr;
+		m_DescriptorSetLayout = nullptr;
+	}
+
+	inline void WriteDescriptor(const RHI_Device* rhi_Device, void* descriptorSet, const RHI_Bindless_Type type, const uint32_t index, const VkDescriptorType descriptorType, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
+	{
+		VkWriteDescriptorSet writeDescriptorSet = {};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.dstSet = static_cast<VkDescriptorSet>(descriptorSet);
+		writeDescriptorSet.dstBinding = static_cast<uint32_t>(type);
+		writeDescriptorSet.dstArrayElement = index;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.descriptorType = descriptorType;
+		writeDescriptorSet.pImageInfo = imageInfo;
+		writeDescriptorSet.pBufferInfo = bufferInfo;
+
+		vkUpdateDescriptorSets(rhi_Device->RetrieveContextRHI()->m_LogicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+	}
+
+	void RHI_BindlessHeap::UpdateTexture(const uint32_t index, RHI_Texture* texture)
+	{
+		/*
+			The layout is part of the descriptor, so it has to be the one the texture is in whenever it's sampled: general for storage textures, which get
+			written in between, and otherwise the read-only layouts SetTexture transitions to.
+		*/
+		VkDescriptorImageInfo imageInfo = {};
+		imageInfo.imageView = static_cast<VkImageView>(texture->RetrieveResourceView(0));
+		imageInfo.imageLayout = texture->IsStorage() ? VK_IMAGE_LAYOUT_GENERAL : texture->IsDepthFormat() ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		WriteDescriptor(m_RHI_Device, m_DescriptorSet, RHI_Bindless_Type::Texture, index, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &imageInfo, nullptr);
+	}
+
+	void RHI_BindlessHeap::UpdateSampler(const uint32_t index, RHI_Sampler* sampler)
+	{
+		VkDescriptorImageInfo imageInfo = {};
+		imageInfo.sampler = static_cast<VkSampler>(sampler->RetrieveResource());
+
+		WriteDescriptor(m_RHI_Device, m_DescriptorSet, RHI_Bindless_Type::Sampler, index, VK_DESCRIPTOR_TYPE_SAMPLER, &imageInfo, nullptr);
+	}
+
+	void RHI_BindlessHeap::UpdateStructuredBuffer(const uint32_t index, RHI_StructuredBuffer* structuredBuffer)
+	{
+		VkDescriptorBufferInfo bufferInfo = {};
+		bufferInfo.buffer = static_cast<VkBuffer>(structuredBuffer->RetrieveResource());
+		bufferInfo.offset = 0;
+		bufferInfo.range = VK_WHOLE_SIZE;
+
+		WriteDescriptor(m_RHI_Device, m_DescriptorSet, RHI_Bindless_Type::StructuredBuffer, index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfo);
+	}
+
+	void RHI_BindlessHeap::Bind(RHI_CommandList* commandList, const bool isCompute) const
+	{
+		if (!m_IsSupported)
+		{
+			return;
+		}
+
+		vkCmdBindDescriptorSets(
+			static_cast<VkCommandBuffer>(commandList->RetrieveCommandBuffer()),
+			isCompute ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS,
+			static_cast<VkPipelineLayout>(m_PipelineLayout),
+			g_RHI_DescriptorSetIndexBindless,
+			1,
+			reinterpret_cast<const VkDescriptorSet*>(&m_DescriptorSet),
+			0,
+			nullptr
+		);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -1,15 +1,19 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_CommandList.h"
 #include "../RHI_Pipeline.h"
 #include "../RHI_VertexBuffer.h"
 #include "../RHI_IndexBuffer.h"
 #include "../RHI_ConstantBuffer.h"
+#include "../RHI_StructuredBuffer.h"
 #include "../RHI_Sampler.h"
 #include "../RHI_DescriptorSet.h"
 #include "../RHI_DescriptorSetLayout.h"
 #include "../RHI_DescriptorSetLayoutCache.h"
 #include "../RHI_PipelineCache.h"
+#include "../RHI_BindlessHeap.h"
+#include "../RHI_UploadHeap.h"
 #include "../RHI_Semaphore.h"
 #include "../RHI_Fence.h"
 #include "../Rendering/Renderer.h"
@@ -40,6 +44,23 @@ namespace Amethyst
 		// Query Pool - Only if profiler exists.
 	}
 
+	RHI_CommandList::RHI_CommandList(RHI_CommandList* primary, const uint32_t index)
+	{
+		m_Primary = primary;
+		m_SwapChain = primary->m_SwapChain;
+		m_Renderer = primary->m_Renderer;
+		m_RHI_Device = primary->m_RHI_Device;
+		m_PipelineCache = primary->m_PipelineCache;
+		m_DescriptorSetLayoutCache = primary->m_DescriptorSetLayoutCache;
+
+		// Command Pool
+		VulkanUtility::CommandPool::CreateCommandPool(m_CommandPool, RHI_Queue_Type::RHI_Queue_Graphics);
+
+		// Command Buffer - Executed by the primary, so it is never submitted and needs no fence or semaphore.
+		VulkanUtility::CommandBuffer::CreateCommandBuffer(m_CommandPool, m_CommandBuffer, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+		VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkCommandBuffer>(m_CommandBuffer), ("Secondary Command Buffer " + std::to_string(index)).c_str());
+	}
+
 	RHI_CommandList::~RHI_CommandList()
 	{
 		RHI_Context* rhi_Context = m_RHI_Device->RetrieveContextRHI();
@@ -47,8 +68,19 @@ namespace Amethyst
 		// Wait in case its still in use by the GPU.
 		m_RHI_Device->Queue_WaitAll();
 
+		// Secondaries
+		m_SecondaryCommandLists.clear();
+
 		// Command Buffer
-		VulkanUtility::CommandBuffer::DestroyCommandBuffer(m_SwapChain->RetrieveCommandPool(), m_CommandBuffer);
+		if (m_Primary)
+		{
+			VulkanUtility::CommandBuffer::DestroyCommandBuffer(m_CommandPool, m_CommandBuffer);
+			VulkanUtility::CommandPool::DestroyCommandPool(m_CommandPool);
+		}
+		else
+		{
+			VulkanUtility::CommandBuffer::DestroyCommandBuffer(m_SwapChain->RetrieveCommandPool(), m_CommandBuffer);
+		}
 
 		// Query Pool
 		if (m_QueryPool) // - Swapchain
@@ -80,15 +112,44 @@ namespace Amethyst
 		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // Specifies that each recording of the command buffer will only be submitted once, and that the command buffer will be reset and recorded again between each submission.
 
+		// Secondaries record entirely within the render pass their primary has begun.
+		VkCommandBufferInheritanceInfo inheritanceInfo = {};
+		if (m_Primary)
+		{
+			RHI_PipelineState* pipelineState = m_Primary->m_Pipeline->RetrievePipelineState();
+
+			inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+			inheritanceInfo.renderPass = static_cast<VkRenderPass>(pipelineState->RetrieveRenderPass());
+			inheritanceInfo.subpass = 0;
+			inheritanceInfo.framebuffer = static_cast<VkFramebuffer>(pipelineState->RetrieveFramebuffer());
+
+			beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+			beginInfo.pInheritanceInfo = &inheritanceInfo;
+		}
+
 		if (!VulkanUtility::Error::CheckResult(vkBeginCommandBuffer(static_cast<VkCommandBuffer>(m_CommandBuffer), &beginInfo)))
 		{
 			return false;
 		}
 
+		// The bindless set is bound once per command buffer. Every pipeline layout starts with it, so it stays bound as pipelines and pass sets change.
+		if (RHI_BindlessHeap* bindlessHeap = m_Renderer->RetrieveBindlessHeap())
+		{
+			bindlessHeap->Bind(this, false);
+
+			// Secondaries only ever draw.
+			if (!m_Primary)
+			{
+				bindlessHeap->Bind(this, true);
+			}
+		}
+
 		/// 
 
 		m_CommandListState = RHI_CommandListState::Recording;
 		m_IsCommandBufferFlushed = false;
+		m_SecondaryCommandListOffset = 0;
+		m_SecondaryCommandListCount = 0;
 
 		return true;
 	}
@@ -103,7 +164,7 @@ namespace Amethyst
 			return false;
 		}
 
-		m_CommandListState == RHI_CommandListState::Ended;
+		m_CommandListState = RHI_CommandListState::Ended;
 
 		return true;
 	}
@@ -144,6 +205,12 @@ namespace Amethyst
 			}
 		}
 
+		// Uploads recorded so far go first, so that whatever this command buffer reads has arrived by the time it executes.
+		if (RHI_UploadHeap* uploadHeap = m_Renderer->RetrieveUploadHeap())
+		{
+			uploadHeap->Flush();
+		}
+
 		m_ProcessedFence->Reset(); // Fence to signal once the command buffer completes execution.
 
 		if (!m_RHI_Device->Queue_Submit(
@@ -196,11 +263,17 @@ namespace Amethyst
 			m_DescriptorSetLayoutCache->SetPipelineState(pipelineState);
 
 			// Retrieve (or create) a pipeline which matches the pipeline state.
-			m_Pipeline = m_PipelineCache->RetrievePipeline(this, pipelineState, m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout());
+			bool isCompiling = false;
+			m_Pipeline = m_PipelineCache->RetrievePipeline(this, pipelineState, m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout(), isCompiling);
 
 			if (!m_Pipeline)
 			{
-				AMETHYST_ERROR("Failed to acquire appropriate pipeline.");
+				// Passes whose pipeline is still compiling in the background are skipped until it's done.
+				if (!isCompiling)
+				{
+					AMETHYST_ERROR("Failed to acquire appropriate pipeline.");
+				}
+
 				return false;
 			}
 
@@ -240,6 +313,121 @@ namespace Amethyst
 		return true;
 	}
 
+	bool RHI_CommandList::BeginSecondaryCommandLists(const uint32_t count)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary && m_SecondaryCommandListCount == 0);
+
+		// Only graphics passes which haven't drawn anything yet can be split up.
+		if (count == 0 || !m_Pipeline || m_PipelineState->IsComputePipeline() || m_IsRenderPassActive || m_IsCommandBufferFlushed)
+		{
+			return false;
+		}
+
+		// The descriptor set is resolved up front and bound by every secondary, as the cache it comes from can only be used by one thread.
+		RHI_DescriptorSet* descriptorSet = nullptr;
+		m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout()->NeedsToBind();
+		if (!m_DescriptorSetLayoutCache->RetrieveDescriptorSet(descriptorSet) || !descriptorSet)
+		{
+			return false;
+		}
+
+		// The secondaries are readied before the render pass begins, so that if any of them fails, the pass can still be recorded inline.
+		const uint32_t offset = m_SecondaryCommandListOffset + m_SecondaryCommandListCount;
+		for (uint32_t i = offset; i < offset + count; i++)
+		{
+			if (i == m_SecondaryCommandLists.size())
+			{
+				m_SecondaryCommandLists.emplace_back(std::make_shared<RHI_CommandList>(this, i));
+			}
+
+			RHI_CommandList* secondary = m_SecondaryCommandLists[i].get();
+			secondary->m_Pipeline = m_Pipeline;
+			secondary->m_PipelineState = m_PipelineState;
+			secondary->m_IsPipelineActive = false;
+			secondary->m_VertexBufferID = 0;
+			secondary->m_IndexBufferID = 0;
+
+			if (!secondary->BeginCommandBuffer() || !secondary->Deferred_BindPipeline())
+			{
+				AbortSecondaryCommandLists(offset, i + 1);
+				return false;
+			}
+
+			secondary->BindDescriptorSet(descriptorSet);
+			secondary->m_IsRenderPassActive = true;
+		}
+
+		if (!Deferred_BeginRenderPass(true))
+		{
+			AMETHYST_ERROR("Failed to begin render pass.");
+			AbortSecondaryCommandLists(offset, offset + count);
+			return false;
+		}
+
+		m_SecondaryCommandListOffset = offset;
+		m_SecondaryCommandListCount = count;
+
+		return true;
+	}
+
+	void RHI_CommandList::AbortSecondaryCommandLists(const uint32_t begin, const uint32_t end)
+	{
+		// Whatever they recorded is never executed, they only have to be ready to record again.
+		for (uint32_t i = begin; i < end; i++)
+		{
+			RHI_CommandList* secondary = m_SecondaryCommandLists[i].get();
+			secondary->m_IsRenderPassActive = false;
+
+			if (secondary->m_CommandListState == RHI_CommandListState::Recording)
+			{
+				secondary->EndCommandBuffer();
+			}
+
+			secondary->m_CommandListState = RHI_CommandListState::Idle;
+		}
+	}
+
+	RHI_CommandList* RHI_CommandList::RetrieveSecondaryCommandList(const uint32_t index) const
+	{
+		AMETHYST_ASSERT(index < m_SecondaryCommandListCount);
+		return m_SecondaryCommandLists[m_SecondaryCommandListOffset + index].get();
+	}
+
+	bool RHI_CommandList::ExecuteSecondaryCommandLists()
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(m_IsRenderPassActive);
+
+		std::array<VkCommandBuffer, 64> commandBuffers;
+		uint32_t commandBufferCount = 0;
+
+		for (uint32_t i = 0; i < m_SecondaryCommandListCount; i++)
+		{
+			RHI_CommandList* secondary = RetrieveSecondaryCommandList(i);
+			secondary->m_IsRenderPassActive = false;
+
+			if (!secondary->EndCommandBuffer())
+			{
+				return false;
+			}
+
+			// It's safe to record again once the primary is done executing, which the primary's own BeginCommandBuffer() waits for.
+			secondary->m_CommandListState = RHI_CommandListState::Idle;
+			commandBuffers[commandBufferCount++] = static_cast<VkCommandBuffer>(secondary->m_CommandBuffer);
+
+			if (commandBufferCount == commandBuffers.size() || i == m_SecondaryCommandListCount - 1)
+			{
+				vkCmdExecuteCommands(static_cast<VkCommandBuffer>(m_CommandBuffer), commandBufferCount, commandBuffers.data());
+				commandBufferCount = 0;
+			}
+		}
+
+		return true;
+	}
+
 	bool RHI_CommandList::OnDraw()
 	{
 		if (m_IsCommandBufferFlushed)
@@ -247,6 +435,12 @@ namespace Amethyst
 			return false;
 		}
 
+		// Secondaries were handed the render pass, pipeline and descriptor set by their primary.
+		if (m_Primary)
+		{
+			return true;
+		}
+
 		// Validate command list state.
 		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
 
@@ -297,7 +491,7 @@ namespace Amethyst
 		return true;
 	}
 
-	bool RHI_CommandList::DrawIndexed(const uint32_t indexCount, const uint32_t indexOffset, const uint32_t vertexOffset)
+	bool RHI_CommandList::DrawIndexed(const uint32_t indexCount, const uint32_t indexOffset, const uint32_t vertexOffset, const uint32_t instanceCount, const uint32_t instanceOffset)
 	{
 		// Validate command list state.
 		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
@@ -313,10 +507,10 @@ namespace Amethyst
 		vkCmdDrawIndexed(
 			static_cast<VkCommandBuffer>(m_CommandBuffer), // Command Buffer - Buffer into which the command is recorded.
 			indexCount,									   // Index Count	 - The number of vertices to draw.
-			1,											   // Instance Count - The number of instances to draw.
-			indexCount,									   // First Index    - Base index within the index buffer.
+			instanceCount,								   // Instance Count - The number of instances to draw.
+			indexOffset,								   // First Index    - Base index within the index buffer.
 			vertexOffset,								   // Vertex Offset	 - Value added to the vertex index before indexing into the vertex buffer.
-			0											   // First Instance - Instance ID of the first instanc to draw.
+			instanceOffset								   // First Instance - Instance ID of the first instance to draw. SV_InstanceID starts from it, so it doubles as an offset into per-instance buffers.
 		);
 
 		/// Profiling.
@@ -472,6 +666,55 @@ namespace Amethyst
 		return true;
 	}
 
+	void RHI_CommandList::InsertBarriers(const std::vector<RHI_ImageBarrier>& barriers)
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_IsRenderPassActive); // Layout transitions can't happen within a render pass.
+
+		static thread_local std::vector<VkImageMemoryBarrier> imageBarriers;
+		imageBarriers.clear();
+
+		VkPipelineStageFlags sourceStages = 0;
+		VkPipelineStageFlags destinationStages = 0;
+
+		for (const RHI_ImageBarrier& barrier : barriers)
+		{
+			RHI_Texture* texture = barrier.m_Texture;
+			const RHI_Image_Layout oldLayout = barrier.m_DiscardContents ? RHI_Image_Layout::Undefined : texture->RetrieveLayout();
+			if (!barrier.m_DiscardContents && oldLayout == barrier.m_Layout)
+			{
+				continue;
+			}
+
+			VkPipelineStageFlags sourceStage = 0;
+			VkPipelineStageFlags destinationStage = 0;
+			VulkanUtility::Image::CreateImageBarrier(imageBarriers.emplace_back(), sourceStage, destinationStage, texture->RetrieveResource(), VulkanUtility::Image::RetrieveAspectMask(texture), texture->RetrieveMipCount(), texture->RetrieveArraySize(), oldLayout, barrier.m_Layout);
+
+			// Another texture sharing the memory may still be writing to it, so wait on everything before discarding.
+			sourceStages |= barrier.m_DiscardContents ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : sourceStage;
+			destinationStages |= destinationStage;
+
+			texture->SetLayout(barrier.m_Layout);
+		}
+
+		if (imageBarriers.empty())
+		{
+			return;
+		}
+
+		// A single barrier for all of the transitions.
+		vkCmdPipelineBarrier
+		(
+			static_cast<VkCommandBuffer>(m_CommandBuffer),
+			sourceStages, destinationStages,
+			0,
+			0, nullptr,
+			0, nullptr,
+			static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data()
+		);
+	}
+
 	//=========================
 
 	void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
@@ -570,6 +813,7 @@ namespace Amethyst
 	{
 		// Validate command list state.
 		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
 
 		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
 		{
@@ -581,10 +825,27 @@ namespace Amethyst
 		return m_DescriptorSetLayoutCache->SetConstantBuffer(slot, constantBuffer);
 	}
 
+	bool RHI_CommandList::SetStructuredBuffer(const uint32_t slot, const uint8_t scope, RHI_StructuredBuffer* structuredBuffer) const
+	{
+		// Validate command list state.
+		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
+
+		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
+		{
+			AMETHYST_WARNING("Descriptor layout not set, try setting structured buffer \"%s\" within a render pass.", structuredBuffer->RetrieveObjectName().c_str());
+			return false;
+		}
+
+		// Set (will only happen if it's not already set).
+		return m_DescriptorSetLayoutCache->SetStructuredBuffer(slot, structuredBuffer);
+	}
+
 	void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
 	{
 		// Validate command list state.
 		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
 
 		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
 		{
@@ -600,6 +861,7 @@ namespace Amethyst
 	{
 		// Validate command list state.
 		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
+		AMETHYST_ASSERT(!m_Primary); // The descriptor cache is shared, so resources are bound through the primary.
 
 		if (!m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout())
 		{
@@ -613,6 +875,12 @@ namespace Amethyst
 			texture = m_Renderer->RetrieveDefaultTextureTransparent();
 		}
 
+		// Its data is still on the transfer queue (see RHI_UploadHeap), so stand in with a white texture until the graphics queue has acquired it.
+		if (!texture->IsResident())
+		{
+			texture = m_Renderer->RetrieveDefaultTextureWhite();
+		}
+
 		// If the image has an invalid layout (can happen for a few frames during staging), replace with black texture.
 		if (texture->RetrieveLayout() == RHI_Image_Layout::Undefined || texture->RetrieveLayout() == RHI_Image_Layout::Preinitialized)
 		{
@@ -696,7 +964,7 @@ namespace Amethyst
 		}
 	}
 
-	bool RHI_CommandList::Deferred_BeginRenderPass()
+	bool RHI_CommandList::Deferred_BeginRenderPass(const bool isRecordedBySecondaries /*= false*/)
 	{
 		// Validate command list state.
 		AMETHYST_ASSERT(m_CommandListState == RHI_CommandListState::Recording);
@@ -750,7 +1018,7 @@ namespace Amethyst
 
 		// After beginning a render pass instance, the command buffer is ready to record the commands for the first subpass of that render pass.
 		// The last parameter is a VkSubpassContents value specifying how the commands in the first subpass will be provided - Inline specifies that the contents of the subpass will be recorded inline in the primary command buffer, and secondary command buffers must not be executed within the subpass. See: https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VkSubpassContents.html
-		vkCmdBeginRenderPass(static_cast<VkCommandBuffer>(m_CommandBuffer), &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdBeginRenderPass(static_cast<VkCommandBuffer>(m_CommandBuffer), &renderPassInfo, isRecordedBySecondaries ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
 
 		m_IsRenderPassActive = true;
 
@@ -771,37 +1039,42 @@ namespace Amethyst
 
 		if (result && descriptorSet != nullptr)
 		{
-			// Bind point.
-			VkPipelineBindPoint pipelineBindPoint = m_PipelineState->IsComputePipeline() ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+			BindDescriptorSet(descriptorSet);
+		}
 
-			// Dynamic Offsets
-			RHI_DescriptorSetLayout* descriptorSetLayout = m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout();
-			const std::array<uint32_t, g_RHI_MaxConstantBufferCount> dynamicOffsets = descriptorSetLayout->RetrieveDynamicOffsets();
-			uint32_t dynamicOffsetCount = descriptorSetLayout->RetrieveDynamicOffsetCount();
+		return result;
+	}
 
-			// Validate descriptor sets.
-			std::array<void*, 1> descriptorSets = { descriptorSet->RetrieveResource() };
-			for (uint32_t i = 0; i < static_cast<uint32_t>(descriptorSets.size()); i++)
-			{
-				AMETHYST_ASSERT(descriptorSets[i] != nullptr);
-			}
+	void RHI_CommandList::BindDescriptorSet(RHI_DescriptorSet* descriptorSet)
+	{
+		// Bind point.
+		VkPipelineBindPoint pipelineBindPoint = m_PipelineState->IsComputePipeline() ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
 
-			// Bind descriptor sets to a command buffer. Once bound, a descriptor set affects the rendering of subsequent commands that interact with the given pipeline type in the command buffer until a different set is bound or the set is "disturbed".
-			vkCmdBindDescriptorSets(
-				static_cast<VkCommandBuffer>(m_CommandBuffer),							// Command buffer the descriptor sets will be bound to.
-				pipelineBindPoint,														// Indicates the type of pipeline that will use the descriptors. There is a seperate set of bind points for each pipeline type, so binding one does not disturb the others.
-				static_cast<VkPipelineLayout>(m_Pipeline->RetrievePipelineLayout()),	// VkPipelineLayout object used to program the bindings.
-				0,																		// firstSet is the set number of the first descriptor set to be bound.
-				static_cast<uint32_t>(descriptorSets.size()),							// Number of elements in the pDescriptorSets array.
-				reinterpret_cast<VkDescriptorSet*>(descriptorSets.data()),				// Pointer to an array of handles to VkDescriptorSet objects describing the descriptor sets to bind to.
-				dynamicOffsetCount,														// Number of dynamic offsets in the pDynamicOffsets array.
-				!dynamicOffsets.empty() ? dynamicOffsets.data() : nullptr				// Pointer to an array of uint32_t values specifying dynamic offsets.
-			);
+		// Dynamic Offsets
+		RHI_DescriptorSetLayout* descriptorSetLayout = m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout();
+		const std::array<uint32_t, g_RHI_MaxConstantBufferCount> dynamicOffsets = descriptorSetLayout->RetrieveDynamicOffsets();
+		uint32_t dynamicOffsetCount = descriptorSetLayout->RetrieveDynamicOffsetCount();
 
-			/// Profiler.
+		// Validate descriptor sets.
+		std::array<void*, 1> descriptorSets = { descriptorSet->RetrieveResource() };
+		for (uint32_t i = 0; i < static_cast<uint32_t>(descriptorSets.size()); i++)
+		{
+			AMETHYST_ASSERT(descriptorSets[i] != nullptr);
 		}
 
-		return result;
+		// Bind descriptor sets to a command buffer. Once bound, a descriptor set affects the rendering of subsequent commands that interact with the given pipeline type in the command buffer until a different set is bound or the set is "disturbed".
+		vkCmdBindDescriptorSets(
+			static_cast<VkCommandBuffer>(m_CommandBuffer),							// Command buffer the descriptor sets will be bound to.
+			pipelineBindPoint,														// Indicates the type of pipeline that will use the descriptors. There is a seperate set of bind points for each pipeline type, so binding one does not disturb the others.
+			static_cast<VkPipelineLayout>(m_Pipeline->RetrievePipelineLayout()),	// VkPipelineLayout object used to program the bindings.
+			g_RHI_DescriptorSetIndexPass,											// firstSet is the set number of the first descriptor set to be bound.
+			static_cast<uint32_t>(descriptorSets.size()),							// Number of elements in the pDescriptorSets array.
+			reinterpret_cast<VkDescriptorSet*>(descriptorSets.data()),				// Pointer to an array of handles to VkDescriptorSet objects describing the descriptor sets to bind to.
+			dynamicOffsetCount,														// Number of dynamic offsets in the pDynamicOffsets array.
+			!dynamicOffsets.empty() ? dynamicOffsets.data() : nullptr				// Pointer to an array of uint32_t values specifying dynamic offsets.
+		);
+
+		/// Profiler.
 	}
 	
 	bool RHI_CommandList::Deferred_BindPipeline()
@@ -825,4 +1098,6 @@ namespace Amethyst
 
 		return true;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
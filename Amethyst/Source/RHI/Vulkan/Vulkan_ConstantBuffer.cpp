@@ -1,13 +1,21 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_ConstantBuffer.h"
 #include "../RHI_Device.h"
 #include "../RHI_CommandList.h"
+#include "../../Profiling/MemoryTracker.h"
 
 namespace Amethyst
 {
 	void RHI_ConstantBuffer::_Destroy()
 	{
+		// Nothing to wait for if the buffer was never created.
+		if (!m_Buffer)
+		{
+			return;
+		}
+
 		// Wait in case its still in use by the GPU.
 		m_RHI_Device->Queue_WaitAll();
 
@@ -20,6 +28,8 @@ namespace Amethyst
 
 		// Destroy
 		VulkanUtility::Buffer::DestroyBufferAllocation(m_Buffer);
+		m_BufferAllocation = nullptr;
+		MemoryTracker::Untrack(this);
 	}
 
 	RHI_ConstantBuffer::RHI_ConstantBuffer(const std::shared_ptr<RHI_Device>& rhi_Device, const std::string& name, bool isDynamic /*= false*/)
@@ -65,6 +75,10 @@ namespace Amethyst
 			AMETHYST_ERROR("Failed to allocate buffer.");
 			return false;
 		}
+		m_BufferAllocation = static_cast<void*>(allocation);
+
+		// Memory Accounting
+		MemoryTracker::Track(this, MemoryCategory::ConstantBuffer);
 
 		// Set debug name.
 		VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkBuffer>(m_Buffer), "Constant Buffer");
@@ -131,4 +145,6 @@ namespace Amethyst
 
 		return true;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
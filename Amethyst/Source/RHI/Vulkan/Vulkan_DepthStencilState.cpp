@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_DepthStencilState.h"
 #include "../RHI_Device.h"
@@ -31,4 +32,6 @@ namespace Amethyst
 	}
 
 	RHI_DepthStencilState::~RHI_DepthStencilState() = default;
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
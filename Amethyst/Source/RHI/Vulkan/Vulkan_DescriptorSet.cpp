@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_DescriptorSet.h"
 #include "../RHI_Implementation.h"
 #include "../RHI_DescriptorSetLayout.h"
@@ -16,20 +17,8 @@ namespace Amethyst
 		// Validate Descriptor Set
 		AMETHYST_ASSERT(m_Resource = nullptr);
 
-		// Descriptor Set Layouts
-		std::array<void*, 1> descriptorSetLayouts = { m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout()->RetrieveResource() };
-
-		// Allocate Info
-		VkDescriptorSetAllocateInfo allocateInfo = {};
-		{
-			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			allocateInfo.descriptorPool = static_cast<VkDescriptorPool>(m_DescriptorSetLayoutCache->RetrieveDescriptorPool());
-			allocateInfo.descriptorSetCount = 1;
-			allocateInfo.pSetLayouts = reinterpret_cast<VkDescriptorSetLayout*>(descriptorSetLayouts.data());
-		}
-
-		// Allocates the descriptor set from the passed in descriptor pool.
-		if (!VulkanUtility::Error::CheckResult(vkAllocateDescriptorSets(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, &allocateInfo, reinterpret_cast<VkDescriptorSet*>(&m_Resource))))
+		// Allocated from whichever of the cache's pools has room.
+		if (!m_DescriptorSetLayoutCache->AllocateDescriptorSet(m_DescriptorSetLayoutCache->RetrieveCurrentDescriptorSetLayout()->RetrieveResource(), m_Resource, m_PoolIndex))
 		{
 			return false;
 		}
@@ -72,8 +61,8 @@ namespace Amethyst
 				imageInfos[i].imageView = static_cast<VkImageView>(descriptor.m_Resource);
 				imageInfos[i].imageLayout = descriptor.m_Resource ? VulkanImageLayout[static_cast<uint8_t>(descriptor.m_Layout)] : VK_IMAGE_LAYOUT_UNDEFINED;
 			}
-			// Constant/Uniform Buffer
-			else if (descriptor.m_DescriptorType == RHI_Descriptor_Type::ConstantBuffer)
+			// Constant/Uniform Buffer & Structured/Storage Buffer
+			else if (descriptor.m_DescriptorType == RHI_Descriptor_Type::ConstantBuffer || descriptor.m_DescriptorType == RHI_Descriptor_Type::StructuredBuffer)
 			{
 				bufferInfos[i].buffer = static_cast<VkBuffer>(descriptor.m_Resource);
 				bufferInfos[i].offset = descriptor.m_Offset;
@@ -103,4 +92,6 @@ namespace Amethyst
 			nullptr												 // pDescriptorCopies
 		);
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
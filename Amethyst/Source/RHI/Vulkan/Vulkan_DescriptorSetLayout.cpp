@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_DescriptorSet.h"
 #include "../RHI_DescriptorSetLayout.h"
@@ -62,4 +63,6 @@ namespace Amethyst
 
 		VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkDescriptorSetLayout>(m_Resource), m_Name.c_str());
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
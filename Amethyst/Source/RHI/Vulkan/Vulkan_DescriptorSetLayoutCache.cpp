@@ -1,28 +1,40 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI/RHI_Implementation.h"
 #include "../RHI_DescriptorSetLayoutCache.h"
 #include "../RHI_Shader.h"
+#include "../RHI_PipelineCache.h"
+#include "../../Rendering/Renderer.h"
 
 namespace Amethyst
 {
 	RHI_DescriptorSetLayoutCache::~RHI_DescriptorSetLayoutCache()
 	{
-		if (m_DescriptorPool)
+		if (m_DescriptorPools.empty())
 		{
-			// Wait in case it's still in use by the GPU.
-			m_RHI_Device->Queue_WaitAll();
+			return;
+		}
+
+		// Wait in case they're still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
 
-			vkDestroyDescriptorPool(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkDescriptorPool>(m_DescriptorPool), nullptr);
-			m_DescriptorPool = nullptr;
+		for (DescriptorPool& descriptorPool : m_DescriptorPools)
+		{
+			DestroyDescriptorPool(descriptorPool.m_Resource);
 		}
+
+		m_DescriptorPools.clear();
 	}
 
-	void RHI_DescriptorSetLayoutCache::ResetDescriptorCache(uint32_t descriptorSetCapacity /*= 0*/)
+	void RHI_DescriptorSetLayoutCache::ResetDescriptorCache()
 	{
-		// If the requested capacity is zero, then only recreate the existing descriptor pool. Otherwise, it will not be a recreation but a new one with a new capacity.
-		if (descriptorSetCapacity == 0)
+		// Pipelines compiling in the background may still be creating their layouts from these.
+		if (Renderer* renderer = m_RHI_Device->RetrieveContextEngine()->RetrieveSubsystem<Renderer>())
 		{
-			descriptorSetCapacity = m_DescriptorSetCapacity;
+			if (RHI_PipelineCache* pipelineCache = renderer->RetrievePipelineCache())
+			{
+				pipelineCache->WaitForCompilation();
+			}
 		}
 
 		// Destroy Layouts
@@ -30,81 +42,100 @@ namespace Amethyst
 		m_DescriptorSetLayouts.clear();
 		m_AreDescriptorSetLayoutsBeingCleared = false;
 		m_DescriptorSetLayoutCurrent = nullptr;
+		m_Generation++;
 
-		// Destroy Pool
-		if (m_DescriptorPool)
-		{
-			// Wait in case its still in use by the GPU.
-			m_RHI_Device->Queue_WaitAll();
+		// Wait in case their sets are still in use by the GPU. Only resource destruction gets here, which waits for the GPU anyway, whereas growing adds a pool instead.
+		m_RHI_Device->Queue_WaitAll();
 
-			vkDestroyDescriptorPool(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkDescriptorPool>(m_DescriptorPool), nullptr);
-			m_DescriptorPool = nullptr;
-		}
-
-		// Create Pool
-		CreateDescriptorPool(descriptorSetCapacity);
-
-		// Log
-		if (descriptorSetCapacity > m_DescriptorSetCapacity)
-		{
-			AMETHYST_INFO("Capacity has been increased to %d elements.", descriptorSetCapacity);
-		}
-		else if (descriptorSetCapacity < m_DescriptorSetCapacity)
+		// Reset Pools - They are kept around, as whatever filled them is likely to fill them again.
+		for (DescriptorPool& descriptorPool : m_DescriptorPools)
 		{
-			AMETHYST_INFO("Capacity has been decreased to %d elements.", descriptorSetCapacity);
-		}
-		else
-		{
-			AMETHYST_INFO("Descriptor pool has been reset.");
+			ResetDescriptorPool(descriptorPool.m_Resource);
+			descriptorPool.m_SetCount = 0;
+			descriptorPool.m_IsFull = false;
 		}
+		m_DescriptorPoolIndex = 0;
+
+		AMETHYST_INFO("Descriptor pools have been reset.");
 	}
 
-	void RHI_DescriptorSetLayoutCache::SetDescriptorSetCapacity(uint32_t descriptorSetCapacity)
+	void* RHI_DescriptorSetLayoutCache::CreateDescriptorPool()
 	{
-		if (!m_RHI_Device || !m_RHI_Device->RetrieveContextRHI())
+		// Pool Sizes. Specifies the type of descriptor and the number of descriptors of mentioned type to allocate. Enough for every set to use as many of each as a set can have.
+		std::array<VkDescriptorPoolSize, 6> poolSizes =
 		{
-			AMETHYST_ERROR_INVALID_INTERNALS();
-			return;
+			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLER,				  g_RHI_DescriptorPoolCapacity * g_RHI_Descriptor_Max_Samplers },
+			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,		  g_RHI_DescriptorPoolCapacity * g_RHI_Descriptor_Max_Textures },
+			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,		  g_RHI_DescriptorPoolCapacity * g_RHI_Descriptor_Max_StorageTextures },
+			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,		  g_RHI_DescriptorPoolCapacity * g_RHI_Descriptor_Max_ConstantBuffers },
+			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, g_RHI_DescriptorPoolCapacity * g_RHI_Descriptor_Max_ConstantBuffersDynamic },
+			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,		  g_RHI_DescriptorPoolCapacity * g_RHI_Descriptor_Max_StructuredBuffers }
+		};
+
+		// Creation Info
+		VkDescriptorPoolCreateInfo poolCreationInfo = {};
+		{
+			poolCreationInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolCreationInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // Trimmed sets are freed one by one.
+			poolCreationInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size()); // Number of elements in pPoolSizes.
+			poolCreationInfo.pPoolSizes = poolSizes.data(); // Pointer to an array of vkDescriptorPoolSize structures, each containing a descriptor type and number of descriptors of that type to be allocated in the pool.
+			poolCreationInfo.maxSets = g_RHI_DescriptorPoolCapacity; // Maximum number of descriptor sets that can be allocated from the pool.
 		}
 
-		if (m_DescriptorSetCapacity == descriptorSetCapacity)
+		// Pool
+		VkDescriptorPool descriptorPool = nullptr;
+		if (!VulkanUtility::Error::CheckResult(vkCreateDescriptorPool(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, &poolCreationInfo, nullptr, &descriptorPool)))
 		{
-			AMETHYST_INFO("Descriptor set capacity is already at %d elements.", m_DescriptorSetCapacity);
-			return;
+			return nullptr;
 		}
 
-		// Re-create descriptor pool.
-		ResetDescriptorCache(descriptorSetCapacity);
+		return static_cast<void*>(descriptorPool);
+	}
 
-		// Update Capacity
-		m_DescriptorSetCapacity = descriptorSetCapacity;
+	void RHI_DescriptorSetLayoutCache::DestroyDescriptorPool(void*& descriptorPool)
+	{
+		vkDestroyDescriptorPool(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkDescriptorPool>(descriptorPool), nullptr);
+		descriptorPool = nullptr;
 	}
 
+	void RHI_DescriptorSetLayoutCache::ResetDescriptorPool(void* descriptorPool)
+	{
+		// Frees every set allocated from it at once.
+		VulkanUtility::Error::CheckResult(vkResetDescriptorPool(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkDescriptorPool>(descriptorPool), 0));
+	}
 
-	bool RHI_DescriptorSetLayoutCache::CreateDescriptorPool(uint32_t descriptorSetCapacity)
+	bool RHI_DescriptorSetLayoutCache::AllocateFromDescriptorPool(void* descriptorPool, void* descriptorSetLayout, void*& descriptorSet)
 	{
-		// Pool Sizes. Specifies the type of descriptor and the number of descriptors of mentioned type to allocate. 
-		std::array<VkDescriptorPoolSize, 5> poolSizes =
+		// Descriptor Set Layouts
+		std::array<void*, 1> descriptorSetLayouts = { descriptorSetLayout };
+
+		// Allocate Info
+		VkDescriptorSetAllocateInfo allocateInfo = {};
 		{
-			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLER,				  g_RHI_Descriptor_Max_Samplers },
-			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,		  g_RHI_Descriptor_Max_Textures },
-			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,		  g_RHI_Descriptor_Max_StorageTextures },
-			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,		  g_RHI_Descriptor_Max_ConstantBuffers },
-			VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, g_RHI_Descriptor_Max_ConstantBuffersDynamic }
-		};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocateInfo.descriptorPool = static_cast<VkDescriptorPool>(descriptorPool);
+			allocateInfo.descriptorSetCount = 1;
+			allocateInfo.pSetLayouts = reinterpret_cast<VkDescriptorSetLayout*>(descriptorSetLayouts.data());
+		}
 
-		// Creation Info
-		VkDescriptorPoolCreateInfo poolCreationInfo = {};
+		// Allocates the descriptor set from the passed in descriptor pool.
+		const VkResult result = vkAllocateDescriptorSets(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, &allocateInfo, reinterpret_cast<VkDescriptorSet*>(&descriptorSet));
+
+		// A full pool isn't an error, the next one in the chain is tried instead.
+		if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
 		{
-			poolCreationInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-			poolCreationInfo.flags = 0;
-			poolCreationInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size()); // Number of elements in pPoolSizes.
-			poolCreationInfo.pPoolSizes = poolSizes.data(); // Pointer to an array of vkDescriptorPoolSize structures, each containing a descriptor type and number of descriptors of that type to be allocated in the pool.
-			poolCreationInfo.maxSets = descriptorSetCapacity; // Maximum number of descriptor sets that can be allocated from the pool.
+			descriptorSet = nullptr;
+			return false;
 		}
 
-		// Pool
-		VkDescriptorPool* descriptorPool = reinterpret_cast<VkDescriptorPool*>(&m_DescriptorPool);
-		return VulkanUtility::Error::CheckResult(vkCreateDescriptorPool(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, &poolCreationInfo, nullptr, descriptorPool));
+		return VulkanUtility::Error::CheckResult(result);
 	}
-}
\ No newline at end of file
+
+	void RHI_DescriptorSetLayoutCache::FreeToDescriptorPool(void* descriptorPool, void*& descriptorSet)
+	{
+		VulkanUtility::Error::CheckResult(vkFreeDescriptorSets(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkDescriptorPool>(descriptorPool), 1, reinterpret_cast<VkDescriptorSet*>(&descriptorSet)));
+		descriptorSet = nullptr;
+	}
+}
+
+#endif
\ No newline at end of file
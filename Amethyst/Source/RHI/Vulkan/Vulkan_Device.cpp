@@ -1,8 +1,10 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Device.h"
 #include "../RHI/RHI_Implementation.h"
 #include "../RHI/RHI_Semaphore.h"
 #include "../RHI/RHI_Fence.h"
+#include <algorithm>
 
 namespace Amethyst
 {
@@ -117,13 +119,15 @@ namespace Amethyst
 		// Device
 		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
 		{
-			// Queue Creation Info
-			std::vector<uint32_t> uniqueQueueFamilies =
+			// Queue Creation Info - Families can only be requested once, and the transfer and compute queues fall back to the graphics family when there is no dedicated one.
+			std::vector<uint32_t> uniqueQueueFamilies = { m_RHI_Context->m_Queue_GraphicsIndex };
+			for (const uint32_t queueFamilyIndex : { m_RHI_Context->m_Queue_TransferIndex, m_RHI_Context->m_Queue_ComputeIndex })
 			{
-				m_RHI_Context->m_Queue_GraphicsIndex,
-				m_RHI_Context->m_Queue_TransferIndex,
-				m_RHI_Context->m_Queue_ComputeIndex
-			};
+				if (std::find(uniqueQueueFamilies.begin(), uniqueQueueFamilies.end(), queueFamilyIndex) == uniqueQueueFamilies.end())
+				{
+					uniqueQueueFamilies.emplace_back(queueFamilyIndex);
+				}
+			}
 
 			float queuePriority = 1.0f;
 
@@ -174,6 +178,22 @@ namespace Amethyst
 			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures.features, deviceFeaturesEnabled.features, wideLines)			// Enables lines with width other than 1.0.
 			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures.features, deviceFeaturesEnabled.features, imageCubeArray);	// Enables VkImageViewType of VK_IMAGE_VIEW_TYPE_CUBE_ARRAY to be created.
 			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, timelineSemaphore)			// Enables Timeline Semaphores.
+
+			// Descriptor Indexing - Large, partially bound arrays of descriptors which shaders index freely and which can be written while in use (see RHI_BindlessHeap).
+			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, runtimeDescriptorArray)
+			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, descriptorBindingPartiallyBound)
+			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, descriptorBindingUpdateUnusedWhilePending)
+			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, descriptorBindingSampledImageUpdateAfterBind) // Covers samplers as well.
+			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, descriptorBindingStorageBufferUpdateAfterBind)
+			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, shaderSampledImageArrayNonUniformIndexing)
+			ENABLE_FEATURE(m_RHI_Context->m_PhysicalDeviceFeatures1_2, deviceFeatures_1_2_Enabled, shaderStorageBufferArrayNonUniformIndexing)
+
+			m_RHI_Context->m_IsDescriptorIndexingSupported =
+				deviceFeatures_1_2_Enabled.runtimeDescriptorArray &&
+				deviceFeatures_1_2_Enabled.descriptorBindingPartiallyBound &&
+				deviceFeatures_1_2_Enabled.descriptorBindingUpdateUnusedWhilePending &&
+				deviceFeatures_1_2_Enabled.descriptorBindingSampledImageUpdateAfterBind &&
+				deviceFeatures_1_2_Enabled.descriptorBindingStorageBufferUpdateAfterBind;
 		}
 
 		// Determine enabled graphics shader stages.
@@ -247,6 +267,33 @@ namespace Amethyst
 		}
 	}
 
+	void RHI_Device::RetrieveMemoryStatistics(RHI_MemoryStatistics& statistics) const
+	{
+		statistics = RHI_MemoryStatistics();
+
+		if (!m_RHI_Context || !m_RHI_Context->m_Allocator)
+		{
+			return;
+		}
+
+		VmaStats stats = {};
+		vmaCalculateStats(m_RHI_Context->m_Allocator, &stats);
+		statistics.m_BytesAllocated = stats.total.usedBytes + stats.total.unusedBytes;
+		statistics.m_BytesUsed = stats.total.usedBytes;
+		statistics.m_AllocationCount = stats.total.allocationCount;
+		statistics.m_BlockCount = stats.total.blockCount;
+
+		const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+		vmaGetMemoryProperties(m_RHI_Context->m_Allocator, &memoryProperties);
+
+		VmaBudget budgets[VK_MAX_MEMORY_HEAPS] = {};
+		vmaGetBudget(m_RHI_Context->m_Allocator, budgets);
+		for (uint32_t i = 0; i < memoryProperties->memoryHeapCount; i++)
+		{
+			statistics.m_BytesBudget += budgets[i].budget;
+		}
+	}
+
 	//Remember that Fences are mainly used to synchronize your application itself with rendering operations, whereas semaphores are used to synchronize operations within or across command queues.
 	bool RHI_Device::Queue_Present(void* swapchainView, uint32_t* imageIndex, RHI_Semaphore* waitSemaphore /*= nullptr*/) const
 	{
@@ -282,28 +329,43 @@ namespace Amethyst
 		return true;
 	}
 
-	bool RHI_Device::Queue_Submit(const RHI_Queue_Type queueType, const uint32_t waitFlags, void* commandBuffer, RHI_Semaphore* waitSemaphore /*= nullptr*/, RHI_Semaphore* signalSemaphore /*= nullptr*/, RHI_Fence* signalFence /*= nullptr*/) const
+	bool RHI_Device::Queue_Submit(const RHI_Queue_Type queueType, const uint32_t waitFlags, void* commandBuffer, RHI_Semaphore* waitSemaphore /*= nullptr*/, RHI_Semaphore* signalSemaphore /*= nullptr*/, RHI_Fence* signalFence /*= nullptr*/, const uint64_t waitValue /*= 0*/, const uint64_t signalValue /*= 0*/) const
 	{
 		// Validate Input
 		AMETHYST_ASSERT(commandBuffer != nullptr);
 
+		// Timeline semaphores have values instead of states, so only binary semaphores are tracked.
+		const bool isWaitBinary = waitSemaphore && !waitSemaphore->IsTimelineSemaphore();
+		const bool isSignalBinary = signalSemaphore && !signalSemaphore->IsTimelineSemaphore();
+
 		// Validate Semaphore States
-		if (waitSemaphore)	 AMETHYST_ASSERT(waitSemaphore->RetrieveState() == RHI_Semaphore_State::Signaled); //Ensure that our wait semaphore is signalled.
-		if (signalSemaphore) AMETHYST_ASSERT(signalSemaphore->RetrieveState() == RHI_Semaphore_State::Idle);   //Ensure that our signal semaphore is still idle.
+		if (isWaitBinary)	AMETHYST_ASSERT(waitSemaphore->RetrieveState() == RHI_Semaphore_State::Signaled); //Ensure that our wait semaphore is signalled.
+		if (isSignalBinary) AMETHYST_ASSERT(signalSemaphore->RetrieveState() == RHI_Semaphore_State::Idle);   //Ensure that our signal semaphore is still idle.
 
 		// Retrieve Semaphores (Vulkan Device)
 		void* vkWaitSemaphore = waitSemaphore ? waitSemaphore->RetrieveResource() : nullptr;
 		void* vkSignalSemaphore = signalSemaphore ? signalSemaphore->RetrieveResource() : nullptr;
 
+		// Values to wait for and signal, for whichever of the semaphores are timeline semaphores. Binary semaphores ignore theirs.
+		VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {};
+		{
+			timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			timelineSubmitInfo.waitSemaphoreValueCount = waitSemaphore ? 1 : 0;
+			timelineSubmitInfo.pWaitSemaphoreValues = &waitValue;
+			timelineSubmitInfo.signalSemaphoreValueCount = signalSemaphore ? 1 : 0;
+			timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+		}
+		const bool isTimeline = (waitSemaphore && !isWaitBinary) || (signalSemaphore && !isSignalBinary);
+
 		// Submits our sequence of semaphores/command buffers to the queue.
 		VkSubmitInfo submitInfo = {};
 		{
 			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			submitInfo.pNext = nullptr;
+			submitInfo.pNext = isTimeline ? &timelineSubmitInfo : nullptr;
 			submitInfo.waitSemaphoreCount = waitSemaphore ? 1 : 0; // Semaphores to wait on before executing the command buffers for the batch.
-			submitInfo.pWaitSemaphores = waitSemaphore ? reinterpret_cast<VkSemaphore*>(&waitSemaphore) : nullptr;
+			submitInfo.pWaitSemaphores = waitSemaphore ? reinterpret_cast<VkSemaphore*>(&vkWaitSemaphore) : nullptr;
 			submitInfo.signalSemaphoreCount = signalSemaphore ? 1 : 0; // Semaphores to signal once the command buffers in pCommandBuffers have completed execution.
-			submitInfo.pSignalSemaphores = signalSemaphore ? reinterpret_cast<VkSemaphore*>(signalSemaphore) : nullptr;
+			submitInfo.pSignalSemaphores = signalSemaphore ? reinterpret_cast<VkSemaphore*>(&vkSignalSemaphore) : nullptr;
 			submitInfo.pWaitDstStageMask = &waitFlags; // An array of pipeline stages at which each corresponding semaphore wait will occur.
 			submitInfo.commandBufferCount = 1;
 			submitInfo.pCommandBuffers = reinterpret_cast<VkCommandBuffer*>(&commandBuffer);
@@ -319,8 +381,8 @@ namespace Amethyst
 		}
 
 		// Update Semaphore States
-		if (waitSemaphore)   waitSemaphore->SetState(RHI_Semaphore_State::Idle);		// Ensure our wait semaphore is idle.
-		if (signalSemaphore) signalSemaphore->SetState(RHI_Semaphore_State::Signaled);  // Ensure our signal semaphore is now in signalled state.
+		if (isWaitBinary)   waitSemaphore->SetState(RHI_Semaphore_State::Idle);		// Ensure our wait semaphore is idle.
+		if (isSignalBinary) signalSemaphore->SetState(RHI_Semaphore_State::Signaled);  // Ensure our signal semaphore is now in signalled state.
 
 		return true;
 	}
@@ -332,4 +394,6 @@ namespace Amethyst
 		// Wait on the host for the completion of outstanding queue operations for the given queue. Equivalent to submitting a fence to a queue and waiting with an infinite timeout for that fence to signal.
 		return VulkanUtility::Error::CheckResult(vkQueueWaitIdle(static_cast<VkQueue>(Queue_Retrieve(queueType))));
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
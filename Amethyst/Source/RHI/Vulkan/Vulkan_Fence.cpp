@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Fence.h"
 #include "../RHI_Implementation.h"
 #include "../RHI_Device.h"
@@ -58,4 +59,6 @@ namespace Amethyst
 		// Resets one or more fence objects to unsignalled state.
 		return IsSignaled() ? VulkanUtility::Error::CheckResult(vkResetFences(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, 1, reinterpret_cast<VkFence*>(&m_Resource))) : true;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
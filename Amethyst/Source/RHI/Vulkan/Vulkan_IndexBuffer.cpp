@@ -1,13 +1,22 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_Device.h"
 #include "../RHI_IndexBuffer.h"
 #include "../RHI_CommandList.h"
+#include "../RHI_UploadHeap.h"
+#include "../../Profiling/MemoryTracker.h"
 
 namespace Amethyst
 {
 	void RHI_IndexBuffer::_Destroy()
 	{
+		// Nothing to wait for when there is no buffer yet, which spares every creation a wait on the GPU.
+		if (!m_Buffer)
+		{
+			return;
+		}
+
 		// Wait in case it's still in use by the GPU.
 		m_RHI_Device->Queue_WaitAll();
 
@@ -20,6 +29,7 @@ namespace Amethyst
 
 		// Destroy
 		VulkanUtility::Buffer::DestroyBufferAllocation(m_Buffer);
+		MemoryTracker::Untrack(this);
 	}
 
 	/* Memory Coherence
@@ -89,14 +99,6 @@ namespace Amethyst
 		}
 		else
 		{
-			// Create staging/source buffer with VMA and copy the indices to it.
-			void* stagingBuffer = nullptr;
-			VmaAllocation stagingAllocation = VulkanUtility::Buffer::CreateBufferAllocation(stagingBuffer, m_Size_GPU, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false, indices);
-			if (!stagingAllocation)
-			{
-				return false;
-			}
-
 			// Create destination buffer with VMA.
 			// INDEX_BUFFER_BIT specifies that the buffer is suitable for passing as the buffer parameter to vkCmdBindIndexBuffer.
 			VmaAllocation destinationAllocation = VulkanUtility::Buffer::CreateBufferAllocation(m_Buffer, m_Size_GPU, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
@@ -105,33 +107,21 @@ namespace Amethyst
 				return false;
 			}
 
-			// Copy staging buffer to destination buffer.
+			// Stage the indices through the upload heap, which copies them right away and records the copy into its open batch.
+			RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+			if (!uploadHeap || !uploadHeap->UploadBuffer(m_Buffer, indices, m_Size_GPU, m_UploadValue))
 			{
-				// Create command buffer.
-				VkCommandBuffer commandBuffer = VulkanUtility::CommandBufferImmediate::BeginRecording(RHI_Queue_Type::RHI_Queue_Transfer);
-
-				VkBuffer* vulkanDestinationBuffer = reinterpret_cast<VkBuffer*>(&m_Buffer);
-				VkBuffer* vulkanStagingBuffer = reinterpret_cast<VkBuffer*>(&stagingBuffer);
-
-				// Copy
-				VkBufferCopy copyRegionInfo = {};
-				copyRegionInfo.size = m_Size_GPU;
-				vkCmdCopyBuffer(commandBuffer, *vulkanStagingBuffer, *vulkanDestinationBuffer, 1, &copyRegionInfo);
-
-				// Flush and free command buffer.
-				if (!VulkanUtility::CommandBufferImmediate::EndRecordingAndSubmit(RHI_Queue_Type::RHI_Queue_Transfer))
-				{
-					return false;
-				}
-
-				// Destroy staging buffer.
-				VulkanUtility::Buffer::DestroyBufferAllocation(stagingBuffer);
+				AMETHYST_ERROR("Failed to stage indices.");
+				return false;
 			}
 
 			m_BufferAllocation = static_cast<void*>(destinationAllocation);
 			m_IsMappable = false;
 		}
 		
+		// Memory Accounting
+		MemoryTracker::Track(this, MemoryCategory::IndexBuffer);
+
 		// Set debug name.
 		VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkBuffer>(m_Buffer), "Index Buffer");
 		
@@ -204,3 +194,5 @@ namespace Amethyst
 		return true;
 	}
 }
+
+#endif
\ No newline at end of file
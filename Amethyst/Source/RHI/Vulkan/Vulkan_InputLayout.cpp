@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_InputLayout.h"
 
@@ -13,4 +14,6 @@ namespace Amethyst
 	{
 		return true;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -1,11 +1,13 @@
 #pragma once
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_Pipeline.h"
 #include "../RHI_Shader.h"
 #include "../RHI_BlendState.h"
 #include "../RHI_InputLayout.h"
 #include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_BindlessHeap.h"
 #include "../RHI_RasterizerState.h"
 
 namespace Amethyst
@@ -18,8 +20,10 @@ namespace Amethyst
 		Both types take in commands through command buffers and processes them for their respective purposes.
 	*/
 	
-	RHI_Pipeline::RHI_Pipeline(const RHI_Device* rhi_Device, RHI_PipelineState& rhi_PipelineState, RHI_DescriptorSetLayout* rhi_DescriptorSetLayout)
+	RHI_Pipeline::RHI_Pipeline(const RHI_Device* rhi_Device, RHI_PipelineState& rhi_PipelineState, RHI_DescriptorSetLayout* rhi_DescriptorSetLayout, void* rhi_PipelineCache /*= nullptr*/)
 	{
+		AMETHYST_PROFILE_FUNCTION(); // Pipeline creation is where the driver compiles our shader modules.
+
 		m_RHI_Device = rhi_Device;
 		m_PipelineState = rhi_PipelineState;
 
@@ -32,7 +36,9 @@ namespace Amethyst
 		*/
 
 		{
-			std::array<void*, 1> layouts = { rhi_DescriptorSetLayout->RetrieveResource() };
+			// The bindless arrays, then the pass's own resources (see g_RHI_DescriptorSetIndexBindless and g_RHI_DescriptorSetIndexPass).
+			RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device);
+			std::array<void*, 2> layouts = { bindlessHeap ? bindlessHeap->RetrieveDescriptorSetLayout() : nullptr, rhi_DescriptorSetLayout->RetrieveResource() };
 
 			// Validate Descriptor Set Layouts
 			for (void* layout : layouts)
@@ -90,7 +96,7 @@ namespace Amethyst
 
 				// Pipeline Creation
 				VkPipeline* pipeline = reinterpret_cast<VkPipeline*>(&m_Pipeline);
-				if (!VulkanUtility::Error::CheckResult(vkCreateComputePipelines(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, nullptr, 1, &pipelineCreateInfo, nullptr, pipeline)))
+				if (!VulkanUtility::Error::CheckResult(vkCreateComputePipelines(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkPipelineCache>(rhi_PipelineCache), 1, &pipelineCreateInfo, nullptr, pipeline)))
 				{
 					return;
 				}
@@ -455,7 +461,7 @@ namespace Amethyst
 
 				// Creation
 				VkPipeline* pipeline = reinterpret_cast<VkPipeline*>(&m_Pipeline);
-				if (!VulkanUtility::Error::CheckResult(vkCreateGraphicsPipelines(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, nullptr, 1, &pipelineCreateInfo, nullptr, pipeline)))
+				if (!VulkanUtility::Error::CheckResult(vkCreateGraphicsPipelines(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkPipelineCache>(rhi_PipelineCache), 1, &pipelineCreateInfo, nullptr, pipeline)))
 				{
 					return;
 				}
@@ -477,4 +483,6 @@ namespace Amethyst
 		vkDestroyPipelineLayout(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkPipelineLayout>(m_PipelineLayout), nullptr);
 		m_PipelineLayout = nullptr;
 	}
-};
\ No newline at end of file
+};
+
+#endif
\ No newline at end of file
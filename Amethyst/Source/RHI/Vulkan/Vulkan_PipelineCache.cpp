@@ -0,0 +1,114 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_PipelineCache.h"
+#include "../../Core/FileSystem.h"
+
+namespace Amethyst
+{
+	// What every pipeline cache blob starts with. See: https://registry.khronos.org/vulkan/specs/1.2-extensions/html/vkspec.html#pipelines-cache-header
+	struct PipelineCacheHeader
+	{
+		uint32_t m_HeaderSize = 0;
+		uint32_t m_HeaderVersion = 0;
+		uint32_t m_VendorID = 0;
+		uint32_t m_DeviceID = 0;
+		uint8_t m_PipelineCacheUUID[VK_UUID_SIZE] = {};
+	};
+
+	// A blob written by another GPU or driver version is of no use to us, and not every driver copes with being handed one.
+	inline bool IsBlobCompatible(const std::vector<char>& blob, const VkPhysicalDeviceProperties& properties)
+	{
+		if (blob.size() < sizeof(PipelineCacheHeader))
+		{
+			return false;
+		}
+
+		PipelineCacheHeader header;
+		memcpy(&header, blob.data(), sizeof(PipelineCacheHeader));
+
+		return
+			header.m_HeaderSize >= sizeof(PipelineCacheHeader) &&
+			header.m_HeaderVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+			header.m_VendorID == properties.vendorID &&
+			header.m_DeviceID == properties.deviceID &&
+			memcmp(header.m_PipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+
+	RHI_PipelineCache::RHI_PipelineCache(const RHI_Device* rhi_Device)
+	{
+		m_RHI_Device = rhi_Device;
+		RHI_Context* rhi_Context = m_RHI_Device->RetrieveContextRHI();
+
+		// Load whatever the previous run left behind.
+		std::vector<char> blob;
+		{
+			std::ifstream file(g_RHI_PipelineCacheBlobFilePath, std::ios::binary | std::ios::ate);
+			if (file.is_open())
+			{
+				blob.resize(static_cast<size_t>(file.tellg()));
+				file.seekg(0);
+				file.read(blob.data(), blob.size());
+			}
+
+			if (!blob.empty() && !IsBlobCompatible(blob, rhi_Context->m_PhysicalDeviceProperties))
+			{
+				AMETHYST_WARNING("The pipeline cache on disk was written by a different GPU or driver and will be rebuilt.");
+				blob.clear();
+			}
+		}
+
+		VkPipelineCacheCreateInfo createInfo = {};
+		createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		createInfo.initialDataSize = blob.size();
+		createInfo.pInitialData = blob.empty() ? nullptr : blob.data();
+
+		// Without one, pipelines are still created, just from scratch every run.
+		if (!VulkanUtility::Error::CheckResult(vkCreatePipelineCache(rhi_Context->m_LogicalDevice, &createInfo, nullptr, reinterpret_cast<VkPipelineCache*>(&m_Resource))))
+		{
+			m_Resource = nullptr;
+		}
+		else if (!blob.empty())
+		{
+			AMETHYST_INFO("Loaded %d bytes of pipeline cache.", static_cast<uint32_t>(blob.size()));
+		}
+
+		LoadPrewarmList();
+	}
+
+	RHI_PipelineCache::~RHI_PipelineCache()
+	{
+		// Nothing may still be creating pipelines from the cache.
+		WaitForCompilation();
+		SavePrewarmList();
+
+		if (!m_Resource)
+		{
+			return;
+		}
+
+		VkDevice logicalDevice = m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice;
+		VkPipelineCache pipelineCache = static_cast<VkPipelineCache>(m_Resource);
+
+		// Save it for the next run.
+		size_t size = 0;
+		if (VulkanUtility::Error::CheckResult(vkGetPipelineCacheData(logicalDevice, pipelineCache, &size, nullptr)) && size != 0)
+		{
+			std::vector<char> blob(size);
+			if (VulkanUtility::Error::CheckResult(vkGetPipelineCacheData(logicalDevice, pipelineCache, &size, blob.data())))
+			{
+				FileSystem::CreateDirectory_(g_RHI_PipelineCacheDirectory);
+				std::ofstream file(g_RHI_PipelineCacheBlobFilePath, std::ios::binary | std::ios::trunc);
+				file.write(blob.data(), size);
+			}
+		}
+
+		// Pipelines created from it stay valid.
+		vkDestroyPipelineCache(logicalDevice, pipelineCache, nullptr);
+		m_Resource = nullptr;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_PipelineState.h"
 
@@ -362,4 +363,6 @@ namespace Amethyst
 		vkDestroyRenderPass(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkRenderPass>(m_RenderPass), nullptr);
 		m_RenderPass = nullptr;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
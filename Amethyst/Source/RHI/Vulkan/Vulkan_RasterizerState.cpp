@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_RasterizerState.h"
 #include "../RHI_Device.h"
@@ -35,4 +36,6 @@ namespace Amethyst
 	{
 
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
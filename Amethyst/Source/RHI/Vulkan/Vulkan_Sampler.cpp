@@ -1,7 +1,9 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_Sampler.h"
 #include "../RHI_Device.h"
+#include "../RHI_BindlessHeap.h"
 #include "../../Rendering/Renderer.h"
 
 namespace Amethyst
@@ -42,6 +44,14 @@ namespace Amethyst
 		// Wait in case its still in use by the GPU.
 		m_RHI_Device->Queue_WaitAll();
 
+		// Free its bindless slot.
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			bindlessHeap->Release(RHI_Bindless_Type::Sampler, m_BindlessIndex);
+		}
+
 		vkDestroySampler(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, reinterpret_cast<VkSampler>(m_Resource), nullptr);
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI/RHI_Semaphore.h"
 #include "../RHI/RHI_Implementation.h"
 
@@ -100,4 +101,6 @@ namespace Amethyst
 		VulkanUtility::Error::CheckResult(vkGetSemaphoreCounterValue(m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice, static_cast<VkSemaphore>(m_Resource), &value));
 		return value;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_Device.h"
 #include "../RHI_Shader.h"
@@ -22,4 +23,6 @@ namespace Amethyst
 			m_Resource = nullptr;
 		}
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
+#include "../RHI_Implementation.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_Device.h"
+#include "../RHI_BindlessHeap.h"
+#include "../../Profiling/MemoryTracker.h"
+
+namespace Amethyst
+{
+	void RHI_StructuredBuffer::_Destroy()
+	{
+		if (!m_Buffer)
+		{
+			return;
+		}
+
+		// Wait in case its still in use by the GPU.
+		m_RHI_Device->Queue_WaitAll();
+
+		// Unmap
+		if (m_MappedMemory)
+		{
+			vmaUnmapMemory(m_RHI_Device->RetrieveContextRHI()->m_Allocator, static_cast<VmaAllocation>(m_BufferAllocation));
+			m_MappedMemory = nullptr;
+		}
+
+		// Destroy
+		VulkanUtility::Buffer::DestroyBufferAllocation(m_Buffer);
+		m_BufferAllocation = nullptr;
+		MemoryTracker::Untrack(this);
+	}
+
+	RHI_StructuredBuffer::RHI_StructuredBuffer(const std::shared_ptr<RHI_Device>& rhi_Device, const std::string& name)
+	{
+		m_RHI_Device = rhi_Device;
+		m_Name = name;
+	}
+
+	RHI_StructuredBuffer::~RHI_StructuredBuffer()
+	{
+		_Destroy();
+
+		// Free its bindless slot.
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			bindlessHeap->Release(RHI_Bindless_Type::StructuredBuffer, m_BindlessIndex);
+		}
+	}
+
+	bool RHI_StructuredBuffer::_Create()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice)
+		{
+			AMETHYST_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		// Destroy previous buffer.
+		_Destroy();
+
+		// Written by the CPU every frame and read in place by the GPU, so it lives in host visible memory.
+		const VkMemoryPropertyFlags memoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+		const bool writtenFrequently = true;
+
+		// STORAGE_BUFFER_BIT specifies that the buffer can be used in a VkDescriptorBufferInfo suitable for occupying a VkDescriptorSet slot of type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER.
+		VmaAllocation allocation = VulkanUtility::Buffer::CreateBufferAllocation(m_Buffer, m_Size_GPU, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, memoryFlags, writtenFrequently, nullptr);
+		if (!allocation)
+		{
+			AMETHYST_ERROR("Failed to allocate buffer.");
+			return false;
+		}
+		m_BufferAllocation = static_cast<void*>(allocation);
+
+		// Memory Accounting
+		MemoryTracker::Track(this, MemoryCategory::StructuredBuffer);
+
+		// Bindless - Written into the slot the buffer already has, if it's being recreated.
+		if (RHI_BindlessHeap* bindlessHeap = RHI_BindlessHeap::Retrieve(m_RHI_Device.get()))
+		{
+			m_BindlessIndex = bindlessHeap->SetStructuredBuffer(this, m_BindlessIndex);
+		}
+
+		// Set debug name.
+		VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkBuffer>(m_Buffer), m_Name.c_str());
+
+		return true;
+	}
+
+	void* RHI_StructuredBuffer::Map()
+	{
+		if (!m_RHI_Device || !m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice)
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation.");
+			return nullptr;
+		}
+
+		if (!m_MappedMemory)
+		{
+			if (!VulkanUtility::Error::CheckResult(vmaMapMemory(m_RHI_Device->RetrieveContextRHI()->m_Allocator, static_cast<VmaAllocation>(m_BufferAllocation), reinterpret_cast<void**>(&m_MappedMemory))))
+			{
+				AMETHYST_ERROR("Failed to map memory.");
+				return nullptr;
+			}
+		}
+
+		return m_MappedMemory;
+	}
+
+	bool RHI_StructuredBuffer::Unmap(const uint64_t offset /*= 0*/, const uint64_t size /*= 0*/)
+	{
+		if (!m_RHI_Device || !m_RHI_Device->RetrieveContextRHI()->m_LogicalDevice)
+		{
+			AMETHYST_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		if (!m_BufferAllocation)
+		{
+			AMETHYST_ERROR("Invalid allocation");
+			return false;
+		}
+
+		// The memory stays mapped, so the written range is flushed to make it visible to the GPU.
+		if (!VulkanUtility::Error::CheckResult(vmaFlushAllocation(m_RHI_Device->RetrieveContextRHI()->m_Allocator, static_cast<VmaAllocation>(m_BufferAllocation), offset, size != 0 ? size : VK_WHOLE_SIZE)))
+		{
+			AMETHYST_ERROR("Failed to flush memory.");
+			return false;
+		}
+
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
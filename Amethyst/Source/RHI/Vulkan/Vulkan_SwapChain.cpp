@@ -1,5 +1,6 @@
 #pragma once
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_SwapChain.h"
 #include "../RHI_Device.h"
@@ -472,4 +473,6 @@ namespace Amethyst
 
 		return true;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
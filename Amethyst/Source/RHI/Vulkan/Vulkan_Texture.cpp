@@ -1,11 +1,14 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_Device.h"
 #include "../RHI_Texture2D.h"
 #include "../RHI_TextureCube.h"
 #include "../RHI_CommandList.h"
 #include "../RHI_DescriptorSetLayoutCache.h"
+#include "../RHI_UploadHeap.h"
 #include "../Rendering/Renderer.h"
+#include "../../Profiling/MemoryTracker.h"
 
 namespace Amethyst
 {
@@ -55,124 +58,6 @@ namespace Amethyst
 		level index, which allows for multiple mip-map levels. See: https://image.slidesharecdn.com/sa2008modernopengl-1231549184153966-1/95/siggraph-asia-2008-modern-opengl-56-638.jpg?cb=1422672731
 	*/
 
-	inline bool CopyToStagingBuffer(RHI_Texture* texture, std::vector<VkBufferImageCopy>& bufferImageCopies, void*& stagingBuffer)
-	{
-		if (!texture->HasData())
-		{
-			AMETHYST_WARNING("No data to stage.");
-			return true;
-		}
-
-		const uint32_t textureWidth = texture->RetrieveWidth();
-		const uint32_t textureHeight = texture->RetrieveHeight();
-		const uint32_t arraySize = texture->RetrieveArraySize();
-		const uint32_t mipLevels = texture->RetrieveMipCount();
-		const uint32_t bytesPerPixel = texture->RetrieveBytesPerPixel();
-
-		// Fill out VkBufferImageCopy structs describing the array and mip-levels.
-		VkDeviceSize bufferOffset = 0;
-		for (uint32_t arrayIndex = 0; arrayIndex < arraySize; arrayIndex++) // For each array texture...
-		{
-			for (uint32_t mipIndex = 0; mipIndex < mipLevels; mipIndex++) // For each of its mip levels...
-			{
-				uint32_t mipWidth = textureWidth >> mipIndex; // Example: 1024 >> 3 = 128.
-				uint32_t mipHeight = textureHeight >> mipIndex; // Example: 1024 >> 3 = 128.
-
-				VkBufferImageCopy regionInfo = {};
-				regionInfo.bufferOffset = bufferOffset; // Offset in bytes from the start of the buffer object where the image data is copied from or to.
-
-				/*
-					bufferRowLength and bufferImageHeight specify in texels a subregion of a larger two or three-dimensional image in buffer memory, and control the 
-					addressing calculations. If either of these values is zero, that aspect of the buffer memory is considered to be tightly packed according to imageExtent.
-				*/
-				regionInfo.bufferRowLength = 0;
-				regionInfo.bufferImageHeight = 0;
-				regionInfo.imageSubresource.aspectMask = VulkanUtility::Image::RetrieveAspectMask(texture);
-				regionInfo.imageSubresource.mipLevel = mipIndex;
-				regionInfo.imageSubresource.baseArrayLayer = arrayIndex;
-				regionInfo.imageSubresource.layerCount = arraySize;
-				regionInfo.imageOffset = { 0, 0, 0 };
-				regionInfo.imageExtent = { mipWidth, mipHeight, 1 };
-
-				bufferImageCopies[mipIndex] = regionInfo;
-
-				// Update staging buffer memory requirement (in bytes).
-				bufferOffset += mipWidth * mipHeight * bytesPerPixel;
-			}
-		}
-
-		// Create staging buffer. VK_BUFFER_USAGE_TRANSFER_SRC_BIT specifies that the buffer can be used as the source of a transfer command. 
-		VmaAllocation allocation = VulkanUtility::Buffer::CreateBufferAllocation(stagingBuffer, bufferOffset, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-		// Copy array and mip-level data to the staging buffer.
-		void* data = nullptr; // Staging buffer.
-		bufferOffset = 0;
-		if (VulkanUtility::Error::CheckResult(vmaMapMemory(VulkanUtility::Globals::g_RHI_Context->m_Allocator, allocation, &data)))
-		{
-			for (uint32_t arrayIndex = 0; arrayIndex < arraySize; arrayIndex++) // For each array texture...
-			{
-				for (uint32_t mipIndex = 0; mipIndex < mipLevels; mipIndex++) // For each of its mip levels...
-				{
-					uint64_t bufferSize = (textureWidth >> mipIndex) * (textureHeight >> mipIndex) * bytesPerPixel;
-					memcpy(static_cast<std::byte*>(data) + bufferOffset, texture->RetrieveMip(arrayIndex + mipIndex).data(), bufferSize);
-					bufferOffset += bufferSize;
-				}
-			}
-
-			vmaUnmapMemory(VulkanUtility::Globals::g_RHI_Context->m_Allocator, allocation);
-		}
-
-		return true;
-	}
-
-	inline bool StageMemoryAndCopyBufferToImage(RHI_Texture* texture, RHI_Image_Layout& textureLayout)
-	{
-		// Copy the texture's data to a staging buffer.
-		void* stagingBuffer = nullptr;
-		std::vector<VkBufferImageCopy> bufferImageCopies(texture->RetrieveMipCount()); // Structure specifying a buffer image copy operation. Can be used to copy specific regions of an image.
-		if (!CopyToStagingBuffer(texture, bufferImageCopies, stagingBuffer))
-		{
-			return false;
-		}
-
-		// Copy the staging buffer into the image.
-		if (VkCommandBuffer commandBuffer = VulkanUtility::CommandBufferImmediate::BeginRecording(RHI_Queue_Type::RHI_Queue_Graphics))
-		{
-			// Optimal layout for images which are the destination of a transfer.
-			RHI_Image_Layout layout = RHI_Image_Layout::Transfer_Destination_Optimal;
-
-			// Transition to Layout.
-			if (!VulkanUtility::Image::SetLayout(commandBuffer, texture, layout))
-			{
-				return false;
-			}
-
-			// Copy data from the staging buffer into our Vulkan image.
-			vkCmdCopyBufferToImage(
-				commandBuffer, // Command Buffer
-				static_cast<VkBuffer>(stagingBuffer), // Source Buffer
-				static_cast<VkImage>(texture->RetrieveResource()), // Destination Image
-				VulkanImageLayout[static_cast<uint8_t>(layout)], // Destination Image Layout
-				static_cast<uint32_t>(bufferImageCopies.size()), // The number of regions to copy. Each region is copied from the specified region of the source buffer to the specified region of the destination image.
-				bufferImageCopies.data() // Pointer to an array of VkBufferImageCopy structures specifying the regions to copy.
-			);
-
-			// End command buffer.
-			if (!VulkanUtility::CommandBufferImmediate::EndRecordingAndSubmit(RHI_Queue_Type::RHI_Queue_Graphics))
-			{
-				return false;
-			}
-
-			// Free staging buffer as we have already done everything we need to.
-			VulkanUtility::Buffer::DestroyBufferAllocation(stagingBuffer);
-
-			// Let the texture know about its new layout.
-			textureLayout = layout;
-		}
-
-		return true;
-	}
-
 	RHI_Texture2D::~RHI_Texture2D()
 	{
 		if (!m_RHI_Device || !m_RHI_Device->IsInitialized())
@@ -195,8 +80,16 @@ namespace Amethyst
 			}
 		}
 
+		// Its bindless slot can be handed out again, now that the GPU is done with it.
+		ReleaseBindlessIndex();
+
 		// Deallocate everything.
 		m_Data.clear();
+		DestroyResourceGPU();
+	}
+
+	void RHI_Texture::DestroyResourceGPU()
+	{
 		VulkanUtility::Image::View::DestroyImageView(m_ResourceView[0]); // Color/Depth
 		VulkanUtility::Image::View::DestroyImageView(m_ResourceView[1]); // Stencil
 
@@ -209,6 +102,29 @@ namespace Amethyst
 		VulkanUtility::Image::DestroyImage(this);
 	}
 
+	void RHI_Texture::UpdateMemoryAccounting()
+	{
+		// CPU - Whatever mip data we are still holding on to.
+		m_Size_CPU = 0;
+		for (const std::vector<std::byte>& mip : m_Data)
+		{
+			m_Size_CPU += static_cast<uint64_t>(mip.size());
+		}
+
+		// GPU - What VMA actually allocated for the image, alignment and padding included.
+		m_Size_GPU = 0;
+		const RHI_Context* rhi_Context = m_RHI_Device->RetrieveContextRHI();
+		auto iterator = rhi_Context->m_Allocations.find(RetrieveObjectID());
+		if (iterator != rhi_Context->m_Allocations.end())
+		{
+			VmaAllocationInfo allocationInfo = {};
+			vmaGetAllocationInfo(rhi_Context->m_Allocator, iterator->second, &allocationInfo);
+			m_Size_GPU = static_cast<uint64_t>(allocationInfo.size);
+		}
+
+		MemoryTracker::Track(this, (IsRenderTarget() || IsDepthStencil()) ? MemoryCategory::RenderTarget : MemoryCategory::Texture);
+	}
+
 	void RHI_Texture::SetLayout(const RHI_Image_Layout newLayout, RHI_CommandList* commandList /*= nullptr*/)
 	{
 		// The texture is most likely still initializing.
@@ -282,39 +198,27 @@ namespace Amethyst
 			return false;
 		}
 
-		// If the texture has any data, stage it.
-		if (HasData())
+		// Memory Accounting
+		UpdateMemoryAccounting();
+
+		// Stage the texture's data (if any) and transition to the target layout, through the upload heap. The copy runs on the transfer queue, and the texture is bound once it's resident.
+		RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+		if (!uploadHeap)
 		{
-			if (!StageMemoryAndCopyBufferToImage(this, m_Layout))
-			{
-				AMETHYST_ERROR("Failed to stage data.");
-				return false;
-			}
+			AMETHYST_ERROR("No upload heap to stage data through.");
+			return false;
 		}
 
-		// Transition to target layout.
-		if (VkCommandBuffer commandBuffer = VulkanUtility::CommandBufferImmediate::BeginRecording(RHI_Queue_Type::RHI_Queue_Graphics))
+		const RHI_Image_Layout targetLayout = RetrieveAppropriateLayout(this);
+		if (!uploadHeap->UploadTexture(this, targetLayout, m_UploadValue))
 		{
-			RHI_Image_Layout targetLayout = RetrieveAppropriateLayout(this);
-
-			// Transition to the final layout.
-			if (!VulkanUtility::Image::SetLayout(commandBuffer, this, targetLayout))
-			{
-				AMETHYST_ERROR("Failed to transition layout.");
-				return false;
-			}
-
-			// Submit
-			if (!VulkanUtility::CommandBufferImmediate::EndRecordingAndSubmit(RHI_Queue_Type::RHI_Queue_Graphics))
-			{
-				AMETHYST_ERROR("Failed to end command buffer.");
-				return false;
-			}
-
-			// Update this texture with the new layout.
-			m_Layout = targetLayout;
+			AMETHYST_ERROR("Failed to stage data.");
+			return false;
 		}
 
+		// Update this texture with the new layout.
+		m_Layout = targetLayout;
+
 		// Create Image Views. Remember that image objects are not directly accessed by pipeline shaders for reading or writing of image data. Instead, image views representating contiguous ranges of the image subresources/additional metadata are used for that purpose.
 		{
 			// Shader Resource Views
@@ -369,6 +273,9 @@ namespace Amethyst
 			SetDebugName(this);
 		}
 
+		// Give shaders access to it through the bindless arrays.
+		UpdateBindlessIndex();
+
 		return true;
 	}
 
@@ -383,16 +290,7 @@ namespace Amethyst
 		m_RHI_Device->Queue_WaitAll();
 		m_Data.clear();
 
-		VulkanUtility::Image::View::DestroyImageView(m_ResourceView[0]);
-		VulkanUtility::Image::View::DestroyImageView(m_ResourceView[1]);
-
-		for (uint32_t i = 0; i < g_RHI_MaxRenderTargetCount; i++)
-		{
-			VulkanUtility::Image::View::DestroyImageView(m_ResourceView_DepthStencil[i]);
-			VulkanUtility::Image::View::DestroyImageView(m_ResourceView_RenderTarget[i]);
-		}
-
-		VulkanUtility::Image::DestroyImage(this);
+		DestroyResourceGPU();
 	}
 
 	bool RHI_TextureCube::CreateResourceGPU()
@@ -410,36 +308,26 @@ namespace Amethyst
 			return false;
 		}
 
-		// If the texture has any data, stage it.
-		if (HasData())
+		// Memory Accounting
+		UpdateMemoryAccounting();
+
+		// Stage the texture's data (if any) and transition to the target layout, through the upload heap.
+		RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+		if (!uploadHeap)
 		{
-			if (!StageMemoryAndCopyBufferToImage(this, m_Layout))
-			{
-				return false;
-			}
+			AMETHYST_ERROR("No upload heap to stage data through.");
+			return false;
 		}
 
-		// Transition to target layout.
-		if (VkCommandBuffer commandBuffer = VulkanUtility::CommandBufferImmediate::BeginRecording(RHI_Queue_Type::RHI_Queue_Graphics))
+		const RHI_Image_Layout targetLayout = RetrieveAppropriateLayout(this);
+		if (!uploadHeap->UploadTexture(this, targetLayout, m_UploadValue))
 		{
-			RHI_Image_Layout targetLayout = RetrieveAppropriateLayout(this);
-
-			// Transition to the final layout.
-			if (!VulkanUtility::Image::SetLayout(commandBuffer, this, targetLayout))
-			{
-				return false;
-			}
-
-			// Submit
-			if (!VulkanUtility::CommandBufferImmediate::EndRecordingAndSubmit(RHI_Queue_Type::RHI_Queue_Graphics))
-			{
-				return false;
-			}
-
-			// Update this texture with the new layout.
-			m_Layout = targetLayout;
+			return false;
 		}
 
+		// Update this texture with the new layout.
+		m_Layout = targetLayout;
+
 		// Create Image Views
 		{
 			// Shader Resource Views
@@ -496,4 +384,6 @@ namespace Amethyst
 
 		return true;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
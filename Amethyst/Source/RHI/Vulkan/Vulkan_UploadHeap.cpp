@@ -0,0 +1,291 @@
+#include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
+#include "../RHI_Implementation.h"
+#include "../RHI_UploadHeap.h"
+#include "../RHI_Device.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Texture.h"
+
+namespace Amethyst
+{
+	inline VmaAllocation RetrieveAllocation(void* buffer)
+	{
+		const RHI_Context* rhi_Context = VulkanUtility::Globals::g_RHI_Context;
+		auto iterator = rhi_Context->m_Allocations.find(reinterpret_cast<uint64_t>(buffer));
+		return iterator != rhi_Context->m_Allocations.end() ? iterator->second : nullptr;
+	}
+
+	// Resources are exclusive to a queue family, so when the transfer queue is a family of its own, ownership has to be released there and acquired on the graphics queue.
+	inline bool IsOwnershipTransferRequired()
+	{
+		return VulkanUtility::Globals::g_RHI_Context->m_Queue_TransferIndex != VulkanUtility::Globals::g_RHI_Context->m_Queue_GraphicsIndex;
+	}
+
+	/*
+		An ownership transfer is the same barrier recorded twice, once on each queue. The release only has to wait for the copy and the acquire only has to make the
+		data visible to the stages that follow, so each half leaves the other's stages and accesses out. The acquire's semaphore wait orders the two.
+	*/
+	inline void TransferOwnership(VkCommandBuffer commandBuffer, const bool release, VkBufferMemoryBarrier* bufferBarrier, VkImageMemoryBarrier* imageBarrier, VkPipelineStageFlags acquireStage)
+	{
+		const uint32_t transferIndex = VulkanUtility::Globals::g_RHI_Context->m_Queue_TransferIndex;
+		const uint32_t graphicsIndex = VulkanUtility::Globals::g_RHI_Context->m_Queue_GraphicsIndex;
+
+		VkAccessFlags* sourceAccessMask = bufferBarrier ? &bufferBarrier->srcAccessMask : &imageBarrier->srcAccessMask;
+		VkAccessFlags* destinationAccessMask = bufferBarrier ? &bufferBarrier->dstAccessMask : &imageBarrier->dstAccessMask;
+		*(release ? destinationAccessMask : sourceAccessMask) = 0;
+
+		if (bufferBarrier)
+		{
+			bufferBarrier->srcQueueFamilyIndex = transferIndex;
+			bufferBarrier->dstQueueFamilyIndex = graphicsIndex;
+		}
+		else
+		{
+			imageBarrier->srcQueueFamilyIndex = transferIndex;
+			imageBarrier->dstQueueFamilyIndex = graphicsIndex;
+		}
+
+		vkCmdPipelineBarrier
+		(
+			commandBuffer,
+			release ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			release ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : acquireStage,
+			0,
+			0, nullptr,
+			bufferBarrier ? 1 : 0, bufferBarrier,
+			imageBarrier ? 1 : 0, imageBarrier
+		);
+	}
+
+	bool RHI_UploadHeap::CreateResources()
+	{
+		// Ring - Host visible, and mapped for as long as it lives.
+		VmaAllocation allocation = VulkanUtility::Buffer::CreateBufferAllocation(m_Buffer, g_RHI_UploadHeap_Size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		if (!allocation)
+		{
+			return false;
+		}
+
+		if (!VulkanUtility::Error::CheckResult(vmaMapMemory(m_RHI_Device->RetrieveContextRHI()->m_Allocator, allocation, reinterpret_cast<void**>(&m_MappedData))))
+		{
+			return false;
+		}
+
+		VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkBuffer>(m_Buffer), "Upload Heap");
+
+		// Command Buffers - Three per batch, all recorded under the heap's lock. Copies come from the transfer family's pool, the rest from the graphics family's.
+		if (!VulkanUtility::CommandPool::CreateCommandPool(m_CommandPoolCopy, RHI_Queue_Type::RHI_Queue_Transfer) || !VulkanUtility::CommandPool::CreateCommandPool(m_CommandPoolGraphics, RHI_Queue_Type::RHI_Queue_Graphics))
+		{
+			return false;
+		}
+
+		for (Batch& batch : m_Batches)
+		{
+			if (!VulkanUtility::CommandBuffer::CreateCommandBuffer(m_CommandPoolCopy, batch.m_CommandBufferCopy, VK_COMMAND_BUFFER_LEVEL_PRIMARY) ||
+				!VulkanUtility::CommandBuffer::CreateCommandBuffer(m_CommandPoolGraphics, batch.m_CommandBufferTransition, VK_COMMAND_BUFFER_LEVEL_PRIMARY) ||
+				!VulkanUtility::CommandBuffer::CreateCommandBuffer(m_CommandPoolGraphics, batch.m_CommandBufferAcquire, VK_COMMAND_BUFFER_LEVEL_PRIMARY))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void RHI_UploadHeap::DestroyResources()
+	{
+		for (Batch& batch : m_Batches)
+		{
+			if (batch.m_CommandBufferCopy)
+			{
+				VulkanUtility::CommandBuffer::DestroyCommandBuffer(m_CommandPoolCopy, batch.m_CommandBufferCopy);
+				batch.m_CommandBufferCopy = nullptr;
+			}
+
+			if (batch.m_CommandBufferTransition)
+			{
+				VulkanUtility::CommandBuffer::DestroyCommandBuffer(m_CommandPoolGraphics, batch.m_CommandBufferTransition);
+				batch.m_CommandBufferTransition = nullptr;
+			}
+
+			if (batch.m_CommandBufferAcquire)
+			{
+				VulkanUtility::CommandBuffer::DestroyCommandBuffer(m_CommandPoolGraphics, batch.m_CommandBufferAcquire);
+				batch.m_CommandBufferAcquire = nullptr;
+			}
+		}
+
+		if (m_CommandPoolCopy)
+		{
+			VulkanUtility::CommandPool::DestroyCommandPool(m_CommandPoolCopy);
+		}
+
+		if (m_CommandPoolGraphics)
+		{
+			VulkanUtility::CommandPool::DestroyCommandPool(m_CommandPoolGraphics);
+		}
+
+		if (m_MappedData)
+		{
+			vmaUnmapMemory(m_RHI_Device->RetrieveContextRHI()->m_Allocator, RetrieveAllocation(m_Buffer));
+			m_MappedData = nullptr;
+		}
+
+		VulkanUtility::Buffer::DestroyBufferAllocation(m_Buffer);
+	}
+
+	bool RHI_UploadHeap::BeginBatch(Batch& batch)
+	{
+		VkCommandBufferBeginInfo beginInfo = {};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // Recorded again from scratch every time the batch is reused.
+
+		for (void* commandBuffer : { batch.m_CommandBufferCopy, batch.m_CommandBufferTransition, batch.m_CommandBufferAcquire })
+		{
+			if (!VulkanUtility::Error::CheckResult(vkBeginCommandBuffer(static_cast<VkCommandBuffer>(commandBuffer), &beginInfo)))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool RHI_UploadHeap::SubmitBatch(Batch& batch)
+	{
+		if (!VulkanUtility::Error::CheckResult(vkEndCommandBuffer(static_cast<VkCommandBuffer>(batch.m_CommandBufferCopy))) ||
+			!VulkanUtility::Error::CheckResult(vkEndCommandBuffer(static_cast<VkCommandBuffer>(batch.m_CommandBufferTransition))))
+		{
+			return false;
+		}
+
+		// Nothing waits for the copies on the GPU until they are known to be done, so the transfer queue runs alongside whatever the graphics queue is doing.
+		if (!m_RHI_Device->Queue_Submit(RHI_Queue_Type::RHI_Queue_Transfer, VK_PIPELINE_STAGE_TRANSFER_BIT, batch.m_CommandBufferCopy, nullptr, m_CopyTimeline.get(), nullptr, 0, batch.m_Value))
+		{
+			return false;
+		}
+
+		// Transitions are ordered before any command list submitted after them by the queue itself.
+		return m_RHI_Device->Queue_Submit(RHI_Queue_Type::RHI_Queue_Graphics, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, batch.m_CommandBufferTransition);
+	}
+
+	bool RHI_UploadHeap::AcquireBatch(Batch& batch)
+	{
+		if (!VulkanUtility::Error::CheckResult(vkEndCommandBuffer(static_cast<VkCommandBuffer>(batch.m_CommandBufferAcquire))))
+		{
+			return false;
+		}
+
+		// The copies are done by now, but the wait is what makes their writes visible to the graphics queue.
+		return m_RHI_Device->Queue_Submit(RHI_Queue_Type::RHI_Queue_Graphics, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, batch.m_CommandBufferAcquire, m_CopyTimeline.get(), m_AcquireTimeline.get(), nullptr, batch.m_Value, batch.m_Value);
+	}
+
+	void RHI_UploadHeap::RecordBufferCopy(Batch& batch, void* sourceBuffer, const uint64_t sourceOffset, void* destinationBuffer, const uint64_t size)
+	{
+		VkBufferCopy copyRegion = {};
+		copyRegion.srcOffset = sourceOffset;
+		copyRegion.dstOffset = 0;
+		copyRegion.size = size;
+
+		vkCmdCopyBuffer(static_cast<VkCommandBuffer>(batch.m_CommandBufferCopy), static_cast<VkBuffer>(sourceBuffer), static_cast<VkBuffer>(destinationBuffer), 1, &copyRegion);
+
+		// Within one family, the semaphore wait alone makes the copy visible.
+		if (IsOwnershipTransferRequired())
+		{
+			VkBufferMemoryBarrier bufferBarrier = {};
+			bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			bufferBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+			bufferBarrier.buffer = static_cast<VkBuffer>(destinationBuffer);
+			bufferBarrier.offset = 0;
+			bufferBarrier.size = VK_WHOLE_SIZE;
+
+			VkBufferMemoryBarrier acquireBarrier = bufferBarrier;
+			TransferOwnership(static_cast<VkCommandBuffer>(batch.m_CommandBufferCopy), true, &bufferBarrier, nullptr, 0);
+			TransferOwnership(static_cast<VkCommandBuffer>(batch.m_CommandBufferAcquire), false, &acquireBarrier, nullptr, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+		}
+	}
+
+	void RHI_UploadHeap::RecordTextureCopy(Batch& batch, void* sourceBuffer, const std::vector<uint64_t>& sourceOffsets, RHI_Texture* texture, const RHI_Image_Layout targetLayout)
+	{
+		const VkImageAspectFlags aspectMask = VulkanUtility::Image::RetrieveAspectMask(texture);
+		const uint32_t mipCount = texture->RetrieveMipCount();
+		const uint32_t arraySize = texture->RetrieveArraySize();
+
+		// Without data, there is nothing for the transfer queue to do.
+		if (sourceOffsets.empty())
+		{
+			VulkanUtility::Image::SetLayout(batch.m_CommandBufferTransition, texture->RetrieveResource(), aspectMask, mipCount, arraySize, texture->RetrieveLayout(), targetLayout);
+			return;
+		}
+
+		VkCommandBuffer commandBuffer = static_cast<VkCommandBuffer>(batch.m_CommandBufferCopy);
+		const RHI_Image_Layout layout = RHI_Image_Layout::Transfer_Destination_Optimal;
+
+		// Optimal layout for images which are the destination of a transfer.
+		VulkanUtility::Image::SetLayout(commandBuffer, texture->RetrieveResource(), aspectMask, mipCount, arraySize, texture->RetrieveLayout(), layout);
+
+		// One region per mip of every slice, all tightly packed.
+		std::vector<VkBufferImageCopy> bufferImageCopies(sourceOffsets.size());
+		for (uint32_t arrayIndex = 0; arrayIndex < arraySize; arrayIndex++)
+		{
+			for (uint32_t mipIndex = 0; mipIndex < mipCount; mipIndex++)
+			{
+				VkBufferImageCopy& regionInfo = bufferImageCopies[arrayIndex * mipCount + mipIndex];
+				regionInfo.bufferOffset = sourceOffsets[arrayIndex * mipCount + mipIndex];
+				regionInfo.bufferRowLength = 0;
+				regionInfo.bufferImageHeight = 0;
+				regionInfo.imageSubresource.aspectMask = aspectMask;
+				regionInfo.imageSubresource.mipLevel = mipIndex;
+				regionInfo.imageSubresource.baseArrayLayer = arrayIndex;
+				regionInfo.imageSubresource.layerCount = 1;
+				regionInfo.imageOffset = { 0, 0, 0 };
+				regionInfo.imageExtent = { Math::Utilities::Max(texture->RetrieveWidth() >> mipIndex, 1u), Math::Utilities::Max(texture->RetrieveHeight() >> mipIndex, 1u), 1 };
+			}
+		}
+
+		vkCmdCopyBufferToImage(
+			commandBuffer,
+			static_cast<VkBuffer>(sourceBuffer),
+			static_cast<VkImage>(texture->RetrieveResource()),
+			VulkanImageLayout[static_cast<uint8_t>(layout)],
+			static_cast<uint32_t>(bufferImageCopies.size()),
+			bufferImageCopies.data()
+		);
+
+		// Transition to the final layout, on the graphics queue, as part of the acquire.
+		if (IsOwnershipTransferRequired())
+		{
+			VkImageMemoryBarrier imageBarrier;
+			VkPipelineStageFlags sourceStage;
+			VkPipelineStageFlags destinationStage;
+			VulkanUtility::Image::CreateImageBarrier(imageBarrier, sourceStage, destinationStage, texture->RetrieveResource(), aspectMask, mipCount, arraySize, layout, targetLayout);
+
+			VkImageMemoryBarrier acquireBarrier = imageBarrier;
+			TransferOwnership(commandBuffer, true, nullptr, &imageBarrier, 0);
+			TransferOwnership(static_cast<VkCommandBuffer>(batch.m_CommandBufferAcquire), false, nullptr, &acquireBarrier, destinationStage);
+		}
+		else
+		{
+			VulkanUtility::Image::SetLayout(batch.m_CommandBufferAcquire, texture->RetrieveResource(), aspectMask, mipCount, arraySize, layout, targetLayout);
+		}
+	}
+
+	void* RHI_UploadHeap::CreateOverflowBuffer(const void* data, const uint64_t size)
+	{
+		void* buffer = nullptr;
+		if (!VulkanUtility::Buffer::CreateBufferAllocation(buffer, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false, data))
+		{
+			return nullptr;
+		}
+
+		return buffer;
+	}
+
+	void RHI_UploadHeap::DestroyOverflowBuffer(void*& buffer)
+	{
+		VulkanUtility::Buffer::DestroyBufferAllocation(buffer);
+	}
+}
+
+#endif
\ No newline at end of file
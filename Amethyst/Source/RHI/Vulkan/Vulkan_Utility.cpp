@@ -1,7 +1,9 @@
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #define VMA_IMPLEMENTATION
 #include "../RHI_Implementation.h"
 #include "Vulkan_Utility.h"
+#include "../RHI_AliasedMemory.h"
 
 namespace Amethyst::VulkanUtility
 {
@@ -18,6 +20,24 @@ namespace Amethyst::VulkanUtility
 	std::mutex CommandBufferImmediate::m_MutexEnd;
 	std::unordered_map<RHI_Queue_Type, CommandBufferImmediate::CBI_Object> CommandBufferImmediate::m_CommandBufferObjects;
 
+	static void RetrieveImageCreateInfo(RHI_Texture* texture, VkImageCreateInfo& createInfo)
+	{
+		createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		createInfo.imageType = VK_IMAGE_TYPE_2D; // Specifies the type of an image object (basic dimensionality): 1D, 2D, 3D. 
+		createInfo.flags = (texture->RetrieveResourceType() == ResourceType::TextureCube) ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0; // Specifies that the image can be used to create a VkImageView of type VK_IMAGE_VIEW_TYPE_CUBE or VK_IMAGE_VIEW_TYPE_CUBE_ARRAY.
+		createInfo.extent.width = texture->RetrieveWidth();
+		createInfo.extent.height = texture->RetrieveHeight();
+		createInfo.extent.depth = 1;
+		createInfo.mipLevels = texture->RetrieveMipCount(); // The number of levels of details avaliable for minified sampling of the image.
+		createInfo.arrayLayers = texture->RetrieveArraySize();
+		createInfo.format = VulkanFormat[texture->RetrieveFormat()]; // The format and type of texel blocks that will be contained in the image.
+		createInfo.tiling = VK_IMAGE_TILING_OPTIMAL; // Specifies the tiling arragement of the texel blocks in memory. Ideally, we can always choose optimal for this.
+		createInfo.initialLayout = VulkanImageLayout[static_cast<uint8_t>(texture->RetrieveLayout())];
+		createInfo.usage = Image::RetrieveUsageFlags(texture); // The intended usage of the image: https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VkImageUsageFlagBits.html
+		createInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // Sharing mode (exclusive/concurrent) when accessed by multiple queue families.
+	}
+
 	bool Image::CreateImage(RHI_Texture* texture)
 	{
 		// Retrieve format support.
@@ -45,20 +65,26 @@ namespace Amethyst::VulkanUtility
 		texture->SetLayout(RHI_Image_Layout::Preinitialized);
 
 		VkImageCreateInfo createInfo = {};
-		createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-		createInfo.imageType = VK_IMAGE_TYPE_2D; // Specifies the type of an image object (basic dimensionality): 1D, 2D, 3D. 
-		createInfo.flags = (texture->RetrieveResourceType() == ResourceType::TextureCube) ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0; // Specifies that the image can be used to create a VkImageView of type VK_IMAGE_VIEW_TYPE_CUBE or VK_IMAGE_VIEW_TYPE_CUBE_ARRAY.
-		createInfo.extent.width = texture->RetrieveWidth();
-		createInfo.extent.height = texture->RetrieveHeight();
-		createInfo.extent.depth = 1;
-		createInfo.mipLevels = texture->RetrieveMipCount(); // The number of levels of details avaliable for minified sampling of the image.
-		createInfo.arrayLayers = texture->RetrieveArraySize();
-		createInfo.format = VulkanFormat[format]; // The format and type of texel blocks that will be contained in the image.
-		createInfo.tiling = VK_IMAGE_TILING_OPTIMAL; // Specifies the tiling arragement of the texel blocks in memory. Ideally, we can always choose optimal for this.
-		createInfo.initialLayout = VulkanImageLayout[static_cast<uint8_t>(texture->RetrieveLayout())];
-		createInfo.usage = RetrieveUsageFlags(texture); // The intended usage of the image: https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VkImageUsageFlagBits.html
-		createInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-		createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // Sharing mode (exclusive/concurrent) when accessed by multiple queue families. 
+		RetrieveImageCreateInfo(texture, createInfo);
+
+		// Aliased textures are bound to the start of the memory they share, which was allocated to fit all of them.
+		if (RHI_AliasedMemory* aliasedMemory = texture->RetrieveAliasedMemory())
+		{
+			VkImage image = nullptr;
+			if (!Error::CheckResult(vkCreateImage(Globals::g_RHI_Context->m_LogicalDevice, &createInfo, nullptr, &image)))
+			{
+				return false;
+			}
+
+			if (!Error::CheckResult(vmaBindImageMemory(Globals::g_RHI_Context->m_Allocator, static_cast<VmaAllocation>(aliasedMemory->RetrieveResource()), image)))
+			{
+				vkDestroyImage(Globals::g_RHI_Context->m_LogicalDevice, image, nullptr);
+				return false;
+			}
+
+			texture->SetResource(static_cast<void*>(image));
+			return true;
+		}
 
 		VmaAllocationCreateInfo allocationInfo = {};
 
@@ -86,11 +112,37 @@ namespace Amethyst::VulkanUtility
 		return true;
 	}
 
+	bool Image::RetrieveMemoryRequirements(RHI_Texture* texture, VkMemoryRequirements& memoryRequirements)
+	{
+		VkImageCreateInfo createInfo = {};
+		RetrieveImageCreateInfo(texture, createInfo);
+
+		// Requirements can only be queried from an image, so create one that is never bound to memory.
+		VkImage image = nullptr;
+		if (!Error::CheckResult(vkCreateImage(Globals::g_RHI_Context->m_LogicalDevice, &createInfo, nullptr, &image)))
+		{
+			return false;
+		}
+
+		vkGetImageMemoryRequirements(Globals::g_RHI_Context->m_LogicalDevice, image, &memoryRequirements);
+		vkDestroyImage(Globals::g_RHI_Context->m_LogicalDevice, image, nullptr);
+
+		return true;
+	}
+
 	void Image::DestroyImage(RHI_Texture* texture)
 	{
 		void* resource = texture->RetrieveResource();
 		uint64_t allocationID = texture->RetrieveObjectID();
 
+		// The memory belongs to the RHI_AliasedMemory, so only the image goes.
+		if (texture->RetrieveAliasedMemory())
+		{
+			vkDestroyImage(Globals::g_RHI_Context->m_LogicalDevice, static_cast<VkImage>(resource), nullptr);
+			texture->SetResource(nullptr);
+			return;
+		}
+
 		auto it = Globals::g_RHI_Context->m_Allocations.find(allocationID);
 		if (it != Globals::g_RHI_Context->m_Allocations.end())
 		{
@@ -190,4 +242,6 @@ namespace Amethyst::VulkanUtility
 			buffer = nullptr;
 		}
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
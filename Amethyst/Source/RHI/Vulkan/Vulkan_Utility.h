@@ -447,6 +447,7 @@ namespace Amethyst::VulkanUtility
 	{
 		bool CreateImage(RHI_Texture* texture);
 		void DestroyImage(RHI_Texture* texture);
+		bool RetrieveMemoryRequirements(RHI_Texture* texture, VkMemoryRequirements& memoryRequirements);
 
 		inline VkImageTiling RetrieveFormatTiling(const RHI_Format format, VkFormatFeatureFlags featureFlags)
 		{
@@ -718,14 +719,15 @@ namespace Amethyst::VulkanUtility
 			return accessMask;
 		}
 
-		inline bool SetLayout(void* commandBuffer, void* image, const VkImageAspectFlags aspectMask, const uint32_t mipLevelCount, const uint32_t layerCount, const RHI_Image_Layout oldLayout, const RHI_Image_Layout newLayout)
+		// Fills in the barrier for a layout transition, along with the stages it has to wait on and the stages it blocks.
+		inline void CreateImageBarrier(VkImageMemoryBarrier& imageBarrierInfo, VkPipelineStageFlags& sourceStage, VkPipelineStageFlags& destinationStage, void* image, const VkImageAspectFlags aspectMask, const uint32_t mipLevelCount, const uint32_t layerCount, const RHI_Image_Layout oldLayout, const RHI_Image_Layout newLayout)
 		{
 			/*
 				VkImageMemoryBarriers make sure that our operations done on the GPU occur in a particular order which assure we get the expected result. A barrier 
 				seperates two operations in a queue: before the barrier and after the barrier. Work done before the barrier will always finish before it can be used again.
 			*/
 
-			VkImageMemoryBarrier imageBarrierInfo = {};
+			imageBarrierInfo = {};
 			imageBarrierInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 			imageBarrierInfo.pNext = nullptr;
 			imageBarrierInfo.oldLayout = VulkanImageLayout[static_cast<uint8_t>(oldLayout)];
@@ -778,7 +780,7 @@ namespace Amethyst::VulkanUtility
 				Simiarly, if you want to be safe on the target side, you move upwards towards the top of the pipe - but it prevents more stages from running, 
 				so that should be avoided as well.
 			*/
-			VkPipelineStageFlags sourceStage = 0; // What stages must finish first. 
+			sourceStage = 0; // What stages must finish first. 
 			{
 				if (imageBarrierInfo.oldLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR)
 				{
@@ -794,9 +796,9 @@ namespace Amethyst::VulkanUtility
 				}
 			}
 
-			VkPipelineStageFlags destinationStage = 0; // What stages cannot execute until the transition is complete.
+			destinationStage = 0; // What stages cannot execute until the transition is complete.
 			{
-				if (imageBarrierInfo.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR)
+				if (imageBarrierInfo.newLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR)
 				{
 					destinationStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT; // We don't start a brand new stage until the transition is complete.
 				}
@@ -809,6 +811,14 @@ namespace Amethyst::VulkanUtility
 					destinationStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
 				}
 			}
+		}
+
+		inline bool SetLayout(void* commandBuffer, void* image, const VkImageAspectFlags aspectMask, const uint32_t mipLevelCount, const uint32_t layerCount, const RHI_Image_Layout oldLayout, const RHI_Image_Layout newLayout)
+		{
+			VkImageMemoryBarrier imageBarrierInfo;
+			VkPipelineStageFlags sourceStage;
+			VkPipelineStageFlags destinationStage;
+			CreateImageBarrier(imageBarrierInfo, sourceStage, destinationStage, image, aspectMask, mipLevelCount, layerCount, oldLayout, newLayout);
 
 			// Record the command and insert our execution dependencies and memory dependencies.
 			vkCmdPipelineBarrier
@@ -1309,6 +1319,11 @@ namespace Amethyst::VulkanUtility
 			return VK_DESCRIPTOR_TYPE_SAMPLER;
 		}
 
+		if (descriptor.m_DescriptorType == RHI_Descriptor_Type::StructuredBuffer)
+		{
+			return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		}
+
 		AMETHYST_ERROR("Invalid descriptor type.");
 		return VK_DESCRIPTOR_TYPE_MAX_ENUM;
 	}
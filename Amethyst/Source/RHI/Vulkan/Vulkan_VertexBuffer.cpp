@@ -1,15 +1,24 @@
 #pragma once
 #include "Amethyst.h"
+#ifdef API_GRAPHICS_VULKAN
 #include "../RHI_Implementation.h"
 #include "../RHI_Device.h"
 #include "../RHI_VertexBuffer.h"
 #include "../RHI_Vertex.h"
 #include "../RHI_CommandList.h"
+#include "../RHI_UploadHeap.h"
+#include "../../Profiling/MemoryTracker.h"
 
 namespace Amethyst
 {
 	void RHI_VertexBuffer::_Destroy()
 	{
+		// Nothing to wait for when there is no buffer yet, which spares every creation a wait on the GPU.
+		if (!m_Buffer)
+		{
+			return;
+		}
+
 		// Wait in case it's still in use by the GPU.
 		m_RHI_Device->Queue_WaitAll();
 
@@ -22,6 +31,7 @@ namespace Amethyst
 
 		// Destroy
 		VulkanUtility::Buffer::DestroyBufferAllocation(m_Buffer);
+		MemoryTracker::Untrack(this);
 	}
 
 	bool RHI_VertexBuffer::_Create(const void* vertices)
@@ -61,18 +71,10 @@ namespace Amethyst
 		{
 			/*
 				The reason we use staging buffers is because while memory with VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT is not mappable/accessible by the CPU on dedicated 
-				graphics cards, it is fast. We want that. We will thus create 1 staging buffer in CPU accessible memory to upload the data from the vertex array to, 
-				and transfer the data to the aforementioned device local memory.
+				graphics cards, it is fast. We want that. We will thus copy the vertex array into the upload heap's CPU accessible memory, 
+				and transfer the data from there to the aforementioned device local memory.
 			*/
 
-			// Create staging/source buffer with VMA and copy the vertices to it.
-			void* stagingBuffer = nullptr;
-			VmaAllocation stagingAllocation = VulkanUtility::Buffer::CreateBufferAllocation(stagingBuffer, m_Size_GPU, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false, vertices);
-			if (!stagingAllocation)
-			{ 
-				return false;
-			}
-
 			// Create destination buffer with VMA.
 			bool writtenFrequently = false;
 			// Note that the data is null here as we are tranferring the data from our staging buffer.
@@ -83,33 +85,21 @@ namespace Amethyst
 				return false;
 			}
 
-			// Copy staging buffer to destination buffer.
+			// Stage the vertices through the upload heap, which copies them right away and records the copy into its open batch.
+			RHI_UploadHeap* uploadHeap = RHI_UploadHeap::Retrieve(m_RHI_Device.get());
+			if (!uploadHeap || !uploadHeap->UploadBuffer(m_Buffer, vertices, m_Size_GPU, m_UploadValue))
 			{
-				// Create command buffer.
-				VkCommandBuffer commandBuffer = VulkanUtility::CommandBufferImmediate::BeginRecording(RHI_Queue_Type::RHI_Queue_Transfer);
-
-				VkBuffer* vulkanBuffer = reinterpret_cast<VkBuffer*>(&m_Buffer);
-				VkBuffer* vulkanStagingBuffer = reinterpret_cast<VkBuffer*>(&stagingBuffer);
-
-				// Copy
-				VkBufferCopy copyRegion = {};
-				copyRegion.size = m_Size_GPU; // The number of bytes to copy. We can also specify offsets.
-				vkCmdCopyBuffer(commandBuffer, *vulkanStagingBuffer, *vulkanBuffer, 1, &copyRegion); //Copies the data between buffer regions.
-
-				// Flush and free command buffer.
-				if (!VulkanUtility::CommandBufferImmediate::EndRecordingAndSubmit(RHI_Queue_Type::RHI_Queue_Transfer))
-				{
-					return false;
-				}
-
-				// Destroy Staging Resources
-				VulkanUtility::Buffer::DestroyBufferAllocation(stagingBuffer);
+				AMETHYST_ERROR("Failed to stage vertices.");
+				return false;
 			}
 
 			m_BufferAllocation = static_cast<void*>(destinationAllocation);
 			m_IsMappable = false; // Updates can only be done through staging as well, not direct mapping as the data is now on the device.
 		}
 
+		// Memory Accounting
+		MemoryTracker::Track(this, MemoryCategory::VertexBuffer);
+
 		// Set debug name.
 		VulkanUtility::Debug::SetVulkanObjectName(static_cast<VkBuffer>(m_Buffer), "Vertex Buffer");
 
@@ -181,4 +171,6 @@ namespace Amethyst
 
 		return true;
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include "../RHI/RHI_ConstantBuffer.h"
+
+namespace Amethyst
+{
+	struct ConstantAllocatorStatistics
+	{
+		uint32_t m_Capacity = 0;	  // Allocations a frame can make before spilling into overflow buffers.
+		uint32_t m_Used = 0;		  // Allocations made so far this frame.
+		uint32_t m_HighWaterMark = 0; // Most allocations made by any of the recent frames.
+		uint32_t m_OverflowCount = 0; // Overflow buffers alive. Non-zero for at most a frame, until the next resize.
+
+		float RetrieveUtilization() const { return m_Capacity != 0 ? static_cast<float>(m_HighWaterMark) / static_cast<float>(m_Capacity) : 0.0f; }
+	};
+
+	/*
+		Linear allocator over a dynamic constant buffer. The buffer holds a region for every frame in flight, and every allocation takes the next slot of
+		the current frame's region and becomes the buffer's dynamic offset. A region is only written again once the frame that used it last has retired.
+
+		Nothing is ever flushed while recording. A frame that outgrows its region carries on in overflow buffers, which are created without waiting on
+		the GPU. At the start of the next frame, the regions are resized to fit the recent high water mark. Resizing waits for the GPU once, at a frame
+		boundary, and a scene that stays the same size never resizes again.
+	*/
+	template<typename T>
+	class ConstantAllocator
+	{
+	public:
+		ConstantAllocator(const std::shared_ptr<RHI_Device>& rhi_Device, const std::string& name, const uint32_t frameCount, const uint32_t capacity)
+		{
+			m_RHI_Device = rhi_Device;
+			m_Name = name;
+			m_FrameCount = Math::Utilities::Clamp<uint32_t>(frameCount, 1, MaxFrameCount);
+			m_HighWaterMarks.fill(0);
+
+			Resize(Math::Utilities::Max(capacity, 1u));
+		}
+
+		// Starts filling frameIndex's region.
+		bool BeginFrame(const uint32_t frameIndex)
+		{
+			m_HighWaterMarks[m_FrameIndex] = m_Used;
+			m_FrameIndex = frameIndex % m_FrameCount;
+			m_Used = 0;
+
+			const uint32_t highWaterMark = *std::max_element(m_HighWaterMarks.begin(), m_HighWaterMarks.begin() + m_FrameCount);
+			if (highWaterMark > m_Capacity)
+			{
+				// A quarter of headroom, so that a scene growing slowly doesn't resize every frame.
+				return Resize(Math::Utilities::NextPowerOfTwo(highWaterMark + highWaterMark / 4));
+			}
+
+			return true;
+		}
+
+		// Copies data into the next slot. The buffer to bind can change when a frame overflows, so it is only valid until the next allocation.
+		bool Allocate(const T& data)
+		{
+			RHI_ConstantBuffer* buffer = m_Buffer.get();
+			uint32_t offsetIndex = m_FrameIndex * m_Capacity + m_Used;
+
+			if (m_Used >= m_Capacity)
+			{
+				const uint32_t overflowIndex = (m_Used - m_Capacity) / m_Capacity;
+				if (overflowIndex >= m_BuffersOverflow.size())
+				{
+					std::shared_ptr<RHI_ConstantBuffer> bufferOverflow = std::make_shared<RHI_ConstantBuffer>(m_RHI_Device, m_Name + " (Overflow)", true);
+					if (!bufferOverflow->Create<T>(m_Capacity))
+					{
+						AMETHYST_ERROR("Failed to allocate an overflow buffer for %s.", m_Name.c_str());
+						return false;
+					}
+
+					m_BuffersOverflow.emplace_back(bufferOverflow);
+				}
+
+				buffer = m_BuffersOverflow[overflowIndex].get();
+				offsetIndex = (m_Used - m_Capacity) % m_Capacity;
+			}
+
+			std::byte* mappedMemory = static_cast<std::byte*>(buffer->Map());
+			if (!mappedMemory)
+			{
+				AMETHYST_ERROR("Failed to map buffer.");
+				return false;
+			}
+
+			const uint64_t size = buffer->RetrieveStride();
+			const uint64_t offset = offsetIndex * size;
+			std::memcpy(mappedMemory + offset, &data, sizeof(T));
+
+			buffer->SetOffsetIndexDynamic(offsetIndex);
+			m_BufferCurrent = buffer;
+			m_Used++;
+
+			return buffer->Unmap(offset, size);
+		}
+
+		// The buffer holding the latest allocation, with its dynamic offset set.
+		RHI_ConstantBuffer* RetrieveBuffer() const { return m_BufferCurrent; }
+		bool IsAllocatedThisFrame() const { return m_Used != 0; }
+
+		ConstantAllocatorStatistics RetrieveStatistics() const
+		{
+			ConstantAllocatorStatistics statistics;
+			statistics.m_Capacity = m_Capacity;
+			statistics.m_Used = m_Used;
+			statistics.m_HighWaterMark = Math::Utilities::Max(m_Used, *std::max_element(m_HighWaterMarks.begin(), m_HighWaterMarks.begin() + m_FrameCount));
+			statistics.m_OverflowCount = static_cast<uint32_t>(m_BuffersOverflow.size());
+
+			return statistics;
+		}
+
+	private:
+		bool Resize(const uint32_t capacity)
+		{
+			// Both the old buffer and the overflow buffers wait for the GPU as they are destroyed.
+			m_BuffersOverflow.clear();
+			m_Buffer = std::make_shared<RHI_ConstantBuffer>(m_RHI_Device, m_Name, true);
+			m_BufferCurrent = m_Buffer.get();
+			m_Capacity = capacity;
+			m_HighWaterMarks.fill(0);
+
+			if (!m_Buffer->Create<T>(m_Capacity * m_FrameCount))
+			{
+				AMETHYST_ERROR("Failed to allocate %s buffer with %d offsets per frame.", m_Name.c_str(), m_Capacity);
+				return false;
+			}
+
+			AMETHYST_INFO("Resized %s buffer to %d offsets per frame. That's %dkb.", m_Name.c_str(), m_Capacity, (m_Capacity * m_FrameCount * m_Buffer->RetrieveStride()) / 1000);
+			return true;
+		}
+
+	private:
+		static constexpr uint32_t MaxFrameCount = 4;
+
+		std::shared_ptr<RHI_ConstantBuffer> m_Buffer;
+		std::vector<std::shared_ptr<RHI_ConstantBuffer>> m_BuffersOverflow;
+		RHI_ConstantBuffer* m_BufferCurrent = nullptr;
+
+		std::string m_Name;
+		uint32_t m_FrameCount = 1;
+		uint32_t m_FrameIndex = 0;
+		uint32_t m_Capacity = 0;
+		uint32_t m_Used = 0;
+		std::array<uint32_t, MaxFrameCount> m_HighWaterMarks;
+
+		//Dependencies
+		std::shared_ptr<RHI_Device> m_RHI_Device;
+	};
+}
\ No newline at end of file
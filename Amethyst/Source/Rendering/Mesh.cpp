@@ -12,11 +12,11 @@ namespace Amethyst
 		m_Indices.shrink_to_fit();
 	}
 
-	uint32_t Mesh::RetrieveMemoryUsage() const
+	uint64_t Mesh::RetrieveMemoryUsage() const
 	{
-		uint32_t size = 0;
-		size += uint32_t(m_Vertices.size() * sizeof(RHI_Vertex_PositionTextureNormalTangent));
-		size += uint32_t(m_Indices.size() * sizeof(uint32_t));
+		uint64_t size = 0;
+		size += uint64_t(m_Vertices.size() * sizeof(RHI_Vertex_PositionTextureNormalTangent));
+		size += uint64_t(m_Indices.size() * sizeof(uint32_t));
 
 		return size;
 	}
@@ -21,7 +21,7 @@ namespace Amethyst
 			std::vector<uint32_t>* indices,
 			std::vector<RHI_Vertex_PositionTextureNormalTangent>* vertices
 		);
-		uint32_t RetrieveMemoryUsage() const;
+		uint64_t RetrieveMemoryUsage() const;
 
 		// Vertices
 		void VertexAdd(const RHI_Vertex_PositionTextureNormalTangent& vertex);
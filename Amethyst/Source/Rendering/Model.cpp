@@ -10,6 +10,8 @@
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_Vertex.h"
+#include "../Profiling/MemoryTracker.h"
+#include "../Threading/Threading.h"
 
 namespace Amethyst
 {
@@ -63,8 +65,23 @@ namespace Amethyst
 		}
 
 		GeometryCreateBuffers();
+
+		// Memory Accounting
+		m_Size_CPU = m_Mesh->RetrieveMemoryUsage();
+		m_Size_GPU = 0;
+		if (m_IndexBuffer)
+		{
+			m_Size_GPU += m_IndexBuffer->RetrieveGPUSize();
+			MemoryTracker::SetOwner(m_IndexBuffer.get(), RetrieveResourceName());
+		}
+		if (m_VertexBuffer)
+		{
+			m_Size_GPU += m_VertexBuffer->RetrieveGPUSize();
+			MemoryTracker::SetOwner(m_VertexBuffer.get(), RetrieveResourceName());
+		}
+
 		m_NormalizedScale = GeometryComputeNormalizedScale();
-		m_AABB = Math::BoundingBox(m_Mesh->VerticesRetrieve().data(), static_cast<uint32_t>(m_Mesh->VerticesRetrieve().size()));
+		m_AABB = GeometryComputeAABB();
 	}
 
 	bool Model::GeometryCreateBuffers()
@@ -108,6 +125,32 @@ namespace Amethyst
 		return success;
 	}
 
+	Math::BoundingBox Model::GeometryComputeAABB() const
+	{
+		const std::vector<RHI_Vertex_PositionTextureNormalTangent>& vertices = m_Mesh->VerticesRetrieve();
+		const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+		// Large meshes are bounded in chunks across the worker threads, and the partial boxes merged after.
+		constexpr uint32_t chunkSize = 65536;
+		const uint32_t chunkCount = (vertexCount + chunkSize - 1) / chunkSize;
+		if (chunkCount <= 1)
+		{
+			return Math::BoundingBox(vertices.data(), vertexCount);
+		}
+
+		std::vector<Math::BoundingBox> chunkBoxes(chunkCount);
+		m_Context->RetrieveSubsystem<Threading>()->AddTaskLoop([&vertices, &chunkBoxes, vertexCount](uint32_t chunkStart, uint32_t chunkEnd)
+		{
+			for (uint32_t chunk = chunkStart; chunk < chunkEnd; chunk++)
+			{
+				const uint32_t vertexStart = chunk * chunkSize;
+				chunkBoxes[chunk] = Math::BoundingBox(vertices.data() + vertexStart, Math::Utilities::Min(chunkSize, vertexCount - vertexStart));
+			}
+		}, chunkCount);
+
+		return Math::BoundingBox::Merge(chunkBoxes.data(), chunkCount);
+	}
+
 	float Model::GeometryComputeNormalizedScale() const ///
 	{
 		// Compute Scale Offset
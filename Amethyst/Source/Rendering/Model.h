@@ -56,6 +56,7 @@ namespace Amethyst
 		// Geometry
 		bool GeometryCreateBuffers();
 		float GeometryComputeNormalizedScale() const;
+		Math::BoundingBox GeometryComputeAABB() const;
 
 	private:
 		std::weak_ptr<Entity> m_RootEntity;
@@ -0,0 +1,270 @@
+#include "Amethyst.h"
+#include "OcclusionCuller.h"
+#include "../Runtime/Math/MathWide.h"
+#include "../Threading/Threading.h"
+#include <algorithm>
+
+namespace Amethyst
+{
+	static constexpr float g_OcclusionDepthMinimum = 1e-4f; // Anything closer (or behind the camera) is treated as crossing the near plane.
+
+	OcclusionCuller::OcclusionCuller(const uint32_t width /*= 256*/, const uint32_t height /*= 128*/)
+	{
+		m_Width = ((Math::Utilities::Max(width, 1u) + TileSize - 1) / TileSize) * TileSize;
+		m_Height = ((Math::Utilities::Max(height, 1u) + TileSize - 1) / TileSize) * TileSize;
+
+		m_Depth.resize(m_Width * m_Height, Math::Utilities::Infinity);
+		m_DepthTiles.resize((m_Width / TileSize) * (m_Height / TileSize), Math::Utilities::Infinity);
+	}
+
+	void OcclusionCuller::Begin(const Math::Matrix& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		m_Triangles.clear();
+
+		std::fill(m_Depth.begin(), m_Depth.end(), Math::Utilities::Infinity);
+		std::fill(m_DepthTiles.begin(), m_DepthTiles.end(), Math::Utilities::Infinity);
+	}
+
+	void OcclusionCuller::AddOccluder(const float* positions, const uint32_t positionStride, const uint32_t* indices, const uint32_t indexCount, const Math::Matrix& transform)
+	{
+		const Math::Matrix worldViewProjection = transform * m_ViewProjection;
+		const float* matrix = &worldViewProjection.m00;
+		const float halfWidth = static_cast<float>(m_Width) * 0.5f;
+		const float halfHeight = static_cast<float>(m_Height) * 0.5f;
+
+		for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+		{
+			float x[3], y[3], w[3];
+			bool isCrossingNearPlane = false;
+
+			for (uint32_t corner = 0; corner < 3; corner++)
+			{
+				const float* position = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + static_cast<size_t>(indices[i + corner]) * positionStride);
+				const float clipX = matrix[0] * position[0] + matrix[1] * position[1] + matrix[2] * position[2] + matrix[3];
+				const float clipY = matrix[4] * position[0] + matrix[5] * position[1] + matrix[6] * position[2] + matrix[7];
+				const float clipW = matrix[12] * position[0] + matrix[13] * position[1] + matrix[14] * position[2] + matrix[15];
+
+				if (clipW < g_OcclusionDepthMinimum)
+				{
+					isCrossingNearPlane = true;
+					break;
+				}
+
+				x[corner] = (clipX / clipW + 1.0f) * halfWidth;
+				y[corner] = (1.0f - clipY / clipW) * halfHeight;
+				w[corner] = clipW;
+			}
+
+			if (isCrossingNearPlane)
+			{
+				continue;
+			}
+
+			const float minimumX = Math::Utilities::Min3(x[0], x[1], x[2]);
+			const float maximumX = Math::Utilities::Max3(x[0], x[1], x[2]);
+			const float minimumY = Math::Utilities::Min3(y[0], y[1], y[2]);
+			const float maximumY = Math::Utilities::Max3(y[0], y[1], y[2]);
+			if (maximumX < 0.0f || maximumY < 0.0f || minimumX >= static_cast<float>(m_Width) || minimumY >= static_cast<float>(m_Height))
+			{
+				continue;
+			}
+
+			// Edges are set up for a positive area. The winding is flipped where needed, since occluders are two-sided.
+			float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+			if (Math::Utilities::Absolute(area) < Math::Utilities::Episilon)
+			{
+				continue;
+			}
+
+			if (area < 0.0f)
+			{
+				std::swap(x[1], x[2]);
+				std::swap(y[1], y[2]);
+			}
+
+			Triangle triangle;
+			for (uint32_t edge = 0; edge < 3; edge++)
+			{
+				const uint32_t start = edge;
+				const uint32_t end = (edge + 1) % 3;
+
+				triangle.m_EdgeA[edge] = y[start] - y[end];
+				triangle.m_EdgeB[edge] = x[end] - x[start];
+				triangle.m_EdgeC[edge] = -(triangle.m_EdgeA[edge] * x[start] + triangle.m_EdgeB[edge] * y[start]);
+			}
+
+			triangle.m_Depth = Math::Utilities::Max3(w[0], w[1], w[2]);
+			triangle.m_MinimumX = static_cast<uint32_t>(Math::Utilities::Max(minimumX, 0.0f));
+			triangle.m_MaximumX = static_cast<uint32_t>(Math::Utilities::Min(maximumX, static_cast<float>(m_Width - 1)));
+			triangle.m_MinimumY = static_cast<uint32_t>(Math::Utilities::Max(minimumY, 0.0f));
+			triangle.m_MaximumY = static_cast<uint32_t>(Math::Utilities::Min(maximumY, static_cast<float>(m_Height - 1)));
+
+			m_Triangles.emplace_back(triangle);
+		}
+	}
+
+	void OcclusionCuller::Rasterize(Threading* threading /*= nullptr*/)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		// Bands of tile rows never share pixels or tiles, so the workers need no synchronization.
+		const uint32_t tileRowCount = m_Height / TileSize;
+		if (threading && !m_Triangles.empty())
+		{
+			threading->AddTaskLoop([this](uint32_t tileRowStart, uint32_t tileRowEnd) { RasterizeTileRows(tileRowStart, tileRowEnd); }, tileRowCount);
+		}
+		else
+		{
+			RasterizeTileRows(0, tileRowCount);
+		}
+	}
+
+	void OcclusionCuller::RasterizeTileRows(const uint32_t tileRowStart, const uint32_t tileRowEnd)
+	{
+		const uint32_t rowStart = tileRowStart * TileSize;
+		const uint32_t rowEnd = tileRowEnd * TileSize;
+
+		const float pixelOffsets[Math::Float8::Width] = { 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f };
+		const Math::Float8 pixelOffset = Math::Float8::Load(pixelOffsets);
+		const Math::Float8 zero = 0.0f;
+
+		for (const Triangle& triangle : m_Triangles)
+		{
+			const uint32_t yStart = Math::Utilities::Max(triangle.m_MinimumY, rowStart);
+			const uint32_t yEnd = Math::Utilities::Min(triangle.m_MaximumY + 1, rowEnd);
+			if (yStart >= yEnd)
+			{
+				continue;
+			}
+
+			// Spans start on a multiple of eight, which the width always is, so a span never runs past the end of its row.
+			const uint32_t xStart = triangle.m_MinimumX & ~(Math::Float8::Width - 1);
+			const uint32_t xEnd = triangle.m_MaximumX + 1;
+
+			const Math::Float8 depth = triangle.m_Depth;
+			const Math::Float8 edgeA0 = triangle.m_EdgeA[0];
+			const Math::Float8 edgeA1 = triangle.m_EdgeA[1];
+			const Math::Float8 edgeA2 = triangle.m_EdgeA[2];
+
+			for (uint32_t y = yStart; y < yEnd; y++)
+			{
+				const float rowCenter = static_cast<float>(y) + 0.5f;
+				const Math::Float8 rowEdge0 = triangle.m_EdgeB[0] * rowCenter + triangle.m_EdgeC[0];
+				const Math::Float8 rowEdge1 = triangle.m_EdgeB[1] * rowCenter + triangle.m_EdgeC[1];
+				const Math::Float8 rowEdge2 = triangle.m_EdgeB[2] * rowCenter + triangle.m_EdgeC[2];
+				float* depthRow = &m_Depth[y * m_Width];
+
+				for (uint32_t x = xStart; x < xEnd; x += Math::Float8::Width)
+				{
+					const Math::Float8 pixelCenter = Math::Float8(static_cast<float>(x)) + pixelOffset;
+					const Math::Float8 isInside = (edgeA0 * pixelCenter + rowEdge0 >= zero) & (edgeA1 * pixelCenter + rowEdge1 >= zero) & (edgeA2 * pixelCenter + rowEdge2 >= zero);
+					if (isInside.MoveMask() == 0)
+					{
+						continue;
+					}
+
+					const Math::Float8 depthCurrent = Math::Float8::Load(depthRow + x);
+					Math::Float8::Select(isInside, Math::Float8::Min(depthCurrent, depth), depthCurrent).Store(depthRow + x);
+				}
+			}
+		}
+
+		// Farthest depth of every tile in the band.
+		const uint32_t tileCountX = m_Width / TileSize;
+		for (uint32_t tileY = tileRowStart; tileY < tileRowEnd; tileY++)
+		{
+			for (uint32_t tileX = 0; tileX < tileCountX; tileX++)
+			{
+				Math::Float8 farthest = 0.0f;
+				for (uint32_t y = tileY * TileSize; y < (tileY + 1) * TileSize; y++)
+				{
+					farthest = Math::Float8::Max(farthest, Math::Float8::Load(&m_Depth[y * m_Width + tileX * TileSize]));
+				}
+
+				float lanes[Math::Float8::Width];
+				farthest.Store(lanes);
+				m_DepthTiles[tileY * tileCountX + tileX] = *std::max_element(lanes, lanes + Math::Float8::Width);
+			}
+		}
+	}
+
+	bool OcclusionCuller::IsVisible(const Math::BoundingBox& box) const
+	{
+		if (!box.IsDefined())
+		{
+			return true;
+		}
+
+		// All eight corners at once.
+		const Math::Vector3& minimum = box.RetrieveMinimum();
+		const Math::Vector3& maximum = box.RetrieveMaximum();
+		const float cornersX[Math::Float8::Width] = { minimum.m_X, maximum.m_X, minimum.m_X, maximum.m_X, minimum.m_X, maximum.m_X, minimum.m_X, maximum.m_X };
+		const float cornersY[Math::Float8::Width] = { minimum.m_Y, minimum.m_Y, maximum.m_Y, maximum.m_Y, minimum.m_Y, minimum.m_Y, maximum.m_Y, maximum.m_Y };
+		const float cornersZ[Math::Float8::Width] = { minimum.m_Z, minimum.m_Z, minimum.m_Z, minimum.m_Z, maximum.m_Z, maximum.m_Z, maximum.m_Z, maximum.m_Z };
+		const Math::Vector3x8 corners = Math::Vector3x8(Math::Float8::Load(cornersX), Math::Float8::Load(cornersY), Math::Float8::Load(cornersZ));
+
+		const float* matrix = &m_ViewProjection.m00;
+		const Math::Float8 clipX = Math::Float8(matrix[0]) * corners.m_X + Math::Float8(matrix[1]) * corners.m_Y + Math::Float8(matrix[2]) * corners.m_Z + Math::Float8(matrix[3]);
+		const Math::Float8 clipY = Math::Float8(matrix[4]) * corners.m_X + Math::Float8(matrix[5]) * corners.m_Y + Math::Float8(matrix[6]) * corners.m_Z + Math::Float8(matrix[7]);
+		const Math::Float8 clipW = Math::Float8(matrix[12]) * corners.m_X + Math::Float8(matrix[13]) * corners.m_Y + Math::Float8(matrix[14]) * corners.m_Z + Math::Float8(matrix[15]);
+
+		// Boxes reaching behind the camera can't be bounded on screen.
+		if ((clipW < Math::Float8(g_OcclusionDepthMinimum)).MoveMask() != 0)
+		{
+			return true;
+		}
+
+		const Math::Float8 one = 1.0f;
+		float screenX[Math::Float8::Width], screenY[Math::Float8::Width], depths[Math::Float8::Width];
+		((clipX / clipW + one) * Math::Float8(static_cast<float>(m_Width) * 0.5f)).Store(screenX);
+		((one - clipY / clipW) * Math::Float8(static_cast<float>(m_Height) * 0.5f)).Store(screenY);
+		clipW.Store(depths);
+
+		const float minimumX = *std::min_element(screenX, screenX + Math::Float8::Width);
+		const float maximumX = *std::max_element(screenX, screenX + Math::Float8::Width);
+		const float minimumY = *std::min_element(screenY, screenY + Math::Float8::Width);
+		const float maximumY = *std::max_element(screenY, screenY + Math::Float8::Width);
+		const float depthNearest = *std::min_element(depths, depths + Math::Float8::Width);
+
+		// Off screen is for frustum culling to decide.
+		if (maximumX < 0.0f || maximumY < 0.0f || minimumX >= static_cast<float>(m_Width) || minimumY >= static_cast<float>(m_Height))
+		{
+			return true;
+		}
+
+		const uint32_t pixelMinimumX = static_cast<uint32_t>(Math::Utilities::Max(minimumX, 0.0f));
+		const uint32_t pixelMaximumX = static_cast<uint32_t>(Math::Utilities::Min(maximumX, static_cast<float>(m_Width - 1)));
+		const uint32_t pixelMinimumY = static_cast<uint32_t>(Math::Utilities::Max(minimumY, 0.0f));
+		const uint32_t pixelMaximumY = static_cast<uint32_t>(Math::Utilities::Min(maximumY, static_cast<float>(m_Height - 1)));
+
+		const uint32_t tileCountX = m_Width / TileSize;
+		for (uint32_t tileY = pixelMinimumY / TileSize; tileY <= pixelMaximumY / TileSize; tileY++)
+		{
+			for (uint32_t tileX = pixelMinimumX / TileSize; tileX <= pixelMaximumX / TileSize; tileX++)
+			{
+				// Everything in the tile is in front of the box.
+				if (m_DepthTiles[tileY * tileCountX + tileX] < depthNearest)
+				{
+					continue;
+				}
+
+				// Part of the tile is farther away or empty, so look at the pixels the box covers.
+				const uint32_t yEnd = Math::Utilities::Min(pixelMaximumY, tileY * TileSize + TileSize - 1);
+				const uint32_t xEnd = Math::Utilities::Min(pixelMaximumX, tileX * TileSize + TileSize - 1);
+				for (uint32_t y = Math::Utilities::Max(pixelMinimumY, tileY * TileSize); y <= yEnd; y++)
+				{
+					for (uint32_t x = Math::Utilities::Max(pixelMinimumX, tileX * TileSize); x <= xEnd; x++)
+					{
+						if (m_Depth[y * m_Width + x] >= depthNearest)
+						{
+							return true;
+						}
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+}
\ No newline at end of file
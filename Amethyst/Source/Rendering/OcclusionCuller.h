@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include "../Runtime/Math/Matrix.h"
+#include "../Runtime/Math/BoundingBox.h"
+
+namespace Amethyst
+{
+	class Threading;
+
+	/*
+		Software occlusion culling. Designated occluders are rasterized on the CPU into a small depth buffer, and bounding boxes are then tested against it
+		before anything is submitted to the GPU.
+
+		Depth is view distance (clip space w), so the buffer works the same with or without reversed Z. Each occluder triangle is written at its farthest
+		vertex's depth and boxes are tested at their nearest corner, which keeps every answer conservative: a box is only reported hidden when it is
+		entirely behind occluders. Triangles crossing the near plane are skipped (they'd only ever hide less). An orthographic camera has a constant w,
+		so nothing is culled by it.
+
+		Rows are rasterized eight pixels at a time with the wide float type, in bands of tile rows spread across the workers. Every 8 x 8 tile keeps its
+		farthest depth, so most boxes are decided from the tiles without touching the pixels.
+	*/
+	class OcclusionCuller
+	{
+	public:
+		OcclusionCuller(const uint32_t width = 256, const uint32_t height = 128); // Rounded up to whole tiles.
+		~OcclusionCuller() = default;
+
+		// Clears everything for a new view. viewProjection takes world space to clip space.
+		void Begin(const Math::Matrix& viewProjection);
+
+		// Queues an occluder. Positions are positionStride bytes apart (vertex structures can be passed as they are) and indices refer to them.
+		void AddOccluder(const float* positions, const uint32_t positionStride, const uint32_t* indices, const uint32_t indexCount, const Math::Matrix& transform);
+
+		// Rasterizes every queued occluder and builds the tiles. Boxes can be tested from any thread afterwards.
+		void Rasterize(Threading* threading = nullptr);
+
+		bool IsVisible(const Math::BoundingBox& box) const;
+
+		uint32_t RetrieveWidth() const { return m_Width; }
+		uint32_t RetrieveHeight() const { return m_Height; }
+		uint32_t RetrieveTriangleCount() const { return static_cast<uint32_t>(m_Triangles.size()); }
+		const std::vector<float>& RetrieveDepth() const { return m_Depth; } // Row by row, infinity where nothing was drawn.
+
+	public:
+		static constexpr uint32_t TileSize = 8;
+
+	private:
+		// Screen space, with edge functions A * x + B * y + C that are non-negative inside.
+		struct Triangle
+		{
+			float m_EdgeA[3];
+			float m_EdgeB[3];
+			float m_EdgeC[3];
+			float m_Depth;
+			uint32_t m_MinimumX;
+			uint32_t m_MaximumX;
+			uint32_t m_MinimumY;
+			uint32_t m_MaximumY;
+		};
+
+		void RasterizeTileRows(const uint32_t tileRowStart, const uint32_t tileRowEnd);
+
+	private:
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		Math::Matrix m_ViewProjection = Math::Matrix::Identity;
+
+		std::vector<Triangle> m_Triangles;
+		std::vector<float> m_Depth;
+		std::vector<float> m_DepthTiles; // Farthest depth of every tile.
+	};
+}
\ No newline at end of file
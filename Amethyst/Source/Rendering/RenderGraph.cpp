@@ -0,0 +1,420 @@
+#include "Amethyst.h"
+#include "RenderGraph.h"
+#include "../RHI/RHI_Device.h"
+#include "../RHI/RHI_Texture2D.h"
+#include "../RHI/RHI_AliasedMemory.h"
+#include "../Utilities/Hash.h"
+#include <algorithm>
+
+namespace Amethyst
+{
+	RenderGraph::~RenderGraph()
+	{
+		Release();
+	}
+
+	void RenderGraph::Reset()
+	{
+		m_Passes.clear();
+		m_Resources.clear();
+		m_Aliases.clear();
+		m_Statistics = RenderGraph_Statistics();
+		m_IsCompiled = false;
+	}
+
+	RenderGraph_ResourceHandle RenderGraph::CreateTexture(const RenderGraph_TextureDescription& description)
+	{
+		Resource& resource = m_Resources.emplace_back();
+		resource.m_Description = description;
+
+		return static_cast<RenderGraph_ResourceHandle>(m_Resources.size() - 1);
+	}
+
+	RenderGraph_ResourceHandle RenderGraph::ImportTexture(RHI_Texture* texture)
+	{
+		AMETHYST_ASSERT(texture != nullptr);
+
+		Resource& resource = m_Resources.emplace_back();
+		resource.m_ImportedTexture = texture;
+		resource.m_Description.m_Width = texture->RetrieveWidth();
+		resource.m_Description.m_Height = texture->RetrieveHeight();
+		resource.m_Description.m_Format = texture->RetrieveFormat();
+		resource.m_Description.m_ArraySize = texture->RetrieveArraySize();
+		resource.m_Description.m_Flags = texture->RetrieveFlags();
+		resource.m_Description.m_Name = texture->RetrieveObjectName();
+
+		return static_cast<RenderGraph_ResourceHandle>(m_Resources.size() - 1);
+	}
+
+	void RenderGraph::MarkOutput(const RenderGraph_ResourceHandle resource)
+	{
+		AMETHYST_ASSERT(resource < m_Resources.size());
+		m_Resources[resource].m_IsOutput = true;
+	}
+
+	RenderGraph_Pass& RenderGraph::AddPass(const char* name)
+	{
+		return m_Passes.emplace_back(name);
+	}
+
+	bool RenderGraph::Compile()
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		m_IsCompiled = false;
+		m_Aliases.clear();
+		m_Statistics = RenderGraph_Statistics();
+		m_Statistics.m_PassCount = static_cast<uint32_t>(m_Passes.size());
+
+		const uint32_t passCount = static_cast<uint32_t>(m_Passes.size());
+		const uint32_t resourceCount = static_cast<uint32_t>(m_Resources.size());
+
+		// Validate Accesses
+		for (const RenderGraph_Pass& pass : m_Passes)
+		{
+			for (const bool isRead : { true, false })
+			{
+				for (const RenderGraph_Pass::Access& access : isRead ? pass.m_Reads : pass.m_Writes)
+				{
+					if (access.m_Resource >= resourceCount)
+					{
+						AMETHYST_ERROR("Pass \"%s\" accesses a resource which doesn't exist.", pass.m_Name);
+						return false;
+					}
+				}
+			}
+		}
+
+		// Culling - Walk back from the last pass. A pass is needed if something after it reads what it writes, and reads of its own make their writers needed in turn.
+		m_ResourcesNeeded.assign(resourceCount, false);
+		for (uint32_t passIndex = passCount; passIndex-- > 0;)
+		{
+			RenderGraph_Pass& pass = m_Passes[passIndex];
+
+			bool isNeeded = pass.m_HasSideEffects;
+			for (const RenderGraph_Pass::Access& write : pass.m_Writes)
+			{
+				const Resource& resource = m_Resources[write.m_Resource];
+				isNeeded |= !IsTransient(resource) || resource.m_IsOutput || m_ResourcesNeeded[write.m_Resource];
+			}
+
+			pass.m_IsCulled = !isNeeded;
+			if (pass.m_IsCulled)
+			{
+				m_Statistics.m_CulledPassCount++;
+				continue;
+			}
+
+			// Whatever was written before this pass is overwritten, unless this pass reads it too.
+			for (const RenderGraph_Pass::Access& write : pass.m_Writes)
+			{
+				m_ResourcesNeeded[write.m_Resource] = false;
+			}
+
+			for (const RenderGraph_Pass::Access& read : pass.m_Reads)
+			{
+				m_ResourcesNeeded[read.m_Resource] = true;
+			}
+		}
+
+		// Lifetimes - The first and last pass each resource is used by. Outputs are read after the graph, so they live until the end.
+		for (Resource& resource : m_Resources)
+		{
+			resource.m_FirstPass = g_RenderGraph_InvalidHandle;
+			resource.m_LastPass = 0;
+			resource.m_AliasIndex = g_RenderGraph_InvalidHandle;
+			resource.m_Size = static_cast<uint64_t>(resource.m_Description.m_Width) * resource.m_Description.m_Height * resource.m_Description.m_ArraySize * RHI_Format_ToBytesPerPixel(resource.m_Description.m_Format);
+		}
+
+		for (uint32_t passIndex = 0; passIndex < passCount; passIndex++)
+		{
+			const RenderGraph_Pass& pass = m_Passes[passIndex];
+			if (pass.m_IsCulled)
+			{
+				continue;
+			}
+
+			for (const bool isRead : { true, false })
+			{
+				for (const RenderGraph_Pass::Access& access : isRead ? pass.m_Reads : pass.m_Writes)
+				{
+					Resource& resource = m_Resources[access.m_Resource];
+					resource.m_FirstPass = (std::min)(resource.m_FirstPass, passIndex);
+					resource.m_LastPass = (std::max)(resource.m_LastPass, passIndex);
+				}
+			}
+		}
+
+		// Aliasing - Largest first, each transient texture goes into the first block of its kind whose textures are all done before it starts or start after it is done.
+		std::vector<RenderGraph_ResourceHandle> transientResources;
+		for (RenderGraph_ResourceHandle handle = 0; handle < resourceCount; handle++)
+		{
+			Resource& resource = m_Resources[handle];
+			if (!IsTransient(resource) || resource.m_FirstPass == g_RenderGraph_InvalidHandle)
+			{
+				continue;
+			}
+
+			if (resource.m_IsOutput)
+			{
+				resource.m_LastPass = passCount;
+			}
+
+			transientResources.push_back(handle);
+			m_Statistics.m_TransientTextureCount++;
+			m_Statistics.m_TransientBytes += resource.m_Size;
+		}
+
+		std::stable_sort(transientResources.begin(), transientResources.end(), [this](const RenderGraph_ResourceHandle a, const RenderGraph_ResourceHandle b)
+		{
+			return m_Resources[a].m_Size > m_Resources[b].m_Size;
+		});
+
+		for (const RenderGraph_ResourceHandle handle : transientResources)
+		{
+			Resource& resource = m_Resources[handle];
+			const bool isDepthStencil = resource.m_Description.m_Format == RHI_Format_D32_Float || resource.m_Description.m_Format == RHI_Format_D32_Float_S8X24_Uint;
+
+			for (uint32_t aliasIndex = 0; aliasIndex < m_Aliases.size() && resource.m_AliasIndex == g_RenderGraph_InvalidHandle; aliasIndex++)
+			{
+				const Alias& alias = m_Aliases[aliasIndex];
+				if (alias.m_IsDepthStencil != isDepthStencil)
+				{
+					continue;
+				}
+
+				const bool overlaps = std::any_of(alias.m_Resources.begin(), alias.m_Resources.end(), [this, &resource](const RenderGraph_ResourceHandle other)
+				{
+					return m_Resources[other].m_FirstPass <= resource.m_LastPass && resource.m_FirstPass <= m_Resources[other].m_LastPass;
+				});
+
+				if (!overlaps)
+				{
+					resource.m_AliasIndex = aliasIndex;
+				}
+			}
+
+			if (resource.m_AliasIndex == g_RenderGraph_InvalidHandle)
+			{
+				resource.m_AliasIndex = static_cast<uint32_t>(m_Aliases.size());
+				m_Aliases.emplace_back().m_IsDepthStencil = isDepthStencil;
+			}
+
+			Alias& alias = m_Aliases[resource.m_AliasIndex];
+			alias.m_Resources.push_back(handle);
+			alias.m_Size = (std::max)(alias.m_Size, resource.m_Size);
+		}
+
+		m_Statistics.m_AliasedMemoryCount = static_cast<uint32_t>(m_Aliases.size());
+		for (const Alias& alias : m_Aliases)
+		{
+			m_Statistics.m_AliasedBytes += alias.m_Size;
+		}
+
+		// Transitions - Imported textures are always handed over, as only they know their layout when the graph executes. Transient ones are tracked here.
+		m_ResourceLayouts.assign(resourceCount, RHI_Image_Layout::Undefined);
+		for (uint32_t passIndex = 0; passIndex < passCount; passIndex++)
+		{
+			RenderGraph_Pass& pass = m_Passes[passIndex];
+			pass.m_Transitions.clear();
+
+			if (pass.m_IsCulled)
+			{
+				continue;
+			}
+
+			for (const bool isRead : { true, false })
+			{
+				for (const RenderGraph_Pass::Access& access : isRead ? pass.m_Reads : pass.m_Writes)
+				{
+					const Resource& resource = m_Resources[access.m_Resource];
+
+					// A pass can read and write the same texture, but only in a single layout.
+					auto transition = std::find_if(pass.m_Transitions.begin(), pass.m_Transitions.end(), [&access](const RenderGraph_Transition& transition) { return transition.m_Resource == access.m_Resource; });
+					if (transition != pass.m_Transitions.end())
+					{
+						if (transition->m_Layout != access.m_Layout)
+						{
+							AMETHYST_ERROR("Pass \"%s\" uses \"%s\" in two different layouts.", pass.m_Name, resource.m_Description.m_Name.c_str());
+							return false;
+						}
+
+						continue;
+					}
+
+					const bool isFirstUse = IsTransient(resource) && resource.m_FirstPass == passIndex;
+					if (IsTransient(resource) && !isFirstUse && m_ResourceLayouts[access.m_Resource] == access.m_Layout)
+					{
+						continue;
+					}
+
+					if (isFirstUse && isRead)
+					{
+						AMETHYST_WARNING("Pass \"%s\" reads \"%s\" before anything has written to it.", pass.m_Name, resource.m_Description.m_Name.c_str());
+					}
+
+					pass.m_Transitions.push_back({ access.m_Resource, access.m_Layout, isFirstUse });
+					m_ResourceLayouts[access.m_Resource] = access.m_Layout;
+				}
+			}
+
+			m_Statistics.m_BarrierCount += static_cast<uint32_t>(pass.m_Transitions.size());
+			m_Statistics.m_BarrierBatchCount += pass.m_Transitions.empty() ? 0 : 1;
+		}
+
+		m_IsCompiled = true;
+		return true;
+	}
+
+	uint32_t RenderGraph::ComputeLayoutHash() const
+	{
+		uint32_t hash = 0;
+
+		for (RenderGraph_ResourceHandle handle = 0; handle < m_Resources.size(); handle++)
+		{
+			const Resource& resource = m_Resources[handle];
+			if (resource.m_AliasIndex == g_RenderGraph_InvalidHandle)
+			{
+				continue;
+			}
+
+			Utility::HashCombine(hash, handle);
+			Utility::HashCombine(hash, resource.m_AliasIndex);
+			Utility::HashCombine(hash, resource.m_Description.m_Width);
+			Utility::HashCombine(hash, resource.m_Description.m_Height);
+			Utility::HashCombine(hash, static_cast<uint32_t>(resource.m_Description.m_Format));
+			Utility::HashCombine(hash, resource.m_Description.m_ArraySize);
+			Utility::HashCombine(hash, resource.m_Description.m_Flags);
+		}
+
+		return hash;
+	}
+
+	void RenderGraph::Release()
+	{
+		// Textures have to go before the memory they are placed in.
+		m_Textures.clear();
+		m_AliasedMemory.clear();
+		m_IsRealized = false;
+	}
+
+	bool RenderGraph::Realize(Context* context, const std::shared_ptr<RHI_Device>& rhi_Device)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		if (!m_IsCompiled)
+		{
+			AMETHYST_ERROR("The graph has to be compiled first.");
+			return false;
+		}
+
+		// Textures and memory only need to be created again when what Compile decided has changed.
+		const uint32_t layoutHash = ComputeLayoutHash();
+		if (!m_IsRealized || m_RealizedHash != layoutHash || m_RHI_Device != rhi_Device)
+		{
+			// Wait in case any of them is still in use by the GPU.
+			if (m_RHI_Device)
+			{
+				m_RHI_Device->Queue_WaitAll();
+			}
+
+			Release();
+			m_RHI_Device = rhi_Device;
+			m_Textures.resize(m_Resources.size());
+
+			std::vector<RHI_Texture*> textures;
+			for (uint32_t aliasIndex = 0; aliasIndex < m_Aliases.size(); aliasIndex++)
+			{
+				textures.clear();
+
+				for (const RenderGraph_ResourceHandle handle : m_Aliases[aliasIndex].m_Resources)
+				{
+					const RenderGraph_TextureDescription& description = m_Resources[handle].m_Description;
+					m_Textures[handle] = std::make_shared<RHI_Texture2D>(context, description.m_Width, description.m_Height, description.m_Format, description.m_ArraySize, static_cast<uint16_t>(description.m_Flags | RHI_Texture_Aliased), description.m_Name);
+					textures.push_back(m_Textures[handle].get());
+				}
+
+				const std::string name = "RenderGraph_Alias_" + std::to_string(aliasIndex);
+				std::shared_ptr<RHI_AliasedMemory> aliasedMemory = std::make_shared<RHI_AliasedMemory>(m_RHI_Device.get(), textures, name.c_str());
+				if (!aliasedMemory->IsInitialized())
+				{
+					AMETHYST_ERROR("Failed to allocate \"%s\".", name.c_str());
+					Release();
+					return false;
+				}
+
+				m_AliasedMemory.push_back(aliasedMemory);
+			}
+
+			m_RealizedHash = layoutHash;
+			m_IsRealized = true;
+		}
+
+		// Barriers - Rebuilt every time, as imported textures can change from one build to the next.
+		for (RenderGraph_Pass& pass : m_Passes)
+		{
+			pass.m_Barriers.clear();
+
+			for (const RenderGraph_Transition& transition : pass.m_Transitions)
+			{
+				pass.m_Barriers.push_back({ RetrieveTexture(transition.m_Resource), transition.m_Layout, transition.m_DiscardContents });
+			}
+		}
+
+		return true;
+	}
+
+	void RenderGraph::Execute(RHI_CommandList* commandList)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		// Nothing to run if the last build failed.
+		if (!m_IsCompiled || !m_IsRealized)
+		{
+			return;
+		}
+
+		for (RenderGraph_Pass& pass : m_Passes)
+		{
+			if (pass.m_IsCulled)
+			{
+				continue;
+			}
+
+			if (!pass.m_Barriers.empty())
+			{
+				commandList->InsertBarriers(pass.m_Barriers);
+			}
+
+			if (pass.m_Execute)
+			{
+				pass.m_Execute(commandList);
+			}
+		}
+	}
+
+	RHI_Texture* RenderGraph::RetrieveTexture(const RenderGraph_ResourceHandle resource) const
+	{
+		if (resource >= m_Resources.size())
+		{
+			return nullptr;
+		}
+
+		if (RHI_Texture* texture = m_Resources[resource].m_ImportedTexture)
+		{
+			return texture;
+		}
+
+		return resource < m_Textures.size() ? m_Textures[resource].get() : nullptr;
+	}
+
+	std::shared_ptr<RHI_Texture> RenderGraph::RetrieveTransientTexture(const RenderGraph_ResourceHandle resource) const
+	{
+		return resource < m_Textures.size() ? m_Textures[resource] : nullptr;
+	}
+
+	uint32_t RenderGraph::RetrieveAliasIndex(const RenderGraph_ResourceHandle resource) const
+	{
+		return resource < m_Resources.size() ? m_Resources[resource].m_AliasIndex : g_RenderGraph_InvalidHandle;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include "../RHI/RHI_Utilities.h"
+#include "../RHI/RHI_CommandList.h"
+
+namespace Amethyst
+{
+	class Context;
+
+	using RenderGraph_ResourceHandle = uint32_t;
+	static const RenderGraph_ResourceHandle g_RenderGraph_InvalidHandle = (std::numeric_limits<uint32_t>::max)();
+
+	struct RenderGraph_TextureDescription
+	{
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		RHI_Format m_Format = RHI_Format::RHI_Format_Undefined;
+		uint32_t m_ArraySize = 1;
+		uint16_t m_Flags = 0;
+		std::string m_Name;
+	};
+
+	struct RenderGraph_Statistics
+	{
+		uint32_t m_PassCount = 0;
+		uint32_t m_CulledPassCount = 0;
+		uint32_t m_TransientTextureCount = 0;  // Ones used by a pass which wasn't culled.
+		uint32_t m_AliasedMemoryCount = 0;	   // Blocks the transient textures were packed into.
+		uint32_t m_BarrierCount = 0;
+		uint32_t m_BarrierBatchCount = 0;
+		uint64_t m_TransientBytes = 0;		   // What the transient textures would take on their own.
+		uint64_t m_AliasedBytes = 0;		   // What they take once aliased.
+	};
+
+	// A layout transition as decided by Compile. Turned into an RHI_ImageBarrier once the textures exist.
+	struct RenderGraph_Transition
+	{
+		RenderGraph_ResourceHandle m_Resource = g_RenderGraph_InvalidHandle;
+		RHI_Image_Layout m_Layout = RHI_Image_Layout::Undefined;
+		bool m_DiscardContents = false;
+	};
+
+	class RenderGraph_Pass
+	{
+	public:
+		RenderGraph_Pass(const char* name) : m_Name(name) { }
+
+		// Accesses - A write which keeps what is already there (no clear) has to Read the resource as well, so that whatever wrote it before is kept.
+		void Read(const RenderGraph_ResourceHandle resource, const RHI_Image_Layout layout = RHI_Image_Layout::Shader_Read_Only_Optimal) { m_Reads.push_back({ resource, layout }); }
+		void Write(const RenderGraph_ResourceHandle resource, const RHI_Image_Layout layout = RHI_Image_Layout::Color_Attachment_Optimal) { m_Writes.push_back({ resource, layout }); }
+
+		// Passes with side effects (buffer updates, readbacks) are kept even when nothing reads what they write.
+		void SetSideEffects() { m_HasSideEffects = true; }
+		void SetExecute(const std::function<void(RHI_CommandList*)>& execute) { m_Execute = execute; }
+
+		const char* RetrieveName() const { return m_Name; }
+		bool IsCulled() const { return m_IsCulled; }
+		const std::vector<RenderGraph_Transition>& RetrieveTransitions() const { return m_Transitions; }
+
+	private:
+		friend class RenderGraph;
+
+		struct Access
+		{
+			RenderGraph_ResourceHandle m_Resource = g_RenderGraph_InvalidHandle;
+			RHI_Image_Layout m_Layout = RHI_Image_Layout::Undefined;
+		};
+
+		const char* m_Name = nullptr;
+		std::vector<Access> m_Reads;
+		std::vector<Access> m_Writes;
+		bool m_HasSideEffects = false;
+		std::function<void(RHI_CommandList*)> m_Execute;
+
+		// Compiled
+		bool m_IsCulled = false;
+		std::vector<RenderGraph_Transition> m_Transitions;
+		std::vector<RHI_ImageBarrier> m_Barriers;
+	};
+
+	/*
+		Passes declare the textures they read and write, in the order they execute. Compiling the graph then:
+
+		- Culls every pass whose writes are never read, unless it has side effects or writes an imported or output texture.
+		- Works out the span of passes each transient texture lives for, and packs transient textures whose spans don't overlap into the same block of memory
+		  (largest first, into the first block with room in time). Color and depth-stencil textures are never packed together, as drivers may want them in
+		  different kinds of memory.
+		- Decides the layout transitions ahead of each pass. They are recorded as a single barrier per pass, and a texture's first use within the frame
+		  discards its contents, as another texture may have been using the memory in the meantime.
+
+		Compile only looks at descriptions and needs no device, so a graph can be built and inspected without one. Realize then creates the textures and
+		their memory, which is kept for as long as later compiles come to the same result.
+	*/
+	class RenderGraph
+	{
+	public:
+		RenderGraph() = default;
+		~RenderGraph();
+
+		// Building - Reset drops the passes and resources, but keeps any realized textures around for the next Realize to reuse.
+		void Reset();
+		RenderGraph_ResourceHandle CreateTexture(const RenderGraph_TextureDescription& description);
+		RenderGraph_ResourceHandle ImportTexture(RHI_Texture* texture);
+		void MarkOutput(const RenderGraph_ResourceHandle resource); // Read once the graph has executed, so it lives until the end of the frame.
+		RenderGraph_Pass& AddPass(const char* name);
+
+		bool Compile();
+		bool Realize(Context* context, const std::shared_ptr<RHI_Device>& rhi_Device);
+		void Execute(RHI_CommandList* commandList);
+
+		// Queries
+		RHI_Texture* RetrieveTexture(const RenderGraph_ResourceHandle resource) const;
+		std::shared_ptr<RHI_Texture> RetrieveTransientTexture(const RenderGraph_ResourceHandle resource) const;
+		uint32_t RetrieveAliasIndex(const RenderGraph_ResourceHandle resource) const; // The block a transient texture was packed into.
+		const std::deque<RenderGraph_Pass>& RetrievePasses() const { return m_Passes; }
+		const RenderGraph_Statistics& RetrieveStatistics() const { return m_Statistics; }
+
+	private:
+		struct Resource
+		{
+			RenderGraph_TextureDescription m_Description;
+			RHI_Texture* m_ImportedTexture = nullptr;
+			bool m_IsOutput = false;
+
+			// Compiled
+			uint32_t m_FirstPass = g_RenderGraph_InvalidHandle;
+			uint32_t m_LastPass = 0;
+			uint32_t m_AliasIndex = g_RenderGraph_InvalidHandle;
+			uint64_t m_Size = 0;
+		};
+
+		struct Alias
+		{
+			std::vector<RenderGraph_ResourceHandle> m_Resources;
+			uint64_t m_Size = 0;
+			bool m_IsDepthStencil = false;
+		};
+
+		bool IsTransient(const Resource& resource) const { return resource.m_ImportedTexture == nullptr; }
+		uint32_t ComputeLayoutHash() const;
+		void Release();
+
+		std::deque<RenderGraph_Pass> m_Passes; // Passes stay where they are as more are added.
+		std::vector<Resource> m_Resources;
+		std::vector<Alias> m_Aliases;
+		std::vector<bool> m_ResourcesNeeded;
+		std::vector<RHI_Image_Layout> m_ResourceLayouts;
+		RenderGraph_Statistics m_Statistics;
+		bool m_IsCompiled = false;
+
+		// Realized - Textures are indexed by resource handle, and only exist for transient resources which weren't culled.
+		std::vector<std::shared_ptr<RHI_Texture>> m_Textures;
+		std::vector<std::shared_ptr<RHI_AliasedMemory>> m_AliasedMemory;
+		std::shared_ptr<RHI_Device> m_RHI_Device;
+		uint32_t m_RealizedHash = 0;
+		bool m_IsRealized = false;
+	};
+}
\ No newline at end of file
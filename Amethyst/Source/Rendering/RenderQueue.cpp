@@ -0,0 +1,164 @@
+#include "Amethyst.h"
+#include "RenderQueue.h"
+#include "../Threading/Threading.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Amethyst
+{
+	// 11 bit digits cover the 24 bit depth and a small material range in three passes, where bytes would take five.
+	static constexpr uint32_t g_RadixBits = 11;
+	static constexpr uint32_t g_RadixSize = 1 << g_RadixBits;
+	static constexpr uint32_t g_RadixDigitCount = (64 + g_RadixBits - 1) / g_RadixBits;
+	static constexpr uint32_t g_RadixChunkSizeMinimum = 16384; // Smaller chunks cost more to dispatch than they take to sort.
+
+	uint64_t RenderQueue::ComputeSortKey(const Renderer_ObjectType pass, const uint32_t pipelineHash, const uint32_t materialID, const float distanceSquared)
+	{
+		// Non-negative floats compare like their bit patterns, and the sign bit is always clear, so the top 24 of the remaining 31 bits are kept. NaN sorts as zero.
+		const float distance = distanceSquared > 0.0f ? distanceSquared : 0.0f;
+		uint32_t distanceBits;
+		std::memcpy(&distanceBits, &distance, sizeof(distanceBits));
+
+		const uint64_t passField = static_cast<uint64_t>(pass) & ((1ull << PassBits) - 1);
+		const uint64_t pipelineField = static_cast<uint64_t>(pipelineHash) & ((1ull << PipelineBits) - 1);
+		const uint64_t materialField = static_cast<uint64_t>(materialID) & ((1ull << MaterialBits) - 1);
+		uint64_t depthField = static_cast<uint64_t>(distanceBits >> (31 - DepthBits));
+
+		if (pass == Renderer_ObjectType::Renderer_Object_Transparent)
+		{
+			// Farthest first.
+			depthField = ((1ull << DepthBits) - 1) - depthField;
+			return (passField << 60) | (depthField << 36) | (pipelineField << 20) | materialField;
+		}
+
+		return (passField << 60) | (pipelineField << 44) | (materialField << 24) | depthField;
+	}
+
+	void RenderQueue::Sort(Threading* threading /*= nullptr*/)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		const uint32_t itemCount = static_cast<uint32_t>(m_Items.size());
+		if (itemCount <= 1)
+		{
+			return;
+		}
+
+		// A digit that is the same in every key would leave the order untouched, so its pass is skipped. Bits that differ anywhere show up in (AND ^ OR).
+		uint64_t keysAnd = ~0ull;
+		uint64_t keysOr = 0;
+		for (const RenderItem& item : m_Items)
+		{
+			keysAnd &= item.m_SortKey;
+			keysOr |= item.m_SortKey;
+		}
+
+		const uint64_t keysVarying = keysAnd ^ keysOr;
+		if (keysVarying == 0)
+		{
+			return;
+		}
+
+		// Each chunk is histogrammed and scattered by one thread. Offsets are laid out digit by digit across the chunks in order, so the sort stays stable.
+		uint32_t chunkCount = 1;
+		if (threading)
+		{
+			chunkCount = Math::Utilities::Clamp<uint32_t>(itemCount / g_RadixChunkSizeMinimum, 1, threading->RetrieveThreadCount() + 1); // Plus one for the current thread.
+		}
+
+		m_ItemsScratch.resize(itemCount);
+		m_ChunkOffsets.resize(chunkCount * g_RadixSize);
+
+		RenderItem* source = m_Items.data();
+		RenderItem* destination = m_ItemsScratch.data();
+
+		for (uint32_t digit = 0; digit < g_RadixDigitCount; digit++)
+		{
+			const uint32_t shift = digit * g_RadixBits;
+			if (((keysVarying >> shift) & (g_RadixSize - 1)) == 0)
+			{
+				continue;
+			}
+
+			const auto Histogram = [this, source, shift, itemCount, chunkCount](uint32_t chunkStart, uint32_t chunkEnd)
+			{
+				for (uint32_t chunk = chunkStart; chunk < chunkEnd; chunk++)
+				{
+					uint32_t* offsets = &m_ChunkOffsets[chunk * g_RadixSize];
+					std::memset(offsets, 0, g_RadixSize * sizeof(uint32_t));
+
+					const uint32_t itemEnd = static_cast<uint32_t>(static_cast<uint64_t>(itemCount) * (chunk + 1) / chunkCount);
+					for (uint32_t i = static_cast<uint32_t>(static_cast<uint64_t>(itemCount) * chunk / chunkCount); i < itemEnd; i++)
+					{
+						offsets[(source[i].m_SortKey >> shift) & (g_RadixSize - 1)]++;
+					}
+				}
+			};
+
+			const auto Scatter = [this, source, destination, shift, itemCount, chunkCount](uint32_t chunkStart, uint32_t chunkEnd)
+			{
+				for (uint32_t chunk = chunkStart; chunk < chunkEnd; chunk++)
+				{
+					uint32_t* offsets = &m_ChunkOffsets[chunk * g_RadixSize];
+
+					const uint32_t itemEnd = static_cast<uint32_t>(static_cast<uint64_t>(itemCount) * (chunk + 1) / chunkCount);
+					for (uint32_t i = static_cast<uint32_t>(static_cast<uint64_t>(itemCount) * chunk / chunkCount); i < itemEnd; i++)
+					{
+						destination[offsets[(source[i].m_SortKey >> shift) & (g_RadixSize - 1)]++] = source[i];
+					}
+				}
+			};
+
+			if (chunkCount > 1)
+			{
+				threading->AddTaskLoop(Histogram, chunkCount);
+			}
+			else
+			{
+				Histogram(0, 1);
+			}
+
+			// Exclusive prefix sum.
+			uint32_t offset = 0;
+			for (uint32_t value = 0; value < g_RadixSize; value++)
+			{
+				for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+				{
+					uint32_t& chunkOffset = m_ChunkOffsets[chunk * g_RadixSize + value];
+					const uint32_t count = chunkOffset;
+					chunkOffset = offset;
+					offset += count;
+				}
+			}
+
+			if (chunkCount > 1)
+			{
+				threading->AddTaskLoop(Scatter, chunkCount);
+			}
+			else
+			{
+				Scatter(0, 1);
+			}
+
+			std::swap(source, destination);
+		}
+
+		// An odd number of passes leaves the result in the scratch buffer.
+		if (source != m_Items.data())
+		{
+			m_Items.swap(m_ItemsScratch);
+		}
+	}
+
+	const RenderItem* RenderQueue::RetrieveItems(const Renderer_ObjectType pass, uint32_t* itemCount) const
+	{
+		const uint64_t passFirst = static_cast<uint64_t>(pass) << 60;
+		const auto IsBefore = [](const RenderItem& item, const uint64_t sortKey) { return item.m_SortKey < sortKey; };
+
+		const std::vector<RenderItem>::const_iterator first = std::lower_bound(m_Items.begin(), m_Items.end(), passFirst, IsBefore);
+		const std::vector<RenderItem>::const_iterator last = pass + 1u < (1u << PassBits) ? std::lower_bound(first, m_Items.end(), passFirst + (1ull << 60), IsBefore) : m_Items.end();
+
+		*itemCount = static_cast<uint32_t>(last - first);
+		return m_Items.data() + (first - m_Items.begin());
+	}
+}
\ No newline at end of file
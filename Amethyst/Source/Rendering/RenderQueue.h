@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include "RendererEnums.h"
+
+namespace Amethyst
+{
+	class Entity;
+	class Threading;
+
+	struct RenderItem
+	{
+		uint64_t m_SortKey = 0;
+		Entity* m_Entity = nullptr;
+	};
+
+	/*
+		Draws are described by 64-bit sort keys so that a single integer sort orders a whole frame. From the most significant bit down:
+
+		Opaque:      [Pass : 4] [Pipeline : 16] [Material : 20] [Depth : 24] - Fewest state changes first, then front to back for early depth rejection.
+		Transparent: [Pass : 4] [Depth : 24] [Pipeline : 16] [Material : 20] - Back to front first as blending requires it, state second.
+
+		Keys are sorted with a least significant digit radix sort, 11 bits per pass. Digits that are the same across every key (the pass within a queue, an
+		unused pipeline field, a scene with few materials) are skipped, and large queues split each pass across the worker threads. The renderer keeps a
+		queue per pass for that reason - mixing the two layouts would leave no digit in common.
+	*/
+	class RenderQueue
+	{
+	public:
+		RenderQueue() = default;
+		~RenderQueue() = default;
+
+		// Depth is the squared distance to the camera. Its float bits order the same way the values do, so they are quantized without needing the far plane.
+		static uint64_t ComputeSortKey(const Renderer_ObjectType pass, const uint32_t pipelineHash, const uint32_t materialID, const float distanceSquared);
+
+		void Clear() { m_Items.clear(); }
+		void Add(const uint64_t sortKey, Entity* entity) { m_Items.push_back({ sortKey, entity }); }
+		void Sort(Threading* threading = nullptr);
+
+		// Passes occupy the top bits, so once sorted each pass is one contiguous range.
+		const RenderItem* RetrieveItems(const Renderer_ObjectType pass, uint32_t* itemCount) const;
+		const std::vector<RenderItem>& RetrieveItems() const { return m_Items; }
+		bool IsEmpty() const { return m_Items.empty(); }
+
+	public:
+		static constexpr uint32_t PassBits = 4;
+		static constexpr uint32_t PipelineBits = 16;
+		static constexpr uint32_t MaterialBits = 20;
+		static constexpr uint32_t DepthBits = 24;
+
+	private:
+		std::vector<RenderItem> m_Items;
+		std::vector<RenderItem> m_ItemsScratch;
+		std::vector<uint32_t> m_ChunkOffsets; // 2048 digit offsets (one per 11-bit digit value) per chunk.
+	};
+}
\ No newline at end of file
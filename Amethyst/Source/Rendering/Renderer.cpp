@@ -10,14 +10,18 @@
 #include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_PipelineCache.h"
 #include "../RHI/RHI_ConstantBuffer.h"
+#include "../RHI/RHI_StructuredBuffer.h"
 #include "../RHI/RHI_CommandList.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_SwapChain.h"
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_DescriptorSetLayoutCache.h"
+#include "../RHI/RHI_BindlessHeap.h"
+#include "../RHI/RHI_UploadHeap.h"
 #include "../RHI/RHI_Implementation.h"
 #include "../RHI/RHI_Semaphore.h"
 #include "../Display/Display.h"
+#include "../Threading/Threading.h"
 
 namespace Amethyst
 {
@@ -25,6 +29,7 @@ namespace Amethyst
 	{
 		// Options - Rendering
 		m_RendererOptions |= RendererOption::Render_ReverseZ;
+		m_RendererOptions |= RendererOption::Render_OcclusionCulling;
 
 		// Options - Debugging
 		m_RendererOptions |= RendererOption::RenderDebug_Transform;
@@ -55,7 +60,6 @@ namespace Amethyst
 	{	   
 		// Retrieve required systems.
 		m_ResourceCache = m_EngineContext->RetrieveSubsystem<ResourceCache>();
-		/// Retrieve Profiler.
 
 		// Create Device
 		m_RHI_Device = std::make_shared<RHI_Device>(m_EngineContext);
@@ -65,22 +69,28 @@ namespace Amethyst
 			return false;
 		}
 
+		// Create upload heap, before anything which has data to upload.
+		m_UploadHeap = std::make_shared<RHI_UploadHeap>(m_RHI_Device.get());
+
 		// Create pipeline cache.
 		m_PipelineCache = std::make_shared<RHI_PipelineCache>(m_RHI_Device.get());
 
 		// Create descriptor set layout cache.
 		m_DescriptorSetLayoutCache = std::make_shared<RHI_DescriptorSetLayoutCache>(m_RHI_Device.get());
 
-		// Retrieve Window
+		// Create bindless heap, before any textures, samplers or structured buffers which want a slot in it.
+		m_BindlessHeap = std::make_shared<RHI_BindlessHeap>(m_RHI_Device.get());
+
+		// Retrieve Window - Headless runs (null backend only) have none and render at a fixed resolution instead.
 		Window* window = m_EngineContext->RetrieveSubsystem<Window>();
-		uint32_t windowWidth = window->RetrieveWidth();
-		uint32_t windowHeight = window->RetrieveHeight();
+		uint32_t windowWidth = window ? window->RetrieveWidth() : 1920;
+		uint32_t windowHeight = window ? window->RetrieveHeight() : 1080;
 
 		// Create Swapchain
 		{
 			m_SwapChain = std::make_shared<RHI_SwapChain>
 			(
-				window->RetrieveHWND(),
+				window ? window->RetrieveHWND() : nullptr,
 				m_RHI_Device,
 				windowWidth,
 				windowHeight,
@@ -112,6 +122,7 @@ namespace Amethyst
 		   
 		// Create Our Renderer Assets
 		CreateConstantBuffers();
+		CreateStructuredBuffers();
 		CreateShaders();
 		CreateDepthStencilStates();
 		CreateRasterizerStates();
@@ -119,7 +130,10 @@ namespace Amethyst
 		CreateRenderTextures(false, false, true, true);
 		CreateFonts();
 		CreateSamplers();
-		CreateTextures();
+		CreateDefaultTextures();
+
+		// Non-resident textures fall back to the default ones, so those have to be resident from the first frame on.
+		m_UploadHeap->Flush(true);
 
 		if (!m_IsRendererInitialized)
 		{
@@ -133,6 +147,8 @@ namespace Amethyst
 
 	void Renderer::OnUpdate(float deltaTime)
 	{
+		AMETHYST_PROFILE_FUNCTION();
+
 		AMETHYST_ASSERT(m_RHI_Device != nullptr);
 		AMETHYST_ASSERT(m_RHI_Device->IsInitialized());
 
@@ -142,9 +158,18 @@ namespace Amethyst
 			// Acquire command list.
 			RHI_CommandList* commandList = m_SwapChain->RetrieveCommandList();
 
+			// Render targets are (re)created by the render graph, before anything is recorded.
+			if (m_IsRenderGraphDirty)
+			{
+				RenderGraphBuild();
+			}
+
 			// Begin
 			commandList->BeginCommandBuffer();
 
+			// Frees descriptor sets which have gone unused for long enough, now that the GPU is done with them.
+			m_DescriptorSetLayoutCache->BeginFrame(m_FrameNumber);
+
 			// Only render when the world is not loading as the command list will get flushed by the loading thread.
 			if (!m_EngineContext->RetrieveSubsystem<World>()->IsWorldLoading())
 			{
@@ -164,17 +189,15 @@ namespace Amethyst
 					return;
 				}
 
-				// Reset dynamic buffer indices when the swapchain reverts to first buffer/command list.
-				if (m_SwapChain->RetrieveCommandListIndex() == 0)
-				{
-					m_BufferUber_DynamicOffsetIndex = 0;
-					m_BufferFrame_DynamicOffsetIndex = 0;
-					m_BufferLight_DynamicOffsetIndex = 0;
-					m_BufferMaterial_DynamicOffsetIndex = 0;
-				}
+				// Every command list has its own region in the constant buffers, which is free again by the time the command list is being recorded.
+				m_BufferFrame_GPU->BeginFrame(m_SwapChain->RetrieveCommandListIndex());
+				m_BufferUber_GPU->BeginFrame(m_SwapChain->RetrieveCommandListIndex());
+				BeginInstanceBuffer(m_SwapChain->RetrieveCommandListIndex());
 
 				// Update Framebuffer
 				{
+					AMETHYST_PROFILE_SCOPE("Renderer::UpdateFrameBufferCPU");
+
 					if (m_UpdateOrthographicProjection || m_NearPlane != m_Camera->RetrieveNearPlane() || m_FarPlane != m_Camera->RetrieveFarPlane()) // There were changes to our camera because of user input. Thus, recompute for our constant buffers.
 					{
 						m_BufferFrame_CPU.m_ProjectionOrthographic = Math::Matrix::CreateOrthographic(m_Viewport.m_Width, m_Viewport.m_Height, m_NearPlane, m_FarPlane);
@@ -219,6 +242,10 @@ namespace Amethyst
 					/// TAA
 				}
 
+				RenderablesCull();
+				RenderQueuesUpdate();
+				InstanceBatchesUpdate();
+
 				Pass_Main(commandList);
 
 				// TickPrimitives(deltaTime);
@@ -230,9 +257,9 @@ namespace Amethyst
 		}
 
 		// Resize Swapchain to Window Size if Needed.
+		if (Window* window = m_EngineContext->RetrieveSubsystem<Window>())
 		{
 			// Passing zero dimensions will cause the swapchain to not present at all.
-			Window* window = m_EngineContext->RetrieveSubsystem<Window>();
 			uint32_t width = static_cast<uint32_t>(window->IsMinimized() ? 0 : window->RetrieveWidth());
 			uint32_t height = static_cast<uint32_t>(window->IsMinimized() ? 0 : window->RetrieveHeight());
 
@@ -336,64 +363,21 @@ namespace Amethyst
 	}
 
 	template<typename T>
-	bool UpdateDynamicBuffer(RHI_CommandList* commandList, RHI_ConstantBuffer* bufferGPU, T& bufferCPU, T& bufferCPUPrevious, uint32_t& offsetIndex)
+	bool UpdateDynamicBuffer(ConstantAllocator<T>* bufferGPU, T& bufferCPU, T& bufferCPUPrevious)
 	{
-		// Only update if needed.
-		if (bufferCPU == bufferCPUPrevious)
+		// Only update if needed. Earlier frames' slots get reused, so every frame makes at least one allocation.
+		if (bufferGPU->IsAllocatedThisFrame() && bufferCPU == bufferCPUPrevious)
 		{
 			return true;
 		}
 
-		offsetIndex++;
-
-		// Reallocate buffer with double size if needed.
-		if (bufferGPU->IsDynamic())
-		{
-			if (offsetIndex >= bufferGPU->RetrieveOffsetCount())
-			{
-				commandList->FlushCommandBuffer();
-				const uint32_t newSize = Math::Utilities::NextPowerOfTwo(offsetIndex + 1);
-				if (!bufferGPU->Create<T>(newSize))
-				{
-					AMETHYST_ERROR("Failed to re-allocate %s buffer with %d offsets.", bufferGPU->RetrieveObjectName().c_str(), newSize);
-					return false;
-				}
-
-				AMETHYST_INFO("Increased %s buffer offsets to %d. That's %dkb.", bufferGPU->RetrieveObjectName().c_str(), newSize, (newSize * bufferGPU->RetrieveStride()) / 1000);
-			}
-		}
-
-		// Set new buffer offset.
-		if (bufferGPU->IsDynamic())
+		if (!bufferGPU->Allocate(bufferCPU))
 		{
-			bufferGPU->SetOffsetIndexDynamic(offsetIndex);
-		}
-
-		// Map
-		T* buffer = static_cast<T*>(bufferGPU->Map());
-		if (!buffer)
-		{
-			AMETHYST_ERROR("Failed to map buffer.");
 			return false;
 		}
 
-		const uint64_t size = bufferGPU->RetrieveStride();
-		const uint64_t offset = offsetIndex * size;
-
-		// Update
-		if (bufferGPU->IsDynamic())
-		{
-			memcpy(reinterpret_cast<std::byte*>(buffer) + offset, reinterpret_cast<std::byte*>(&bufferCPU), size);
-		}
-		else
-		{
-			*buffer = bufferCPU;
-		}
-
 		bufferCPUPrevious = bufferCPU;
-
-		// Unmap
-		return bufferGPU->Unmap(offset, size);
+		return true;
 	}
 
 	bool Renderer::UpdateFrameBuffer(RHI_CommandList* commandList)
@@ -405,13 +389,13 @@ namespace Amethyst
 			return false;
 		}
 
-		if (!UpdateDynamicBuffer<BufferFrame>(commandList, m_BufferFrame_GPU.get(), m_BufferFrame_CPU, m_BufferFrame_CPUPrevious, m_BufferFrame_DynamicOffsetIndex))
+		if (!UpdateDynamicBuffer<BufferFrame>(m_BufferFrame_GPU.get(), m_BufferFrame_CPU, m_BufferFrame_CPUPrevious))
 		{
 			return false;
 		}
 
 		// Dynamic buffers with offsets have to be rebound whenever the offset changes.
-		return commandList->SetConstantBuffer(0, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferFrame_GPU);
+		return commandList->SetConstantBuffer(0, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferFrame_GPU->RetrieveBuffer());
 	}
 
 	bool Renderer::UpdateUberBuffer(RHI_CommandList* commandList)
@@ -422,13 +406,84 @@ namespace Amethyst
 			return false;
 		}
 
-		if (!UpdateDynamicBuffer<BufferUber>(commandList, m_BufferUber_GPU.get(), m_BufferUber_CPU, m_BufferUber_CPUPrevious, m_BufferUber_DynamicOffsetIndex))
+		if (!UpdateDynamicBuffer<BufferUber>(m_BufferUber_GPU.get(), m_BufferUber_CPU, m_BufferUber_CPUPrevious))
 		{
 			return false;
 		}
 
 		// Dynamic buffers with offsets have to be rebound whenever the offset changes.
-		return commandList->SetConstantBuffer(2, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferUber_GPU);
+		return commandList->SetConstantBuffer(2, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferUber_GPU->RetrieveBuffer());
+	}
+
+	bool Renderer::BeginInstanceBuffer(const uint32_t commandListIndex)
+	{
+		// What the last frame wrote is known by now, so it becomes that region's high-water mark.
+		m_BufferInstances_HighWaterMarks[m_BufferInstances_RegionIndex] = m_BufferInstances_Used;
+		m_BufferInstances_RegionIndex = commandListIndex % m_SwapChainBufferCount;
+		m_BufferInstances_GPUCurrent = m_BufferInstances_GPU.get();
+		m_BufferInstances_Used = 0;
+
+		// Resizing waits for the GPU, which is only ever done here, in between frames. Headroom keeps a slowly growing scene from resizing every frame.
+		const uint32_t highWaterMark = *std::max_element(m_BufferInstances_HighWaterMarks.begin(), m_BufferInstances_HighWaterMarks.end());
+		if (highWaterMark > m_BufferInstances_Capacity)
+		{
+			m_BufferInstances_GPUOverflow.reset();
+
+			const uint32_t capacity = Math::Utilities::NextPowerOfTwo(highWaterMark + highWaterMark / 4);
+			if (!m_BufferInstances_GPU->Create<BufferInstance>(capacity * m_SwapChainBufferCount))
+			{
+				AMETHYST_ERROR("Failed to re-allocate %s buffer with %d elements per command list.", m_BufferInstances_GPU->RetrieveObjectName().c_str(), capacity);
+				m_BufferInstances_Capacity = 0;
+				return false;
+			}
+
+			m_BufferInstances_Capacity = capacity;
+			m_BufferInstances_HighWaterMarks.fill(0);
+			AMETHYST_INFO("Increased %s buffer elements to %d per command list. That's %dkb.", m_BufferInstances_GPU->RetrieveObjectName().c_str(), capacity, (capacity * m_SwapChainBufferCount * m_BufferInstances_GPU->RetrieveStride()) / 1000);
+		}
+
+		m_BufferInstances_Base = m_BufferInstances_RegionIndex * m_BufferInstances_Capacity;
+		return true;
+	}
+
+	bool Renderer::UpdateInstanceBuffer(RHI_CommandList* commandList)
+	{
+		if (m_BufferInstances_CPU.empty())
+		{
+			return true;
+		}
+
+		// A frame which outgrew its region goes into a buffer of its own, as resizing the shared one would have to wait for the command lists still in flight.
+		const uint32_t instanceCount = static_cast<uint32_t>(m_BufferInstances_CPU.size());
+		m_BufferInstances_Used = instanceCount;
+		if (instanceCount > m_BufferInstances_Capacity)
+		{
+			if (!m_BufferInstances_GPUOverflow || instanceCount > m_BufferInstances_GPUOverflow->RetrieveElementCount())
+			{
+				// Created anew rather than recreated, as the previous one may still be in use by the GPU. It's released along with the next resize, which waits anyway.
+				std::shared_ptr<RHI_StructuredBuffer> overflow = std::make_shared<RHI_StructuredBuffer>(m_RHI_Device, "Instances (Overflow)");
+				if (!overflow->Create<BufferInstance>(Math::Utilities::NextPowerOfTwo(instanceCount)))
+				{
+					AMETHYST_ERROR("Failed to allocate %s buffer with %d elements.", overflow->RetrieveObjectName().c_str(), instanceCount);
+					return false;
+				}
+
+				m_BufferInstances_GPUOverflow = overflow;
+			}
+
+			m_BufferInstances_GPUCurrent = m_BufferInstances_GPUOverflow.get();
+			m_BufferInstances_Base = 0;
+		}
+
+		BufferInstance* buffer = static_cast<BufferInstance*>(m_BufferInstances_GPUCurrent->Map());
+		if (!buffer)
+		{
+			AMETHYST_ERROR("Failed to map buffer.");
+			return false;
+		}
+
+		std::copy(m_BufferInstances_CPU.begin(), m_BufferInstances_CPU.end(), buffer + m_BufferInstances_Base);
+		return m_BufferInstances_GPUCurrent->Unmap(m_BufferInstances_Base * sizeof(BufferInstance), instanceCount * sizeof(BufferInstance));
 	}
 
 	void Renderer::RenderablesAcquire(const Variant& renderables)
@@ -469,35 +524,117 @@ namespace Amethyst
 				m_Camera = camera->RetrieveSharedPointer<Camera>();
 			}
 		}
-
-		RenderablesSort(&m_Entities[Renderer_ObjectType::Renderer_Object_Opaque]);
-		/// Sort transparent objects as well.
 	}
 
-	void Renderer::RenderablesSort(std::vector<Entity*>* renderables)
+	void Renderer::RenderQueuesUpdate()
 	{
-		if (!m_Camera || renderables->size() <= 2)
+		AMETHYST_PROFILE_FUNCTION();
+
+		// Depth changes whenever the camera or an entity moves, so keys are rebuilt every frame. Sorting integers keeps that cheap.
+		const Math::Vector3 cameraPosition = m_Camera->RetrieveTransform()->RetrievePosition();
+		Threading* threading = m_EngineContext->RetrieveSubsystem<Threading>();
+
+		for (const Renderer_ObjectType objectType : { Renderer_ObjectType::Renderer_Object_Opaque, Renderer_ObjectType::Renderer_Object_Transparent })
 		{
-			return;
+			RenderQueue& renderQueue = m_RenderQueues[objectType];
+			renderQueue.Clear();
+
+			for (Entity* entity : m_EntitiesVisible[objectType])
+			{
+				Renderable* renderable = entity->RetrieveRenderable();
+				if (!renderable)
+				{
+					continue;
+				}
+
+				// There are no pipeline variations or materials yet. Renderables sharing a model share its vertex and index buffers, so the model stands in for the material.
+				const uint32_t materialID = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(renderable->RetrieveGeometryModel()) >> 4);
+				const float distanceSquared = (renderable->RetrieveAABB().RetrieveCenter() - cameraPosition).LengthSquared();
+
+				renderQueue.Add(RenderQueue::ComputeSortKey(objectType, 0, materialID, distanceSquared), entity);
+			}
+
+			renderQueue.Sort(threading);
 		}
+	}
+
+	void Renderer::InstanceBatchesUpdate()
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		m_BufferInstances_CPU.clear();
 
-		// Retrieve magnitude from camera to the object.
-		auto comparisonOperation = [this](Entity* entity)
+		for (const Renderer_ObjectType objectType : { Renderer_ObjectType::Renderer_Object_Opaque, Renderer_ObjectType::Renderer_Object_Transparent })
 		{
-			Renderable* renderable = entity->RetrieveRenderable();
-			if (!renderable)
+			std::vector<Renderer_InstanceBatch>& instanceBatches = m_InstanceBatches[objectType];
+			instanceBatches.clear();
+
+			const std::vector<RenderItem>& renderItems = m_RenderQueues[objectType].RetrieveItems();
+			m_InstanceBatchIndices.resize(renderItems.size());
+
+			// Opaque items are grouped within each run of equal state, keeping the batches in the order their nearest instance was queued. Transparent items
+			// have to stay back to front, so only neighbours with the same state and geometry are merged there.
+			const bool isTransparent = objectType == Renderer_ObjectType::Renderer_Object_Transparent;
+			const uint64_t stateMask = isTransparent ? (1ull << (RenderQueue::PipelineBits + RenderQueue::MaterialBits)) - 1 : ~((1ull << RenderQueue::DepthBits) - 1);
+			uint64_t statePrevious = ~0ull;
+			Renderer_InstanceKey keyPrevious;
+
+			for (uint32_t i = 0; i < static_cast<uint32_t>(renderItems.size()); i++)
 			{
-				return 0.0f;
+				const Renderable* renderable = renderItems[i].m_Entity->RetrieveRenderable();
+
+				Renderer_InstanceKey key;
+				key.m_Model = renderable->RetrieveGeometryModel();
+				key.m_IndexOffset = renderable->RetrieveGeometryIndexOffset();
+				key.m_IndexCount = renderable->RetrieveGeometryIndexCount();
+				key.m_VertexOffset = renderable->RetrieveGeometryVertexOffset();
+
+				const uint64_t state = renderItems[i].m_SortKey & stateMask;
+				if (state != statePrevious)
+				{
+					m_InstanceBatchLookup.clear();
+				}
+
+				uint32_t batchIndex = 0;
+				if (isTransparent)
+				{
+					const bool isMerged = state == statePrevious && key == keyPrevious;
+					batchIndex = isMerged ? static_cast<uint32_t>(instanceBatches.size()) - 1 : static_cast<uint32_t>(instanceBatches.size());
+				}
+				else
+				{
+					batchIndex = m_InstanceBatchLookup.emplace(key, static_cast<uint32_t>(instanceBatches.size())).first->second;
+				}
+
+				if (batchIndex == instanceBatches.size())
+				{
+					instanceBatches.push_back({ renderItems[i].m_Entity, 0, 0 });
+				}
+
+				instanceBatches[batchIndex].m_InstanceCount++;
+				m_InstanceBatchIndices[i] = batchIndex;
+				statePrevious = state;
+				keyPrevious = key;
 			}
 
-			return (renderable->RetrieveAABB().RetrieveCenter() - m_Camera->RetrieveTransform()->RetrievePosition()).LengthSquared();
-		};
+			// Lay the batches out one after another, then scatter the transforms into place.
+			uint32_t instanceOffset = static_cast<uint32_t>(m_BufferInstances_CPU.size());
+			for (Renderer_InstanceBatch& instanceBatch : instanceBatches)
+			{
+				instanceBatch.m_InstanceOffset = instanceOffset;
+				instanceOffset += instanceBatch.m_InstanceCount;
+				instanceBatch.m_InstanceCount = 0;
+			}
 
-		// Sort by depth (front to back).
-		std::sort(renderables->begin(), renderables->end(), [&comparisonOperation](Entity* a, Entity* b)
-		{
-			return comparisonOperation(a) < comparisonOperation(b);
-		});
+			m_BufferInstances_CPU.resize(instanceOffset);
+			for (uint32_t i = 0; i < static_cast<uint32_t>(renderItems.size()); i++)
+			{
+				Renderer_InstanceBatch& instanceBatch = instanceBatches[m_InstanceBatchIndices[i]];
+				m_BufferInstances_CPU[instanceBatch.m_InstanceOffset + instanceBatch.m_InstanceCount++].m_Transform = renderItems[i].m_Entity->RetrieveTransform()->RetrieveMatrix();
+			}
+		}
+
+		m_InstanceBatchLookup.clear();
 	}
 
 	void Renderer::ClearEntities()
@@ -505,6 +642,13 @@ namespace Amethyst
 		// Flush to remove references to entity resources that will be deallocated.
 		FlushRenderer();
 		m_Entities.clear();
+		m_EntitiesVisible[Renderer_ObjectType::Renderer_Object_Opaque].clear();
+		m_EntitiesVisible[Renderer_ObjectType::Renderer_Object_Transparent].clear();
+		m_RenderQueues[Renderer_ObjectType::Renderer_Object_Opaque].Clear();
+		m_RenderQueues[Renderer_ObjectType::Renderer_Object_Transparent].Clear();
+		m_InstanceBatches[Renderer_ObjectType::Renderer_Object_Opaque].clear();
+		m_InstanceBatches[Renderer_ObjectType::Renderer_Object_Transparent].clear();
+		m_BufferInstances_CPU.clear();
 	}
 
 	void Renderer::SetRendererOption(RendererOption option, bool isEnabled)
@@ -512,10 +656,12 @@ namespace Amethyst
 		if (isEnabled && !RetrieveRendererOption(option))
 		{
 			m_RendererOptions |= option;
+			m_IsRenderGraphDirty = true; // Options decide what passes run and how they clear, so pipeline states are built again along with the graph.
 		}
 		else if (!isEnabled && RetrieveRendererOption(option))
 		{
 			m_RendererOptions &= ~option;
+			m_IsRenderGraphDirty = true;
 		}
 	}
 
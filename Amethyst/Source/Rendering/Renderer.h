@@ -6,9 +6,15 @@
 #include "../Core/ISubsystem.h"
 #include "../RHI/RHI_Viewport.h"
 #include "../RHI/RHI_CommandList.h"
+#include "../RHI/RHI_PipelineState.h"
 #include "../Runtime/Math/BoundingBox.h"
 #include "../Runtime/Math/Rectangle.h"
+#include "../Utilities/Hash.h"
 #include "RendererEnums.h"
+#include "RenderQueue.h"
+#include "OcclusionCuller.h"
+#include "ConstantAllocator.h"
+#include "RenderGraph.h"
 
 namespace Amethyst
 {
@@ -17,6 +23,51 @@ namespace Amethyst
 	class Camera;
 	///class Light;
 	class ResourceCache;
+	class Threading;
+	class Model;
+
+	struct Renderer_CullingStatistics
+	{
+		uint32_t m_TestedCount = 0;
+		uint32_t m_VisibleCount = 0;
+		uint32_t m_OccludedCount = 0; // Inside the frustum but hidden by occluders. Not part of the visible count.
+		float m_TimeInMilliseconds = 0.0f;
+	};
+
+	// Renderables are instanced together when they draw the same range of the same model.
+	struct Renderer_InstanceKey
+	{
+		const Model* m_Model = nullptr;
+		uint32_t m_IndexOffset = 0;
+		uint32_t m_IndexCount = 0;
+		uint32_t m_VertexOffset = 0;
+
+		bool operator==(const Renderer_InstanceKey& key) const
+		{
+			return m_Model == key.m_Model && m_IndexOffset == key.m_IndexOffset && m_IndexCount == key.m_IndexCount && m_VertexOffset == key.m_VertexOffset;
+		}
+	};
+
+	struct Renderer_InstanceKeyHasher
+	{
+		size_t operator()(const Renderer_InstanceKey& key) const
+		{
+			uint32_t hash = 0;
+			Utility::HashCombine(hash, key.m_Model);
+			Utility::HashCombine(hash, key.m_IndexOffset);
+			Utility::HashCombine(hash, key.m_IndexCount);
+			Utility::HashCombine(hash, key.m_VertexOffset);
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	// One draw call. Its instances' transforms are contiguous in the instance buffer.
+	struct Renderer_InstanceBatch
+	{
+		Entity* m_Entity = nullptr; // Any of the instances, as they all share the geometry.
+		uint32_t m_InstanceOffset = 0;
+		uint32_t m_InstanceCount = 0;
+	};
 	
 	class Renderer : public ISubsystem
 	{
@@ -59,11 +110,11 @@ namespace Amethyst
 
 		// Debug/Visualize a Render Target
 		const std::array<std::shared_ptr<RHI_Texture>, 25> RetrieveRenderTargets() { return m_RenderTargets; }
-		void SetRenderTargetDebug(const Renderer_RenderTargetType renderTargetDebug) { m_RenderTargetDebug = renderTargetDebug; }
+		void SetRenderTargetDebug(const Renderer_RenderTargetType renderTargetDebug) { m_IsRenderGraphDirty |= m_RenderTargetDebug != renderTargetDebug; m_RenderTargetDebug = renderTargetDebug; } // The graph only keeps render targets something reads.
 		Renderer_RenderTargetType RetrieveRenderTargetDebug() const { return m_RenderTargetDebug; }
 
 		// Depth
-		float RetrieveClearDepth() { RetrieveRendererOption(RendererOption::Render_ReverseZ) ? m_Viewport.m_DepthMinimum : m_Viewport.m_DepthMaximum; }
+		float RetrieveClearDepth() { return RetrieveRendererOption(RendererOption::Render_ReverseZ) ? m_Viewport.m_DepthMinimum : m_Viewport.m_DepthMaximum; }
 		RHI_Comparison_Function RetrieveDepthComparisonFunction() const { return RetrieveRendererOption(RendererOption::Render_ReverseZ) ? RHI_Comparison_GreaterEqual : RHI_Comparison_LessEqual; }
 
 		// Environment
@@ -106,18 +157,25 @@ namespace Amethyst
 		const std::shared_ptr<RHI_Device>& RetrieveRHIDevice() const { return m_RHI_Device; }
 		RHI_PipelineCache* RetrievePipelineCache() const { return m_PipelineCache.get(); }
 		RHI_DescriptorSetLayoutCache* RetrieveDescriptorLayoutCache() const { return m_DescriptorSetLayoutCache.get(); }
+		RHI_BindlessHeap* RetrieveBindlessHeap() const { return m_BindlessHeap.get(); }
+		RHI_UploadHeap* RetrieveUploadHeap() const { return m_UploadHeap.get(); }
+		const RenderGraph& RetrieveRenderGraph() const { return m_RenderGraph; }
 		RHI_Texture* RetrieveFrameTexture() { return m_RenderTargets[static_cast<uint8_t>(Renderer_RenderTargetType::Frame_PostProcess)].get(); }
 		uint64_t RetrieveFrameNumber() const { return m_FrameNumber; }
 		std::shared_ptr<Camera> RetrieveCamera() const { return m_Camera; }
 		// Retrieve Shaders
 		uint32_t RetrieveMaxResolution() const;
 		void ClearEntities();
+		const Renderer_CullingStatistics& RetrieveCullingStatistics() const { return m_CullingStatistics; }
+		ConstantAllocatorStatistics RetrieveBufferFrameStatistics() const { return m_BufferFrame_GPU->RetrieveStatistics(); }
+		ConstantAllocatorStatistics RetrieveBufferUberStatistics() const { return m_BufferUber_GPU->RetrieveStatistics(); }
 
 		void Pass_CopyToBackbuffer(RHI_CommandList* commandList);
 
 	private:
 		// Resource Creation
 		void CreateConstantBuffers();
+		void CreateStructuredBuffers();
 		void CreateDepthStencilStates();
 		void CreateRasterizerStates();
 		void CreateBlendStates();
@@ -126,6 +184,8 @@ namespace Amethyst
 		void CreateShaders();
 		void CreateSamplers();
 		void CreateRenderTextures(const bool createRenderResolutions, const bool createOutputResolutions, const bool createFixedResolutions, const bool createDynamicResolutions);
+		void RenderGraphBuild();
+		void PipelineStatesBuild();
 
 		// Passes
 		void Pass_Main(RHI_CommandList* commandList);
@@ -138,19 +198,33 @@ namespace Amethyst
 		bool UpdateFrameBuffer(RHI_CommandList* commandList);
 		///bool UpdateMaterialBuffer(RHI_CommandList* commandList);
 		bool UpdateUberBuffer(RHI_CommandList* commandList);
+		bool UpdateInstanceBuffer(RHI_CommandList* commandList);
+		bool BeginInstanceBuffer(const uint32_t commandListIndex);
 		///bool UpdateLightBuffer(RHI_CommandList** commandList, const Light* light);
 
 		// Misc
 		void RenderablesAcquire(const Variant& renderables);
-		void RenderablesSort(std::vector<Entity*>* renderables);
+		void RenderablesCull();
+		void RenderablesOcclude(Threading* threading);
+		void RenderQueuesUpdate();
+		void InstanceBatchesUpdate();
 
 	private:
 
 
+		// Render Graph - Declared before the render targets, so that the textures it hands out are let go of before their memory.
+		RenderGraph m_RenderGraph;
+		std::array<RenderGraph_ResourceHandle, 25> m_RenderGraphTextures;
+		bool m_IsRenderGraphDirty = true;
+
 		// Render Targets
 		std::array<std::shared_ptr<RHI_Texture>, 25> m_RenderTargets;
 		Renderer_RenderTargetType m_RenderTargetDebug = Renderer_RenderTargetType::Undefined;
 
+		// Pipeline States - One per pass variant, built along with the render graph, which is when the render targets they draw to change.
+		RHI_PipelineState m_PipelineState_UpdateFrameBuffer;
+		std::array<RHI_PipelineState, 2> m_PipelineStates_GBuffer; // Opaque and transparent.
+
 		// Standard Textures
 		std::shared_ptr<RHI_Texture> m_Texture_DefaultWhite;
 		std::shared_ptr<RHI_Texture> m_Texture_DefaultBlack;
@@ -184,6 +258,8 @@ namespace Amethyst
 		std::shared_ptr<RHI_Device> m_RHI_Device;
 		std::shared_ptr<RHI_PipelineCache> m_PipelineCache;
 		std::shared_ptr<RHI_DescriptorSetLayoutCache> m_DescriptorSetLayoutCache;
+		std::shared_ptr<RHI_BindlessHeap> m_BindlessHeap;
+		std::shared_ptr<RHI_UploadHeap> m_UploadHeap;
 
 		// Swapchain
 		std::shared_ptr<RHI_SwapChain> m_SwapChain;
@@ -219,22 +295,42 @@ namespace Amethyst
 		// ==== Constant Buffers ====
 		BufferFrame m_BufferFrame_CPU;
 		BufferFrame m_BufferFrame_CPUPrevious;
-		std::shared_ptr<RHI_ConstantBuffer> m_BufferFrame_GPU;
-		uint32_t m_BufferFrame_DynamicOffsetIndex = 0;
+		std::unique_ptr<ConstantAllocator<BufferFrame>> m_BufferFrame_GPU;
 
 		BufferUber m_BufferUber_CPU;
 		BufferUber m_BufferUber_CPUPrevious;
-		std::shared_ptr<RHI_ConstantBuffer> m_BufferUber_GPU;
-		uint32_t m_BufferUber_DynamicOffsetIndex = 0;
+		std::unique_ptr<ConstantAllocator<BufferUber>> m_BufferUber_GPU;
+
+		std::vector<BufferInstance> m_BufferInstances_CPU;
+		std::shared_ptr<RHI_StructuredBuffer> m_BufferInstances_GPU;		  // A region of m_BufferInstances_Capacity instances for every command list, as the GPU reads it in place.
+		std::shared_ptr<RHI_StructuredBuffer> m_BufferInstances_GPUOverflow; // For a frame which outgrew its region, until the next BeginInstanceBuffer() resizes.
+		RHI_StructuredBuffer* m_BufferInstances_GPUCurrent = nullptr;		  // The one this frame's instances went into.
+		std::array<uint32_t, m_SwapChainBufferCount> m_BufferInstances_HighWaterMarks = {};
+		uint32_t m_BufferInstances_Capacity = 0;
+		uint32_t m_BufferInstances_RegionIndex = 0;
+		uint32_t m_BufferInstances_Used = 0;								  // Instances written this frame.
+		uint32_t m_BufferInstances_Base = 0;								  // First instance of this frame's region, which every draw adds to its own.
 
 		uint32_t m_BufferMaterial_DynamicOffsetIndex = 0;
 		uint32_t m_BufferLight_DynamicOffsetIndex = 0;
 
 		// Entities and Material References
 		std::unordered_map<Renderer_ObjectType, std::vector<Entity*>> m_Entities; // Binds an entity to an object type.
+		std::array<std::vector<Entity*>, 2> m_EntitiesVisible; // Opaque and transparent renderables inside the camera's frustum, rebuilt every frame.
+		std::array<RenderQueue, 2> m_RenderQueues; // Opaque and transparent renderables, sorted every frame.
+		std::array<std::vector<Renderer_InstanceBatch>, 2> m_InstanceBatches; // The render queues, grouped into draw calls.
+		std::unordered_map<Renderer_InstanceKey, uint32_t, Renderer_InstanceKeyHasher> m_InstanceBatchLookup;
+		std::vector<uint32_t> m_InstanceBatchIndices;
 		//std::array<Material*, m_MaxMaterialInstances> m_MaterialInstances;
 		std::shared_ptr<Camera> m_Camera;
 
+		// Culling - Bounds are gathered as structure-of-arrays (six arrays of entity count floats) for the batch culling kernels.
+		std::vector<float> m_CullingBounds;
+		std::vector<uint32_t> m_CullingMasks;
+		Renderer_CullingStatistics m_CullingStatistics;
+		OcclusionCuller m_OcclusionCuller;
+		std::vector<uint8_t> m_OcclusionVisibility;
+
 		// Dependencies
 		ResourceCache* m_ResourceCache = nullptr;
 	};
@@ -50,7 +50,8 @@ namespace Amethyst
 		Tex = 31,
 		Tex2 = 32,
 		Font_Atlas = 33,
-		SSGI = 34
+		SSGI = 34,
+		Instances = 35
 	};
 
 	//Unordered Access Views Bindings
@@ -105,7 +106,8 @@ namespace Amethyst
 		RenderDebug_Physics				= 1 << 7,
 		RenderDebug_Wireframe			= 1 << 8,
 
-		Render_ReverseZ					= 1 << 23
+		Render_ReverseZ					= 1 << 23,
+		Render_OcclusionCulling			= 1 << 24
 	};
 
 	// Renderable Object Types
@@ -84,6 +84,12 @@ namespace Amethyst
 		bool operator !=(const BufferFrame& bufferFrame) const { return !(*this == bufferFrame); }
 	};
 
+	// Per Instance - One for every drawn renderable, written once per frame. Read through SV_InstanceID, which starts from the draw's first instance.
+	struct BufferInstance
+	{
+		Math::Matrix m_Transform;
+	};
+
 	// High Frequency - Updates like Crazy. 
 	struct BufferUber
 	{
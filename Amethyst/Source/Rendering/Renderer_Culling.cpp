@@ -0,0 +1,170 @@
+#include "Amethyst.h"
+#include "Renderer.h"
+#include "../Runtime/ECS/Entity.h"
+#include "../Runtime/ECS/Components/Camera.h"
+#include "../Runtime/ECS/Components/Renderable.h"
+#include "../Runtime/ECS/Components/Transform.h"
+#include "Model.h"
+#include "Mesh.h"
+#include "../Threading/Threading.h"
+
+namespace Amethyst
+{
+	static constexpr uint32_t g_CullingChunkSize = 1024; // A multiple of 32, so that every chunk writes whole visibility mask words.
+
+	void Renderer::RenderablesCull()
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		const Stopwatch stopwatch;
+		const Math::Frustum& frustum = m_Camera->RetrieveFrustum();
+		Threading* threading = m_EngineContext->RetrieveSubsystem<Threading>();
+
+		m_CullingStatistics = Renderer_CullingStatistics();
+
+		for (const Renderer_ObjectType objectType : { Renderer_ObjectType::Renderer_Object_Opaque, Renderer_ObjectType::Renderer_Object_Transparent })
+		{
+			const std::vector<Entity*>& entities = m_Entities[objectType];
+			std::vector<Entity*>& entitiesVisible = m_EntitiesVisible[objectType];
+			entitiesVisible.clear();
+
+			const uint32_t entityCount = static_cast<uint32_t>(entities.size());
+			if (entityCount == 0)
+			{
+				continue;
+			}
+
+			m_CullingBounds.resize(entityCount * 6);
+			m_CullingMasks.resize((entityCount + 31) / 32);
+
+			float* centersX = m_CullingBounds.data();
+			float* centersY = centersX + entityCount;
+			float* centersZ = centersY + entityCount;
+			float* extentsX = centersZ + entityCount;
+			float* extentsY = extentsX + entityCount;
+			float* extentsZ = extentsY + entityCount;
+			uint32_t* visibilityMasks = m_CullingMasks.data();
+
+			// Each chunk gathers its world-space bounds (updating any that moved) and culls them, so the whole stage spreads across the workers.
+			const uint32_t chunkCount = (entityCount + g_CullingChunkSize - 1) / g_CullingChunkSize;
+			threading->AddTaskLoop([&](uint32_t chunkStart, uint32_t chunkEnd)
+			{
+				for (uint32_t chunk = chunkStart; chunk < chunkEnd; chunk++)
+				{
+					const uint32_t first = chunk * g_CullingChunkSize;
+					const uint32_t count = Math::Utilities::Min(g_CullingChunkSize, entityCount - first);
+
+					for (uint32_t i = first; i < first + count; i++)
+					{
+						const Math::BoundingBox& boundingBox = entities[i]->RetrieveRenderable()->RetrieveAABB();
+
+						// Without geometry there are no bounds to go by. These are kept, as they were before culling existed.
+						const Math::Vector3 center = boundingBox.IsDefined() ? boundingBox.RetrieveCenter() : Math::Vector3::Zero;
+						const Math::Vector3 extents = boundingBox.IsDefined() ? boundingBox.RetrieveExtents() : Math::Vector3(1e30f, 1e30f, 1e30f);
+
+						centersX[i] = center.m_X;
+						centersY[i] = center.m_Y;
+						centersZ[i] = center.m_Z;
+						extentsX[i] = extents.m_X;
+						extentsY[i] = extents.m_Y;
+						extentsZ[i] = extents.m_Z;
+					}
+
+					frustum.CullBoxes(centersX + first, centersY + first, centersZ + first, extentsX + first, extentsY + first, extentsZ + first, visibilityMasks + first / 32, count);
+				}
+			}, chunkCount);
+
+			// Compact the survivors, in their original order.
+			for (uint32_t word = 0; word < static_cast<uint32_t>(m_CullingMasks.size()); word++)
+			{
+				uint32_t mask = visibilityMasks[word];
+				for (uint32_t i = word * 32; mask != 0; i++, mask >>= 1)
+				{
+					if (mask & 1)
+					{
+						entitiesVisible.emplace_back(entities[i]);
+					}
+				}
+			}
+
+			m_CullingStatistics.m_TestedCount += entityCount;
+			m_CullingStatistics.m_VisibleCount += static_cast<uint32_t>(entitiesVisible.size());
+		}
+
+		if (RetrieveRendererOption(RendererOption::Render_OcclusionCulling))
+		{
+			RenderablesOcclude(threading);
+		}
+
+		m_CullingStatistics.m_TimeInMilliseconds = stopwatch.RetrieveElapsedTimeInMilliseconds();
+	}
+
+	void Renderer::RenderablesOcclude(Threading* threading)
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		// Only opaque occluders can hide anything. Their own geometry is drawn, so every occluder stays visible itself.
+		m_OcclusionCuller.Begin(m_Camera->RetrieveViewProjectionMatrix());
+		for (Entity* entity : m_EntitiesVisible[Renderer_ObjectType::Renderer_Object_Opaque])
+		{
+			Renderable* renderable = entity->RetrieveRenderable();
+			Model* model = renderable->RetrieveGeometryModel();
+			if (!renderable->IsOccluder() || !model || !model->RetrieveMesh() || renderable->RetrieveGeometryIndexCount() == 0)
+			{
+				continue;
+			}
+
+			Mesh* mesh = model->RetrieveMesh().get();
+			m_OcclusionCuller.AddOccluder(
+				&mesh->VerticesRetrieve()[renderable->RetrieveGeometryVertexOffset()].m_Position[0],
+				sizeof(RHI_Vertex_PositionTextureNormalTangent),
+				&mesh->IndicesRetrieve()[renderable->RetrieveGeometryIndexOffset()],
+				renderable->RetrieveGeometryIndexCount(),
+				entity->RetrieveTransform()->RetrieveMatrix()
+			);
+		}
+
+		if (m_OcclusionCuller.RetrieveTriangleCount() == 0)
+		{
+			return;
+		}
+
+		m_OcclusionCuller.Rasterize(threading);
+
+		for (const Renderer_ObjectType objectType : { Renderer_ObjectType::Renderer_Object_Opaque, Renderer_ObjectType::Renderer_Object_Transparent })
+		{
+			std::vector<Entity*>& entitiesVisible = m_EntitiesVisible[objectType];
+			const uint32_t entityCount = static_cast<uint32_t>(entitiesVisible.size());
+			if (entityCount == 0)
+			{
+				continue;
+			}
+
+			// Occluders are never tested, as they would only ever hide themselves.
+			m_OcclusionVisibility.resize(entityCount);
+			const uint32_t chunkCount = (entityCount + g_CullingChunkSize - 1) / g_CullingChunkSize;
+			threading->AddTaskLoop([&](uint32_t chunkStart, uint32_t chunkEnd)
+			{
+				const uint32_t end = Math::Utilities::Min(chunkEnd * g_CullingChunkSize, entityCount);
+				for (uint32_t i = chunkStart * g_CullingChunkSize; i < end; i++)
+				{
+					Renderable* renderable = entitiesVisible[i]->RetrieveRenderable();
+					m_OcclusionVisibility[i] = renderable->IsOccluder() || m_OcclusionCuller.IsVisible(renderable->RetrieveAABB());
+				}
+			}, chunkCount);
+
+			uint32_t visibleCount = 0;
+			for (uint32_t i = 0; i < entityCount; i++)
+			{
+				if (m_OcclusionVisibility[i])
+				{
+					entitiesVisible[visibleCount++] = entitiesVisible[i];
+				}
+			}
+
+			entitiesVisible.resize(visibleCount);
+			m_CullingStatistics.m_OccludedCount += entityCount - visibleCount;
+			m_CullingStatistics.m_VisibleCount -= entityCount - visibleCount;
+		}
+	}
+}
\ No newline at end of file
@@ -4,22 +4,61 @@
 #include "../RHI/RHI_CommandList.h"
 #include "../RHI/RHI_Implementation.h"
 #include "../RHI/RHI_VertexBuffer.h"
+#include "../RHI/RHI_IndexBuffer.h"
 #include "../RHI/RHI_PipelineState.h"
 #include "../RHI/RHI_Texture.h"
 #include "../RHI/RHI_SwapChain.h"
+#include "../RHI/RHI_Vertex.h"
 #include "../Runtime/ECS/Entity.h"
 #include "../Runtime/ECS/Components/Camera.h"
 #include "../Runtime/ECS/Components/Transform.h"
 #include "../Runtime/ECS/Components/Renderable.h"
+#include "../Threading/Threading.h"
 
 namespace Amethyst
 {
+	static constexpr uint32_t g_DrawsPerSecondaryCommandList = 256; // Fewer, and recording is quicker than handing it out.
+
+	// Batches are drawn in the order given. The queue is sorted by state before depth, so buffers are only rebound when the model changes.
+	// Instance offsets are relative to the frame's region of the instance buffer, which starts at instanceBase.
+	static void DrawInstanceBatches(RHI_CommandList* commandList, const Renderer_InstanceBatch* begin, const Renderer_InstanceBatch* end, const uint32_t instanceBase)
+	{
+		const Model* modelBound = nullptr;
+
+		for (const Renderer_InstanceBatch* instanceBatch = begin; instanceBatch != end; instanceBatch++)
+		{
+			Renderable* renderable = instanceBatch->m_Entity->RetrieveRenderable();
+			const Model* model = renderable->RetrieveGeometryModel();
+			if (!model || !model->RetrieveVertexBuffer() || !model->RetrieveIndexBuffer())
+			{
+				continue;
+			}
+
+			// Geometry which is still being uploaded shows up once it's resident, instead of the frame waiting for it.
+			if (!model->RetrieveVertexBuffer()->IsResident() || !model->RetrieveIndexBuffer()->IsResident())
+			{
+				continue;
+			}
+
+			if (model != modelBound)
+			{
+				commandList->SetBufferIndex(model->RetrieveIndexBuffer());
+				commandList->SetBufferVertex(model->RetrieveVertexBuffer());
+				modelBound = model;
+			}
+
+			/// Material - Texture indices into the bindless arrays go into BufferInstance next to the transform, so that nothing is set per draw (which secondaries can't do anyway).
+
+			commandList->DrawIndexed(renderable->RetrieveGeometryIndexCount(), renderable->RetrieveGeometryIndexOffset(), renderable->RetrieveGeometryVertexOffset(), instanceBatch->m_InstanceCount, instanceBase + instanceBatch->m_InstanceOffset);
+		}
+	}
+
 	void Renderer::SetGlobalSamplersAndConstantBuffers(RHI_CommandList* commandList) const
 	{
 		// Constant Buffers
-		commandList->SetConstantBuffer(0, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferFrame_GPU);
+		commandList->SetConstantBuffer(0, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferFrame_GPU->RetrieveBuffer());
 		/// Material Constant Buffer
-		commandList->SetConstantBuffer(2, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferUber_GPU);
+		commandList->SetConstantBuffer(2, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_BufferUber_GPU->RetrieveBuffer());
 		/// Light Constant Buffer
 
 		// Samplers
@@ -34,6 +73,8 @@ namespace Amethyst
 
 	void Renderer::Pass_Main(RHI_CommandList* commandList)
 	{
+		AMETHYST_PROFILE_FUNCTION();
+
 		// Validate Command List.
 		AMETHYST_ASSERT(commandList != nullptr);
 		AMETHYST_ASSERT(commandList->RetrieveCommandListState() == RHI_CommandListState::Recording);
@@ -41,25 +82,17 @@ namespace Amethyst
 		// Update frame constant buffer.
 		Pass_UpdateFrameBuffer(commandList);
 
+		// Every instance transform for the frame, uploaded once for all passes. Each command list writes its own region, so nothing the GPU is still reading is overwritten.
+		UpdateInstanceBuffer(commandList);
+
 		/// Generate BRDF LUT.
 
 		/// Transparency Stuff
 
 		/// Depth/Lighting Stuff
 
-		// Acquire Render Targets
-		RHI_Texture* renderTarget1 = RENDER_TARGET(Renderer_RenderTargetType::Frame).get();
-		RHI_Texture* renderTarget2 = RENDER_TARGET(Renderer_RenderTargetType::Frame_2).get();
-
-		// G-Buffer & Lighting
-		{
-			// G-Buffer
-			Pass_GBuffer(commandList);
-
-			/// Passes that rely on the G-Buffer.
-			/// Lighting
-			/// Transparent Objects Stuff
-		}
+		// G-Buffer & Lighting - Passes are added in RenderGraphBuild, which decides which of them run and the barriers between them.
+		m_RenderGraph.Execute(commandList);
 
 		/// Pass for Post Processing
 		Pass_PostProcess(commandList);
@@ -67,12 +100,10 @@ namespace Amethyst
 
 	void Renderer::Pass_UpdateFrameBuffer(RHI_CommandList* commandList)
 	{
-		// Set Render State
-		static RHI_PipelineState pipelineStateObject;
-		pipelineStateObject.m_PassName = "Pass_UpdateFrameBuffer";
+		AMETHYST_PROFILE_FUNCTION();
 
 		// Draw
-		if (commandList->BeginRenderPass(pipelineStateObject))
+		if (commandList->BeginRenderPass(m_PipelineState_UpdateFrameBuffer))
 		{
 			UpdateFrameBuffer(commandList);
 			commandList->EndRenderPass();
@@ -81,22 +112,60 @@ namespace Amethyst
 
 	void Renderer::Pass_GBuffer(RHI_CommandList* commandList, const bool isTransparentPass /*= false*/)
 	{
-		// Acquire required resources/shaders.
-		RHI_Texture* textureAlbedo   = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Albedo).get();
-		RHI_Texture* textureNormal   = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Normal).get();
-		RHI_Texture* textureMaterial = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Material).get();
-		RHI_Texture* textureVelocity = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Velocity).get();
-		RHI_Texture* textureDepth    = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Depth).get();
+		AMETHYST_PROFILE_FUNCTION();
 
+		const std::vector<Renderer_InstanceBatch>& instanceBatches = m_InstanceBatches[isTransparentPass ? Renderer_ObjectType::Renderer_Object_Transparent : Renderer_ObjectType::Renderer_Object_Opaque];
+		if (instanceBatches.empty())
+		{
+			return;
+		}
+
+		// Set Render State - Filled in by PipelineStatesBuild. A state which failed to build then (such as from shaders still compiling) is tried again.
+		RHI_PipelineState& pipelineState = m_PipelineStates_GBuffer[isTransparentPass ? 1 : 0];
+		if (!pipelineState.IsBuilt())
+		{
+			pipelineState.Build();
+		}
+
+		// Draw
+		if (commandList->BeginRenderPass(pipelineState))
+		{
+			// Draws pick their transforms out of the instance buffer through their first instance.
+			commandList->SetStructuredBuffer(static_cast<uint32_t>(RendererBindingsSRV::Instances), RHI_Shader_Vertex, m_BufferInstances_GPUCurrent);
+			const uint32_t instanceBase = m_BufferInstances_Base;
+
+			// Large scenes are split into contiguous runs of batches, each recorded on its own thread and executed in order, so the result is the same as recording inline.
+			Threading* threading = m_EngineContext->RetrieveSubsystem<Threading>();
+			const uint32_t batchCount = static_cast<uint32_t>(instanceBatches.size());
+			const uint32_t secondaryCount = Math::Utilities::Min(batchCount / g_DrawsPerSecondaryCommandList, threading->RetrieveThreadCount() + 1);
+
+			if (secondaryCount > 1 && commandList->BeginSecondaryCommandLists(secondaryCount))
+			{
+				threading->AddTaskForEach([commandList, &instanceBatches, batchCount, secondaryCount, instanceBase](const uint32_t index)
+				{
+					const uint32_t start = static_cast<uint32_t>((static_cast<uint64_t>(batchCount) * index) / secondaryCount);
+					const uint32_t end = static_cast<uint32_t>((static_cast<uint64_t>(batchCount) * (index + 1)) / secondaryCount);
+					DrawInstanceBatches(commandList->RetrieveSecondaryCommandList(index), instanceBatches.data() + start, instanceBatches.data() + end, instanceBase);
+				}, secondaryCount);
+
+				commandList->ExecuteSecondaryCommandLists();
+			}
+			else
+			{
+				DrawInstanceBatches(commandList, instanceBatches.data(), instanceBatches.data() + batchCount, instanceBase);
+			}
+
+			commandList->EndRenderPass();
+		}
 	}
 
 	void Renderer::Pass_PostProcess(RHI_CommandList* commandList)
 	{
-
+		AMETHYST_PROFILE_FUNCTION();
 	}
 
 	void Renderer::Pass_Lines(RHI_CommandList* commandList, RHI_Texture* textureOut)
 	{
-
+		AMETHYST_PROFILE_FUNCTION();
 	}
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../RHI/RHI_Sampler.h"
 #include "../RHI/RHI_BlendState.h"
 #include "../RHI/RHI_ConstantBuffer.h"
+#include "../RHI/RHI_StructuredBuffer.h"
 #include "../RHI/RHI_RasterizerState.h"
 #include "../RHI/RHI_DepthStencilState.h"
 #include "../RHI/RHI_SwapChain.h"
@@ -14,20 +15,27 @@ namespace Amethyst
 {
 	void Renderer::CreateConstantBuffers()
 	{
-		bool isDynamicConstantBuffer = true;
+		// Starting capacities per frame. They grow to fit the scene from the frames' high water marks.
 
 		// Frame
-		m_BufferFrame_GPU = std::make_shared<RHI_ConstantBuffer>(m_RHI_Device, "Frame", isDynamicConstantBuffer);
-		m_BufferFrame_GPU->Create<BufferFrame>(m_SwapChainBufferCount);
+		m_BufferFrame_GPU = std::make_unique<ConstantAllocator<BufferFrame>>(m_RHI_Device, "Frame", m_SwapChainBufferCount, 4);
 
 		/// Material GPU
 
-		m_BufferUber_GPU = std::make_shared<RHI_ConstantBuffer>(m_RHI_Device, "Uber", isDynamicConstantBuffer);
-		m_BufferUber_GPU->Create<BufferUber>(64);
+		m_BufferUber_GPU = std::make_unique<ConstantAllocator<BufferUber>>(m_RHI_Device, "Uber", m_SwapChainBufferCount, 64);
 
 		/// Light GPU
 	}
 
+	void Renderer::CreateStructuredBuffers()
+	{
+		// Instances - A region for every command list, which grows with the scene.
+		m_BufferInstances_GPU = std::make_shared<RHI_StructuredBuffer>(m_RHI_Device, "Instances");
+		m_BufferInstances_Capacity = 1024;
+		m_BufferInstances_GPU->Create<BufferInstance>(m_BufferInstances_Capacity * m_SwapChainBufferCount);
+		m_BufferInstances_GPUCurrent = m_BufferInstances_GPU.get();
+	}
+
 	void Renderer::CreateDepthStencilStates()
 	{
 		m_DepthStencil_Off_Off		   = std::make_shared<RHI_DepthStencilState>(m_RHI_Device, false, false, RHI_Comparison_Function::RHI_Comparison_Never, false, false, RHI_Comparison_Function::RHI_Comparison_Never); // No Depth or Stencil 
@@ -69,10 +77,6 @@ namespace Amethyst
 	
 	void Renderer::CreateRenderTextures(const bool createRenderResolutions, const bool createOutputResolutions, const bool createFixedResolutions, const bool createDynamicResolutions)
 	{
-		// Retrieve Render Resolution
-		uint32_t renderWidth = static_cast<uint32_t>(m_ResolutionRender.m_X);
-		uint32_t renderHeight = static_cast<uint32_t>(m_ResolutionRender.m_Y);
-
 		// Retrieve Output Resolution
 		uint32_t outputWidth = static_cast<uint32_t>(m_ResolutionOutput.m_X);
 		uint32_t outputHeight = static_cast<uint32_t>(m_ResolutionOutput.m_Y);
@@ -80,21 +84,10 @@ namespace Amethyst
 		// Ensure none of the textures is being used by the GPU.
 		FlushRenderer();
 
-		// Render Resolution
+		// Render Resolution - Owned by the render graph, which is rebuilt before the next frame.
 		if (createRenderResolutions)
 		{
-			// Full Resolution
-			RENDER_TARGET(Renderer_RenderTargetType::Frame) =            std::make_unique<RHI_Texture2D>(m_EngineContext, renderWidth, renderHeight, RHI_Format_R16G16B16A16_Float,   1, 0,								    "RenderTarget_Frame");
-			RENDER_TARGET(Renderer_RenderTargetType::Frame_2) =          std::make_unique<RHI_Texture2D>(m_EngineContext, renderWidth, renderHeight, RHI_Format_R16G16B16A16_Float,   1, 0,								    "RenderTarget_Frame2");
-			RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Albedo) =   std::make_shared<RHI_Texture2D>(m_EngineContext, renderWidth, renderHeight, RHI_Format_R8G8B8A8_Unorm,		  1, 0,								    "RenderTarget_GBuffer_Albedo");
-			RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Normal) =   std::make_shared<RHI_Texture2D>(m_EngineContext, renderWidth, renderHeight, RHI_Format_R16G16B16A16_Float,   1, 0,								    "RenderTarget_GBuffer_Normal");
-			RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Material) = std::make_shared<RHI_Texture2D>(m_EngineContext, renderWidth, renderHeight, RHI_Format_R8G8B8A8_Unorm,		  1, 0,								    "RenderTarget_GBuffer_Material");
-			RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Velocity) = std::make_shared<RHI_Texture2D>(m_EngineContext, renderWidth, renderHeight, RHI_Format_R16G16_Float,		  1, 0,									"RenderTarget_GBuffer_Velocity");
-			RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Depth) =    std::make_shared<RHI_Texture2D>(m_EngineContext, renderWidth, renderHeight, RHI_Format_D32_Float_S8X24_Uint, 1, RHI_Texture_DepthStencilReadOnly,  "RenderTarget_GBuffer_Depth");
-		
-			/// Half Resolution
-
-			/// Bloom
+			m_IsRenderGraphDirty = true;
 		}
 
 		// Output Resolution
@@ -109,6 +102,129 @@ namespace Amethyst
 		/// Dynamic Resolution (TAA)
 	}
 
+	void Renderer::RenderGraphBuild()
+	{
+		AMETHYST_PROFILE_FUNCTION();
+
+		// Retrieve Render Resolution
+		const uint32_t renderWidth = static_cast<uint32_t>(m_ResolutionRender.m_X);
+		const uint32_t renderHeight = static_cast<uint32_t>(m_ResolutionRender.m_Y);
+
+		// Let go of the previous build's textures. The graph holds on to them, so they are reused if nothing about them changed.
+		m_RenderGraphTextures.fill(g_RenderGraph_InvalidHandle);
+		for (const Renderer_RenderTargetType renderTarget : { Renderer_RenderTargetType::Frame, Renderer_RenderTargetType::Frame_2, Renderer_RenderTargetType::GBuffer_Albedo, Renderer_RenderTargetType::GBuffer_Normal, Renderer_RenderTargetType::GBuffer_Material, Renderer_RenderTargetType::GBuffer_Velocity, Renderer_RenderTargetType::GBuffer_Depth })
+		{
+			RENDER_TARGET(renderTarget) = nullptr;
+		}
+
+		m_RenderGraph.Reset();
+
+		// Full Resolution
+		auto createTexture = [this, renderWidth, renderHeight](const Renderer_RenderTargetType renderTarget, const RHI_Format format, const uint16_t flags, const char* name)
+		{
+			m_RenderGraphTextures[static_cast<uint8_t>(renderTarget)] = m_RenderGraph.CreateTexture({ renderWidth, renderHeight, format, 1, flags, name });
+			return m_RenderGraphTextures[static_cast<uint8_t>(renderTarget)];
+		};
+
+		createTexture(Renderer_RenderTargetType::Frame,   RHI_Format_R16G16B16A16_Float, 0, "RenderTarget_Frame");
+		createTexture(Renderer_RenderTargetType::Frame_2, RHI_Format_R16G16B16A16_Float, 0, "RenderTarget_Frame2");
+		const RenderGraph_ResourceHandle gBufferAlbedo   = createTexture(Renderer_RenderTargetType::GBuffer_Albedo,   RHI_Format_R8G8B8A8_Unorm,	   0,								 "RenderTarget_GBuffer_Albedo");
+		const RenderGraph_ResourceHandle gBufferNormal   = createTexture(Renderer_RenderTargetType::GBuffer_Normal,   RHI_Format_R16G16B16A16_Float,   0,								 "RenderTarget_GBuffer_Normal");
+		const RenderGraph_ResourceHandle gBufferMaterial = createTexture(Renderer_RenderTargetType::GBuffer_Material, RHI_Format_R8G8B8A8_Unorm,	   0,								 "RenderTarget_GBuffer_Material");
+		const RenderGraph_ResourceHandle gBufferVelocity = createTexture(Renderer_RenderTargetType::GBuffer_Velocity, RHI_Format_R16G16_Float,		   0,								 "RenderTarget_GBuffer_Velocity");
+		const RenderGraph_ResourceHandle gBufferDepth    = createTexture(Renderer_RenderTargetType::GBuffer_Depth,    RHI_Format_D32_Float_S8X24_Uint, RHI_Texture_DepthStencilReadOnly, "RenderTarget_GBuffer_Depth");
+
+		/// Half Resolution
+
+		/// Bloom
+
+		// G-Buffer
+		RenderGraph_Pass& passGBuffer = m_RenderGraph.AddPass("Pass_GBuffer");
+		passGBuffer.Write(gBufferAlbedo);
+		passGBuffer.Write(gBufferNormal);
+		passGBuffer.Write(gBufferMaterial);
+		passGBuffer.Write(gBufferVelocity);
+		passGBuffer.Write(gBufferDepth, RHI_Image_Layout::Depth_Stencil_Attachment_Optimal);
+		passGBuffer.SetExecute([this](RHI_CommandList* commandList) { Pass_GBuffer(commandList); });
+
+		/// Passes that rely on the G-Buffer.
+		/// Lighting
+		/// Transparent Objects Stuff
+
+		// Whatever is being debugged is read after the graph is done with it.
+		if (m_RenderTargetDebug != Renderer_RenderTargetType::Undefined && m_RenderGraphTextures[static_cast<uint8_t>(m_RenderTargetDebug)] != g_RenderGraph_InvalidHandle)
+		{
+			m_RenderGraph.MarkOutput(m_RenderGraphTextures[static_cast<uint8_t>(m_RenderTargetDebug)]);
+		}
+
+		// Realize waits for the GPU itself, should any of the textures have to be created again.
+		if (!m_RenderGraph.Compile() || !m_RenderGraph.Realize(m_EngineContext, m_RHI_Device))
+		{
+			AMETHYST_ERROR("Failed to build the render graph.");
+			return;
+		}
+
+		// Textures which weren't culled. The rest stay null.
+		for (uint32_t i = 0; i < m_RenderGraphTextures.size(); i++)
+		{
+			if (m_RenderGraphTextures[i] != g_RenderGraph_InvalidHandle)
+			{
+				m_RenderTargets[i] = m_RenderGraph.RetrieveTransientTexture(m_RenderGraphTextures[i]);
+			}
+		}
+
+		const RenderGraph_Statistics& statistics = m_RenderGraph.RetrieveStatistics();
+		AMETHYST_INFO("Render graph built with %u of %u passes, %u transient textures in %u aliased allocations (%llu MB instead of %llu MB).", statistics.m_PassCount - statistics.m_CulledPassCount, statistics.m_PassCount, statistics.m_TransientTextureCount, statistics.m_AliasedMemoryCount, statistics.m_AliasedBytes / (1024 * 1024), statistics.m_TransientBytes / (1024 * 1024));
+
+		PipelineStatesBuild();
+
+		m_IsRenderGraphDirty = false;
+	}
+
+	void Renderer::PipelineStatesBuild()
+	{
+		// Update Frame Buffer
+		m_PipelineState_UpdateFrameBuffer.m_PassName = "Pass_UpdateFrameBuffer";
+		m_PipelineState_UpdateFrameBuffer.Build();
+
+		// G-Buffer - Culled along with its render targets when nothing reads them.
+		RHI_Texture* textureAlbedo   = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Albedo).get();
+		RHI_Texture* textureNormal   = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Normal).get();
+		RHI_Texture* textureMaterial = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Material).get();
+		RHI_Texture* textureVelocity = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Velocity).get();
+		RHI_Texture* textureDepth    = RENDER_TARGET(Renderer_RenderTargetType::GBuffer_Depth).get();
+
+		if (!textureAlbedo || !textureNormal || !textureMaterial || !textureVelocity || !textureDepth)
+		{
+			return;
+		}
+
+		for (const bool isTransparentPass : { false, true })
+		{
+			RHI_PipelineState& pipelineState = m_PipelineStates_GBuffer[isTransparentPass ? 1 : 0];
+			pipelineState.m_PassName = isTransparentPass ? "Pass_GBuffer_Transparent" : "Pass_GBuffer";
+			/// Vertex & Pixel Shaders
+			pipelineState.m_BlendState = isTransparentPass ? m_Blend_Alpha.get() : m_Blend_Disabled.get();
+			pipelineState.m_RasterizerState = m_Rasterizer_CullBackSolid.get();
+			pipelineState.m_DepthStencilState = isTransparentPass ? m_DepthStencil_Read_Off.get() : m_DepthStencil_ReadWrite_Off.get();
+			pipelineState.m_RenderTargetColorTextures[0] = textureAlbedo;
+			pipelineState.m_RenderTargetColorTextures[1] = textureNormal;
+			pipelineState.m_RenderTargetColorTextures[2] = textureMaterial;
+			pipelineState.m_RenderTargetColorTextures[3] = textureVelocity;
+			pipelineState.m_RenderTargetDepthTexture = textureDepth;
+			pipelineState.m_Viewport = textureAlbedo->RetrieveViewport();
+			pipelineState.m_VertexBufferStride = static_cast<uint32_t>(sizeof(RHI_Vertex_PositionTextureNormalTangent));
+			pipelineState.m_PrimitiveTopology = RHI_PrimitiveTopology_Mode::RHI_PrimitiveTopology_TriangleList;
+
+			// Transparent objects are drawn over what the opaque pass left behind.
+			const Math::Vector4 clearColor = isTransparentPass ? g_RHI_ColorLoadValue : Math::Vector4::Zero;
+			pipelineState.m_ClearValuesColor = { clearColor, clearColor, clearColor, clearColor, g_RHI_ColorLoadValue, g_RHI_ColorLoadValue, g_RHI_ColorLoadValue, g_RHI_ColorLoadValue };
+			pipelineState.m_ClearValueDepth = isTransparentPass ? g_RHI_DepthLoadValue : RetrieveClearDepth();
+
+			pipelineState.Build();
+		}
+	}
+
 	void Renderer::CreateShaders()
 	{
 		// Compile asynchronously?
@@ -128,5 +244,16 @@ namespace Amethyst
 	void Renderer::CreateDefaultTextures()
 	{
 		/// Retrieve Standard Texture Directory. We upload our default textures here.
+
+		// Stand-ins for textures which are missing or not resident yet (see RHI_CommandList::SetTexture). A single texel each, so there is nothing to import.
+		const auto createTexel = [this](const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t alpha)
+		{
+			const std::vector<std::byte> texel = { std::byte(red), std::byte(green), std::byte(blue), std::byte(alpha) };
+			return std::make_shared<RHI_Texture2D>(m_EngineContext, 1, 1, RHI_Format_R8G8B8A8_Unorm, texel);
+		};
+
+		m_Texture_DefaultWhite		 = createTexel(255, 255, 255, 255);
+		m_Texture_DefaultBlack		 = createTexel(0, 0, 0, 255);
+		m_Texture_DefaultTransparent = createTexel(0, 0, 0, 0);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "IResource.h"
 #include "ISubsystem.h"
+#include "../Profiling/TimeBlock.h"
 #include <thread>
 #include <string>
 #include <vector>
@@ -131,6 +132,8 @@ namespace Amethyst
 		template<typename T>
 		std::shared_ptr<T> LoadResource(const std::string& resourcePath)
 		{
+			AMETHYST_PROFILE_SCOPE("ResourceCache::LoadResource");
+
 			if (!FileSystem::Exists(resourcePath))
 			{
 				AMETHYST_ERROR("The resource at \"%s\" does not exist.", resourcePath.c_str());
@@ -84,6 +84,7 @@ namespace Amethyst
 		void SetClearColor(const Math::Vector4& color) { m_ClearColor = color; }
 		bool IsInViewFrustrum(Renderable* renderable) const;
 		bool IsInViewFrustrum(const Math::Vector3& center, const Math::Vector3& extents) const;
+		const Math::Frustum& RetrieveFrustum() const { return m_Frustrum; }
 		/// bool RetrieveFPSControlEnabled() const { return m_FPS_ControlEnabled; }
 		/// void SetFPSControlEnabled(const bool isEnabled) { m_FPS_ControlEnabled = isEnabled; }
 		/// bool IsFPSControlled() const { return m_FPS_ControlAssumed; }
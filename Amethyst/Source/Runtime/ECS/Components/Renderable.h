@@ -74,6 +74,10 @@ namespace Amethyst
 		/// Properties
 		/// Cast Shadows
 
+		// Occluders are rasterized on the CPU to hide whatever is behind them. Best kept to large, solid and simple geometry such as walls and terrain.
+		void SetOccluder(const bool isOccluder) { m_IsOccluder = isOccluder; }
+		bool IsOccluder() const { return m_IsOccluder; }
+
 	private:
 		std::string m_GeometryName;
 		uint32_t m_GeometryIndexOffset;
@@ -86,6 +90,7 @@ namespace Amethyst
 		Math::BoundingBox m_AABB;
 		Math::Matrix m_LastTransform = Math::Matrix::Identity;
 		
+		bool m_IsOccluder = false;
 		/// bool m_IsShadowCasting = true;
 		/// bool m_IsDefaultMaterial;
 
@@ -24,7 +24,12 @@ namespace Amethyst
 	bool World::OnInitialize()
 	{
 		m_Input = m_EngineContext->RetrieveSubsystem<Input>();
-		/// Retrieve Profiler from Engine Context.
+
+		// Headless runs populate the world themselves.
+		if (m_EngineContext->m_Engine->EngineMode_IsToggled(EngineMode::Engine_Headless))
+		{
+			return true;
+		}
 
 		//Create our default entities.
 		CreateCamera();
@@ -42,6 +47,8 @@ namespace Amethyst
 
 	void World::OnUpdate(float deltaTime)
 	{
+		AMETHYST_PROFILE_FUNCTION();
+
 		//If something is being loaded, don't tick as entities are probably being added at the moment.
 		if (IsWorldLoading())
 		{
@@ -50,6 +57,8 @@ namespace Amethyst
 
 		// Tick Entities
 		{
+			AMETHYST_PROFILE_SCOPE("World::TickEntities");
+
 			// Detect mode toggling between editor and play modes.
 			const bool isPlayModeActivated = m_EngineContext->m_Engine->EngineMode_IsToggled(EngineMode::Engine_Game) && m_WasInEditorMode;
 			const bool isPlayModeStopped = !m_EngineContext->m_Engine->EngineMode_IsToggled(EngineMode::Engine_Game) && !m_WasInEditorMode;
@@ -83,6 +92,8 @@ namespace Amethyst
 		// Resolve World
 		if (m_ResolveWorld) // If our world should be resolved...
 		{
+			AMETHYST_PROFILE_SCOPE("World::Resolve");
+
 			// Update "dirty" entities.
 			{
 				// Make a copy so we can still iterate while removing entities.
@@ -112,7 +123,10 @@ namespace Amethyst
 	{
 		// Notify any systems that entities are about to be cleared.
 		FIRE_EVENT(EventType::WorldClear);
-		m_EngineContext->RetrieveSubsystem<Renderer>()->ClearEntities();
+		if (Renderer* renderer = m_EngineContext->RetrieveSubsystem<Renderer>())
+		{
+			renderer->ClearEntities();
+		}
 		m_EngineContext->RetrieveSubsystem<ResourceCache>()->Reset();
 
 		//Clear the entities.
@@ -48,7 +48,6 @@ namespace Amethyst
 		std::string m_WorldName;
 		bool m_WasInEditorMode = false;
 		bool m_ResolveWorld = true;
-		/// Profiler Pointer.
 		Input* m_Input = nullptr;
 
 		std::vector<std::shared_ptr<Entity>> m_Entities;
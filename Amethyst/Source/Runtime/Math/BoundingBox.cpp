@@ -3,6 +3,9 @@
 
 namespace Amethyst::Math
 {
+	// The batch kernels read boxes as 6 tightly packed floats.
+	static_assert(sizeof(BoundingBox) == sizeof(float) * 6, "BoundingBox is expected to be six tightly packed floats.");
+
 	const BoundingBox BoundingBox::Zero(Vector3::Zero, Vector3::Zero);
 
 	BoundingBox::BoundingBox()
@@ -19,36 +22,12 @@ namespace Amethyst::Math
 
 	BoundingBox::BoundingBox(const Vector3* vertices, const uint32_t point_count)
 	{
-		m_Minimum = Vector3::Infinity;
-		m_Maximum = Vector3::InfinityNegative;
-
-		for (uint32_t i = 0; i < point_count; i++)
-		{
-			m_Maximum.m_X = Utilities::Max(m_Maximum.m_X, vertices[i].m_X);
-			m_Maximum.m_Y = Utilities::Max(m_Maximum.m_Y, vertices[i].m_Y);
-			m_Maximum.m_Z = Utilities::Max(m_Maximum.m_Z, vertices[i].m_Z);
-						  		   
-			m_Minimum.m_X = Utilities::Min(m_Minimum.m_X, vertices[i].m_X);
-			m_Minimum.m_Y = Utilities::Min(m_Minimum.m_Y, vertices[i].m_Y);
-			m_Minimum.m_Z = Utilities::Min(m_Minimum.m_Z, vertices[i].m_Z);
-		}
+		SIMD::RetrieveKernels().m_BoundingBoxFromPointsBatch(&vertices[0].m_X, sizeof(Vector3), point_count, &m_Minimum.m_X);
 	}
 
 	BoundingBox::BoundingBox(const RHI_Vertex_PositionTextureNormalTangent* vertices, const uint32_t vertexCount)
 	{
-		m_Minimum = Vector3::Infinity;
-		m_Maximum = Vector3::InfinityNegative;
-
-		for (uint32_t i = 0; i < vertexCount; i++)
-		{
-			m_Maximum.m_X = Utilities::Max(m_Maximum.m_X, vertices[i].m_Position[0]);
-			m_Maximum.m_Y = Utilities::Max(m_Maximum.m_Y, vertices[i].m_Position[1]);
-			m_Maximum.m_Z = Utilities::Max(m_Maximum.m_Z, vertices[i].m_Position[2]);
-
-			m_Minimum.m_X = Utilities::Min(m_Minimum.m_X, vertices[i].m_Position[0]);
-			m_Minimum.m_Y = Utilities::Min(m_Minimum.m_Y, vertices[i].m_Position[1]);
-			m_Minimum.m_Z = Utilities::Min(m_Minimum.m_Z, vertices[i].m_Position[2]);
-		}
+		SIMD::RetrieveKernels().m_BoundingBoxFromPointsBatch(vertices[0].m_Position, sizeof(RHI_Vertex_PositionTextureNormalTangent), vertexCount, &m_Minimum.m_X);
 	}
 
 	Intersection BoundingBox::IsInside(const Vector3& point) const
@@ -89,18 +68,18 @@ namespace Amethyst::Math
 		}
 	}
 
+	// Arvo's method - the center is transformed as a point and the extents through the absolute value of the rotation and scale part.
 	BoundingBox BoundingBox::Transform(const Matrix& transform) const
 	{
-		const Vector3 center_new = transform * RetrieveCenter();
-		const Vector3 extent_old = RetrieveExtents();
-		const Vector3 extend_new = Vector3
-		(
-			Utilities::Absolute(transform.m00) * extent_old.m_X + Utilities::Absolute(transform.m10) * extent_old.m_Y + Utilities::Absolute(transform.m20) * extent_old.m_Z,
-			Utilities::Absolute(transform.m01) * extent_old.m_X + Utilities::Absolute(transform.m11) * extent_old.m_Y + Utilities::Absolute(transform.m21) * extent_old.m_Z,
-			Utilities::Absolute(transform.m02) * extent_old.m_X + Utilities::Absolute(transform.m12) * extent_old.m_Y + Utilities::Absolute(transform.m22) * extent_old.m_Z
-		);
+		BoundingBox result;
+		SIMD::BoundingBoxTransform(transform.Data(), &m_Minimum.m_X, &result.m_Minimum.m_X);
+
+		return result;
+	}
 
-		return BoundingBox(center_new - extend_new, center_new + extend_new);
+	void BoundingBox::Transform(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* resultBoxes, const uint32_t count)
+	{
+		SIMD::RetrieveKernels().m_BoundingBoxTransformBatch(transforms[0].Data(), &boxes[0].m_Minimum.m_X, &resultBoxes[0].m_Minimum.m_X, count);
 	}
 
 	void BoundingBox::Merge(const BoundingBox& box)
@@ -109,7 +88,15 @@ namespace Amethyst::Math
 		m_Minimum.m_Y = Utilities::Min(m_Minimum.m_Y, box.m_Minimum.m_Y);
 		m_Minimum.m_Z = Utilities::Min(m_Minimum.m_Z, box.m_Minimum.m_Z);
 		m_Maximum.m_X = Utilities::Max(m_Maximum.m_X, box.m_Maximum.m_X);
-		m_Maximum.m_Y = Utilities::Max(m_Maximum.m_X, box.m_Maximum.m_X);
-		m_Maximum.m_Z = Utilities::Max(m_Maximum.m_X, box.m_Maximum.m_X);
+		m_Maximum.m_Y = Utilities::Max(m_Maximum.m_Y, box.m_Maximum.m_Y);
+		m_Maximum.m_Z = Utilities::Max(m_Maximum.m_Z, box.m_Maximum.m_Z);
+	}
+
+	BoundingBox BoundingBox::Merge(const BoundingBox* boxes, const uint32_t count)
+	{
+		BoundingBox result;
+		SIMD::RetrieveKernels().m_BoundingBoxMergeBatch(&boxes[0].m_Minimum.m_X, count, &result.m_Minimum.m_X);
+
+		return result;
 	}
 }
\ No newline at end of file
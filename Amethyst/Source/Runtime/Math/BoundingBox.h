@@ -49,9 +49,15 @@ namespace Amethyst
 			// Returns a transformed bounding box.
 			BoundingBox Transform(const Matrix& transform) const;
 
+			// Transforms each box by the matrix at the same index, through the active SIMD kernels.
+			static void Transform(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* resultBoxes, const uint32_t count);
+
 			// Merge with another bounding box.
 			void Merge(const BoundingBox& box);
 
+			// Returns the box enclosing every box in the array. Large arrays can be split across workers and the partial results merged again.
+			static BoundingBox Merge(const BoundingBox* boxes, const uint32_t count);
+
 			const Vector3& RetrieveMinimum() const { return m_Minimum; }
 			const Vector3& RetrieveMaximum() const { return m_Maximum; }
 
@@ -3,6 +3,9 @@
 
 namespace Amethyst::Math
 {
+    // The batch kernels read the planes as 6 x (normal x, y, z, distance).
+    static_assert(sizeof(Plane) == sizeof(float) * 4, "Plane is expected to be four tightly packed floats.");
+
     Frustum::Frustum(const Matrix& view, const Matrix& projection, float screen_depth)
     {
         // Calculate the minimum m_Z distance in the frustum.
@@ -114,4 +117,45 @@ namespace Amethyst::Math
 
         return result;
     }
+
+    void Frustum::CullBoxes(const float* centersX, const float* centersY, const float* centersZ, const float* extentsX, const float* extentsY, const float* extentsZ, uint32_t* visibilityMasks, const uint32_t count) const
+    {
+        SIMD::RetrieveKernels().m_FrustumCullBoxesBatch(&m_Planes[0].m_Normal.m_X, centersX, centersY, centersZ, extentsX, extentsY, extentsZ, visibilityMasks, count);
+    }
+
+    void Frustum::CullSpheres(const float* centersX, const float* centersY, const float* centersZ, const float* radii, uint32_t* visibilityMasks, const uint32_t count) const
+    {
+        SIMD::RetrieveKernels().m_FrustumCullSpheresBatch(&m_Planes[0].m_Normal.m_X, centersX, centersY, centersZ, radii, visibilityMasks, count);
+    }
+
+    Intersection Frustum::CheckBox(const Vector3& center, const Vector3& extent, uint8_t& planeMask, uint8_t& planeHint) const
+    {
+        for (uint8_t i = 0; i < 6; i++)
+        {
+            const uint8_t planeIndex = (planeHint + i) % 6;
+            const uint8_t planeBit = 1 << planeIndex;
+            if (!(planeMask & planeBit))
+            {
+                continue;
+            }
+
+            const Plane& plane = m_Planes[planeIndex];
+            const float distance = center.m_X * plane.m_Normal.m_X + center.m_Y * plane.m_Normal.m_Y + center.m_Z * plane.m_Normal.m_Z;
+            const float radius = extent.m_X * Utilities::Absolute(plane.m_Normal.m_X) + extent.m_Y * Utilities::Absolute(plane.m_Normal.m_Y) + extent.m_Z * Utilities::Absolute(plane.m_Normal.m_Z);
+
+            if (distance + radius < -plane.m_DistanceFromOrigin)
+            {
+                planeHint = planeIndex;
+                return Outside;
+            }
+
+            // Entirely on the inside of this plane, so nothing contained in this box needs to test against it again.
+            if (distance - radius >= -plane.m_DistanceFromOrigin)
+            {
+                planeMask &= ~planeBit;
+            }
+        }
+
+        return planeMask == 0 ? Inside : Intersects;
+    }
 }
\ No newline at end of file
@@ -14,6 +14,21 @@ namespace Amethyst::Math
 
 		bool IsVisible(const Vector3& center, const Vector3& extent, bool ignoreNearPlane = false) const;
 
+		// Batch culling over structure-of-arrays bounds, through the active SIMD kernels. Bit (i % 32) of visibilityMasks[i / 32] is set when element i
+		// is at least partially inside, so the masks need (count + 31) / 32 words. Splitting a batch across workers on multiples of 32 elements (and
+		// offsetting every pointer to match) keeps each worker on its own words.
+		void CullBoxes(const float* centersX, const float* centersY, const float* centersZ, const float* extentsX, const float* extentsY, const float* extentsZ, uint32_t* visibilityMasks, const uint32_t count) const;
+		void CullSpheres(const float* centersX, const float* centersY, const float* centersZ, const float* radii, uint32_t* visibilityMasks, const uint32_t count) const;
+
+		// For hierarchies. planeMask has a bit per plane still to be tested - start from PlaneMaskAll at the root and hand the updated mask down to children,
+		// as a plane the parent lies fully inside of can't cull anything below it. planeHint remembers the plane that last culled this node and is tested
+		// first next time, since from one frame to the next it is usually the same plane.
+		Intersection CheckBox(const Vector3& center, const Vector3& extent, uint8_t& planeMask, uint8_t& planeHint) const;
+
+		static constexpr uint8_t PlaneMaskAll = 0x3F;
+
+		const Plane* RetrievePlanes() const { return m_Planes; } // Near, far, left, right, top, bottom.
+
 	private:
 		Intersection CheckCube(const Vector3& center, const Vector3& extent) const;
 		/// Check Sphere.
@@ -0,0 +1,858 @@
+#include "Amethyst.h"
+#include "MathSIMD.h"
+#include <cstring>
+
+#if defined(AMETHYST_SIMD_X86)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace Amethyst::Math::SIMD
+{
+	// Scalar - The formulas Matrix.h used before vectorization, written against raw column-major floats.
+	namespace Scalar
+	{
+		void MatrixMultiply(const float* leftMatrix, const float* rightMatrix, float* resultMatrix)
+		{
+			float result[16];
+
+			for (int column = 0; column < 4; column++)
+			{
+				for (int row = 0; row < 4; row++)
+				{
+					result[column * 4 + row] = leftMatrix[row] * rightMatrix[column * 4] + leftMatrix[4 + row] * rightMatrix[column * 4 + 1] +
+											   leftMatrix[8 + row] * rightMatrix[column * 4 + 2] + leftMatrix[12 + row] * rightMatrix[column * 4 + 3];
+				}
+			}
+
+			for (int i = 0; i < 16; i++)
+			{
+				resultMatrix[i] = result[i];
+			}
+		}
+
+		void MatrixInvert(const float* matrix, float* resultMatrix)
+		{
+			const float m00 = matrix[0], m10 = matrix[1], m20 = matrix[2], m30 = matrix[3];
+			const float m01 = matrix[4], m11 = matrix[5], m21 = matrix[6], m31 = matrix[7];
+			const float m02 = matrix[8], m12 = matrix[9], m22 = matrix[10], m32 = matrix[11];
+			const float m03 = matrix[12], m13 = matrix[13], m23 = matrix[14], m33 = matrix[15];
+
+			float v0 = m20 * m31 - m21 * m30;
+			float v1 = m20 * m32 - m22 * m30;
+			float v2 = m20 * m33 - m23 * m30;
+			float v3 = m21 * m32 - m22 * m31;
+			float v4 = m21 * m33 - m23 * m31;
+			float v5 = m22 * m33 - m23 * m32;
+
+			float i00 = (v5 * m11 - v4 * m12 + v3 * m13);
+			float i10 = -(v5 * m10 - v2 * m12 + v1 * m13);
+			float i20 = (v4 * m10 - v2 * m11 + v0 * m13);
+			float i30 = -(v3 * m10 - v1 * m11 + v0 * m12);
+
+			const float invDet = 1.0f / (i00 * m00 + i10 * m01 + i20 * m02 + i30 * m03);
+
+			i00 *= invDet;
+			i10 *= invDet;
+			i20 *= invDet;
+			i30 *= invDet;
+
+			const float i01 = -(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
+			const float i11 = (v5 * m00 - v2 * m02 + v1 * m03) * invDet;
+			const float i21 = -(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
+			const float i31 = (v3 * m00 - v1 * m01 + v0 * m02) * invDet;
+
+			v0 = m10 * m31 - m11 * m30;
+			v1 = m10 * m32 - m12 * m30;
+			v2 = m10 * m33 - m13 * m30;
+			v3 = m11 * m32 - m12 * m31;
+			v4 = m11 * m33 - m13 * m31;
+			v5 = m12 * m33 - m13 * m32;
+
+			const float i02 = (v5 * m01 - v4 * m02 + v3 * m03) * invDet;
+			const float i12 = -(v5 * m00 - v2 * m02 + v1 * m03) * invDet;
+			const float i22 = (v4 * m00 - v2 * m01 + v0 * m03) * invDet;
+			const float i32 = -(v3 * m00 - v1 * m01 + v0 * m02) * invDet;
+
+			v0 = m21 * m10 - m20 * m11;
+			v1 = m22 * m10 - m20 * m12;
+			v2 = m23 * m10 - m20 * m13;
+			v3 = m22 * m11 - m21 * m12;
+			v4 = m23 * m11 - m21 * m13;
+			v5 = m23 * m12 - m22 * m13;
+
+			const float i03 = -(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
+			const float i13 = (v5 * m00 - v2 * m02 + v1 * m03) * invDet;
+			const float i23 = -(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
+			const float i33 = (v3 * m00 - v1 * m01 + v0 * m02) * invDet;
+
+			resultMatrix[0] = i00;  resultMatrix[1] = i10;  resultMatrix[2] = i20;  resultMatrix[3] = i30;
+			resultMatrix[4] = i01;  resultMatrix[5] = i11;  resultMatrix[6] = i21;  resultMatrix[7] = i31;
+			resultMatrix[8] = i02;  resultMatrix[9] = i12;  resultMatrix[10] = i22; resultMatrix[11] = i32;
+			resultMatrix[12] = i03; resultMatrix[13] = i13; resultMatrix[14] = i23; resultMatrix[15] = i33;
+		}
+
+		void MatrixCompose(const float* translation, const float* rotation, const float* scale, float* resultMatrix)
+		{
+			const float num9 = rotation[0] * rotation[0];
+			const float num8 = rotation[1] * rotation[1];
+			const float num7 = rotation[2] * rotation[2];
+			const float num6 = rotation[0] * rotation[1];
+			const float num5 = rotation[2] * rotation[3];
+			const float num4 = rotation[2] * rotation[0];
+			const float num3 = rotation[1] * rotation[3];
+			const float num2 = rotation[1] * rotation[2];
+			const float num = rotation[0] * rotation[3];
+
+			// Column 0
+			resultMatrix[0] = scale[0] * (1.0f - (2.0f * (num8 + num7)));
+			resultMatrix[1] = scale[1] * (2.0f * (num6 - num5));
+			resultMatrix[2] = scale[2] * (2.0f * (num4 + num3));
+			resultMatrix[3] = translation[0];
+
+			// Column 1
+			resultMatrix[4] = scale[0] * (2.0f * (num6 + num5));
+			resultMatrix[5] = scale[1] * (1.0f - (2.0f * (num7 + num9)));
+			resultMatrix[6] = scale[2] * (2.0f * (num2 - num));
+			resultMatrix[7] = translation[1];
+
+			// Column 2
+			resultMatrix[8] = scale[0] * (2.0f * (num4 - num3));
+			resultMatrix[9] = scale[1] * (2.0f * (num2 + num));
+			resultMatrix[10] = scale[2] * (1.0f - (2.0f * (num8 + num9)));
+			resultMatrix[11] = translation[2];
+
+			// Column 3
+			resultMatrix[12] = 0.0f;
+			resultMatrix[13] = 0.0f;
+			resultMatrix[14] = 0.0f;
+			resultMatrix[15] = 1.0f;
+		}
+
+		void MatrixRetrieveScale(const float* matrix, float* scale)
+		{
+			// Row r is spread across the columns at matrix[r], matrix[4 + r], matrix[8 + r] and matrix[12 + r].
+			for (int row = 0; row < 3; row++)
+			{
+				const float m0 = matrix[row], m1 = matrix[4 + row], m2 = matrix[8 + row], m3 = matrix[12 + row];
+				const int isSigned = (Utilities::Sign(m0 * m1 * m2 * m3) < 0) ? -1 : 1;
+
+				scale[row] = static_cast<float>(isSigned) * Utilities::SquareRoot(m0 * m0 + m1 * m1 + m2 * m2);
+			}
+		}
+
+		void MatrixRemoveScale(const float* matrix, const float* scale, float* resultMatrix)
+		{
+			for (int column = 0; column < 3; column++)
+			{
+				resultMatrix[column * 4 + 0] = matrix[column * 4 + 0] / scale[0];
+				resultMatrix[column * 4 + 1] = matrix[column * 4 + 1] / scale[1];
+				resultMatrix[column * 4 + 2] = matrix[column * 4 + 2] / scale[2];
+				resultMatrix[column * 4 + 3] = 0.0f;
+			}
+
+			resultMatrix[12] = 0.0f;
+			resultMatrix[13] = 0.0f;
+			resultMatrix[14] = 0.0f;
+			resultMatrix[15] = 1.0f;
+		}
+
+		void MatrixTransformPoint(const float* matrix, const float* point, float* resultPoint)
+		{
+			const float x = (matrix[0] * point[0]) + (matrix[1] * point[1]) + (matrix[2] * point[2]) + matrix[3];
+			const float y = (matrix[4] * point[0]) + (matrix[5] * point[1]) + (matrix[6] * point[2]) + matrix[7];
+			const float z = (matrix[8] * point[0]) + (matrix[9] * point[1]) + (matrix[10] * point[2]) + matrix[11];
+			const float w = 1 / ((matrix[12] * point[0]) + (matrix[13] * point[1]) + (matrix[14] * point[2]) + matrix[15]);
+
+			resultPoint[0] = x * w;
+			resultPoint[1] = y * w;
+			resultPoint[2] = z * w;
+		}
+
+		void MatrixTransformVector4(const float* matrix, const float* vector, float* resultVector)
+		{
+			float result[4];
+
+			for (int column = 0; column < 4; column++)
+			{
+				result[column] = (matrix[column * 4] * vector[0]) + (matrix[column * 4 + 1] * vector[1]) + (matrix[column * 4 + 2] * vector[2]) + (matrix[column * 4 + 3] * vector[3]);
+			}
+
+			for (int i = 0; i < 4; i++)
+			{
+				resultVector[i] = result[i];
+			}
+		}
+
+		// A box is outside once its nearest corner is behind any one plane.
+		bool FrustumIsBoxVisible(const float* planes, const float centerX, const float centerY, const float centerZ, const float extentX, const float extentY, const float extentZ)
+		{
+			for (int i = 0; i < 6; i++)
+			{
+				const float* plane = planes + i * 4;
+				const float distance = centerX * plane[0] + centerY * plane[1] + centerZ * plane[2];
+				const float radius = extentX * std::fabs(plane[0]) + extentY * std::fabs(plane[1]) + extentZ * std::fabs(plane[2]);
+
+				if (distance + radius < -plane[3])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool FrustumIsSphereVisible(const float* planes, const float centerX, const float centerY, const float centerZ, const float radius)
+		{
+			for (int i = 0; i < 6; i++)
+			{
+				const float* plane = planes + i * 4;
+				const float distance = centerX * plane[0] + centerY * plane[1] + centerZ * plane[2];
+
+				if (distance + radius < -plane[3])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		void BoundingBoxTransform(const float* matrix, const float* box, float* resultBox)
+		{
+			const float center[3] = { (box[3] + box[0]) * 0.5f, (box[4] + box[1]) * 0.5f, (box[5] + box[2]) * 0.5f };
+			const float extent[3] = { (box[3] - box[0]) * 0.5f, (box[4] - box[1]) * 0.5f, (box[5] - box[2]) * 0.5f };
+
+			float centerResult[3];
+			MatrixTransformPoint(matrix, center, centerResult);
+
+			float extentResult[3];
+			for (int i = 0; i < 3; i++)
+			{
+				extentResult[i] = std::fabs(matrix[i * 4]) * extent[0] + std::fabs(matrix[i * 4 + 1]) * extent[1] + std::fabs(matrix[i * 4 + 2]) * extent[2];
+			}
+
+			for (int i = 0; i < 3; i++)
+			{
+				resultBox[i] = centerResult[i] - extentResult[i];
+				resultBox[i + 3] = centerResult[i] + extentResult[i];
+			}
+		}
+
+		void BoundingBoxMerge(const float* boxes, const uint32_t count, float* resultBox)
+		{
+			float result[6] = { INFINITY, INFINITY, INFINITY, -INFINITY, -INFINITY, -INFINITY };
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const float* box = boxes + i * 6;
+				for (int j = 0; j < 3; j++)
+				{
+					result[j] = result[j] < box[j] ? result[j] : box[j];
+					result[j + 3] = result[j + 3] > box[j + 3] ? result[j + 3] : box[j + 3];
+				}
+			}
+
+			for (int i = 0; i < 6; i++)
+			{
+				resultBox[i] = result[i];
+			}
+		}
+
+		void BoundingBoxFromPoints(const float* points, const uint32_t strideInBytes, const uint32_t count, float* resultBox)
+		{
+			float result[6] = { INFINITY, INFINITY, INFINITY, -INFINITY, -INFINITY, -INFINITY };
+
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(points);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const float* point = reinterpret_cast<const float*>(bytes + static_cast<size_t>(i) * strideInBytes);
+				for (int j = 0; j < 3; j++)
+				{
+					result[j] = result[j] < point[j] ? result[j] : point[j];
+					result[j + 3] = result[j + 3] > point[j] ? result[j + 3] : point[j];
+				}
+			}
+
+			for (int i = 0; i < 6; i++)
+			{
+				resultBox[i] = result[i];
+			}
+		}
+	}
+
+	// Batches
+	template<void (*Multiply)(const float*, const float*, float*)>
+	static void MatrixMultiplyBatch(const float* leftMatrices, const float* rightMatrices, float* resultMatrices, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Multiply(leftMatrices + i * 16, rightMatrices + i * 16, resultMatrices + i * 16);
+		}
+	}
+
+	template<void (*Invert)(const float*, float*)>
+	static void MatrixInvertBatch(const float* matrices, float* resultMatrices, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Invert(matrices + i * 16, resultMatrices + i * 16);
+		}
+	}
+
+	template<void (*Compose)(const float*, const float*, const float*, float*)>
+	static void MatrixComposeBatch(const float* translations, const float* rotations, const float* scales, float* resultMatrices, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Compose(translations + i * 3, rotations + i * 4, scales + i * 3, resultMatrices + i * 16);
+		}
+	}
+
+	template<void (*TransformPoint)(const float*, const float*, float*)>
+	static void MatrixTransformPointBatch(const float* matrix, const float* points, float* resultPoints, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			TransformPoint(matrix, points + i * 3, resultPoints + i * 3);
+		}
+	}
+
+	template<void (*Transform)(const float*, const float*, float*)>
+	static void BoundingBoxTransformBatch(const float* matrices, const float* boxes, float* resultBoxes, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Transform(matrices + i * 16, boxes + i * 6, resultBoxes + i * 6);
+		}
+	}
+
+	static void FrustumCullBoxesBatch(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* extentsX, const float* extentsY, const float* extentsZ, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (Scalar::FrustumIsBoxVisible(planes, centersX[i], centersY[i], centersZ[i], extentsX[i], extentsY[i], extentsZ[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	static void FrustumCullSpheresBatch(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* radii, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (Scalar::FrustumIsSphereVisible(planes, centersX[i], centersY[i], centersZ[i], radii[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	/*
+		Four elements per register, with the planes broadcast once up front. The comparison is the same as the scalar one, evaluated in the same order,
+		so the masks are identical. Every plane is tested for every group - with six planes, a branch to skip the rest costs more than it saves.
+		Elements past the last full group go through the scalar test.
+	*/
+#if defined(AMETHYST_SIMD_X86)
+	struct FrustumPlanesSSE2
+	{
+		FrustumPlanesSSE2(const float* planes)
+		{
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+
+			for (int i = 0; i < 6; i++)
+			{
+				m_NormalX[i] = _mm_set1_ps(planes[i * 4 + 0]);
+				m_NormalY[i] = _mm_set1_ps(planes[i * 4 + 1]);
+				m_NormalZ[i] = _mm_set1_ps(planes[i * 4 + 2]);
+				m_NormalAbsoluteX[i] = _mm_andnot_ps(signMask, m_NormalX[i]);
+				m_NormalAbsoluteY[i] = _mm_andnot_ps(signMask, m_NormalY[i]);
+				m_NormalAbsoluteZ[i] = _mm_andnot_ps(signMask, m_NormalZ[i]);
+				m_DistanceNegated[i] = _mm_set1_ps(-planes[i * 4 + 3]);
+			}
+		}
+
+		__m128 m_NormalX[6], m_NormalY[6], m_NormalZ[6];
+		__m128 m_NormalAbsoluteX[6], m_NormalAbsoluteY[6], m_NormalAbsoluteZ[6];
+		__m128 m_DistanceNegated[6];
+	};
+
+	static void FrustumCullBoxesBatchSSE2(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* extentsX, const float* extentsY, const float* extentsZ, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		const FrustumPlanesSSE2 frustum(planes);
+		const uint32_t vectorCount = count & ~3u;
+
+		for (uint32_t i = 0; i < vectorCount; i += 4)
+		{
+			const __m128 centerX = _mm_loadu_ps(centersX + i);
+			const __m128 centerY = _mm_loadu_ps(centersY + i);
+			const __m128 centerZ = _mm_loadu_ps(centersZ + i);
+			const __m128 extentX = _mm_loadu_ps(extentsX + i);
+			const __m128 extentY = _mm_loadu_ps(extentsY + i);
+			const __m128 extentZ = _mm_loadu_ps(extentsZ + i);
+
+			__m128 isOutside = _mm_setzero_ps();
+			for (int plane = 0; plane < 6; plane++)
+			{
+				const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(centerX, frustum.m_NormalX[plane]), _mm_mul_ps(centerY, frustum.m_NormalY[plane])), _mm_mul_ps(centerZ, frustum.m_NormalZ[plane]));
+				const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(extentX, frustum.m_NormalAbsoluteX[plane]), _mm_mul_ps(extentY, frustum.m_NormalAbsoluteY[plane])), _mm_mul_ps(extentZ, frustum.m_NormalAbsoluteZ[plane]));
+				isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(_mm_add_ps(distance, radius), frustum.m_DistanceNegated[plane]));
+			}
+
+			const uint32_t visibleBits = static_cast<uint32_t>(~_mm_movemask_ps(isOutside)) & 0xF;
+			visibilityMasks[i / 32] |= visibleBits << (i % 32);
+		}
+
+		for (uint32_t i = vectorCount; i < count; i++)
+		{
+			if (Scalar::FrustumIsBoxVisible(planes, centersX[i], centersY[i], centersZ[i], extentsX[i], extentsY[i], extentsZ[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	static void FrustumCullSpheresBatchSSE2(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* radii, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		const FrustumPlanesSSE2 frustum(planes);
+		const uint32_t vectorCount = count & ~3u;
+
+		for (uint32_t i = 0; i < vectorCount; i += 4)
+		{
+			const __m128 centerX = _mm_loadu_ps(centersX + i);
+			const __m128 centerY = _mm_loadu_ps(centersY + i);
+			const __m128 centerZ = _mm_loadu_ps(centersZ + i);
+			const __m128 radius = _mm_loadu_ps(radii + i);
+
+			__m128 isOutside = _mm_setzero_ps();
+			for (int plane = 0; plane < 6; plane++)
+			{
+				const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(centerX, frustum.m_NormalX[plane]), _mm_mul_ps(centerY, frustum.m_NormalY[plane])), _mm_mul_ps(centerZ, frustum.m_NormalZ[plane]));
+				isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(_mm_add_ps(distance, radius), frustum.m_DistanceNegated[plane]));
+			}
+
+			const uint32_t visibleBits = static_cast<uint32_t>(~_mm_movemask_ps(isOutside)) & 0xF;
+			visibilityMasks[i / 32] |= visibleBits << (i % 32);
+		}
+
+		for (uint32_t i = vectorCount; i < count; i++)
+		{
+			if (Scalar::FrustumIsSphereVisible(planes, centersX[i], centersY[i], centersZ[i], radii[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	// Min and max pick the same operand as the scalar comparisons, so these agree exactly.
+	static void BoundingBoxMergeBatchSSE2(const float* boxes, const uint32_t count, float* resultBox)
+	{
+		__m128 minimum = _mm_set1_ps(INFINITY);
+		__m128 maximum = _mm_set1_ps(-INFINITY);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			minimum = _mm_min_ps(minimum, LoadFloat3(boxes + i * 6));
+			maximum = _mm_max_ps(maximum, LoadFloat3(boxes + i * 6 + 3));
+		}
+
+		StoreFloat3(resultBox, minimum);
+		StoreFloat3(resultBox + 3, maximum);
+	}
+
+	static void BoundingBoxFromPointsBatchSSE2(const float* points, const uint32_t strideInBytes, const uint32_t count, float* resultBox)
+	{
+		__m128 minimum = _mm_set1_ps(INFINITY);
+		__m128 maximum = _mm_set1_ps(-INFINITY);
+
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(points);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const __m128 point = LoadFloat3(reinterpret_cast<const float*>(bytes + static_cast<size_t>(i) * strideInBytes));
+			minimum = _mm_min_ps(minimum, point);
+			maximum = _mm_max_ps(maximum, point);
+		}
+
+		StoreFloat3(resultBox, minimum);
+		StoreFloat3(resultBox + 3, maximum);
+	}
+#elif defined(AMETHYST_SIMD_NEON)
+	struct FrustumPlanesNEON
+	{
+		FrustumPlanesNEON(const float* planes)
+		{
+			for (int i = 0; i < 6; i++)
+			{
+				m_NormalX[i] = vdupq_n_f32(planes[i * 4 + 0]);
+				m_NormalY[i] = vdupq_n_f32(planes[i * 4 + 1]);
+				m_NormalZ[i] = vdupq_n_f32(planes[i * 4 + 2]);
+				m_NormalAbsoluteX[i] = vabsq_f32(m_NormalX[i]);
+				m_NormalAbsoluteY[i] = vabsq_f32(m_NormalY[i]);
+				m_NormalAbsoluteZ[i] = vabsq_f32(m_NormalZ[i]);
+				m_DistanceNegated[i] = vdupq_n_f32(-planes[i * 4 + 3]);
+			}
+		}
+
+		float32x4_t m_NormalX[6], m_NormalY[6], m_NormalZ[6];
+		float32x4_t m_NormalAbsoluteX[6], m_NormalAbsoluteY[6], m_NormalAbsoluteZ[6];
+		float32x4_t m_DistanceNegated[6];
+	};
+
+	// One bit per lane that is all ones.
+	static inline uint32_t MoveMaskNEON(const uint32x4_t mask)
+	{
+		static const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+		return vaddvq_u32(vandq_u32(mask, vld1q_u32(laneBits)));
+	}
+
+	static void FrustumCullBoxesBatchNEON(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* extentsX, const float* extentsY, const float* extentsZ, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		const FrustumPlanesNEON frustum(planes);
+		const uint32_t vectorCount = count & ~3u;
+
+		for (uint32_t i = 0; i < vectorCount; i += 4)
+		{
+			const float32x4_t centerX = vld1q_f32(centersX + i);
+			const float32x4_t centerY = vld1q_f32(centersY + i);
+			const float32x4_t centerZ = vld1q_f32(centersZ + i);
+			const float32x4_t extentX = vld1q_f32(extentsX + i);
+			const float32x4_t extentY = vld1q_f32(extentsY + i);
+			const float32x4_t extentZ = vld1q_f32(extentsZ + i);
+
+			uint32x4_t isOutside = vdupq_n_u32(0);
+			for (int plane = 0; plane < 6; plane++)
+			{
+				const float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(centerX, frustum.m_NormalX[plane]), vmulq_f32(centerY, frustum.m_NormalY[plane])), vmulq_f32(centerZ, frustum.m_NormalZ[plane]));
+				const float32x4_t radius = vaddq_f32(vaddq_f32(vmulq_f32(extentX, frustum.m_NormalAbsoluteX[plane]), vmulq_f32(extentY, frustum.m_NormalAbsoluteY[plane])), vmulq_f32(extentZ, frustum.m_NormalAbsoluteZ[plane]));
+				isOutside = vorrq_u32(isOutside, vcltq_f32(vaddq_f32(distance, radius), frustum.m_DistanceNegated[plane]));
+			}
+
+			visibilityMasks[i / 32] |= (~MoveMaskNEON(isOutside) & 0xF) << (i % 32);
+		}
+
+		for (uint32_t i = vectorCount; i < count; i++)
+		{
+			if (Scalar::FrustumIsBoxVisible(planes, centersX[i], centersY[i], centersZ[i], extentsX[i], extentsY[i], extentsZ[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	static void FrustumCullSpheresBatchNEON(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* radii, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		const FrustumPlanesNEON frustum(planes);
+		const uint32_t vectorCount = count & ~3u;
+
+		for (uint32_t i = 0; i < vectorCount; i += 4)
+		{
+			const float32x4_t centerX = vld1q_f32(centersX + i);
+			const float32x4_t centerY = vld1q_f32(centersY + i);
+			const float32x4_t centerZ = vld1q_f32(centersZ + i);
+			const float32x4_t radius = vld1q_f32(radii + i);
+
+			uint32x4_t isOutside = vdupq_n_u32(0);
+			for (int plane = 0; plane < 6; plane++)
+			{
+				const float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(centerX, frustum.m_NormalX[plane]), vmulq_f32(centerY, frustum.m_NormalY[plane])), vmulq_f32(centerZ, frustum.m_NormalZ[plane]));
+				isOutside = vorrq_u32(isOutside, vcltq_f32(vaddq_f32(distance, radius), frustum.m_DistanceNegated[plane]));
+			}
+
+			visibilityMasks[i / 32] |= (~MoveMaskNEON(isOutside) & 0xF) << (i % 32);
+		}
+
+		for (uint32_t i = vectorCount; i < count; i++)
+		{
+			if (Scalar::FrustumIsSphereVisible(planes, centersX[i], centersY[i], centersZ[i], radii[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	static void BoundingBoxMergeBatchNEON(const float* boxes, const uint32_t count, float* resultBox)
+	{
+		float32x4_t minimum = vdupq_n_f32(INFINITY);
+		float32x4_t maximum = vdupq_n_f32(-INFINITY);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const float* box = boxes + i * 6;
+			minimum = vminq_f32(minimum, vsetq_lane_f32(box[2], vcombine_f32(vld1_f32(box), vdup_n_f32(0.0f)), 2));
+			maximum = vmaxq_f32(maximum, vsetq_lane_f32(box[5], vcombine_f32(vld1_f32(box + 3), vdup_n_f32(0.0f)), 2));
+		}
+
+		vst1_f32(resultBox, vget_low_f32(minimum));
+		resultBox[2] = vgetq_lane_f32(minimum, 2);
+		vst1_f32(resultBox + 3, vget_low_f32(maximum));
+		resultBox[5] = vgetq_lane_f32(maximum, 2);
+	}
+
+	static void BoundingBoxFromPointsBatchNEON(const float* points, const uint32_t strideInBytes, const uint32_t count, float* resultBox)
+	{
+		float32x4_t minimum = vdupq_n_f32(INFINITY);
+		float32x4_t maximum = vdupq_n_f32(-INFINITY);
+
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(points);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const float* point = reinterpret_cast<const float*>(bytes + static_cast<size_t>(i) * strideInBytes);
+			const float32x4_t value = vsetq_lane_f32(point[2], vcombine_f32(vld1_f32(point), vdup_n_f32(0.0f)), 2);
+			minimum = vminq_f32(minimum, value);
+			maximum = vmaxq_f32(maximum, value);
+		}
+
+		vst1_f32(resultBox, vget_low_f32(minimum));
+		resultBox[2] = vgetq_lane_f32(minimum, 2);
+		vst1_f32(resultBox + 3, vget_low_f32(maximum));
+		resultBox[5] = vgetq_lane_f32(maximum, 2);
+	}
+#endif
+
+	static const Kernels g_ScalarKernels =
+	{
+		InstructionSet::Scalar,
+		&MatrixMultiplyBatch<&Scalar::MatrixMultiply>,
+		&MatrixInvertBatch<&Scalar::MatrixInvert>,
+		&MatrixComposeBatch<&Scalar::MatrixCompose>,
+		&MatrixTransformPointBatch<&Scalar::MatrixTransformPoint>,
+		&FrustumCullBoxesBatch,
+		&FrustumCullSpheresBatch,
+		&BoundingBoxTransformBatch<&Scalar::BoundingBoxTransform>,
+		&Scalar::BoundingBoxMerge,
+		&Scalar::BoundingBoxFromPoints
+	};
+
+	// The inlined single operations, looped. Always available on the targets they are compiled for.
+	static const Kernels g_BaselineKernels =
+	{
+#if defined(AMETHYST_SIMD_X86)
+		InstructionSet::SSE2,
+#elif defined(AMETHYST_SIMD_NEON)
+		InstructionSet::NEON,
+#else
+		InstructionSet::Scalar,
+#endif
+		&MatrixMultiplyBatch<&MatrixMultiply>,
+		&MatrixInvertBatch<&MatrixInvert>,
+		&MatrixComposeBatch<&MatrixCompose>,
+		&MatrixTransformPointBatch<&MatrixTransformPoint>,
+#if defined(AMETHYST_SIMD_X86)
+		&FrustumCullBoxesBatchSSE2,
+		&FrustumCullSpheresBatchSSE2,
+		&BoundingBoxTransformBatch<&BoundingBoxTransform>,
+		&BoundingBoxMergeBatchSSE2,
+		&BoundingBoxFromPointsBatchSSE2
+#elif defined(AMETHYST_SIMD_NEON)
+		&FrustumCullBoxesBatchNEON,
+		&FrustumCullSpheresBatchNEON,
+		&BoundingBoxTransformBatch<&BoundingBoxTransform>,
+		&BoundingBoxMergeBatchNEON,
+		&BoundingBoxFromPointsBatchNEON
+#else
+		&FrustumCullBoxesBatch,
+		&FrustumCullSpheresBatch,
+		&BoundingBoxTransformBatch<&BoundingBoxTransform>,
+		&Scalar::BoundingBoxMerge,
+		&Scalar::BoundingBoxFromPoints
+#endif
+	};
+
+	// Constant initialized, so math used during static initialization elsewhere still has a table to go through.
+	const Kernels* g_ActiveKernels = &g_BaselineKernels;
+
+	static CPUFeatures g_CPUFeatures;
+	static bool g_IsCPUFeaturesDetected = false;
+
+#if defined(AMETHYST_SIMD_X86)
+	static void QueryCPUID(const int leaf, const int subleaf, uint32_t registers[4])
+	{
+	#if defined(_MSC_VER)
+		int values[4];
+		__cpuidex(values, leaf, subleaf);
+		for (int i = 0; i < 4; i++)
+		{
+			registers[i] = static_cast<uint32_t>(values[i]);
+		}
+	#else
+		__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+	#endif
+	}
+
+	static uint64_t QueryXCR0()
+	{
+	#if defined(_MSC_VER)
+		return _xgetbv(0);
+	#else
+		uint32_t eax = 0, edx = 0;
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<uint64_t>(edx) << 32) | eax;
+	#endif
+	}
+#endif
+
+	static void DetectCPUFeatures()
+	{
+		if (g_IsCPUFeaturesDetected)
+		{
+			return;
+		}
+
+#if defined(AMETHYST_SIMD_X86)
+		uint32_t registers[4] = { 0, 0, 0, 0 }; // EAX, EBX, ECX, EDX
+		QueryCPUID(0, 0, registers);
+		const uint32_t leafCount = registers[0];
+
+		if (leafCount >= 1)
+		{
+			QueryCPUID(1, 0, registers);
+			g_CPUFeatures.m_SSE2 = (registers[3] & (1u << 26)) != 0;
+			g_CPUFeatures.m_SSE41 = (registers[2] & (1u << 19)) != 0;
+			g_CPUFeatures.m_FMA = (registers[2] & (1u << 12)) != 0;
+
+			// AVX also needs the OS to save YMM state on context switches, which XCR0 reports once OSXSAVE is set.
+			const bool isOSXSAVE = (registers[2] & (1u << 27)) != 0;
+			const bool isAVX = (registers[2] & (1u << 28)) != 0;
+			g_CPUFeatures.m_AVX = isAVX && isOSXSAVE && (QueryXCR0() & 0x6) == 0x6;
+			g_CPUFeatures.m_FMA = g_CPUFeatures.m_FMA && g_CPUFeatures.m_AVX;
+		}
+
+		if (leafCount >= 7)
+		{
+			QueryCPUID(7, 0, registers);
+			g_CPUFeatures.m_AVX2 = g_CPUFeatures.m_AVX && (registers[1] & (1u << 5)) != 0;
+		}
+#elif defined(AMETHYST_SIMD_NEON)
+		g_CPUFeatures.m_NEON = true; // Mandatory on AArch64.
+#endif
+
+		g_IsCPUFeaturesDetected = true;
+	}
+
+	void Initialize()
+	{
+		DetectCPUFeatures();
+
+		for (int i = static_cast<int>(InstructionSet::Count) - 1; i >= 0; i--)
+		{
+			if (const Kernels* kernels = RetrieveKernels(static_cast<InstructionSet>(i)))
+			{
+				g_ActiveKernels = kernels;
+				return;
+			}
+		}
+	}
+
+	// Picks up dispatch for anything that runs before the engine is constructed.
+	static const bool g_IsInitialized = (Initialize(), true);
+
+	const CPUFeatures& RetrieveCPUFeatures()
+	{
+		DetectCPUFeatures();
+		return g_CPUFeatures;
+	}
+
+	bool IsSupported(const InstructionSet instructionSet)
+	{
+		const CPUFeatures& features = RetrieveCPUFeatures();
+
+		switch (instructionSet)
+		{
+			case InstructionSet::Scalar:
+				return true;
+
+#if defined(AMETHYST_SIMD_X86)
+			case InstructionSet::SSE2:
+				return features.m_SSE2;
+
+			case InstructionSet::AVX2:
+				return features.m_AVX2;
+#elif defined(AMETHYST_SIMD_NEON)
+			case InstructionSet::NEON:
+				return features.m_NEON;
+#endif
+
+			default:
+				return false;
+		}
+	}
+
+	const Kernels* RetrieveKernels(const InstructionSet instructionSet)
+	{
+		if (!IsSupported(instructionSet))
+		{
+			return nullptr;
+		}
+
+		switch (instructionSet)
+		{
+			case InstructionSet::Scalar:
+				return &g_ScalarKernels;
+
+#if defined(AMETHYST_SIMD_X86)
+			case InstructionSet::SSE2:
+				return &g_BaselineKernels;
+
+			case InstructionSet::AVX2:
+				return &RetrieveAVX2Kernels();
+#elif defined(AMETHYST_SIMD_NEON)
+			case InstructionSet::NEON:
+				return &g_BaselineKernels;
+#endif
+
+			default:
+				return nullptr;
+		}
+	}
+
+	bool SetInstructionSet(const InstructionSet instructionSet)
+	{
+		const Kernels* kernels = RetrieveKernels(instructionSet);
+		if (!kernels)
+		{
+			return false;
+		}
+
+		g_ActiveKernels = kernels;
+		return true;
+	}
+
+	const char* InstructionSetToString(const InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+			case InstructionSet::Scalar: return "Scalar";
+			case InstructionSet::SSE2:	 return "SSE2";
+			case InstructionSet::AVX2:	 return "AVX2";
+			case InstructionSet::NEON:	 return "NEON";
+			default:					 return "Unknown";
+		}
+	}
+
+	uint32_t InstructionSetToLaneCount(const InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+			case InstructionSet::SSE2:	 return 4;
+			case InstructionSet::AVX2:	 return 8;
+			case InstructionSet::NEON:	 return 4;
+			default:					 return 1;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,422 @@
+#pragma once
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define AMETHYST_SIMD_X86
+	#include <emmintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+	#define AMETHYST_SIMD_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace Amethyst::Math::SIMD
+{
+	/*
+		Kernels work on raw floats laid out exactly as the math types store them, so that the types themselves stay plain structs and the
+		column-major contract in Matrix.h is untouched. Matrices are 16 floats (column by column), Vector3s are 3 floats and Quaternions are 4 (x, y, z, w).
+
+		Single operations are inlined and use the baseline instruction set of the target (SSE2 on x86, NEON on ARM64) - a 4x4 multiply is too short to
+		pay for an indirect call. Batches go through a table of kernels selected at startup from what the CPU reports, which is where wider instruction
+		sets earn their keep.
+
+		Multiply, compose, scale extraction and transforms evaluate in the same order as the scalar reference and without fused multiply-adds,
+		so their results are bit-for-bit identical across instruction sets. Invert uses a block-wise formulation and agrees to within rounding.
+	*/
+
+	enum class InstructionSet : uint8_t
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		NEON,
+		Count
+	};
+
+	struct CPUFeatures
+	{
+		bool m_SSE2 = false;
+		bool m_SSE41 = false;
+		bool m_AVX = false;  // Includes OS support for saving YMM registers.
+		bool m_AVX2 = false;
+		bool m_FMA = false;
+		bool m_NEON = false;
+	};
+
+	// Arrays are tightly packed - 16 floats per matrix, 4 per quaternion and 3 per point, translation or scale.
+	struct Kernels
+	{
+		InstructionSet m_InstructionSet;
+
+		void (*m_MatrixMultiplyBatch)(const float* leftMatrices, const float* rightMatrices, float* resultMatrices, const uint32_t count);
+		void (*m_MatrixInvertBatch)(const float* matrices, float* resultMatrices, const uint32_t count);
+		void (*m_MatrixComposeBatch)(const float* translations, const float* rotations, const float* scales, float* resultMatrices, const uint32_t count);
+		void (*m_MatrixTransformPointBatch)(const float* matrix, const float* points, float* resultPoints, const uint32_t count);
+
+		// Frustum planes are 6 x (normal x, y, z, distance). Bounds are structure-of-arrays, one array per component. Bit (i % 32) of visibilityMasks[i / 32]
+		// is set when element i is at least partially inside, and the unused bits of the last word are cleared.
+		void (*m_FrustumCullBoxesBatch)(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* extentsX, const float* extentsY, const float* extentsZ, uint32_t* visibilityMasks, const uint32_t count);
+		void (*m_FrustumCullSpheresBatch)(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* radii, uint32_t* visibilityMasks, const uint32_t count);
+
+		// Boxes are 6 floats (minimum, then maximum). Merging and bounding points start from the empty box (infinite minimum, negative infinite maximum).
+		void (*m_BoundingBoxTransformBatch)(const float* matrices, const float* boxes, float* resultBoxes, const uint32_t count); // Each box by its own matrix.
+		void (*m_BoundingBoxMergeBatch)(const float* boxes, const uint32_t count, float* resultBox);
+		void (*m_BoundingBoxFromPointsBatch)(const float* points, const uint32_t strideInBytes, const uint32_t count, float* resultBox);
+	};
+
+	extern const Kernels* g_ActiveKernels; // Points at the baseline table until Initialize() has run.
+
+	inline const Kernels& RetrieveKernels() { return *g_ActiveKernels; }
+
+	// Detects CPU features and picks the widest supported instruction set. Safe to call more than once.
+	void Initialize();
+
+	const CPUFeatures& RetrieveCPUFeatures();
+	bool IsSupported(const InstructionSet instructionSet);
+	const Kernels* RetrieveKernels(const InstructionSet instructionSet); // Nullptr if not compiled in or not supported by this CPU.
+	bool SetInstructionSet(const InstructionSet instructionSet); // Forces a specific table, for validation and A/B timings.
+	const char* InstructionSetToString(const InstructionSet instructionSet);
+	uint32_t InstructionSetToLaneCount(const InstructionSet instructionSet); // Floats per register.
+
+#if defined(AMETHYST_SIMD_X86)
+	const Kernels& RetrieveAVX2Kernels(); // Lives in its own translation unit, compiled with /arch:AVX2.
+#endif
+
+	// Reference implementations, and the fallback on targets without a SIMD path.
+	namespace Scalar
+	{
+		void MatrixMultiply(const float* leftMatrix, const float* rightMatrix, float* resultMatrix);
+		void MatrixInvert(const float* matrix, float* resultMatrix);
+		void MatrixCompose(const float* translation, const float* rotation, const float* scale, float* resultMatrix); // TRS.
+		void MatrixRetrieveScale(const float* matrix, float* scale);
+		void MatrixRemoveScale(const float* matrix, const float* scale, float* resultMatrix); // Divides each row by its scale and clears translation.
+		void MatrixTransformPoint(const float* matrix, const float* point, float* resultPoint); // With perspective divide.
+		void MatrixTransformVector4(const float* matrix, const float* vector, float* resultVector);
+		bool FrustumIsBoxVisible(const float* planes, const float centerX, const float centerY, const float centerZ, const float extentX, const float extentY, const float extentZ);
+		bool FrustumIsSphereVisible(const float* planes, const float centerX, const float centerY, const float centerZ, const float radius);
+		void BoundingBoxTransform(const float* matrix, const float* box, float* resultBox); // Center and extents, with the extents taken through the absolute matrix.
+		void BoundingBoxMerge(const float* boxes, const uint32_t count, float* resultBox);
+		void BoundingBoxFromPoints(const float* points, const uint32_t strideInBytes, const uint32_t count, float* resultBox);
+	}
+
+#if defined(AMETHYST_SIMD_X86)
+	template<int X, int Y, int Z, int W>
+	inline __m128 Swizzle(const __m128 vector)
+	{
+		return _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	// Three floats in, (x, y, z, 0) out - without reading past the end of a Vector3.
+	inline __m128 LoadFloat3(const float* values)
+	{
+		return _mm_movelh_ps(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values))), _mm_load_ss(values + 2));
+	}
+
+	inline void StoreFloat3(float* values, const __m128 vector)
+	{
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(values), _mm_castps_si128(vector));
+		_mm_store_ss(values + 2, _mm_movehl_ps(vector, vector));
+	}
+
+	// Lanes x, y and z from the first vector, w from the second.
+	inline __m128 SelectXYZ(const __m128 xyz, const __m128 w)
+	{
+		const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+		return _mm_or_ps(_mm_and_ps(mask, xyz), _mm_andnot_ps(mask, w));
+	}
+
+	// With columns in registers, rows come from a transpose so that row-vector products become broadcasts.
+	inline __m128 MatrixTransform(const float* matrix, const __m128 vector, const bool isPoint)
+	{
+		__m128 row0 = _mm_loadu_ps(matrix + 0);
+		__m128 row1 = _mm_loadu_ps(matrix + 4);
+		__m128 row2 = _mm_loadu_ps(matrix + 8);
+		__m128 row3 = _mm_loadu_ps(matrix + 12);
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		__m128 result = _mm_mul_ps(row0, Swizzle<0, 0, 0, 0>(vector));
+		result = _mm_add_ps(result, _mm_mul_ps(row1, Swizzle<1, 1, 1, 1>(vector)));
+		result = _mm_add_ps(result, _mm_mul_ps(row2, Swizzle<2, 2, 2, 2>(vector)));
+		return _mm_add_ps(result, isPoint ? row3 : _mm_mul_ps(row3, Swizzle<3, 3, 3, 3>(vector)));
+	}
+
+	// 2x2 helpers for the block-wise inverse. Each register holds a 2x2 block as (a, b, c, d), row by row.
+	inline __m128 Matrix2Multiply(const __m128 left, const __m128 right) // A * B
+	{
+		return _mm_add_ps(_mm_mul_ps(left, Swizzle<0, 3, 0, 3>(right)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(left), Swizzle<2, 1, 2, 1>(right)));
+	}
+
+	inline __m128 Matrix2AdjugateMultiply(const __m128 left, const __m128 right) // adj(A) * B
+	{
+		return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(left), right), _mm_mul_ps(Swizzle<1, 1, 2, 2>(left), Swizzle<2, 3, 0, 1>(right)));
+	}
+
+	inline __m128 Matrix2MultiplyAdjugate(const __m128 left, const __m128 right) // A * adj(B)
+	{
+		return _mm_sub_ps(_mm_mul_ps(left, Swizzle<3, 0, 3, 0>(right)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(left), Swizzle<2, 1, 2, 1>(right)));
+	}
+#endif
+
+	// Every column of the result is the left matrix's columns weighted by one column of the right matrix. Safe to use in place.
+	inline void MatrixMultiply(const float* leftMatrix, const float* rightMatrix, float* resultMatrix)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		const __m128 left0 = _mm_loadu_ps(leftMatrix + 0);
+		const __m128 left1 = _mm_loadu_ps(leftMatrix + 4);
+		const __m128 left2 = _mm_loadu_ps(leftMatrix + 8);
+		const __m128 left3 = _mm_loadu_ps(leftMatrix + 12);
+		__m128 result[4];
+
+		for (int column = 0; column < 4; column++)
+		{
+			const float* right = rightMatrix + column * 4;
+			result[column] = _mm_mul_ps(left0, _mm_load1_ps(right + 0));
+			result[column] = _mm_add_ps(result[column], _mm_mul_ps(left1, _mm_load1_ps(right + 1)));
+			result[column] = _mm_add_ps(result[column], _mm_mul_ps(left2, _mm_load1_ps(right + 2)));
+			result[column] = _mm_add_ps(result[column], _mm_mul_ps(left3, _mm_load1_ps(right + 3)));
+		}
+
+		for (int column = 0; column < 4; column++)
+		{
+			_mm_storeu_ps(resultMatrix + column * 4, result[column]);
+		}
+#elif defined(AMETHYST_SIMD_NEON)
+		const float32x4_t left0 = vld1q_f32(leftMatrix + 0);
+		const float32x4_t left1 = vld1q_f32(leftMatrix + 4);
+		const float32x4_t left2 = vld1q_f32(leftMatrix + 8);
+		const float32x4_t left3 = vld1q_f32(leftMatrix + 12);
+		const float32x4_t right[4] = { vld1q_f32(rightMatrix + 0), vld1q_f32(rightMatrix + 4), vld1q_f32(rightMatrix + 8), vld1q_f32(rightMatrix + 12) };
+
+		for (int column = 0; column < 4; column++)
+		{
+			float32x4_t result = vmulq_laneq_f32(left0, right[column], 0);
+			result = vaddq_f32(result, vmulq_laneq_f32(left1, right[column], 1));
+			result = vaddq_f32(result, vmulq_laneq_f32(left2, right[column], 2));
+			result = vaddq_f32(result, vmulq_laneq_f32(left3, right[column], 3));
+			vst1q_f32(resultMatrix + column * 4, result);
+		}
+#else
+		Scalar::MatrixMultiply(leftMatrix, rightMatrix, resultMatrix);
+#endif
+	}
+
+	/*
+		Splits the matrix into four 2x2 blocks and inverts through their adjugates and determinants. The four loaded registers are the columns,
+		so this inverts the transpose - whose inverse, stored the same way, is exactly the column-major inverse we want.
+	*/
+	inline void MatrixInvert(const float* matrix, float* resultMatrix)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		const __m128 row0 = _mm_loadu_ps(matrix + 0);
+		const __m128 row1 = _mm_loadu_ps(matrix + 4);
+		const __m128 row2 = _mm_loadu_ps(matrix + 8);
+		const __m128 row3 = _mm_loadu_ps(matrix + 12);
+
+		// Blocks
+		const __m128 a = _mm_movelh_ps(row0, row1);
+		const __m128 b = _mm_movehl_ps(row1, row0);
+		const __m128 c = _mm_movelh_ps(row2, row3);
+		const __m128 d = _mm_movehl_ps(row3, row2);
+
+		// Block determinants as (|A|, |B|, |C|, |D|).
+		const __m128 determinants = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0)))
+		);
+		const __m128 determinantA = Swizzle<0, 0, 0, 0>(determinants);
+		const __m128 determinantB = Swizzle<1, 1, 1, 1>(determinants);
+		const __m128 determinantC = Swizzle<2, 2, 2, 2>(determinants);
+		const __m128 determinantD = Swizzle<3, 3, 3, 3>(determinants);
+
+		const __m128 adjugateDC = Matrix2AdjugateMultiply(d, c);
+		const __m128 adjugateAB = Matrix2AdjugateMultiply(a, b);
+
+		// Adjugates of the inverse's blocks, before dividing through by the determinant.
+		__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Matrix2Multiply(b, adjugateDC));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Matrix2Multiply(c, adjugateAB));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), Matrix2MultiplyAdjugate(d, adjugateAB));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), Matrix2MultiplyAdjugate(a, adjugateDC));
+
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		__m128 determinant = _mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC));
+		__m128 trace = _mm_mul_ps(adjugateAB, Swizzle<0, 2, 1, 3>(adjugateDC));
+		trace = _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+		trace = _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+		determinant = _mm_sub_ps(determinant, trace);
+
+		// The adjugate's sign pattern is folded into the reciprocal.
+		const __m128 reciprocal = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+		x = _mm_mul_ps(x, reciprocal);
+		y = _mm_mul_ps(y, reciprocal);
+		z = _mm_mul_ps(z, reciprocal);
+		w = _mm_mul_ps(w, reciprocal);
+
+		// Adjugate swizzle and the blocks back into rows in one go.
+		_mm_storeu_ps(resultMatrix + 0, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(resultMatrix + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_storeu_ps(resultMatrix + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(resultMatrix + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+#else
+		Scalar::MatrixInvert(matrix, resultMatrix);
+#endif
+	}
+
+	/*
+		Each rotation column is base + multiplier * (p + sign * q), with p and q the quaternion products the scalar formula pairs up. Multiplying by
+		-1 and adding is exactly a subtraction, so the result matches the scalar reference bit for bit.
+	*/
+	inline void MatrixCompose(const float* translation, const float* rotation, const float* scale, float* resultMatrix)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		const __m128 quaternion = _mm_loadu_ps(rotation);
+		const __m128 translationVector = LoadFloat3(translation);
+		const __m128 scaleVector = LoadFloat3(scale);
+
+		const __m128 p0 = _mm_mul_ps(Swizzle<1, 0, 2, 3>(quaternion), Swizzle<1, 1, 0, 3>(quaternion)); // yy, xy, zx
+		const __m128 q0 = _mm_mul_ps(Swizzle<2, 2, 1, 3>(quaternion), Swizzle<2, 3, 3, 3>(quaternion)); // zz, zw, yw
+		const __m128 p1 = _mm_mul_ps(Swizzle<0, 2, 1, 3>(quaternion), Swizzle<1, 2, 2, 3>(quaternion)); // xy, zz, yz
+		const __m128 q1 = _mm_mul_ps(Swizzle<2, 0, 0, 3>(quaternion), Swizzle<3, 0, 3, 3>(quaternion)); // zw, xx, xw
+		const __m128 p2 = _mm_mul_ps(Swizzle<2, 1, 1, 3>(quaternion), Swizzle<0, 2, 1, 3>(quaternion)); // zx, yz, yy
+		const __m128 q2 = _mm_mul_ps(Swizzle<1, 0, 0, 3>(quaternion), Swizzle<3, 3, 0, 3>(quaternion)); // yw, xw, xx
+
+		const __m128 column0 = _mm_add_ps(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_mul_ps(_mm_setr_ps(-2.0f, 2.0f, 2.0f, 0.0f), _mm_add_ps(p0, _mm_mul_ps(_mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f), q0))));
+		const __m128 column1 = _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f), _mm_mul_ps(_mm_setr_ps(2.0f, -2.0f, 2.0f, 0.0f), _mm_add_ps(p1, _mm_mul_ps(_mm_setr_ps(1.0f, 1.0f, -1.0f, 0.0f), q1))));
+		const __m128 column2 = _mm_add_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f), _mm_mul_ps(_mm_setr_ps(2.0f, 2.0f, -2.0f, 0.0f), _mm_add_ps(p2, _mm_mul_ps(_mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f), q2))));
+
+		// Scale each row, then the fourth row holds translation.
+		_mm_storeu_ps(resultMatrix + 0, SelectXYZ(_mm_mul_ps(column0, scaleVector), Swizzle<0, 0, 0, 0>(translationVector)));
+		_mm_storeu_ps(resultMatrix + 4, SelectXYZ(_mm_mul_ps(column1, scaleVector), Swizzle<1, 1, 1, 1>(translationVector)));
+		_mm_storeu_ps(resultMatrix + 8, SelectXYZ(_mm_mul_ps(column2, scaleVector), Swizzle<2, 2, 2, 2>(translationVector)));
+		_mm_storeu_ps(resultMatrix + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+#else
+		Scalar::MatrixCompose(translation, rotation, scale, resultMatrix);
+#endif
+	}
+
+	// Lane r of each column holds row r, so the row lengths fall out of three multiply-adds.
+	inline void MatrixRetrieveScale(const float* matrix, float* scale)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		const __m128 column0 = _mm_loadu_ps(matrix + 0);
+		const __m128 column1 = _mm_loadu_ps(matrix + 4);
+		const __m128 column2 = _mm_loadu_ps(matrix + 8);
+		const __m128 column3 = _mm_loadu_ps(matrix + 12);
+
+		const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column0, column0), _mm_mul_ps(column1, column1)), _mm_mul_ps(column2, column2));
+		const __m128 product = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(column0, column1), column2), column3);
+		const __m128 signMask = _mm_and_ps(_mm_cmplt_ps(product, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+
+		StoreFloat3(scale, _mm_xor_ps(_mm_sqrt_ps(lengthSquared), signMask));
+#else
+		Scalar::MatrixRetrieveScale(matrix, scale);
+#endif
+	}
+
+	inline void MatrixRemoveScale(const float* matrix, const float* scale, float* resultMatrix)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		const __m128 scaleVector = SelectXYZ(LoadFloat3(scale), _mm_set1_ps(1.0f));
+		const __m128 zero = _mm_setzero_ps();
+
+		_mm_storeu_ps(resultMatrix + 0, SelectXYZ(_mm_div_ps(_mm_loadu_ps(matrix + 0), scaleVector), zero));
+		_mm_storeu_ps(resultMatrix + 4, SelectXYZ(_mm_div_ps(_mm_loadu_ps(matrix + 4), scaleVector), zero));
+		_mm_storeu_ps(resultMatrix + 8, SelectXYZ(_mm_div_ps(_mm_loadu_ps(matrix + 8), scaleVector), zero));
+		_mm_storeu_ps(resultMatrix + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+#else
+		Scalar::MatrixRemoveScale(matrix, scale, resultMatrix);
+#endif
+	}
+
+	inline void MatrixTransformPoint(const float* matrix, const float* point, float* resultPoint)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		const __m128 result = MatrixTransform(matrix, LoadFloat3(point), true);
+		const __m128 reciprocal = _mm_div_ps(_mm_set1_ps(1.0f), Swizzle<3, 3, 3, 3>(result));
+
+		StoreFloat3(resultPoint, _mm_mul_ps(result, reciprocal));
+#elif defined(AMETHYST_SIMD_NEON)
+		const float32x4x4_t rows = vld4q_f32(matrix); // De-interleaving load - val[r] is row r.
+
+		float32x4_t result = vmulq_n_f32(rows.val[0], point[0]);
+		result = vaddq_f32(result, vmulq_n_f32(rows.val[1], point[1]));
+		result = vaddq_f32(result, vmulq_n_f32(rows.val[2], point[2]));
+		result = vaddq_f32(result, rows.val[3]);
+		result = vmulq_n_f32(result, 1.0f / vgetq_lane_f32(result, 3));
+
+		vst1_f32(resultPoint, vget_low_f32(result));
+		resultPoint[2] = vgetq_lane_f32(result, 2);
+#else
+		Scalar::MatrixTransformPoint(matrix, point, resultPoint);
+#endif
+	}
+
+	inline void MatrixTransformVector4(const float* matrix, const float* vector, float* resultVector)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		_mm_storeu_ps(resultVector, MatrixTransform(matrix, _mm_loadu_ps(vector), false));
+#elif defined(AMETHYST_SIMD_NEON)
+		const float32x4x4_t rows = vld4q_f32(matrix);
+
+		float32x4_t result = vmulq_n_f32(rows.val[0], vector[0]);
+		result = vaddq_f32(result, vmulq_n_f32(rows.val[1], vector[1]));
+		result = vaddq_f32(result, vmulq_n_f32(rows.val[2], vector[2]));
+		result = vaddq_f32(result, vmulq_n_f32(rows.val[3], vector[3]));
+		vst1q_f32(resultVector, result);
+#else
+		Scalar::MatrixTransformVector4(matrix, vector, resultVector);
+#endif
+	}
+
+	inline void BoundingBoxTransform(const float* matrix, const float* box, float* resultBox)
+	{
+#if defined(AMETHYST_SIMD_X86)
+		__m128 row0 = _mm_loadu_ps(matrix + 0);
+		__m128 row1 = _mm_loadu_ps(matrix + 4);
+		__m128 row2 = _mm_loadu_ps(matrix + 8);
+		__m128 row3 = _mm_loadu_ps(matrix + 12);
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		const __m128 minimum = LoadFloat3(box);
+		const __m128 maximum = LoadFloat3(box + 3);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 center = _mm_mul_ps(_mm_add_ps(maximum, minimum), half);
+		const __m128 extent = _mm_mul_ps(_mm_sub_ps(maximum, minimum), half);
+
+		__m128 centerResult = _mm_mul_ps(row0, Swizzle<0, 0, 0, 0>(center));
+		centerResult = _mm_add_ps(centerResult, _mm_mul_ps(row1, Swizzle<1, 1, 1, 1>(center)));
+		centerResult = _mm_add_ps(centerResult, _mm_mul_ps(row2, Swizzle<2, 2, 2, 2>(center)));
+		centerResult = _mm_add_ps(centerResult, row3);
+		centerResult = _mm_mul_ps(centerResult, _mm_div_ps(_mm_set1_ps(1.0f), Swizzle<3, 3, 3, 3>(centerResult)));
+
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		__m128 extentResult = _mm_mul_ps(_mm_andnot_ps(signMask, row0), Swizzle<0, 0, 0, 0>(extent));
+		extentResult = _mm_add_ps(extentResult, _mm_mul_ps(_mm_andnot_ps(signMask, row1), Swizzle<1, 1, 1, 1>(extent)));
+		extentResult = _mm_add_ps(extentResult, _mm_mul_ps(_mm_andnot_ps(signMask, row2), Swizzle<2, 2, 2, 2>(extent)));
+
+		StoreFloat3(resultBox, _mm_sub_ps(centerResult, extentResult));
+		StoreFloat3(resultBox + 3, _mm_add_ps(centerResult, extentResult));
+#elif defined(AMETHYST_SIMD_NEON)
+		const float32x4x4_t rows = vld4q_f32(matrix);
+		const float center[3] = { (box[3] + box[0]) * 0.5f, (box[4] + box[1]) * 0.5f, (box[5] + box[2]) * 0.5f };
+		const float extent[3] = { (box[3] - box[0]) * 0.5f, (box[4] - box[1]) * 0.5f, (box[5] - box[2]) * 0.5f };
+
+		float32x4_t centerResult = vmulq_n_f32(rows.val[0], center[0]);
+		centerResult = vaddq_f32(centerResult, vmulq_n_f32(rows.val[1], center[1]));
+		centerResult = vaddq_f32(centerResult, vmulq_n_f32(rows.val[2], center[2]));
+		centerResult = vaddq_f32(centerResult, rows.val[3]);
+		centerResult = vmulq_n_f32(centerResult, 1.0f / vgetq_lane_f32(centerResult, 3));
+
+		float32x4_t extentResult = vmulq_n_f32(vabsq_f32(rows.val[0]), extent[0]);
+		extentResult = vaddq_f32(extentResult, vmulq_n_f32(vabsq_f32(rows.val[1]), extent[1]));
+		extentResult = vaddq_f32(extentResult, vmulq_n_f32(vabsq_f32(rows.val[2]), extent[2]));
+
+		const float32x4_t minimum = vsubq_f32(centerResult, extentResult);
+		const float32x4_t maximum = vaddq_f32(centerResult, extentResult);
+		vst1_f32(resultBox, vget_low_f32(minimum));
+		resultBox[2] = vgetq_lane_f32(minimum, 2);
+		vst1_f32(resultBox + 3, vget_low_f32(maximum));
+		resultBox[5] = vgetq_lane_f32(maximum, 2);
+#else
+		Scalar::BoundingBoxTransform(matrix, box, resultBox);
+#endif
+	}
+}
\ No newline at end of file
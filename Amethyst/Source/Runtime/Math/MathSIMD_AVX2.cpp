@@ -0,0 +1,446 @@
+// Compiled with /arch:AVX2 and without the precompiled header (which is built for the baseline architecture). Don't call any inline function from
+// another header in here - the linker is free to keep this translation unit's AVX2 copy of it for every caller, including those on older CPUs.
+#include "MathSIMD.h"
+
+#if defined(AMETHYST_SIMD_X86)
+#if defined(__GNUC__) && !defined(__AVX2__)
+	#pragma GCC target("avx2")
+#endif
+#include <immintrin.h>
+#include <cstring>
+#include <cmath>
+
+namespace Amethyst::Math::SIMD
+{
+	/*
+		256-bit shuffles and arithmetic work on each 128-bit half independently, so the SSE2 kernels carry over with two matrices (or two points) side by side,
+		one per half. Every operation is the same as its SSE2 counterpart and multiplies and adds are kept separate (no FMA), so results match bit for bit.
+		An odd element at the end of a batch is processed alongside a copy of itself.
+	*/
+
+	template<int X, int Y, int Z, int W>
+	static inline __m256 Swizzle2(const __m256 vector)
+	{
+		return _mm256_permute_ps(vector, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	static inline __m256 MoveLowHigh2(const __m256 left, const __m256 right) // _mm_movelh_ps per half.
+	{
+		return _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(left), _mm256_castps_pd(right)));
+	}
+
+	static inline __m256 MoveHighLow2(const __m256 left, const __m256 right) // _mm_movehl_ps per half.
+	{
+		return _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(right), _mm256_castps_pd(left)));
+	}
+
+	static inline __m256 Load2(const float* first, const float* second)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(first)), _mm_loadu_ps(second), 1);
+	}
+
+	static inline __m256 LoadFloat3x2(const float* first, const float* second)
+	{
+		return _mm256_setr_ps(first[0], first[1], first[2], 0.0f, second[0], second[1], second[2], 0.0f);
+	}
+
+	static inline void Store2(float* first, float* second, const __m256 vector, const bool isSecondStored)
+	{
+		_mm_storeu_ps(first, _mm256_castps256_ps128(vector));
+		if (isSecondStored)
+		{
+			_mm_storeu_ps(second, _mm256_extractf128_ps(vector, 1));
+		}
+	}
+
+	static inline void StoreFloat3x2(float* first, float* second, const __m256 vector, const bool isSecondStored)
+	{
+		const __m128 low = _mm256_castps256_ps128(vector);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(first), _mm_castps_si128(low));
+		_mm_store_ss(first + 2, _mm_movehl_ps(low, low));
+
+		if (isSecondStored)
+		{
+			const __m128 high = _mm256_extractf128_ps(vector, 1);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(second), _mm_castps_si128(high));
+			_mm_store_ss(second + 2, _mm_movehl_ps(high, high));
+		}
+	}
+
+	// Two result columns per instruction.
+	static void MatrixMultiplyBatchAVX2(const float* leftMatrices, const float* rightMatrices, float* resultMatrices, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const float* leftMatrix = leftMatrices + i * 16;
+			const float* rightMatrix = rightMatrices + i * 16;
+
+			const __m256 left0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(leftMatrix + 0));
+			const __m256 left1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(leftMatrix + 4));
+			const __m256 left2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(leftMatrix + 8));
+			const __m256 left3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(leftMatrix + 12));
+			const __m256 right[2] = { _mm256_loadu_ps(rightMatrix + 0), _mm256_loadu_ps(rightMatrix + 8) };
+
+			for (int j = 0; j < 2; j++)
+			{
+				__m256 result = _mm256_mul_ps(left0, Swizzle2<0, 0, 0, 0>(right[j]));
+				result = _mm256_add_ps(result, _mm256_mul_ps(left1, Swizzle2<1, 1, 1, 1>(right[j])));
+				result = _mm256_add_ps(result, _mm256_mul_ps(left2, Swizzle2<2, 2, 2, 2>(right[j])));
+				result = _mm256_add_ps(result, _mm256_mul_ps(left3, Swizzle2<3, 3, 3, 3>(right[j])));
+				_mm256_storeu_ps(resultMatrices + i * 16 + j * 8, result);
+			}
+		}
+	}
+
+	static inline __m256 Matrix2Multiply2(const __m256 left, const __m256 right)
+	{
+		return _mm256_add_ps(_mm256_mul_ps(left, Swizzle2<0, 3, 0, 3>(right)), _mm256_mul_ps(Swizzle2<1, 0, 3, 2>(left), Swizzle2<2, 1, 2, 1>(right)));
+	}
+
+	static inline __m256 Matrix2AdjugateMultiply2(const __m256 left, const __m256 right)
+	{
+		return _mm256_sub_ps(_mm256_mul_ps(Swizzle2<3, 3, 0, 0>(left), right), _mm256_mul_ps(Swizzle2<1, 1, 2, 2>(left), Swizzle2<2, 3, 0, 1>(right)));
+	}
+
+	static inline __m256 Matrix2MultiplyAdjugate2(const __m256 left, const __m256 right)
+	{
+		return _mm256_sub_ps(_mm256_mul_ps(left, Swizzle2<3, 0, 3, 0>(right)), _mm256_mul_ps(Swizzle2<1, 0, 3, 2>(left), Swizzle2<2, 1, 2, 1>(right)));
+	}
+
+	static void MatrixInvertBatchAVX2(const float* matrices, float* resultMatrices, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			const bool isPair = i + 1 < count;
+			const float* first = matrices + i * 16;
+			const float* second = isPair ? first + 16 : first;
+
+			const __m256 row0 = Load2(first + 0, second + 0);
+			const __m256 row1 = Load2(first + 4, second + 4);
+			const __m256 row2 = Load2(first + 8, second + 8);
+			const __m256 row3 = Load2(first + 12, second + 12);
+
+			const __m256 a = MoveLowHigh2(row0, row1);
+			const __m256 b = MoveHighLow2(row1, row0);
+			const __m256 c = MoveLowHigh2(row2, row3);
+			const __m256 d = MoveHighLow2(row3, row2);
+
+			const __m256 determinants = _mm256_sub_ps(
+				_mm256_mul_ps(_mm256_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm256_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+				_mm256_mul_ps(_mm256_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm256_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0)))
+			);
+			const __m256 determinantA = Swizzle2<0, 0, 0, 0>(determinants);
+			const __m256 determinantB = Swizzle2<1, 1, 1, 1>(determinants);
+			const __m256 determinantC = Swizzle2<2, 2, 2, 2>(determinants);
+			const __m256 determinantD = Swizzle2<3, 3, 3, 3>(determinants);
+
+			const __m256 adjugateDC = Matrix2AdjugateMultiply2(d, c);
+			const __m256 adjugateAB = Matrix2AdjugateMultiply2(a, b);
+
+			__m256 x = _mm256_sub_ps(_mm256_mul_ps(determinantD, a), Matrix2Multiply2(b, adjugateDC));
+			__m256 w = _mm256_sub_ps(_mm256_mul_ps(determinantA, d), Matrix2Multiply2(c, adjugateAB));
+			__m256 y = _mm256_sub_ps(_mm256_mul_ps(determinantB, c), Matrix2MultiplyAdjugate2(d, adjugateAB));
+			__m256 z = _mm256_sub_ps(_mm256_mul_ps(determinantC, b), Matrix2MultiplyAdjugate2(a, adjugateDC));
+
+			__m256 determinant = _mm256_add_ps(_mm256_mul_ps(determinantA, determinantD), _mm256_mul_ps(determinantB, determinantC));
+			__m256 trace = _mm256_mul_ps(adjugateAB, Swizzle2<0, 2, 1, 3>(adjugateDC));
+			trace = _mm256_add_ps(trace, Swizzle2<1, 0, 3, 2>(trace));
+			trace = _mm256_add_ps(trace, Swizzle2<2, 3, 0, 1>(trace));
+			determinant = _mm256_sub_ps(determinant, trace);
+
+			const __m256 reciprocal = _mm256_div_ps(_mm256_setr_ps(1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f), determinant);
+			x = _mm256_mul_ps(x, reciprocal);
+			y = _mm256_mul_ps(y, reciprocal);
+			z = _mm256_mul_ps(z, reciprocal);
+			w = _mm256_mul_ps(w, reciprocal);
+
+			float* resultFirst = resultMatrices + i * 16;
+			float* resultSecond = resultFirst + 16;
+			Store2(resultFirst + 0, resultSecond + 0, _mm256_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)), isPair);
+			Store2(resultFirst + 4, resultSecond + 4, _mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)), isPair);
+			Store2(resultFirst + 8, resultSecond + 8, _mm256_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)), isPair);
+			Store2(resultFirst + 12, resultSecond + 12, _mm256_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)), isPair);
+		}
+	}
+
+	static void MatrixComposeBatchAVX2(const float* translations, const float* rotations, const float* scales, float* resultMatrices, const uint32_t count)
+	{
+		const __m256 base0 = _mm256_setr_ps(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+		const __m256 base1 = _mm256_setr_ps(0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+		const __m256 base2 = _mm256_setr_ps(0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+		const __m256 multiplier0 = _mm256_setr_ps(-2.0f, 2.0f, 2.0f, 0.0f, -2.0f, 2.0f, 2.0f, 0.0f);
+		const __m256 multiplier1 = _mm256_setr_ps(2.0f, -2.0f, 2.0f, 0.0f, 2.0f, -2.0f, 2.0f, 0.0f);
+		const __m256 multiplier2 = _mm256_setr_ps(2.0f, 2.0f, -2.0f, 0.0f, 2.0f, 2.0f, -2.0f, 0.0f);
+		const __m256 sign0 = _mm256_setr_ps(1.0f, -1.0f, 1.0f, 0.0f, 1.0f, -1.0f, 1.0f, 0.0f);
+		const __m256 sign1 = _mm256_setr_ps(1.0f, 1.0f, -1.0f, 0.0f, 1.0f, 1.0f, -1.0f, 0.0f);
+		const __m256 sign2 = _mm256_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f, -1.0f, 1.0f, 1.0f, 0.0f);
+		const __m256 column3 = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			const bool isPair = i + 1 < count;
+			const uint32_t j = isPair ? i + 1 : i;
+
+			const __m256 quaternion = Load2(rotations + i * 4, rotations + j * 4);
+			const __m256 translation = LoadFloat3x2(translations + i * 3, translations + j * 3);
+			const __m256 scale = LoadFloat3x2(scales + i * 3, scales + j * 3);
+
+			const __m256 p0 = _mm256_mul_ps(Swizzle2<1, 0, 2, 3>(quaternion), Swizzle2<1, 1, 0, 3>(quaternion));
+			const __m256 q0 = _mm256_mul_ps(Swizzle2<2, 2, 1, 3>(quaternion), Swizzle2<2, 3, 3, 3>(quaternion));
+			const __m256 p1 = _mm256_mul_ps(Swizzle2<0, 2, 1, 3>(quaternion), Swizzle2<1, 2, 2, 3>(quaternion));
+			const __m256 q1 = _mm256_mul_ps(Swizzle2<2, 0, 0, 3>(quaternion), Swizzle2<3, 0, 3, 3>(quaternion));
+			const __m256 p2 = _mm256_mul_ps(Swizzle2<2, 1, 1, 3>(quaternion), Swizzle2<0, 2, 1, 3>(quaternion));
+			const __m256 q2 = _mm256_mul_ps(Swizzle2<1, 0, 0, 3>(quaternion), Swizzle2<3, 3, 0, 3>(quaternion));
+
+			const __m256 column0 = _mm256_add_ps(base0, _mm256_mul_ps(multiplier0, _mm256_add_ps(p0, _mm256_mul_ps(sign0, q0))));
+			const __m256 column1 = _mm256_add_ps(base1, _mm256_mul_ps(multiplier1, _mm256_add_ps(p1, _mm256_mul_ps(sign1, q1))));
+			const __m256 column2 = _mm256_add_ps(base2, _mm256_mul_ps(multiplier2, _mm256_add_ps(p2, _mm256_mul_ps(sign2, q2))));
+
+			// Scale each row, then the fourth row holds translation.
+			const __m256 translationX = Swizzle2<0, 0, 0, 0>(translation);
+			const __m256 translationY = Swizzle2<1, 1, 1, 1>(translation);
+			const __m256 translationZ = Swizzle2<2, 2, 2, 2>(translation);
+
+			float* resultFirst = resultMatrices + i * 16;
+			float* resultSecond = resultFirst + 16;
+			Store2(resultFirst + 0, resultSecond + 0, _mm256_blend_ps(_mm256_mul_ps(column0, scale), translationX, 0x88), isPair);
+			Store2(resultFirst + 4, resultSecond + 4, _mm256_blend_ps(_mm256_mul_ps(column1, scale), translationY, 0x88), isPair);
+			Store2(resultFirst + 8, resultSecond + 8, _mm256_blend_ps(_mm256_mul_ps(column2, scale), translationZ, 0x88), isPair);
+			Store2(resultFirst + 12, resultSecond + 12, column3, isPair);
+		}
+	}
+
+	static void MatrixTransformPointBatchAVX2(const float* matrix, const float* points, float* resultPoints, const uint32_t count)
+	{
+		__m128 row0 = _mm_loadu_ps(matrix + 0);
+		__m128 row1 = _mm_loadu_ps(matrix + 4);
+		__m128 row2 = _mm_loadu_ps(matrix + 8);
+		__m128 row3 = _mm_loadu_ps(matrix + 12);
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		const __m256 rows0 = _mm256_insertf128_ps(_mm256_castps128_ps256(row0), row0, 1);
+		const __m256 rows1 = _mm256_insertf128_ps(_mm256_castps128_ps256(row1), row1, 1);
+		const __m256 rows2 = _mm256_insertf128_ps(_mm256_castps128_ps256(row2), row2, 1);
+		const __m256 rows3 = _mm256_insertf128_ps(_mm256_castps128_ps256(row3), row3, 1);
+		const __m256 one = _mm256_set1_ps(1.0f);
+
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			const bool isPair = i + 1 < count;
+			const __m256 point = LoadFloat3x2(points + i * 3, points + (isPair ? i + 1 : i) * 3);
+
+			__m256 result = _mm256_mul_ps(rows0, Swizzle2<0, 0, 0, 0>(point));
+			result = _mm256_add_ps(result, _mm256_mul_ps(rows1, Swizzle2<1, 1, 1, 1>(point)));
+			result = _mm256_add_ps(result, _mm256_mul_ps(rows2, Swizzle2<2, 2, 2, 2>(point)));
+			result = _mm256_add_ps(result, rows3);
+			result = _mm256_mul_ps(result, _mm256_div_ps(one, Swizzle2<3, 3, 3, 3>(result)));
+
+			StoreFloat3x2(resultPoints + i * 3, resultPoints + (i + 1) * 3, result, isPair);
+		}
+	}
+
+	// Eight elements per register - structure-of-arrays input needs no shuffles, only wider loads.
+	struct FrustumPlanesAVX2
+	{
+		FrustumPlanesAVX2(const float* planes)
+		{
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+			for (int i = 0; i < 6; i++)
+			{
+				m_NormalX[i] = _mm256_set1_ps(planes[i * 4 + 0]);
+				m_NormalY[i] = _mm256_set1_ps(planes[i * 4 + 1]);
+				m_NormalZ[i] = _mm256_set1_ps(planes[i * 4 + 2]);
+				m_NormalAbsoluteX[i] = _mm256_andnot_ps(signMask, m_NormalX[i]);
+				m_NormalAbsoluteY[i] = _mm256_andnot_ps(signMask, m_NormalY[i]);
+				m_NormalAbsoluteZ[i] = _mm256_andnot_ps(signMask, m_NormalZ[i]);
+				m_DistanceNegated[i] = _mm256_set1_ps(-planes[i * 4 + 3]);
+			}
+		}
+
+		__m256 m_NormalX[6], m_NormalY[6], m_NormalZ[6];
+		__m256 m_NormalAbsoluteX[6], m_NormalAbsoluteY[6], m_NormalAbsoluteZ[6];
+		__m256 m_DistanceNegated[6];
+	};
+
+	static void FrustumCullBoxesBatchAVX2(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* extentsX, const float* extentsY, const float* extentsZ, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		const FrustumPlanesAVX2 frustum(planes);
+		const uint32_t vectorCount = count & ~7u;
+
+		for (uint32_t i = 0; i < vectorCount; i += 8)
+		{
+			const __m256 centerX = _mm256_loadu_ps(centersX + i);
+			const __m256 centerY = _mm256_loadu_ps(centersY + i);
+			const __m256 centerZ = _mm256_loadu_ps(centersZ + i);
+			const __m256 extentX = _mm256_loadu_ps(extentsX + i);
+			const __m256 extentY = _mm256_loadu_ps(extentsY + i);
+			const __m256 extentZ = _mm256_loadu_ps(extentsZ + i);
+
+			__m256 isOutside = _mm256_setzero_ps();
+			for (int plane = 0; plane < 6; plane++)
+			{
+				const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(centerX, frustum.m_NormalX[plane]), _mm256_mul_ps(centerY, frustum.m_NormalY[plane])), _mm256_mul_ps(centerZ, frustum.m_NormalZ[plane]));
+				const __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(extentX, frustum.m_NormalAbsoluteX[plane]), _mm256_mul_ps(extentY, frustum.m_NormalAbsoluteY[plane])), _mm256_mul_ps(extentZ, frustum.m_NormalAbsoluteZ[plane]));
+				isOutside = _mm256_or_ps(isOutside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), frustum.m_DistanceNegated[plane], _CMP_LT_OQ));
+			}
+
+			const uint32_t visibleBits = static_cast<uint32_t>(~_mm256_movemask_ps(isOutside)) & 0xFF;
+			visibilityMasks[i / 32] |= visibleBits << (i % 32);
+		}
+
+		for (uint32_t i = vectorCount; i < count; i++)
+		{
+			if (Scalar::FrustumIsBoxVisible(planes, centersX[i], centersY[i], centersZ[i], extentsX[i], extentsY[i], extentsZ[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	static void FrustumCullSpheresBatchAVX2(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* radii, uint32_t* visibilityMasks, const uint32_t count)
+	{
+		std::memset(visibilityMasks, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+		const FrustumPlanesAVX2 frustum(planes);
+		const uint32_t vectorCount = count & ~7u;
+
+		for (uint32_t i = 0; i < vectorCount; i += 8)
+		{
+			const __m256 centerX = _mm256_loadu_ps(centersX + i);
+			const __m256 centerY = _mm256_loadu_ps(centersY + i);
+			const __m256 centerZ = _mm256_loadu_ps(centersZ + i);
+			const __m256 radius = _mm256_loadu_ps(radii + i);
+
+			__m256 isOutside = _mm256_setzero_ps();
+			for (int plane = 0; plane < 6; plane++)
+			{
+				const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(centerX, frustum.m_NormalX[plane]), _mm256_mul_ps(centerY, frustum.m_NormalY[plane])), _mm256_mul_ps(centerZ, frustum.m_NormalZ[plane]));
+				isOutside = _mm256_or_ps(isOutside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), frustum.m_DistanceNegated[plane], _CMP_LT_OQ));
+			}
+
+			const uint32_t visibleBits = static_cast<uint32_t>(~_mm256_movemask_ps(isOutside)) & 0xFF;
+			visibilityMasks[i / 32] |= visibleBits << (i % 32);
+		}
+
+		for (uint32_t i = vectorCount; i < count; i++)
+		{
+			if (Scalar::FrustumIsSphereVisible(planes, centersX[i], centersY[i], centersZ[i], radii[i]))
+			{
+				visibilityMasks[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	// _MM_TRANSPOSE4_PS per half.
+	static inline void Transpose2(__m256& row0, __m256& row1, __m256& row2, __m256& row3)
+	{
+		const __m256 temporary0 = _mm256_unpacklo_ps(row0, row1);
+		const __m256 temporary1 = _mm256_unpacklo_ps(row2, row3);
+		const __m256 temporary2 = _mm256_unpackhi_ps(row0, row1);
+		const __m256 temporary3 = _mm256_unpackhi_ps(row2, row3);
+
+		row0 = MoveLowHigh2(temporary0, temporary1);
+		row1 = MoveHighLow2(temporary1, temporary0);
+		row2 = MoveLowHigh2(temporary2, temporary3);
+		row3 = MoveHighLow2(temporary3, temporary2);
+	}
+
+	static void BoundingBoxTransformBatchAVX2(const float* matrices, const float* boxes, float* resultBoxes, const uint32_t count)
+	{
+		const __m256 half = _mm256_set1_ps(0.5f);
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			const bool isPair = i + 1 < count;
+			const uint32_t second = isPair ? i + 1 : i;
+
+			const float* matrixFirst = matrices + i * 16;
+			const float* matrixSecond = matrices + second * 16;
+			__m256 row0 = Load2(matrixFirst + 0, matrixSecond + 0);
+			__m256 row1 = Load2(matrixFirst + 4, matrixSecond + 4);
+			__m256 row2 = Load2(matrixFirst + 8, matrixSecond + 8);
+			__m256 row3 = Load2(matrixFirst + 12, matrixSecond + 12);
+			Transpose2(row0, row1, row2, row3);
+
+			const __m256 minimum = LoadFloat3x2(boxes + i * 6, boxes + second * 6);
+			const __m256 maximum = LoadFloat3x2(boxes + i * 6 + 3, boxes + second * 6 + 3);
+			const __m256 center = _mm256_mul_ps(_mm256_add_ps(maximum, minimum), half);
+			const __m256 extent = _mm256_mul_ps(_mm256_sub_ps(maximum, minimum), half);
+
+			__m256 centerResult = _mm256_mul_ps(row0, Swizzle2<0, 0, 0, 0>(center));
+			centerResult = _mm256_add_ps(centerResult, _mm256_mul_ps(row1, Swizzle2<1, 1, 1, 1>(center)));
+			centerResult = _mm256_add_ps(centerResult, _mm256_mul_ps(row2, Swizzle2<2, 2, 2, 2>(center)));
+			centerResult = _mm256_add_ps(centerResult, row3);
+			centerResult = _mm256_mul_ps(centerResult, _mm256_div_ps(one, Swizzle2<3, 3, 3, 3>(centerResult)));
+
+			__m256 extentResult = _mm256_mul_ps(_mm256_andnot_ps(signMask, row0), Swizzle2<0, 0, 0, 0>(extent));
+			extentResult = _mm256_add_ps(extentResult, _mm256_mul_ps(_mm256_andnot_ps(signMask, row1), Swizzle2<1, 1, 1, 1>(extent)));
+			extentResult = _mm256_add_ps(extentResult, _mm256_mul_ps(_mm256_andnot_ps(signMask, row2), Swizzle2<2, 2, 2, 2>(extent)));
+
+			float* resultFirst = resultBoxes + i * 6;
+			float* resultSecond = resultBoxes + (i + 1) * 6;
+			StoreFloat3x2(resultFirst, resultSecond, _mm256_sub_ps(centerResult, extentResult), isPair);
+			StoreFloat3x2(resultFirst + 3, resultSecond + 3, _mm256_add_ps(centerResult, extentResult), isPair);
+		}
+	}
+
+	// Two running boxes, one per half, folded together at the end. Min and max are exact, so the order doesn't change the result.
+	static void BoundingBoxMergeBatchAVX2(const float* boxes, const uint32_t count, float* resultBox)
+	{
+		__m256 minimum = _mm256_set1_ps(INFINITY);
+		__m256 maximum = _mm256_set1_ps(-INFINITY);
+
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			const uint32_t second = i + 1 < count ? i + 1 : i;
+			minimum = _mm256_min_ps(minimum, LoadFloat3x2(boxes + i * 6, boxes + second * 6));
+			maximum = _mm256_max_ps(maximum, LoadFloat3x2(boxes + i * 6 + 3, boxes + second * 6 + 3));
+		}
+
+		StoreFloat3x2(resultBox, resultBox, _mm256_min_ps(minimum, _mm256_permute2f128_ps(minimum, minimum, 1)), false);
+		StoreFloat3x2(resultBox + 3, resultBox + 3, _mm256_max_ps(maximum, _mm256_permute2f128_ps(maximum, maximum, 1)), false);
+	}
+
+	static void BoundingBoxFromPointsBatchAVX2(const float* points, const uint32_t strideInBytes, const uint32_t count, float* resultBox)
+	{
+		__m256 minimum = _mm256_set1_ps(INFINITY);
+		__m256 maximum = _mm256_set1_ps(-INFINITY);
+
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(points);
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			const uint32_t second = i + 1 < count ? i + 1 : i;
+			const __m256 point = LoadFloat3x2(reinterpret_cast<const float*>(bytes + static_cast<size_t>(i) * strideInBytes), reinterpret_cast<const float*>(bytes + static_cast<size_t>(second) * strideInBytes));
+			minimum = _mm256_min_ps(minimum, point);
+			maximum = _mm256_max_ps(maximum, point);
+		}
+
+		StoreFloat3x2(resultBox, resultBox, _mm256_min_ps(minimum, _mm256_permute2f128_ps(minimum, minimum, 1)), false);
+		StoreFloat3x2(resultBox + 3, resultBox + 3, _mm256_max_ps(maximum, _mm256_permute2f128_ps(maximum, maximum, 1)), false);
+	}
+
+	const Kernels& RetrieveAVX2Kernels()
+	{
+		static const Kernels kernels =
+		{
+			InstructionSet::AVX2,
+			&MatrixMultiplyBatchAVX2,
+			&MatrixInvertBatchAVX2,
+			&MatrixComposeBatchAVX2,
+			&MatrixTransformPointBatchAVX2,
+			&FrustumCullBoxesBatchAVX2,
+			&FrustumCullSpheresBatchAVX2,
+			&BoundingBoxTransformBatchAVX2,
+			&BoundingBoxMergeBatchAVX2,
+			&BoundingBoxFromPointsBatchAVX2
+		};
+
+		return kernels;
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,575 @@
+#pragma once
+#include <cmath>
+#include <cstring>
+#include "MathSIMD.h"
+#include "Vector3.h"
+#include "Quaternion.h"
+#include "Matrix.h"
+
+namespace Amethyst::Math
+{
+	/*
+		Wide types hold eight values of a math type in structure-of-arrays form - a Vector3x8 is eight x, then eight y, then eight z - so that every
+		operation works on eight elements at once while the code using them reads like its scalar counterpart. Transform hierarchies, culling, skinning
+		and particles can be written once against these and run at full width.
+
+		The eight lanes live in a pair of 128-bit registers (SSE2 on x86, NEON on ARM64, plain floats elsewhere). Like the single operations in MathSIMD.h
+		they are inlined at the baseline instruction set: a translation unit built for AVX2 can't share inline functions with the rest of the engine, and
+		with two independent halves in flight the pair keeps the vector units about as busy as one 256-bit register would.
+
+		Every operation follows the formula of its scalar counterpart in the same order and without fused multiply-adds, so lane i of a result is bit for
+		bit what the scalar type computes for element i. Load() packs from arrays of the scalar types and Store() unpacks back into them. A partial Load()
+		repeats the last element into the unused lanes (so count must be at least one) and a partial Store() writes only the first count elements.
+	*/
+
+	class Float8
+	{
+	public:
+		static constexpr uint32_t Width = 8;
+
+		Float8() = default;
+
+		// Same value in every lane.
+		Float8(const float value)
+		{
+#if defined(AMETHYST_SIMD_X86)
+			m_Low = m_High = _mm_set1_ps(value);
+#elif defined(AMETHYST_SIMD_NEON)
+			m_Low = m_High = vdupq_n_f32(value);
+#else
+			for (uint32_t i = 0; i < Width; i++) { m_Lanes[i] = value; }
+#endif
+		}
+
+		static Float8 Load(const float* values)
+		{
+			Float8 result;
+#if defined(AMETHYST_SIMD_X86)
+			result.m_Low = _mm_loadu_ps(values);
+			result.m_High = _mm_loadu_ps(values + 4);
+#elif defined(AMETHYST_SIMD_NEON)
+			result.m_Low = vld1q_f32(values);
+			result.m_High = vld1q_f32(values + 4);
+#else
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = values[i]; }
+#endif
+			return result;
+		}
+
+		// Eight elements a fixed number of floats apart. Built in registers, as writing the lanes out to memory first stalls the load that follows.
+		static Float8 LoadStrided(const float* values, const uint32_t strideInFloats)
+		{
+			Float8 result;
+#if defined(AMETHYST_SIMD_X86)
+			result.m_Low = _mm_setr_ps(values[0], values[strideInFloats], values[strideInFloats * 2], values[strideInFloats * 3]);
+			result.m_High = _mm_setr_ps(values[strideInFloats * 4], values[strideInFloats * 5], values[strideInFloats * 6], values[strideInFloats * 7]);
+#elif defined(AMETHYST_SIMD_NEON)
+			result.m_Low = vdupq_n_f32(values[0]);
+			result.m_Low = vsetq_lane_f32(values[strideInFloats], result.m_Low, 1);
+			result.m_Low = vsetq_lane_f32(values[strideInFloats * 2], result.m_Low, 2);
+			result.m_Low = vsetq_lane_f32(values[strideInFloats * 3], result.m_Low, 3);
+			result.m_High = vdupq_n_f32(values[strideInFloats * 4]);
+			result.m_High = vsetq_lane_f32(values[strideInFloats * 5], result.m_High, 1);
+			result.m_High = vsetq_lane_f32(values[strideInFloats * 6], result.m_High, 2);
+			result.m_High = vsetq_lane_f32(values[strideInFloats * 7], result.m_High, 3);
+#else
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = values[i * strideInFloats]; }
+#endif
+			return result;
+		}
+
+		void Store(float* values) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			_mm_storeu_ps(values, m_Low);
+			_mm_storeu_ps(values + 4, m_High);
+#elif defined(AMETHYST_SIMD_NEON)
+			vst1q_f32(values, m_Low);
+			vst1q_f32(values + 4, m_High);
+#else
+			for (uint32_t i = 0; i < Width; i++) { values[i] = m_Lanes[i]; }
+#endif
+		}
+
+		Float8 operator+(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_add_ps(m_Low, value.m_Low), _mm_add_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vaddq_f32(m_Low, value.m_Low), vaddq_f32(m_High, value.m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = m_Lanes[i] + value.m_Lanes[i]; }
+			return result;
+#endif
+		}
+
+		Float8 operator-(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_sub_ps(m_Low, value.m_Low), _mm_sub_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vsubq_f32(m_Low, value.m_Low), vsubq_f32(m_High, value.m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = m_Lanes[i] - value.m_Lanes[i]; }
+			return result;
+#endif
+		}
+
+		Float8 operator*(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_mul_ps(m_Low, value.m_Low), _mm_mul_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vmulq_f32(m_Low, value.m_Low), vmulq_f32(m_High, value.m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = m_Lanes[i] * value.m_Lanes[i]; }
+			return result;
+#endif
+		}
+
+		Float8 operator/(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_div_ps(m_Low, value.m_Low), _mm_div_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vdivq_f32(m_Low, value.m_Low), vdivq_f32(m_High, value.m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = m_Lanes[i] / value.m_Lanes[i]; }
+			return result;
+#endif
+		}
+
+		Float8 operator-() const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			return Float8(_mm_xor_ps(m_Low, signMask), _mm_xor_ps(m_High, signMask));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vnegq_f32(m_Low), vnegq_f32(m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = -m_Lanes[i]; }
+			return result;
+#endif
+		}
+
+		void operator+=(const Float8& value) { *this = *this + value; }
+		void operator-=(const Float8& value) { *this = *this - value; }
+		void operator*=(const Float8& value) { *this = *this * value; }
+		void operator/=(const Float8& value) { *this = *this / value; }
+
+		// Comparisons return masks, with all bits of a lane set where the comparison holds. Use them with Select(), the bitwise operators and MoveMask().
+		Float8 operator<(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_cmplt_ps(m_Low, value.m_Low), _mm_cmplt_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vreinterpretq_f32_u32(vcltq_f32(m_Low, value.m_Low)), vreinterpretq_f32_u32(vcltq_f32(m_High, value.m_High)));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = LaneMask(m_Lanes[i] < value.m_Lanes[i]); }
+			return result;
+#endif
+		}
+
+		Float8 operator<=(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_cmple_ps(m_Low, value.m_Low), _mm_cmple_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vreinterpretq_f32_u32(vcleq_f32(m_Low, value.m_Low)), vreinterpretq_f32_u32(vcleq_f32(m_High, value.m_High)));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = LaneMask(m_Lanes[i] <= value.m_Lanes[i]); }
+			return result;
+#endif
+		}
+
+		Float8 operator>(const Float8& value) const { return value < *this; }
+		Float8 operator>=(const Float8& value) const { return value <= *this; }
+
+		Float8 operator&(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_and_ps(m_Low, value.m_Low), _mm_and_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(m_Low), vreinterpretq_u32_f32(value.m_Low))), vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(m_High), vreinterpretq_u32_f32(value.m_High))));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = FromBits(ToBits(m_Lanes[i]) & ToBits(value.m_Lanes[i])); }
+			return result;
+#endif
+		}
+
+		Float8 operator|(const Float8& value) const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_or_ps(m_Low, value.m_Low), _mm_or_ps(m_High, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(m_Low), vreinterpretq_u32_f32(value.m_Low))), vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(m_High), vreinterpretq_u32_f32(value.m_High))));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = FromBits(ToBits(m_Lanes[i]) | ToBits(value.m_Lanes[i])); }
+			return result;
+#endif
+		}
+
+		// Bit i is set when the sign bit of lane i is - for a mask, when lane i passed.
+		uint32_t MoveMask() const
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return static_cast<uint32_t>(_mm_movemask_ps(m_Low) | (_mm_movemask_ps(m_High) << 4));
+#elif defined(AMETHYST_SIMD_NEON)
+			static const int32_t laneShifts[4] = { 0, 1, 2, 3 };
+			const int32x4_t shifts = vld1q_s32(laneShifts);
+			const uint32_t low = vaddvq_u32(vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(m_Low), 31), shifts));
+			const uint32_t high = vaddvq_u32(vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(m_High), 31), shifts));
+			return low | (high << 4);
+#else
+			uint32_t result = 0;
+			for (uint32_t i = 0; i < Width; i++) { result |= (ToBits(m_Lanes[i]) >> 31) << i; }
+			return result;
+#endif
+		}
+
+		// Lanes of trueValue where the mask is set, of falseValue elsewhere.
+		static Float8 Select(const Float8& mask, const Float8& trueValue, const Float8& falseValue)
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_or_ps(_mm_and_ps(mask.m_Low, trueValue.m_Low), _mm_andnot_ps(mask.m_Low, falseValue.m_Low)), _mm_or_ps(_mm_and_ps(mask.m_High, trueValue.m_High), _mm_andnot_ps(mask.m_High, falseValue.m_High)));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vbslq_f32(vreinterpretq_u32_f32(mask.m_Low), trueValue.m_Low, falseValue.m_Low), vbslq_f32(vreinterpretq_u32_f32(mask.m_High), trueValue.m_High, falseValue.m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = ToBits(mask.m_Lanes[i]) ? trueValue.m_Lanes[i] : falseValue.m_Lanes[i]; }
+			return result;
+#endif
+		}
+
+		// Pick the first operand unless the second is smaller (or larger), as Utilities::Min and Utilities::Max do.
+		static Float8 Min(const Float8& valueA, const Float8& valueB) { return Select(valueA < valueB, valueA, valueB); }
+		static Float8 Max(const Float8& valueA, const Float8& valueB) { return Select(valueA > valueB, valueA, valueB); }
+
+		static Float8 Absolute(const Float8& value)
+		{
+#if defined(AMETHYST_SIMD_X86)
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			return Float8(_mm_andnot_ps(signMask, value.m_Low), _mm_andnot_ps(signMask, value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vabsq_f32(value.m_Low), vabsq_f32(value.m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = std::fabs(value.m_Lanes[i]); }
+			return result;
+#endif
+		}
+
+		static Float8 SquareRoot(const Float8& value)
+		{
+#if defined(AMETHYST_SIMD_X86)
+			return Float8(_mm_sqrt_ps(value.m_Low), _mm_sqrt_ps(value.m_High));
+#elif defined(AMETHYST_SIMD_NEON)
+			return Float8(vsqrtq_f32(value.m_Low), vsqrtq_f32(value.m_High));
+#else
+			Float8 result;
+			for (uint32_t i = 0; i < Width; i++) { result.m_Lanes[i] = std::sqrt(value.m_Lanes[i]); }
+			return result;
+#endif
+		}
+
+	private:
+#if defined(AMETHYST_SIMD_X86)
+		Float8(const __m128 low, const __m128 high) : m_Low(low), m_High(high) { }
+
+		__m128 m_Low;
+		__m128 m_High;
+#elif defined(AMETHYST_SIMD_NEON)
+		Float8(const float32x4_t low, const float32x4_t high) : m_Low(low), m_High(high) { }
+
+		float32x4_t m_Low;
+		float32x4_t m_High;
+#else
+		static uint32_t ToBits(const float value) { uint32_t bits; std::memcpy(&bits, &value, sizeof(bits)); return bits; }
+		static float FromBits(const uint32_t bits) { float value; std::memcpy(&value, &bits, sizeof(value)); return value; }
+		static float LaneMask(const bool isSet) { return FromBits(isSet ? 0xFFFFFFFFu : 0u); }
+
+		float m_Lanes[Width];
+#endif
+	};
+
+	// Gathers up to eight elements with the given stride into one wide value, repeating the last element into unused lanes.
+	inline Float8 LoadLanes(const float* values, const uint32_t strideInFloats, const uint32_t count)
+	{
+		if (count >= Float8::Width)
+		{
+			return Float8::LoadStrided(values, strideInFloats);
+		}
+
+		float lanes[Float8::Width];
+		for (uint32_t i = 0; i < Float8::Width; i++)
+		{
+			lanes[i] = values[(i < count ? i : count - 1) * strideInFloats];
+		}
+
+		return Float8::Load(lanes);
+	}
+
+	inline void StoreLanes(const Float8& value, float* values, const uint32_t strideInFloats, const uint32_t count)
+	{
+		if (count >= Float8::Width && strideInFloats == 1)
+		{
+			value.Store(values);
+			return;
+		}
+
+		float lanes[Float8::Width];
+		value.Store(lanes);
+
+		for (uint32_t i = 0; i < count && i < Float8::Width; i++)
+		{
+			values[i * strideInFloats] = lanes[i];
+		}
+	}
+
+	class Vector3x8
+	{
+	public:
+		Vector3x8() = default;
+		Vector3x8(const Float8& x, const Float8& y, const Float8& z) : m_X(x), m_Y(y), m_Z(z) { }
+		Vector3x8(const Vector3& vector) : m_X(vector.m_X), m_Y(vector.m_Y), m_Z(vector.m_Z) { } // Same vector in every lane.
+
+		static Vector3x8 Load(const Vector3* vectors, const uint32_t count = Float8::Width)
+		{
+			const float* values = &vectors[0].m_X;
+			return Vector3x8(LoadLanes(values + 0, 3, count), LoadLanes(values + 1, 3, count), LoadLanes(values + 2, 3, count));
+		}
+
+		void Store(Vector3* vectors, const uint32_t count = Float8::Width) const
+		{
+			float* values = &vectors[0].m_X;
+			StoreLanes(m_X, values + 0, 3, count);
+			StoreLanes(m_Y, values + 1, 3, count);
+			StoreLanes(m_Z, values + 2, 3, count);
+		}
+
+		Vector3x8 operator+(const Vector3x8& vector) const { return Vector3x8(m_X + vector.m_X, m_Y + vector.m_Y, m_Z + vector.m_Z); }
+		Vector3x8 operator-(const Vector3x8& vector) const { return Vector3x8(m_X - vector.m_X, m_Y - vector.m_Y, m_Z - vector.m_Z); }
+		Vector3x8 operator*(const Vector3x8& vector) const { return Vector3x8(m_X * vector.m_X, m_Y * vector.m_Y, m_Z * vector.m_Z); }
+		Vector3x8 operator*(const Float8& value) const { return Vector3x8(m_X * value, m_Y * value, m_Z * value); }
+		Vector3x8 operator/(const Float8& value) const { return Vector3x8(m_X / value, m_Y / value, m_Z / value); }
+		Vector3x8 operator-() const { return Vector3x8(-m_X, -m_Y, -m_Z); }
+
+		static Float8 Dot(const Vector3x8& vectorA, const Vector3x8& vectorB) { return vectorA.m_X * vectorB.m_X + vectorA.m_Y * vectorB.m_Y + vectorA.m_Z * vectorB.m_Z; }
+
+		static Vector3x8 Cross(const Vector3x8& vectorA, const Vector3x8& vectorB)
+		{
+			return Vector3x8
+			(
+				vectorA.m_Y * vectorB.m_Z - vectorB.m_Y * vectorA.m_Z,
+				-(vectorA.m_X * vectorB.m_Z - vectorB.m_X * vectorA.m_Z),
+				vectorA.m_X * vectorB.m_Y - vectorB.m_X * vectorA.m_Y
+			);
+		}
+
+		Float8 LengthSquared() const { return m_X * m_X + m_Y * m_Y + m_Z * m_Z; }
+		Float8 Length() const { return Float8::SquareRoot(LengthSquared()); }
+
+		// Lanes that are already unit length (within epsilon) or zero are left as they are, as Vector3::Normalized() does.
+		Vector3x8 Normalized() const
+		{
+			const Float8 lengthSquared = LengthSquared();
+			const Float8 epsilon = Utilities::Episilon;
+			const Float8 one = 1.0f;
+			const Float8 isUnitLength = (lengthSquared + epsilon >= one) & (lengthSquared - epsilon <= one);
+			const Float8 isNormalized = Float8::Select(isUnitLength, Float8(0.0f), lengthSquared > Float8(0.0f));
+
+			const Vector3x8 normalized = *this * (one / Float8::SquareRoot(lengthSquared));
+			return Select(isNormalized, normalized, *this);
+		}
+
+		static Vector3x8 Select(const Float8& mask, const Vector3x8& trueValue, const Vector3x8& falseValue)
+		{
+			return Vector3x8(Float8::Select(mask, trueValue.m_X, falseValue.m_X), Float8::Select(mask, trueValue.m_Y, falseValue.m_Y), Float8::Select(mask, trueValue.m_Z, falseValue.m_Z));
+		}
+
+		static Vector3x8 Min(const Vector3x8& vectorA, const Vector3x8& vectorB) { return Vector3x8(Float8::Min(vectorA.m_X, vectorB.m_X), Float8::Min(vectorA.m_Y, vectorB.m_Y), Float8::Min(vectorA.m_Z, vectorB.m_Z)); }
+		static Vector3x8 Max(const Vector3x8& vectorA, const Vector3x8& vectorB) { return Vector3x8(Float8::Max(vectorA.m_X, vectorB.m_X), Float8::Max(vectorA.m_Y, vectorB.m_Y), Float8::Max(vectorA.m_Z, vectorB.m_Z)); }
+
+	public:
+		Float8 m_X;
+		Float8 m_Y;
+		Float8 m_Z;
+	};
+
+	class Quaternionx8
+	{
+	public:
+		Quaternionx8() = default;
+		Quaternionx8(const Float8& x, const Float8& y, const Float8& z, const Float8& w) : x(x), y(y), z(z), w(w) { }
+		Quaternionx8(const Quaternion& quaternion) : x(quaternion.x), y(quaternion.y), z(quaternion.z), w(quaternion.w) { } // Same quaternion in every lane.
+
+		static Quaternionx8 Load(const Quaternion* quaternions, const uint32_t count = Float8::Width)
+		{
+			const float* values = &quaternions[0].x;
+			return Quaternionx8(LoadLanes(values + 0, 4, count), LoadLanes(values + 1, 4, count), LoadLanes(values + 2, 4, count), LoadLanes(values + 3, 4, count));
+		}
+
+		void Store(Quaternion* quaternions, const uint32_t count = Float8::Width) const
+		{
+			float* values = &quaternions[0].x;
+			StoreLanes(x, values + 0, 4, count);
+			StoreLanes(y, values + 1, 4, count);
+			StoreLanes(z, values + 2, 4, count);
+			StoreLanes(w, values + 3, 4, count);
+		}
+
+		// Same as Quaternion::Multiply().
+		Quaternionx8 operator*(const Quaternionx8& quaternion) const
+		{
+			const Float8 num12 = (y * quaternion.z) - (z * quaternion.y);
+			const Float8 num11 = (z * quaternion.x) - (x * quaternion.z);
+			const Float8 num10 = (x * quaternion.y) - (y * quaternion.x);
+			const Float8 num9 = ((x * quaternion.x) + (y * quaternion.y)) + (z * quaternion.z);
+
+			return Quaternionx8
+			(
+				((x * quaternion.w) + (quaternion.x * w)) + num12,
+				((y * quaternion.w) + (quaternion.y * w)) + num11,
+				((z * quaternion.w) + (quaternion.z * w)) + num10,
+				(w * quaternion.w) - num9
+			);
+		}
+
+		// Rotates a vector.
+		Vector3x8 operator*(const Vector3x8& vector) const
+		{
+			const Vector3x8 quaternionVector(x, y, z);
+			const Vector3x8 cross1 = Vector3x8::Cross(quaternionVector, vector);
+			const Vector3x8 cross2 = Vector3x8::Cross(quaternionVector, cross1);
+
+			return vector + (cross1 * w + cross2) * Float8(2.0f);
+		}
+
+	public:
+		Float8 x;
+		Float8 y;
+		Float8 z;
+		Float8 w;
+	};
+
+	// Elements are numbered like Matrix's memory - column by column, so m_Elements[1] is m10 and m_Elements[12] is m03.
+	class Matrix4x8
+	{
+	public:
+		Matrix4x8() = default;
+
+		Matrix4x8(const Matrix& matrix) // Same matrix in every lane.
+		{
+			const float* values = matrix.Data();
+			for (int i = 0; i < 16; i++)
+			{
+				m_Elements[i] = values[i];
+			}
+		}
+
+		// Translation, rotation and scale, as Matrix(translation, rotation, scale) builds them.
+		Matrix4x8(const Vector3x8& translation, const Quaternionx8& rotation, const Vector3x8& scale)
+		{
+			const Float8 num9 = rotation.x * rotation.x;
+			const Float8 num8 = rotation.y * rotation.y;
+			const Float8 num7 = rotation.z * rotation.z;
+			const Float8 num6 = rotation.x * rotation.y;
+			const Float8 num5 = rotation.z * rotation.w;
+			const Float8 num4 = rotation.z * rotation.x;
+			const Float8 num3 = rotation.y * rotation.w;
+			const Float8 num2 = rotation.y * rotation.z;
+			const Float8 num = rotation.x * rotation.w;
+			const Float8 one = 1.0f;
+			const Float8 two = 2.0f;
+
+			m_Elements[0] = scale.m_X * (one - (two * (num8 + num7)));
+			m_Elements[1] = scale.m_Y * (two * (num6 - num5));
+			m_Elements[2] = scale.m_Z * (two * (num4 + num3));
+			m_Elements[3] = translation.m_X;
+
+			m_Elements[4] = scale.m_X * (two * (num6 + num5));
+			m_Elements[5] = scale.m_Y * (one - (two * (num7 + num9)));
+			m_Elements[6] = scale.m_Z * (two * (num2 - num));
+			m_Elements[7] = translation.m_Y;
+
+			m_Elements[8] = scale.m_X * (two * (num4 - num3));
+			m_Elements[9] = scale.m_Y * (two * (num2 + num));
+			m_Elements[10] = scale.m_Z * (one - (two * (num8 + num9)));
+			m_Elements[11] = translation.m_Z;
+
+			m_Elements[12] = 0.0f;
+			m_Elements[13] = 0.0f;
+			m_Elements[14] = 0.0f;
+			m_Elements[15] = one;
+		}
+
+		static Matrix4x8 Load(const Matrix* matrices, const uint32_t count = Float8::Width)
+		{
+			Matrix4x8 result;
+			for (int i = 0; i < 16; i++)
+			{
+				result.m_Elements[i] = LoadLanes(matrices[0].Data() + i, 16, count);
+			}
+
+			return result;
+		}
+
+		void Store(Matrix* matrices, const uint32_t count = Float8::Width) const
+		{
+			float* values = &matrices[0].m00;
+			for (int i = 0; i < 16; i++)
+			{
+				StoreLanes(m_Elements[i], values + i, 16, count);
+			}
+		}
+
+		Matrix4x8 operator*(const Matrix4x8& matrix) const
+		{
+			Matrix4x8 result;
+			for (int column = 0; column < 4; column++)
+			{
+				for (int row = 0; row < 4; row++)
+				{
+					result.m_Elements[column * 4 + row] = m_Elements[row] * matrix.m_Elements[column * 4] + m_Elements[4 + row] * matrix.m_Elements[column * 4 + 1] +
+														  m_Elements[8 + row] * matrix.m_Elements[column * 4 + 2] + m_Elements[12 + row] * matrix.m_Elements[column * 4 + 3];
+				}
+			}
+
+			return result;
+		}
+
+		// With perspective divide, as Matrix * Vector3.
+		Vector3x8 TransformPoint(const Vector3x8& point) const
+		{
+			const Float8 x = (m_Elements[0] * point.m_X) + (m_Elements[1] * point.m_Y) + (m_Elements[2] * point.m_Z) + m_Elements[3];
+			const Float8 y = (m_Elements[4] * point.m_X) + (m_Elements[5] * point.m_Y) + (m_Elements[6] * point.m_Z) + m_Elements[7];
+			const Float8 z = (m_Elements[8] * point.m_X) + (m_Elements[9] * point.m_Y) + (m_Elements[10] * point.m_Z) + m_Elements[11];
+			const Float8 w = Float8(1.0f) / ((m_Elements[12] * point.m_X) + (m_Elements[13] * point.m_Y) + (m_Elements[14] * point.m_Z) + m_Elements[15]);
+
+			return Vector3x8(x * w, y * w, z * w);
+		}
+
+		// Rotation and scale only, for directions and normals.
+		Vector3x8 TransformDirection(const Vector3x8& direction) const
+		{
+			return Vector3x8
+			(
+				(m_Elements[0] * direction.m_X) + (m_Elements[1] * direction.m_Y) + (m_Elements[2] * direction.m_Z),
+				(m_Elements[4] * direction.m_X) + (m_Elements[5] * direction.m_Y) + (m_Elements[6] * direction.m_Z),
+				(m_Elements[8] * direction.m_X) + (m_Elements[9] * direction.m_Y) + (m_Elements[10] * direction.m_Z)
+			);
+		}
+
+	public:
+		Float8 m_Elements[16];
+	};
+}
\ No newline at end of file
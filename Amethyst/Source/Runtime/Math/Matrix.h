@@ -3,6 +3,7 @@
 #include "Vector4.h"
 #include "Quaternion.h"
 #include "MathUtilities.h"
+#include "MathSIMD.h"
 
 namespace Amethyst::Math
 {
@@ -10,6 +11,9 @@ namespace Amethyst::Math
 	/*
 		Column Majoring Ordering. Remember that while it is safe to assign matrix values regardless of memory ordering, always return new matrix constructions in 
 		column-major ordering (swap the places of our value variables accordingly).
+
+		Multiplication, inversion, TRS construction and decomposition go through the SIMD kernels in MathSIMD.h, which read and write this exact layout.
+		The batch functions below use the widest instruction set the CPU supports.
 	*/
 	
 	class Matrix
@@ -41,12 +45,7 @@ namespace Amethyst::Math
 
 		Matrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
 		{
-			const Matrix m_Rotation = CreateRotation(rotation);
-
-			m00 = scale.m_X * m_Rotation.m00; m01 = scale.m_X * m_Rotation.m01; m02 = scale.m_X * m_Rotation.m02; m03 = 0.0f;
-			m10 = scale.m_Y * m_Rotation.m10; m11 = scale.m_Y * m_Rotation.m11; m12 = scale.m_Y * m_Rotation.m12; m13 = 0.0f;
-			m20 = scale.m_Z * m_Rotation.m20; m21 = scale.m_Z * m_Rotation.m21; m22 = scale.m_Z * m_Rotation.m22; m23 = 0.0f;
-			m30 = translation.m_X;			  m31 = translation.m_Y;		    m32 = translation.m_Z;			  m33 = 1.0f;
+			SIMD::MatrixCompose(&translation.m_X, &rotation.x, &scale.m_X, &m00);
 		}
 		
 		~Matrix() = default;
@@ -99,18 +98,17 @@ namespace Amethyst::Math
 
 		[[nodiscard]] Quaternion RetrieveRotation() const
 		{
-			const Vector3 scale = RetrieveScale();
+			return RetrieveRotation(RetrieveScale());
+		}
 
+		[[nodiscard]] Quaternion RetrieveRotation(const Vector3& scale) const
+		{
 			//Avoid division by 0 (we will divide to remove scaling).
 			if (scale.m_X == 0.0f || scale.m_Y == 0.0f || scale.m_Z == 0.0f) { return Quaternion(0, 0, 0, 1); }
 
 			//Extract rotation and remove scaling. 
 			Matrix normalizedMatrix;
-
-			normalizedMatrix.m00 = m00 / scale.m_X; normalizedMatrix.m01 = m01 / scale.m_X; normalizedMatrix.m02 = m02 / scale.m_X; normalizedMatrix.m03 = 0.0f;
-			normalizedMatrix.m10 = m10 / scale.m_Y; normalizedMatrix.m11 = m11 / scale.m_Y; normalizedMatrix.m12 = m12 / scale.m_Y; normalizedMatrix.m13 = 0.0f;
-			normalizedMatrix.m20 = m20 / scale.m_Z; normalizedMatrix.m21 = m21 / scale.m_Z; normalizedMatrix.m22 = m22 / scale.m_Z; normalizedMatrix.m23 = 0.0f;
-			normalizedMatrix.m30 = 0.0f;            normalizedMatrix.m31 = 0.0f;			normalizedMatrix.m32 = 0.0f;			normalizedMatrix.m33 = 1.0f;
+			SIMD::MatrixRemoveScale(&m00, &scale.m_X, &normalizedMatrix.m00);
 		
 			return RotationMatrixToQuaternion(normalizedMatrix);
 		}
@@ -172,16 +170,11 @@ namespace Amethyst::Math
 		//Scale
 		[[nodiscard]] Vector3 RetrieveScale() const
 		{
-			//Check if our values are signed. Remember that our scale is made up 3 main values.
-			const int xSigned = (Utilities::Sign(m00 * m01 * m02 * m03) < 0) ? -1 : 1;
-			const int ySigned = (Utilities::Sign(m10 * m11 * m12 * m13) < 0) ? -1 : 1;
-			const int zSigned = (Utilities::Sign(m20 * m21 * m22 * m23) < 0) ? -1 : 1;
-
-			return Vector3(
-				static_cast<float>(xSigned) * Utilities::SquareRoot(m00 * m00 + m01 * m01 + m02 * m02),
-				static_cast<float>(ySigned) * Utilities::SquareRoot(m10 * m10 + m11 * m11 + m12 * m12),
-				static_cast<float>(zSigned) * Utilities::SquareRoot(m20 * m20 + m21 * m21 * m22 * m22)
-			);
+			//The length of each of the first three rows, signed by the product of that row. Remember that our scale is made up 3 main values.
+			Vector3 scale;
+			SIMD::MatrixRetrieveScale(&m00, &scale.m_X);
+
+			return scale;
 		}
 
 		static inline Matrix CreateScale(float scale) { return CreateScale(scale, scale, scale); }
@@ -259,7 +252,7 @@ namespace Amethyst::Math
 		{
 			translation = RetrieveTranslation();
 			scale = RetrieveScale();
-			rotation = RetrieveRotation();
+			rotation = RetrieveRotation(scale);
 		}
 
 		void SetIdentity()
@@ -273,47 +266,26 @@ namespace Amethyst::Math
 		//Multiplication
 		Vector3 operator*(const Vector3& vector) const
 		{
-			Vector4 workingVector;
+			Vector3 result;
+			SIMD::MatrixTransformPoint(&m00, &vector.m_X, &result.m_X);
 
-			workingVector.m_X = (m00 * vector.m_X) + (m10 * vector.m_X) + (m20 * vector.m_Z) + m30;
-			workingVector.m_Y = (m01 * vector.m_X) + (m11 * vector.m_Y) + (m21 * vector.m_Z) + m31;
-			workingVector.m_Z = (m02 * vector.m_Z) + (m12 * vector.m_Z) + (m22 * vector.m_Z) + m32;
-			workingVector.m_W = 1 / ((m03 * vector.m_X) + (m13 * vector.m_Z) + (m23 * vector.m_Z) + m33); ///
-
-			return Vector3(workingVector.m_X * workingVector.m_W, workingVector.m_Y * workingVector.m_W, workingVector.m_Z * workingVector.m_W);
+			return result;
 		}
 
 		Vector4 operator*(const Vector4& vector) const
 		{
-			return Vector4
-			{
-				((m00 * vector.m_X) + (m10 * vector.m_Y) + (m20 * vector.m_Z) + (m30 * vector.m_W)),
-				((m01 * vector.m_X) + (m11 * vector.m_Y) + (m21 * vector.m_Z) + (m31 * vector.m_W)),
-				((m02 * vector.m_X) + (m12 * vector.m_Y) + (m22 * vector.m_Z) + (m32 * vector.m_W)),
-				((m03 * vector.m_X) + (m13 * vector.m_Y) + (m23 * vector.m_Z) + (m33 * vector.m_W))
-			};
+			Vector4 result;
+			SIMD::MatrixTransformVector4(&m00, &vector.m_X, &result.m_X);
+
+			return result;
 		}
 
 		Matrix operator*(const Matrix& matrix) const
 		{
-			return Matrix(
-				m00 * matrix.m00 + m01 * matrix.m10 + m02 * matrix.m20 + m03 * matrix.m30,
-				m00 * matrix.m01 + m01 * matrix.m11 + m02 * matrix.m21 + m03 * matrix.m31,
-				m00 * matrix.m02 + m01 * matrix.m12 + m02 * matrix.m22 + m03 * matrix.m32,
-				m00 * matrix.m03 + m01 * matrix.m13 + m02 * matrix.m23 + m03 * matrix.m33,
-				m10 * matrix.m00 + m11 * matrix.m10 + m12 * matrix.m20 + m13 * matrix.m30,
-				m10 * matrix.m01 + m11 * matrix.m11 + m12 * matrix.m21 + m13 * matrix.m31,
-				m10 * matrix.m02 + m11 * matrix.m12 + m12 * matrix.m22 + m13 * matrix.m32,
-				m10 * matrix.m03 + m11 * matrix.m13 + m12 * matrix.m23 + m13 * matrix.m33,
-				m20 * matrix.m00 + m21 * matrix.m10 + m22 * matrix.m20 + m23 * matrix.m30,
-				m20 * matrix.m01 + m21 * matrix.m11 + m22 * matrix.m21 + m23 * matrix.m31,
-				m20 * matrix.m02 + m21 * matrix.m12 + m22 * matrix.m22 + m23 * matrix.m32,
-				m20 * matrix.m03 + m21 * matrix.m13 + m22 * matrix.m23 + m23 * matrix.m33,
-				m30 * matrix.m00 + m31 * matrix.m10 + m32 * matrix.m20 + m33 * matrix.m30,
-				m30 * matrix.m01 + m31 * matrix.m11 + m32 * matrix.m21 + m33 * matrix.m31,
-				m30 * matrix.m02 + m31 * matrix.m12 + m32 * matrix.m22 + m33 * matrix.m32,
-				m30 * matrix.m03 + m31 * matrix.m13 + m32 * matrix.m23 + m33 * matrix.m33
-			);
+			Matrix result;
+			SIMD::MatrixMultiply(&m00, &matrix.m00, &result.m00);
+
+			return result;
 		}
 		
 		//Comparison
@@ -340,59 +312,31 @@ namespace Amethyst::Math
 		[[nodiscard]] Matrix Inverted() const { return Invert(*this); }
 		static inline Matrix Invert(const Matrix& matrix)
 		{
-			float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
-			float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
-			float v2 = matrix.m20 * matrix.m33 - matrix.m23 * matrix.m30;
-			float v3 = matrix.m21 * matrix.m32 - matrix.m22 * matrix.m31;
-			float v4 = matrix.m21 * matrix.m33 - matrix.m23 * matrix.m31;
-			float v5 = matrix.m22 * matrix.m33 - matrix.m23 * matrix.m32;
-
-			float i00 = (v5 * matrix.m11 - v4 * matrix.m12 + v3 * matrix.m13);
-			float i10 = -(v5 * matrix.m10 - v2 * matrix.m12 + v1 * matrix.m13);
-			float i20 = (v4 * matrix.m10 - v2 * matrix.m11 + v0 * matrix.m13);
-			float i30 = -(v3 * matrix.m10 - v1 * matrix.m11 + v0 * matrix.m12);
-
-			const float invDet = 1.0f / (i00 * matrix.m00 + i10 * matrix.m01 + i20 * matrix.m02 + i30 * matrix.m03);
-
-			i00 *= invDet;
-			i10 *= invDet;
-			i20 *= invDet;
-			i30 *= invDet;
-
-			const float i01 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			const float i11 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			const float i21 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			const float i31 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			v0 = matrix.m10 * matrix.m31 - matrix.m11 * matrix.m30;
-			v1 = matrix.m10 * matrix.m32 - matrix.m12 * matrix.m30;
-			v2 = matrix.m10 * matrix.m33 - matrix.m13 * matrix.m30;
-			v3 = matrix.m11 * matrix.m32 - matrix.m12 * matrix.m31;
-			v4 = matrix.m11 * matrix.m33 - matrix.m13 * matrix.m31;
-			v5 = matrix.m12 * matrix.m33 - matrix.m13 * matrix.m32;
-
-			const float i02 = (v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			const float i12 = -(v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			const float i22 = (v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			const float i32 = -(v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			v0 = matrix.m21 * matrix.m10 - matrix.m20 * matrix.m11;
-			v1 = matrix.m22 * matrix.m10 - matrix.m20 * matrix.m12;
-			v2 = matrix.m23 * matrix.m10 - matrix.m20 * matrix.m13;
-			v3 = matrix.m22 * matrix.m11 - matrix.m21 * matrix.m12;
-			v4 = matrix.m23 * matrix.m11 - matrix.m21 * matrix.m13;
-			v5 = matrix.m23 * matrix.m12 - matrix.m22 * matrix.m13;
-
-			const float i03 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			const float i13 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			const float i23 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			const float i33 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
+			Matrix result;
+			SIMD::MatrixInvert(&matrix.m00, &result.m00);
 
-			return Matrix(
-				i00, i01, i02, i03,
-				i10, i11, i12, i13,
-				i20, i21, i22, i23,
-				i30, i31, i32, i33);
+			return result;
+		}
+
+		// Batches - Arrays of equal length. Results may be written in place over the inputs.
+		static inline void Multiply(const Matrix* leftMatrices, const Matrix* rightMatrices, Matrix* resultMatrices, const uint32_t count)
+		{
+			SIMD::RetrieveKernels().m_MatrixMultiplyBatch(&leftMatrices->m00, &rightMatrices->m00, &resultMatrices->m00, count);
+		}
+
+		static inline void Invert(const Matrix* matrices, Matrix* resultMatrices, const uint32_t count)
+		{
+			SIMD::RetrieveKernels().m_MatrixInvertBatch(&matrices->m00, &resultMatrices->m00, count);
+		}
+
+		static inline void Compose(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix* resultMatrices, const uint32_t count)
+		{
+			SIMD::RetrieveKernels().m_MatrixComposeBatch(&translations->m_X, &rotations->x, &scales->m_X, &resultMatrices->m00, count);
+		}
+
+		void TransformPoints(const Vector3* points, Vector3* resultPoints, const uint32_t count) const
+		{
+			SIMD::RetrieveKernels().m_MatrixTransformPointBatch(&m00, &points->m_X, &resultPoints->m_X, count);
 		}
 
 		[[nodiscard]] const float* Data() const { return &m00; }
@@ -1,8 +1,47 @@
 #include "Amethyst.h"
 #include "Ray.h"
+#include "RayHit.h"
+#include "Plane.h"
+#include "../RHI/RHI_Vertex.h"
 
 namespace Amethyst::Math
 {
+	// Slab test - the ray enters the box at the last of its three entry distances and leaves at the first exit. Empty boxes are never hit.
+	static Float8 HitDistanceBoxes(const Vector3x8& start, const Vector3x8& directionInverse, const Vector3x8& boxMinimum, const Vector3x8& boxMaximum)
+	{
+		const Vector3x8 distances1 = (boxMinimum - start) * directionInverse;
+		const Vector3x8 distances2 = (boxMaximum - start) * directionInverse;
+		const Vector3x8 distancesNear = Vector3x8::Min(distances1, distances2);
+		const Vector3x8 distancesFar = Vector3x8::Max(distances1, distances2);
+
+		const Float8 distanceNear = Float8::Max(Float8::Max(distancesNear.m_X, distancesNear.m_Y), distancesNear.m_Z);
+		const Float8 distanceFar = Float8::Min(Float8::Min(distancesFar.m_X, distancesFar.m_Y), distancesFar.m_Z);
+		const Float8 distance = Float8::Max(distanceNear, Float8(0.0f));
+
+		const Float8 isHit = (distanceFar >= distance) & (boxMinimum.m_X <= boxMaximum.m_X);
+		return Float8::Select(isHit, distance, Float8(Utilities::Infinity));
+	}
+
+	// Möller-Trumbore.
+	static Float8 HitDistanceTriangles(const Vector3x8& start, const Vector3x8& direction, const Vector3x8& vector1, const Vector3x8& vector2, const Vector3x8& vector3)
+	{
+		const Vector3x8 edge1 = vector2 - vector1;
+		const Vector3x8 edge2 = vector3 - vector1;
+		const Vector3x8 p = Vector3x8::Cross(direction, edge2);
+		const Float8 determinant = Vector3x8::Dot(edge1, p);
+		const Float8 determinantInverse = Float8(1.0f) / determinant;
+
+		const Vector3x8 startFromVertex = start - vector1;
+		const Float8 u = Vector3x8::Dot(startFromVertex, p) * determinantInverse;
+		const Vector3x8 q = Vector3x8::Cross(startFromVertex, edge1);
+		const Float8 v = Vector3x8::Dot(direction, q) * determinantInverse;
+		const Float8 distance = Vector3x8::Dot(edge2, q) * determinantInverse;
+
+		const Float8 zero = 0.0f;
+		const Float8 isHit = (Float8::Absolute(determinant) >= Float8(Utilities::Episilon)) & (u >= zero) & (v >= zero) & (u + v <= Float8(1.0f)) & (distance >= zero);
+		return Float8::Select(isHit, distance, Float8(Utilities::Infinity));
+	}
+
 	Ray::Ray(const Vector3& start, const Vector3& end)
 	{
 		m_Start = start;
@@ -15,27 +54,214 @@ namespace Amethyst::Math
 	float Ray::HitDistance(const BoundingBox& box) const
 	{
 		// If undefined, no hit is registered (obviously). We return an infinite distance.
-		if (!box.IsDefined())
+		if (!box.IsDefined() || box.RetrieveMinimum().m_X > box.RetrieveMaximum().m_X)
+		{
+			return Utilities::Infinity;
+		}
+
+		const Vector3& minimum = box.RetrieveMinimum();
+		const Vector3& maximum = box.RetrieveMaximum();
+		const Vector3 directionInverse = Vector3(1.0f / m_Direction.m_X, 1.0f / m_Direction.m_Y, 1.0f / m_Direction.m_Z);
+		const Vector3 distances1 = (minimum - m_Start) * directionInverse;
+		const Vector3 distances2 = (maximum - m_Start) * directionInverse;
+
+		// Entry and exit distances for each pair of parallel planes. We are inside the box between the last entry and the first exit.
+		const float distanceNear = Utilities::Max(Utilities::Max(Utilities::Min(distances1.m_X, distances2.m_X), Utilities::Min(distances1.m_Y, distances2.m_Y)), Utilities::Min(distances1.m_Z, distances2.m_Z));
+		const float distanceFar = Utilities::Min(Utilities::Min(Utilities::Max(distances1.m_X, distances2.m_X), Utilities::Max(distances1.m_Y, distances2.m_Y)), Utilities::Max(distances1.m_Z, distances2.m_Z));
+
+		// If our ray's origin is inside the box, the distance is zero.
+		const float distance = Utilities::Max(distanceNear, 0.0f);
+		return distanceFar >= distance ? distance : Utilities::Infinity;
+	}
+
+	float Ray::HitDistance(const Plane& plane, Vector3* intersectionPoint /*= nullptr*/) const
+	{
+		// Parallel rays never meet the plane.
+		const float denominator = plane.m_Normal.Dot(m_Direction);
+		if (Utilities::Absolute(denominator) < Utilities::Episilon)
+		{
+			return Utilities::Infinity;
+		}
+
+		const float distance = -(plane.m_Normal.Dot(m_Start) + plane.m_DistanceFromOrigin) / denominator;
+		if (distance < 0.0f)
+		{
+			return Utilities::Infinity;
+		}
+
+		if (intersectionPoint)
+		{
+			*intersectionPoint = m_Start + m_Direction * distance;
+		}
+
+		return distance;
+	}
+
+	float Ray::HitDistance(const Vector3& vector1, const Vector3& vector2, const Vector3& vector3, Vector3* outNormal /*= nullptr*/, Vector3* outBary /*= nullptr*/) const
+	{
+		const Vector3 edge1 = vector2 - vector1;
+		const Vector3 edge2 = vector3 - vector1;
+		const Vector3 p = Vector3::Cross(m_Direction, edge2);
+		const float determinant = Vector3::Dot(edge1, p);
+
+		// Parallel to the triangle's plane.
+		if (Utilities::Absolute(determinant) < Utilities::Episilon)
 		{
 			return Utilities::Infinity;
 		}
 
-		// Check if our ray's origin is inside the box.
-		if (box.IsInside(m_Start))
+		const float determinantInverse = 1.0f / determinant;
+		const Vector3 startFromVertex = m_Start - vector1;
+		const float u = Vector3::Dot(startFromVertex, p) * determinantInverse;
+		const Vector3 q = Vector3::Cross(startFromVertex, edge1);
+		const float v = Vector3::Dot(m_Direction, q) * determinantInverse;
+		const float distance = Vector3::Dot(edge2, q) * determinantInverse;
+
+		// Outside one of the edges, or behind us.
+		if (u < 0.0f || v < 0.0f || u + v > 1.0f || distance < 0.0f)
 		{
-			return 0.0f;
+			return Utilities::Infinity;
 		}
 
-		float distance = Utilities::Infinity;
+		if (outNormal)
+		{
+			*outNormal = Vector3::Cross(edge1, edge2).Normalized();
+		}
 
-		// Check for intersection in the X direction.
-		if (m_Start.m_X < box.RetrieveMinimum().m_X && m_Direction.m_X > 0.0f)
+		if (outBary)
 		{
-			const float x = (box.RetrieveMinimum().m_X - m_Start.m_X) / m_Direction.m_X;
-			if (x < distance)
+			*outBary = Vector3(1.0f - u - v, u, v);
+		}
+
+		return distance;
+	}
+
+	Float8 Ray::HitDistance(const Vector3x8& boxMinimum, const Vector3x8& boxMaximum) const
+	{
+		const Vector3 directionInverse = Vector3(1.0f / m_Direction.m_X, 1.0f / m_Direction.m_Y, 1.0f / m_Direction.m_Z);
+		return HitDistanceBoxes(Vector3x8(m_Start), Vector3x8(directionInverse), boxMinimum, boxMaximum);
+	}
+
+	Float8 Ray::HitDistance(const Vector3x8& vector1, const Vector3x8& vector2, const Vector3x8& vector3) const
+	{
+		return HitDistanceTriangles(Vector3x8(m_Start), Vector3x8(m_Direction), vector1, vector2, vector3);
+	}
+
+	void Ray::HitDistances(const BoundingBox* boxes, const uint32_t boxCount, float* distances) const
+	{
+		const Vector3x8 start = Vector3x8(m_Start);
+		const Vector3x8 directionInverse = Vector3x8(Vector3(1.0f / m_Direction.m_X, 1.0f / m_Direction.m_Y, 1.0f / m_Direction.m_Z));
+
+		for (uint32_t first = 0; first < boxCount; first += Float8::Width)
+		{
+			// Boxes are a minimum and a maximum, 6 floats apart.
+			const uint32_t laneCount = Utilities::Min(Float8::Width, boxCount - first);
+			const float* values = &boxes[first].RetrieveMinimum().m_X;
+			const Vector3x8 minimum = Vector3x8(LoadLanes(values + 0, 6, laneCount), LoadLanes(values + 1, 6, laneCount), LoadLanes(values + 2, 6, laneCount));
+			const Vector3x8 maximum = Vector3x8(LoadLanes(values + 3, 6, laneCount), LoadLanes(values + 4, 6, laneCount), LoadLanes(values + 5, 6, laneCount));
+
+			StoreLanes(HitDistanceBoxes(start, directionInverse, minimum, maximum), distances + first, 1, laneCount);
+		}
+	}
+
+	float Ray::HitDistance(const RHI_Vertex_PositionTextureNormalTangent* vertices, const uint32_t* indices, const uint32_t indexCount, uint32_t* triangleIndex /*= nullptr*/) const
+	{
+		const Vector3x8 start = Vector3x8(m_Start);
+		const Vector3x8 direction = Vector3x8(m_Direction);
+		const uint32_t triangleCount = indexCount / 3;
+
+		float closestDistance = Utilities::Infinity;
+		uint32_t closestTriangle = 0;
+
+		for (uint32_t first = 0; first < triangleCount; first += Float8::Width)
+		{
+			// Gather eight triangles' corners straight out of the vertex buffer. Unused lanes repeat the last triangle.
+			const uint32_t laneCount = Utilities::Min(Float8::Width, triangleCount - first);
+			float corners[3][3][Float8::Width]; // Corner, axis, lane.
+			for (uint32_t lane = 0; lane < Float8::Width; lane++)
 			{
+				const uint32_t triangle = first + Utilities::Min(lane, laneCount - 1);
+				for (uint32_t corner = 0; corner < 3; corner++)
+				{
+					const float* position = vertices[indices[triangle * 3 + corner]].m_Position;
+					corners[corner][0][lane] = position[0];
+					corners[corner][1][lane] = position[1];
+					corners[corner][2][lane] = position[2];
+				}
+			}
+
+			const Vector3x8 vector1 = Vector3x8(Float8::Load(corners[0][0]), Float8::Load(corners[0][1]), Float8::Load(corners[0][2]));
+			const Vector3x8 vector2 = Vector3x8(Float8::Load(corners[1][0]), Float8::Load(corners[1][1]), Float8::Load(corners[1][2]));
+			const Vector3x8 vector3 = Vector3x8(Float8::Load(corners[2][0]), Float8::Load(corners[2][1]), Float8::Load(corners[2][2]));
+			const Float8 distance = HitDistanceTriangles(start, direction, vector1, vector2, vector3);
 
+			// Most groups miss entirely.
+			if ((distance < Float8(closestDistance)).MoveMask() == 0)
+			{
+				continue;
+			}
+
+			float distances[Float8::Width];
+			distance.Store(distances);
+			for (uint32_t lane = 0; lane < laneCount; lane++)
+			{
+				if (distances[lane] < closestDistance)
+				{
+					closestDistance = distances[lane];
+					closestTriangle = first + lane;
+				}
 			}
 		}
+
+		if (triangleIndex)
+		{
+			*triangleIndex = closestTriangle;
+		}
+
+		return closestDistance;
+	}
+
+	bool Ray::Trace(const std::shared_ptr<Entity>& entity, const RHI_Vertex_PositionTextureNormalTangent* vertices, const uint32_t* indices, const uint32_t indexCount, RayHit* hit) const
+	{
+		const float distance = HitDistance(vertices, indices, indexCount);
+		if (distance == Utilities::Infinity)
+		{
+			return false;
+		}
+
+		*hit = RayHit(entity, m_Start + m_Direction * distance, distance, false);
+		return true;
+	}
+
+	RayPacket::RayPacket(const Ray* rays, const uint32_t count /*= Float8::Width*/)
+	{
+		float values[7][Float8::Width]; // Start, direction and length, component by component.
+		for (uint32_t lane = 0; lane < Float8::Width; lane++)
+		{
+			const Ray& ray = rays[Utilities::Min(lane, count - 1)];
+			values[0][lane] = ray.RetrieveStart().m_X;
+			values[1][lane] = ray.RetrieveStart().m_Y;
+			values[2][lane] = ray.RetrieveStart().m_Z;
+			values[3][lane] = ray.RetrieveDirection().m_X;
+			values[4][lane] = ray.RetrieveDirection().m_Y;
+			values[5][lane] = ray.RetrieveDirection().m_Z;
+			values[6][lane] = ray.RetrieveLength();
+		}
+
+		m_Start = Vector3x8(Float8::Load(values[0]), Float8::Load(values[1]), Float8::Load(values[2]));
+		m_Direction = Vector3x8(Float8::Load(values[3]), Float8::Load(values[4]), Float8::Load(values[5]));
+		m_Length = Float8::Load(values[6]);
+	}
+
+	Float8 RayPacket::HitDistance(const BoundingBox& box) const
+	{
+		const Float8 one = 1.0f;
+		const Vector3x8 directionInverse = Vector3x8(one / m_Direction.m_X, one / m_Direction.m_Y, one / m_Direction.m_Z);
+		return HitDistanceBoxes(m_Start, directionInverse, Vector3x8(box.RetrieveMinimum()), Vector3x8(box.RetrieveMaximum()));
+	}
+
+	Float8 RayPacket::HitDistance(const Vector3& vector1, const Vector3& vector2, const Vector3& vector3) const
+	{
+		return HitDistanceTriangles(m_Start, m_Direction, Vector3x8(vector1), Vector3x8(vector2), Vector3x8(vector3));
 	}
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
+#include <memory>
 #include "Vector3.h"
+#include "MathWide.h"
 #include "../Core/AmethystDefinitions.h"
 
 namespace Amethyst
 {
 	class Context;
+	class Entity;
+	struct RHI_Vertex_PositionTextureNormalTangent;
 
 	namespace Math
 	{
@@ -12,6 +16,11 @@ namespace Amethyst
 		class BoundingBox;
 		class Plane;
 
+		/*
+			Distances are along the normalized direction and aren't clipped to the ray's length - compare against RetrieveLength() where that matters.
+			Triangles are two-sided. The wide tests (eight boxes or triangles per call, or eight rays in a RayPacket) evaluate the same formulas in the
+			same order as the single ones, so they agree exactly.
+		*/
 		class Ray
 		{
 		public:
@@ -20,11 +29,23 @@ namespace Amethyst
 			~Ray() = default;
 
 			// Returns hit distance or infinity if there is no hit.
-			float HitDistance(const BoundingBox& box) const; // Objects have a bounding box. We check if we hit this bounding box.
+			float HitDistance(const BoundingBox& box) const; // Objects have a bounding box. We check if we hit this bounding box. Zero if we start inside.
 			float HitDistance(const Plane& plane, Vector3* intersectionPoint = nullptr) const; // Check if we hit a point on a plane.
 			float HitDistance(const Vector3& vector1, const Vector3& vector2, const Vector3& vector3, Vector3* outNormal = nullptr, Vector3* outBary = nullptr) const;
 			/// float HitDistance(const Sphere& sphere) const;
 
+			// Eight boxes or triangles at once, as structure-of-arrays.
+			Float8 HitDistance(const Vector3x8& boxMinimum, const Vector3x8& boxMaximum) const;
+			Float8 HitDistance(const Vector3x8& vector1, const Vector3x8& vector2, const Vector3x8& vector3) const;
+
+			// Streams over arrays, eight at a time. Distances are written per box, and the closest triangle is returned with its index.
+			void HitDistances(const BoundingBox* boxes, const uint32_t boxCount, float* distances) const;
+			float HitDistance(const RHI_Vertex_PositionTextureNormalTangent* vertices, const uint32_t* indices, const uint32_t indexCount, uint32_t* triangleIndex = nullptr) const;
+
+			// Closest triangle hit, read in place from mesh data - pass Mesh::VerticesRetrieve() and Mesh::IndicesRetrieve(), offset to the renderable's
+			// geometry range. The ray has to be in the same space as the vertices. Returns false and leaves the hit untouched if nothing is hit.
+			bool Trace(const std::shared_ptr<Entity>& entity, const RHI_Vertex_PositionTextureNormalTangent* vertices, const uint32_t* indices, const uint32_t indexCount, RayHit* hit) const;
+
 			const Vector3& RetrieveStart() const { return m_Start; }
 			const Vector3& RetrieveEnd() const { return m_End; }
 			const float& RetrieveLength() const { return m_Length; }
@@ -36,5 +57,26 @@ namespace Amethyst
 			Vector3 m_Direction;
 			float m_Length = 0.0f;
 		};
+
+		// Eight rays tested together against one box or triangle - a tile of picking or probe rays against a node of a hierarchy, for example.
+		class RayPacket
+		{
+		public:
+			RayPacket() = default;
+			RayPacket(const Ray* rays, const uint32_t count = Float8::Width); // Unused lanes repeat the last ray.
+			~RayPacket() = default;
+
+			Float8 HitDistance(const BoundingBox& box) const;
+			Float8 HitDistance(const Vector3& vector1, const Vector3& vector2, const Vector3& vector3) const;
+
+			const Vector3x8& RetrieveStart() const { return m_Start; }
+			const Vector3x8& RetrieveDirection() const { return m_Direction; }
+			const Float8& RetrieveLength() const { return m_Length; }
+
+		private:
+			Vector3x8 m_Start;
+			Vector3x8 m_Direction;
+			Float8 m_Length;
+		};
 	}
 }
\ No newline at end of file
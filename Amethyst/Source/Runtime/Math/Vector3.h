@@ -98,7 +98,7 @@ namespace Amethyst::Math
 		{
 			return Vector3(
 				vectorA.m_Y * vectorB.m_Z - vectorB.m_Y * vectorA.m_Z,
-				-(vectorA.m_Z * vectorB.m_X - vectorB.m_Z * vectorA.m_X),
+				-(vectorA.m_X * vectorB.m_Z - vectorB.m_X * vectorA.m_Z),
 				vectorA.m_X * vectorB.m_Y - vectorB.m_X * vectorA.m_Y
 			);
 		}
@@ -9,10 +9,11 @@ namespace Amethyst
 		m_ThreadCountSupported = std::thread::hardware_concurrency();
 		m_ThreadCount = m_ThreadCountSupported - 1; // Not including our main thread.
 		m_ThreadNames[std::this_thread::get_id()] = "Main";
+		TimeBlockBuffer::SetCurrentThreadName("Main");
 
 		for (uint32_t i = 0; i < m_ThreadCount; i++)
 		{
-			m_Threads.emplace_back(std::thread(&Threading::ThreadLoop, this));
+			m_Threads.emplace_back(std::thread(&Threading::ThreadLoop, this, i));
 			m_ThreadNames[m_Threads.back().get_id()] = "Worker_" + std::to_string(i);
 		}
 
@@ -47,14 +48,8 @@ namespace Amethyst
 
 	uint32_t Threading::RetrieveThreadsAvaliable() const
 	{
-		uint32_t avaliableThreads = m_ThreadCount;
-
-		for (const std::shared_ptr<Task>& task : m_Tasks)
-		{
-			avaliableThreads -= task->IsExecuting() ? 1 : 0;
-		}
-
-		return avaliableThreads;
+		std::lock_guard<std::mutex> lock(m_TasksMutex);
+		return m_ThreadCount - m_ExecutingTaskCount;
 	}
 
 	void Threading::FlushTasks(bool removeQueued /*= false*/)
@@ -62,18 +57,29 @@ namespace Amethyst
 		// Clear any queued tasks.
 		if (removeQueued)
 		{
+			std::lock_guard<std::mutex> lock(m_TasksMutex);
 			m_Tasks.clear();
 		}
 
-		// If there are any tasks currently running, we shall wait for them to complete.
-		while (AreTasksRunning())
+		// If there are any tasks queued or currently running, we shall wait for them to complete.
+		while (true)
 		{
+			{
+				std::lock_guard<std::mutex> lock(m_TasksMutex);
+				if (m_Tasks.empty() && m_ExecutingTaskCount == 0)
+				{
+					return;
+				}
+			}
+
 			std::this_thread::sleep_for(std::chrono::milliseconds(16));
 		}
 	}
 
-	void Threading::ThreadLoop()
+	void Threading::ThreadLoop(const uint32_t threadIndex)
 	{
+		TimeBlockBuffer::SetCurrentThreadName("Worker_" + std::to_string(threadIndex));
+
 		std::shared_ptr<Task> task;
 
 		while (true)
@@ -95,12 +101,19 @@ namespace Amethyst
 
 			// Remove said task from the queue.
 			m_Tasks.pop_front();
+			m_ExecutingTaskCount++;
 
 			// Unlock the mutex.
 			taskMutex.unlock();
 
 			// Execute the task.
-			task->ExecuteTask();
+			{
+				AMETHYST_PROFILE_SCOPE("Threading::Task");
+				task->ExecuteTask();
+			}
+
+			taskMutex.lock();
+			m_ExecutingTaskCount--;
 		}
 	}
 }
\ No newline at end of file
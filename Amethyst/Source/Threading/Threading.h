@@ -1,12 +1,15 @@
 #pragma once
 #include <vector>
+#include <algorithm>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <deque>
 #include <unordered_map>
 #include "../Runtime/Log/Log.h"
 #include "../Core/ISubsystem.h"
 #include "Task.h"
+#include "../Profiling/TimeBlock.h"
 
 namespace Amethyst
 {
@@ -45,36 +48,57 @@ namespace Amethyst
 		template<typename Function>
 		void AddTaskLoop(Function&& function, uint32_t range)
 		{
-			uint32_t avaliableThreads = RetrieveThreadsAvaliable();
-			std::vector<bool> tasksComplete = std::vector<bool>(avaliableThreads, false); // Creates a vector with a count of all currently avaliable threads.
-			const uint32_t taskCount = avaliableThreads + 1; // Plus one for the current thread.
+			if (range == 0)
+			{
+				return;
+			}
 
-			uint32_t start = 0;
-			uint32_t end = 0;
+			// One chunk per worker plus one for the current thread, but never more chunks than there are iterations. Busy workers only delay their chunk.
+			const uint32_t taskCount = std::min(m_ThreadCount + 1, range);
+			std::atomic<uint32_t> tasksComplete = 0; // Counted rather than flagged per task, as neighbouring bits of a std::vector<bool> can't be written from different threads.
 
-			for (uint32_t i = 0; i < avaliableThreads; i++)
+			// Spread evenly, so that the remainder doesn't all land on the last chunk.
+			for (uint32_t i = 0; i < taskCount - 1; i++)
 			{
-				start = (range / taskCount) * i;
-				end = start + (range / taskCount);
+				const uint32_t start = static_cast<uint32_t>(static_cast<uint64_t>(range) * i / taskCount);
+				const uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(range) * (i + 1) / taskCount);
 
 				// Kick off task.
-				AddTask([&function, &tasksComplete, i, start, end] { function(start, end); tasksComplete[i] = true; });
+				AddTask([&function, &tasksComplete, start, end] { function(start, end); tasksComplete++; });
 			}
 
 			// Complete the last task in the current thread.
-			function(end, range);
+			function(static_cast<uint32_t>(static_cast<uint64_t>(range) * (taskCount - 1) / taskCount), range);
 
-			// Wait till the threads are done.
-			uint32_t tasks = 0;
-			while (tasks != tasksComplete.size())
+			// Wait till the threads are done. The chunks are short, so yield rather than sleep for a whole frame.
+			while (tasksComplete.load() != taskCount - 1)
 			{
-				tasks = 0;
-				for (const bool jobDone : tasksComplete)
-				{
-					tasks += jobDone ? 1 : 0;
-				}
+				std::this_thread::yield();
+			}
+		}
 
-				std::this_thread::sleep_for(std::chrono::milliseconds(16)); // Set current thread to sleep as we wait for the tasks to complete.
+		// Runs function(index) for every index in [0, count) as a task of its own, and waits for all of them. Unlike AddTaskLoop, the split is up to the caller, so each index can own state (such as a command list) no matter which thread runs it.
+		template<typename Function>
+		void AddTaskForEach(Function&& function, const uint32_t count)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			std::atomic<uint32_t> tasksComplete = 0;
+
+			for (uint32_t i = 1; i < count; i++)
+			{
+				AddTask([&function, &tasksComplete, i] { function(i); tasksComplete++; });
+			}
+
+			// The first one runs in the current thread.
+			function(0);
+
+			while (tasksComplete.load() != count - 1)
+			{
+				std::this_thread::yield();
 			}
 		}
 
@@ -82,7 +106,7 @@ namespace Amethyst
 		uint32_t RetrieveThreadCount() const { return m_ThreadCount; }
 		// Retrieve the maximum number of threads the hardware supports.
 		uint32_t RetrieveThreadCountSupported() const { return m_ThreadCountSupported; }
-		// Retrieve the number of free threads.
+		// Retrieve the number of threads not executing a task right now. Only a snapshot, so don't size work from it.
 		uint32_t RetrieveThreadsAvaliable() const;
 		// Returns true if at least one task is running.
 		bool AreTasksRunning() const { return RetrieveThreadsAvaliable() != RetrieveThreadCount(); }
@@ -90,7 +114,7 @@ namespace Amethyst
 		void FlushTasks(bool removeQueued = false);
 
 	private:
-		void ThreadLoop(); // This function is invoked by the threads.
+		void ThreadLoop(const uint32_t threadIndex); // This function is invoked by the threads.
 
 	private:
 		uint32_t m_ThreadCount = 0; //Does not include the main thread.
@@ -100,7 +124,8 @@ namespace Amethyst
 		std::deque<std::shared_ptr<Task>> m_Tasks;
 		std::vector<std::thread> m_Threads;
 		std::condition_variable m_ConditionVariable;
-		std::mutex m_TasksMutex;
+		mutable std::mutex m_TasksMutex;
+		uint32_t m_ExecutingTaskCount = 0; // Guarded by the tasks mutex. Tasks leave the queue before they execute, so it can't tell.
 		bool m_IsStopping;
 	};
 }
\ No newline at end of file
@@ -20,7 +20,7 @@ namespace Amethyst
 		{
 			// The kernel takes time to wake up the thread after the thread has finished sleeping. It can't be trusted for accurate frame limiting. Thus, we do it ourselves.
 			double targetMilliseconds = 1000.0 / m_FPSTarget;
-			while (_deltaTime.count() < targetMilliseconds)
+			while (m_IsFPSLimitEnabled && _deltaTime.count() < targetMilliseconds)
 			{
 				_deltaTime = std::chrono::high_resolution_clock::now() - m_TimeSleepStart;
 			}
@@ -26,6 +26,8 @@ namespace Amethyst
 		double RetrieveTargetFPS() const { return m_FPSTarget; }
 		double RetrieveMinimumFPS() const { return m_FPSMinimum; }
 		FPSLimitType RetrieveFPSLimitType();
+		void SetFPSLimitEnabled(const bool isEnabled) { m_IsFPSLimitEnabled = isEnabled; }
+		bool IsFPSLimitEnabled() const { return m_IsFPSLimitEnabled; }
 
 		//Timer
 		double RetrieveTimeInMilliseconds() const { return m_TimeInMilliseconds; }
@@ -52,5 +54,6 @@ namespace Amethyst
 		double m_FPSMaximum = 1000.0f;
 		double m_FPSTarget = m_FPSMaximum;
 		bool m_IsUserSelectedFPSTarget = false;
+		bool m_IsFPSLimitEnabled = true;
 	};
 }
\ No newline at end of file
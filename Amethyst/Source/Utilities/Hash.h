@@ -9,4 +9,12 @@ namespace Amethyst::Utility
 		std::hash<T> hasher;
 		seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 	}
+
+	// 64-bit keys, for when enough of them are around that 32 bits would start to collide.
+	template<typename T>
+	constexpr void HashCombine(uint64_t& seed, const T& v)
+	{
+		std::hash<T> hasher;
+		seed ^= hasher(v) + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+	}
 }
\ No newline at end of file